@@ -58,6 +58,11 @@
   // is normally defined in bli_config_macro_defs.h.)
   #define BLIS_EXPORT_BLIS
 
+  // Some of the structures defined in bli_type_defs.h are sized by the cache
+  // line size and the maximum number of NUMA nodes. (This header is normally
+  // included via bli_config_macro_defs.h.)
+  #include "bli_mem_macro_defs.h"
+
   #include "bli_system.h"
   #include "bli_type_defs.h"
   #include "bli_arch.h"
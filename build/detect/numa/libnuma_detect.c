@@ -0,0 +1,11 @@
+#include <stdio.h>
+#include <numa.h>
+
+int main( int argc, char **argv )
+{
+	int n = numa_available();
+
+	printf( "%s: numa_available() returned %d\n", __FILE__, n );
+
+	return 0;
+}
@@ -565,6 +565,7 @@ else
 LIBM       := -lm
 endif
 LIBMEMKIND := -lmemkind
+LIBNUMA    := -lnuma
 
 # Default linker flags.
 # NOTE: -lpthread is needed unconditionally because BLIS uses pthread_once()
@@ -577,6 +578,11 @@ ifeq ($(MK_ENABLE_MEMKIND),yes)
 LDFLAGS    += $(LIBMEMKIND)
 endif
 
+# Add libnuma to the link-time flags, if it was enabled at configure-time.
+ifeq ($(MK_ENABLE_LIBNUMA),yes)
+LDFLAGS    += $(LIBNUMA)
+endif
+
 # Never use libm with Intel compilers.
 ifeq ($(CC_VENDOR),icc)
 LDFLAGS    := $(filter-out $(LIBM),$(LDFLAGS))
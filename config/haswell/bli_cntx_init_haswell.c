@@ -69,6 +69,18 @@ void bli_cntx_init_haswell( cntx_t* cntx )
 	  BLIS_GEMMTRSM_U_UKR, BLIS_FLOAT,    bli_sgemmtrsm_u_haswell_asm_6x16,
 	  BLIS_GEMMTRSM_U_UKR, BLIS_DOUBLE,   bli_dgemmtrsm_u_haswell_asm_6x8,
 
+	  // post-ops
+	  BLIS_POSTOPS_KER,    BLIS_FLOAT,    bli_spostops_haswell_int,
+	  BLIS_POSTOPS_KER,    BLIS_DOUBLE,   bli_dpostops_haswell_int,
+
+	  // compact (interleaved batch)
+	  BLIS_GEMM_COMPACT_KER,    BLIS_FLOAT,  bli_sgemm_compact_haswell_int,
+	  BLIS_GEMM_COMPACT_KER,    BLIS_DOUBLE, bli_dgemm_compact_haswell_int,
+	  BLIS_TRSM_COMPACT_KER,    BLIS_FLOAT,  bli_strsm_compact_haswell_int,
+	  BLIS_TRSM_COMPACT_KER,    BLIS_DOUBLE, bli_dtrsm_compact_haswell_int,
+	  BLIS_GETRFNP_COMPACT_KER, BLIS_FLOAT,  bli_sgetrfnp_compact_haswell_int,
+	  BLIS_GETRFNP_COMPACT_KER, BLIS_DOUBLE, bli_dgetrfnp_compact_haswell_int,
+
 #if 1
 	  // packm
 	  BLIS_PACKM_MRXK_KER, BLIS_FLOAT,    bli_spackm_haswell_asm_6xk,
@@ -207,6 +219,11 @@ void bli_cntx_init_haswell( cntx_t* cntx )
 	bli_blksz_init_easy( &blkszs[ BLIS_AF ],     8,     8,     8,     8 );
 	bli_blksz_init_easy( &blkszs[ BLIS_DF ],     8,     8,     8,     8 );
 
+	// Initialize the number of batch members interleaved in each vector of
+	// the compact batch format.
+	//                                           s      d      c      z
+	bli_blksz_init_easy( &blkszs[ BLIS_CV ],     8,     4,     4,     2 );
+
 	// -------------------------------------------------------------------------
 
 	// Initialize sup thresholds with architecture-appropriate values.
@@ -242,6 +259,9 @@ void bli_cntx_init_haswell( cntx_t* cntx )
 	  BLIS_AF, &blkszs[ BLIS_AF ], BLIS_AF,
 	  BLIS_DF, &blkszs[ BLIS_DF ], BLIS_DF,
 
+	  // compact batch format
+	  BLIS_CV, &blkszs[ BLIS_CV ], BLIS_CV,
+
 	  // gemmsup thresholds
 	  BLIS_MT, &blkszs[ BLIS_MT ], BLIS_MT,
 	  BLIS_NT, &blkszs[ BLIS_NT ], BLIS_NT,
@@ -52,6 +52,14 @@ void bli_cntx_init_skx( cntx_t* cntx )
 	  BLIS_GEMM_UKR,       BLIS_FLOAT ,   bli_sgemm_skx_asm_32x12_l2,
 	  BLIS_GEMM_UKR,       BLIS_DOUBLE,   bli_dgemm_skx_asm_16x14,
 
+	  // compact (interleaved batch)
+	  BLIS_GEMM_COMPACT_KER,    BLIS_FLOAT,  bli_sgemm_compact_skx_int,
+	  BLIS_GEMM_COMPACT_KER,    BLIS_DOUBLE, bli_dgemm_compact_skx_int,
+	  BLIS_TRSM_COMPACT_KER,    BLIS_FLOAT,  bli_strsm_compact_skx_int,
+	  BLIS_TRSM_COMPACT_KER,    BLIS_DOUBLE, bli_dtrsm_compact_skx_int,
+	  BLIS_GETRFNP_COMPACT_KER, BLIS_FLOAT,  bli_sgetrfnp_compact_skx_int,
+	  BLIS_GETRFNP_COMPACT_KER, BLIS_DOUBLE, bli_dgetrfnp_compact_skx_int,
+
 	  // axpyf
 	  BLIS_AXPYF_KER,     BLIS_FLOAT,  bli_saxpyf_zen_int_8,
 	  BLIS_AXPYF_KER,     BLIS_DOUBLE, bli_daxpyf_zen_int_8,
@@ -118,6 +126,11 @@ void bli_cntx_init_skx( cntx_t* cntx )
 	bli_blksz_init_easy( &blkszs[ BLIS_AF ],     8,     8,    -1,    -1 );
 	bli_blksz_init_easy( &blkszs[ BLIS_DF ],     8,     8,    -1,    -1 );
 
+	// Initialize the number of batch members interleaved in each vector of
+	// the compact batch format.
+	//                                           s      d      c      z
+	bli_blksz_init_easy( &blkszs[ BLIS_CV ],    16,     8,     8,     4 );
+
 	// Update the context with the current architecture's register and cache
 	// blocksizes (and multiples) for native execution.
 	bli_cntx_set_blkszs
@@ -135,6 +148,9 @@ void bli_cntx_init_skx( cntx_t* cntx )
 	  BLIS_AF, &blkszs[ BLIS_AF ], BLIS_AF,
 	  BLIS_DF, &blkszs[ BLIS_DF ], BLIS_DF,
 
+	  // compact batch format
+	  BLIS_CV, &blkszs[ BLIS_CV ], BLIS_CV,
+
 	  BLIS_VA_END
 	);
 }
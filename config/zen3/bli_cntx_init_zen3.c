@@ -62,6 +62,18 @@ void bli_cntx_init_zen3( cntx_t* cntx )
 	  BLIS_GEMMTRSM_U_UKR, BLIS_FLOAT,    bli_sgemmtrsm_u_haswell_asm_6x16,
 	  BLIS_GEMMTRSM_U_UKR, BLIS_DOUBLE,   bli_dgemmtrsm_u_haswell_asm_6x8,
 
+	  // post-ops
+	  BLIS_POSTOPS_KER,    BLIS_FLOAT,    bli_spostops_haswell_int,
+	  BLIS_POSTOPS_KER,    BLIS_DOUBLE,   bli_dpostops_haswell_int,
+
+	  // compact (interleaved batch)
+	  BLIS_GEMM_COMPACT_KER,    BLIS_FLOAT,  bli_sgemm_compact_haswell_int,
+	  BLIS_GEMM_COMPACT_KER,    BLIS_DOUBLE, bli_dgemm_compact_haswell_int,
+	  BLIS_TRSM_COMPACT_KER,    BLIS_FLOAT,  bli_strsm_compact_haswell_int,
+	  BLIS_TRSM_COMPACT_KER,    BLIS_DOUBLE, bli_dtrsm_compact_haswell_int,
+	  BLIS_GETRFNP_COMPACT_KER, BLIS_FLOAT,  bli_sgetrfnp_compact_haswell_int,
+	  BLIS_GETRFNP_COMPACT_KER, BLIS_DOUBLE, bli_dgetrfnp_compact_haswell_int,
+
 	  // gemmsup
 #if 0
 	  // AMD: This should be enabled in the PR which has added these kernels
@@ -243,12 +255,21 @@ void bli_cntx_init_zen3( cntx_t* cntx )
 	bli_blksz_init_easy( &blkszs[ BLIS_AF ],     5,     5,    -1,    -1 );
 	bli_blksz_init_easy( &blkszs[ BLIS_DF ],     8,     8,    -1,    -1 );
 
+	// Initialize the number of batch members interleaved in each vector of
+	// the compact batch format.
+	//                                           s      d      c      z
+	bli_blksz_init_easy( &blkszs[ BLIS_CV ],     8,     4,     4,     2 );
+
 	// Initialize sup thresholds with architecture-appropriate values.
 	//                                          s     d     c     z
 	bli_blksz_init_easy( &blkszs[ BLIS_MT ],  512,  256,   -1,   -1 );
 	bli_blksz_init_easy( &blkszs[ BLIS_NT ],  200,  256,   -1,   -1 );
 	bli_blksz_init_easy( &blkszs[ BLIS_KT ],  240,  220,   -1,   -1 );
 
+	// Initialize the level-1v multithreading threshold.
+	//                                           s      d      c      z
+	bli_blksz_init_easy( &blkszs[ BLIS_VT ], 32768, 16384, 16384,  8192 );
+
 	// Initialize level-3 sup blocksize objects with architecture-specific
 	// values.
 	//                                               s      d      c      z
@@ -276,11 +297,17 @@ void bli_cntx_init_zen3( cntx_t* cntx )
 	  BLIS_AF, &blkszs[ BLIS_AF ], BLIS_AF,
 	  BLIS_DF, &blkszs[ BLIS_DF ], BLIS_DF,
 
+	  // compact batch format
+	  BLIS_CV, &blkszs[ BLIS_CV ], BLIS_CV,
+
 	  // sup thresholds
 	  BLIS_MT, &blkszs[ BLIS_MT ], BLIS_MT,
 	  BLIS_NT, &blkszs[ BLIS_NT ], BLIS_NT,
 	  BLIS_KT, &blkszs[ BLIS_KT ], BLIS_KT,
 
+	  // level-1v threading threshold
+	  BLIS_VT, &blkszs[ BLIS_VT ], BLIS_VT,
+
 	  // gemmsup
 	  BLIS_NC_SUP, &blkszs[ BLIS_NC_SUP ], BLIS_NR_SUP,
 	  BLIS_KC_SUP, &blkszs[ BLIS_KC_SUP ], BLIS_KR_SUP,
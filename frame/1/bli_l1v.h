@@ -60,6 +60,9 @@
 // Generate function pointer arrays for tapi functions (expert only).
 #include "bli_l1v_fpa.h"
 
+// Thread decorator and bodies for multithreaded execution.
+#include "bli_l1v_decor.h"
+
 // Pack-related
 // NOTE: packv and unpackv are temporarily disabled.
 //#include "bli_packv.h"
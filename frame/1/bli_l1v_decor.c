@@ -0,0 +1,317 @@
+/*
+
+   BLIS
+   An object-based framework for developing high-performance BLAS-like
+   libraries.
+
+   Copyright (C) 2014, The University of Texas at Austin
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are
+   met:
+    - Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    - Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    - Neither the name(s) of the copyright holder(s) nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include "blis.h"
+
+// The variant that implements asumv, which has no kernel of its own.
+typedef void (*asumv_var_ft)
+     (
+       dim_t   n,
+       void*   x, inc_t incx,
+       void*   asum,
+       cntx_t* cntx,
+       rntm_t* rntm
+     );
+
+// Return a pointer to element i of a vector with element size dt_size.
+BLIS_INLINE char* bli_l1v_elem( const void* x, dim_t i, inc_t incx, siz_t dt_size )
+{
+	return ( char* )x + i * incx * ( inc_t )dt_size;
+}
+
+// -----------------------------------------------------------------------------
+
+void bli_l1v_body_xy( dim_t tid, dim_t i0, dim_t i1, const l1v_decor_params_t* params )
+{
+	const siz_t dt_size = bli_dt_size( params->dt );
+
+	( ( addv_ker_ft )params->f )
+	(
+	  params->conjx,
+	  i1 - i0,
+	  bli_l1v_elem( params->x, i0, params->incx, dt_size ), params->incx,
+	  bli_l1v_elem( params->y, i0, params->incy, dt_size ), params->incy,
+	  params->cntx
+	);
+}
+
+void bli_l1v_body_axy( dim_t tid, dim_t i0, dim_t i1, const l1v_decor_params_t* params )
+{
+	const siz_t dt_size = bli_dt_size( params->dt );
+
+	( ( axpyv_ker_ft )params->f )
+	(
+	  params->conjx,
+	  i1 - i0,
+	  params->alpha,
+	  bli_l1v_elem( params->x, i0, params->incx, dt_size ), params->incx,
+	  bli_l1v_elem( params->y, i0, params->incy, dt_size ), params->incy,
+	  params->cntx
+	);
+}
+
+void bli_l1v_body_axby( dim_t tid, dim_t i0, dim_t i1, const l1v_decor_params_t* params )
+{
+	const siz_t dt_size = bli_dt_size( params->dt );
+
+	( ( axpbyv_ker_ft )params->f )
+	(
+	  params->conjx,
+	  i1 - i0,
+	  params->alpha,
+	  bli_l1v_elem( params->x, i0, params->incx, dt_size ), params->incx,
+	  params->beta,
+	  bli_l1v_elem( params->y, i0, params->incy, dt_size ), params->incy,
+	  params->cntx
+	);
+}
+
+void bli_l1v_body_ax( dim_t tid, dim_t i0, dim_t i1, const l1v_decor_params_t* params )
+{
+	const siz_t dt_size = bli_dt_size( params->dt );
+
+	( ( scalv_ker_ft )params->f )
+	(
+	  params->conjx,
+	  i1 - i0,
+	  params->alpha,
+	  bli_l1v_elem( params->y, i0, params->incy, dt_size ), params->incy,
+	  params->cntx
+	);
+}
+
+void bli_l1v_body_dotv( dim_t tid, dim_t i0, dim_t i1, const l1v_decor_params_t* params )
+{
+	const siz_t dt_size = bli_dt_size( params->dt );
+	      void* rho     = bli_l1v_elem( params->part, tid, 1, dt_size );
+
+	// A thread may be assigned no elements, in which case its partial
+	// result is zero.
+	if ( i1 <= i0 ) { memset( rho, 0, dt_size ); return; }
+
+	( ( dotv_ker_ft )params->f )
+	(
+	  params->conjx,
+	  params->conjy,
+	  i1 - i0,
+	  bli_l1v_elem( params->x, i0, params->incx, dt_size ), params->incx,
+	  bli_l1v_elem( params->y, i0, params->incy, dt_size ), params->incy,
+	  rho,
+	  params->cntx
+	);
+}
+
+void bli_l1v_body_dotxv( dim_t tid, dim_t i0, dim_t i1, const l1v_decor_params_t* params )
+{
+	const siz_t dt_size = bli_dt_size( params->dt );
+	      void* rho     = bli_l1v_elem( params->part, tid, 1, dt_size );
+
+	if ( i1 <= i0 ) { memset( rho, 0, dt_size ); return; }
+
+	// The caller passes a beta of zero so that each partial result is
+	// alpha times the dot product of the thread's subvectors.
+	( ( dotxv_ker_ft )params->f )
+	(
+	  params->conjx,
+	  params->conjy,
+	  i1 - i0,
+	  params->alpha,
+	  bli_l1v_elem( params->x, i0, params->incx, dt_size ), params->incx,
+	  bli_l1v_elem( params->y, i0, params->incy, dt_size ), params->incy,
+	  params->beta,
+	  rho,
+	  params->cntx
+	);
+}
+
+void bli_l1v_body_amaxv( dim_t tid, dim_t i0, dim_t i1, const l1v_decor_params_t* params )
+{
+	const siz_t  dt_size = bli_dt_size( params->dt );
+	      dim_t* index   = ( dim_t* )params->part + tid;
+
+	// A thread that is assigned no elements reports an index of -1.
+	if ( i1 <= i0 ) { *index = -1; return; }
+
+	( ( amaxv_ker_ft )params->f )
+	(
+	  i1 - i0,
+	  bli_l1v_elem( params->x, i0, params->incx, dt_size ), params->incx,
+	  index,
+	  params->cntx
+	);
+
+	// Convert the index to one relative to the start of the full vector.
+	*index += i0;
+}
+
+void bli_l1v_body_asumv( dim_t tid, dim_t i0, dim_t i1, const l1v_decor_params_t* params )
+{
+	const siz_t dt_size   = bli_dt_size( params->dt );
+	const siz_t dtr_size  = bli_dt_size( bli_dt_proj_to_real( params->dt ) );
+	      void* asum      = bli_l1v_elem( params->part, tid, 1, dtr_size );
+
+	// asumv sets its output to zero when given an empty vector.
+	( ( asumv_var_ft )params->f )
+	(
+	  bli_max( i1 - i0, 0 ),
+	  bli_l1v_elem( params->x, i0, params->incx, dt_size ), params->incx,
+	  asum,
+	  ( cntx_t* )params->cntx,
+	  NULL
+	);
+}
+
+// -----------------------------------------------------------------------------
+
+// Compute the portion [i0,i1) of the vectors assigned to thread tid of nt.
+static void bli_l1v_thread_range
+     (
+             dim_t               tid,
+             dim_t               nt,
+       const l1v_decor_params_t* params,
+             dim_t*              i0,
+             dim_t*              i1
+     )
+{
+	const dim_t n       = params->n;
+	const siz_t dt_size = bli_dt_size( params->dt );
+	const dim_t bf      = bli_max( BLIS_CACHE_LINE_SIZE / ( dim_t )dt_size, 1 );
+
+	const void* v       = ( params->y != NULL ? params->y    : params->x    );
+	const inc_t incv    = ( params->y != NULL ? params->incy : params->incx );
+
+	// Partition the vectors in units of cache lines. If the vector being
+	// updated (or read, for reductions) is contiguous, place the boundaries
+	// between threads' subvectors on cache line boundaries so that no two
+	// threads write to the same line. pre is the number of elements that
+	// precede the vector within its first cache line.
+	dim_t pre = 0;
+
+	if ( incv == 1 )
+	{
+		const siz_t off = ( uintptr_t )v % BLIS_CACHE_LINE_SIZE;
+
+		if ( off % dt_size == 0 ) pre = off / dt_size;
+	}
+
+	const dim_t n_units = ( n + pre + bf - 1 ) / bf;
+	const dim_t u0      = ( n_units * ( tid     ) ) / nt;
+	const dim_t u1      = ( n_units * ( tid + 1 ) ) / nt;
+
+	*i0 = bli_min( bli_max( u0 * bf - pre, 0 ), n );
+	*i1 = bli_min( bli_max( u1 * bf - pre, 0 ), n );
+}
+
+static void bli_l1v_thread_decorator_entry( thrcomm_t* gl_comm, dim_t tid, const void* data_void )
+{
+	const l1v_decor_params_t* params = data_void;
+
+	// Resolve any mismatch between the number of threads requested and the
+	// number created (e.g. by an OpenMP implementation with nesting
+	// disabled), just as is done for level-3 operations.
+	bli_l3_thread_decorator_thread_check( gl_comm, params->rntm );
+
+	const dim_t nt = bli_thrcomm_num_threads( gl_comm );
+
+	dim_t i0, i1;
+	bli_l1v_thread_range( tid, nt, params, &i0, &i1 );
+
+	params->body( tid, i0, i1, params );
+}
+
+dim_t bli_l1v_thread_nt
+     (
+             num_t   dt,
+             dim_t   n,
+       const cntx_t* cntx,
+       const rntm_t* rntm,
+             rntm_t* rntm_l
+     )
+{
+#ifdef BLIS_ENABLE_MULTITHREADING
+
+	// Give each thread at least BLIS_VT elements. Since the threshold is
+	// stored in the context, it may be tuned for each sub-configuration. A
+	// threshold of zero (or less) disables multithreading. Check the
+	// threshold first so that short vectors never touch the global rntm_t.
+	const dim_t vt = bli_cntx_get_blksz_def_dt( dt, BLIS_VT, cntx );
+
+	if ( vt <= 0 || n < 2 * vt ) return 1;
+
+	// Threads that were themselves launched by BLIS (e.g. to compute a
+	// level-3 operation) always compute level-1v operations alone rather
+	// than launch a nested team of their own.
+	if ( bli_thread_in_region() ) return 1;
+
+	if ( rntm == NULL ) { bli_rntm_init_from_global( rntm_l ); }
+	else                { *rntm_l = *rntm;                     }
+
+	if ( bli_rntm_thread_impl( rntm_l ) == BLIS_SINGLE ) return 1;
+
+	const dim_t nt = bli_min( bli_rntm_num_threads( rntm_l ), n / vt );
+
+	if ( nt <= 1 ) return 1;
+
+	if ( bli_error_checking_is_enabled() )
+		bli_l3_thread_decorator_check( rntm_l );
+
+	bli_rntm_set_num_threads_only( nt, rntm_l );
+	bli_rntm_set_ways_only( 1, 1, 1, 1, 1, rntm_l );
+
+	return nt;
+
+#else
+
+	( void )dt; ( void )n; ( void )cntx; ( void )rntm; ( void )rntm_l;
+
+	return 1;
+
+#endif
+}
+
+void bli_l1v_thread_decorator
+     (
+       l1v_decor_params_t* params,
+       rntm_t*             rntm_l
+     )
+{
+	params->rntm = rntm_l;
+
+	// Launch the threads using the threading implementation specified by
+	// rntm_l, and use bli_l1v_thread_decorator_entry() as their entry
+	// points.
+	bli_thread_launch_rntm( rntm_l, bli_l1v_thread_decorator_entry, params );
+}
+
@@ -0,0 +1,104 @@
+/*
+
+   BLIS
+   An object-based framework for developing high-performance BLAS-like
+   libraries.
+
+   Copyright (C) 2014, The University of Texas at Austin
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are
+   met:
+    - Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    - Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    - Neither the name(s) of the copyright holder(s) nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef BLIS_L1V_DECOR_H
+#define BLIS_L1V_DECOR_H
+
+struct l1v_decor_params_s;
+
+// Level-1v thread body type. A body computes the portion [i0,i1) of the
+// operation described by params on behalf of thread tid.
+typedef void (*l1v_body_ft)
+     (
+             dim_t                      tid,
+             dim_t                      i0,
+             dim_t                      i1,
+       const struct l1v_decor_params_s* params
+     );
+
+// The operands of a multithreaded level-1v operation. Not every field is
+// used by every body. The vector that is updated, if any, is always passed
+// in y, and f is the kernel (or variant) that each body calls. Reductions
+// store one partial result per thread in part.
+struct l1v_decor_params_s
+{
+	      l1v_body_ft body;
+	      void_fp     f;
+	      num_t       dt;
+	      dim_t       n;
+	      conj_t      conjx;
+	      conj_t      conjy;
+	const void*       alpha;
+	const void*       beta;
+	const void*       x; inc_t incx;
+	      void*       y; inc_t incy;
+	      void*       part;
+	const cntx_t*     cntx;
+	      rntm_t*     rntm;
+};
+typedef struct l1v_decor_params_s l1v_decor_params_t;
+
+// Level-1v thread bodies, grouped by kernel signature.
+void bli_l1v_body_xy   ( dim_t tid, dim_t i0, dim_t i1, const l1v_decor_params_t* params );
+void bli_l1v_body_axy  ( dim_t tid, dim_t i0, dim_t i1, const l1v_decor_params_t* params );
+void bli_l1v_body_axby ( dim_t tid, dim_t i0, dim_t i1, const l1v_decor_params_t* params );
+void bli_l1v_body_ax   ( dim_t tid, dim_t i0, dim_t i1, const l1v_decor_params_t* params );
+void bli_l1v_body_dotv ( dim_t tid, dim_t i0, dim_t i1, const l1v_decor_params_t* params );
+void bli_l1v_body_dotxv( dim_t tid, dim_t i0, dim_t i1, const l1v_decor_params_t* params );
+void bli_l1v_body_amaxv( dim_t tid, dim_t i0, dim_t i1, const l1v_decor_params_t* params );
+void bli_l1v_body_asumv( dim_t tid, dim_t i0, dim_t i1, const l1v_decor_params_t* params );
+
+// Return the number of threads that should be used to compute a level-1v
+// operation on vectors of length n. If the result is greater than one,
+// rntm_l is initialized for use with bli_l1v_thread_decorator().
+dim_t bli_l1v_thread_nt
+     (
+             num_t   dt,
+             dim_t   n,
+       const cntx_t* cntx,
+       const rntm_t* rntm,
+             rntm_t* rntm_l
+     );
+
+// Level-1v thread decorator prototype. Upon return, the number of threads
+// in rntm_l reflects the number of partial results stored in params->part.
+void bli_l1v_thread_decorator
+     (
+       l1v_decor_params_t* params,
+       rntm_t*             rntm_l
+     );
+
+#endif
+
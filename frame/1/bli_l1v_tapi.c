@@ -62,6 +62,27 @@ void PASTEMAC2(ch,opname,EX_SUF) \
 	if ( cntx == NULL ) cntx = bli_gks_query_cntx(); \
 \
 	PASTECH(opname,_ker_ft) f = bli_cntx_get_ukr_dt( dt, kerid, cntx ); \
+\
+	/* Use multiple threads if the rntm_t requests them and the vectors are
+	   long enough for each thread to be given a worthwhile amount of work. */ \
+	rntm_t rntm_l; \
+	if ( bli_l1v_thread_nt( dt, n, cntx, rntm, &rntm_l ) > 1 ) \
+	{ \
+		l1v_decor_params_t params = \
+		{ \
+		  .body  = bli_l1v_body_xy, \
+		  .conjx = conjx, \
+		  .x     = x, .incx = incx, \
+		  .y     = y, .incy = incy, \
+		  .f     = ( void_fp )f, \
+		  .dt    = dt, \
+		  .n     = n, \
+		  .cntx  = cntx, \
+		}; \
+\
+		bli_l1v_thread_decorator( &params, &rntm_l ); \
+		return; \
+	} \
 \
 	f \
 	( \
@@ -78,8 +99,8 @@ INSERT_GENTFUNC_BASIC( copyv, BLIS_COPYV_KER )
 INSERT_GENTFUNC_BASIC( subv,  BLIS_SUBV_KER )
 
 
-#undef  GENTFUNC
-#define GENTFUNC( ctype, ch, opname, kerid ) \
+#undef  GENTFUNCR
+#define GENTFUNCR( ctype, ctype_r, ch, chr, opname, kerid ) \
 \
 void PASTEMAC2(ch,opname,EX_SUF) \
      ( \
@@ -99,6 +120,60 @@ void PASTEMAC2(ch,opname,EX_SUF) \
 	if ( cntx == NULL ) cntx = bli_gks_query_cntx(); \
 \
 	PASTECH(opname,_ker_ft) f = bli_cntx_get_ukr_dt( dt, kerid, cntx ); \
+\
+	/* Use multiple threads if the rntm_t requests them and the vector is
+	   long enough for each thread to be given a worthwhile amount of work. */ \
+	rntm_t rntm_l; \
+	dim_t  nt = bli_l1v_thread_nt( dt, n, cntx, rntm, &rntm_l ); \
+	if ( nt > 1 ) \
+	{ \
+		err_t  r_val; \
+		dim_t* part = bli_malloc_intl( nt * sizeof( dim_t ), &r_val ); \
+\
+		l1v_decor_params_t params = \
+		{ \
+		  .body  = bli_l1v_body_amaxv, \
+		  .f     = ( void_fp )f, \
+		  .dt    = dt, \
+		  .n     = n, \
+		  .x     = x, .incx = incx, \
+		  .part  = part, \
+		  .cntx  = cntx, \
+		}; \
+\
+		bli_l1v_thread_decorator( &params, &rntm_l ); \
+\
+		/* Choose among the threads' results in order, using the same rule
+		   as the kernels (including the treatment of NaN), so that the index
+		   of the first maximal element is returned. */ \
+		ctype_r abs_max; \
+		PASTEMAC(chr,copys)( *PASTEMAC(chr,m1), abs_max ); \
+		*index = 0; \
+\
+		for ( dim_t t = 0; t < bli_rntm_num_threads( &rntm_l ); ++t ) \
+		{ \
+			if ( part[ t ] < 0 ) continue; \
+\
+			const ctype* chi1 = x + part[ t ] * incx; \
+			ctype_r      chi1_r, chi1_i, abs_chi1; \
+\
+			PASTEMAC2(ch,chr,gets)( *chi1, chi1_r, chi1_i ); \
+			PASTEMAC(chr,abval2s)( chi1_r, chi1_r ); \
+			PASTEMAC(chr,abval2s)( chi1_i, chi1_i ); \
+			PASTEMAC(chr,set0s)( abs_chi1 ); \
+			PASTEMAC(chr,adds)( chi1_r, abs_chi1 ); \
+			PASTEMAC(chr,adds)( chi1_i, abs_chi1 ); \
+\
+			if ( abs_max < abs_chi1 || ( bli_isnan( abs_chi1 ) && !bli_isnan( abs_max ) ) ) \
+			{ \
+				abs_max = abs_chi1; \
+				*index  = part[ t ]; \
+			} \
+		} \
+\
+		bli_free_intl( part ); \
+		return; \
+	} \
 \
 	f \
 	( \
@@ -109,7 +184,7 @@ void PASTEMAC2(ch,opname,EX_SUF) \
 	); \
 }
 
-INSERT_GENTFUNC_BASIC( amaxv, BLIS_AMAXV_KER )
+INSERT_GENTFUNCR_BASIC( amaxv, BLIS_AMAXV_KER )
 
 
 #undef  GENTFUNC
@@ -136,6 +211,29 @@ void PASTEMAC2(ch,opname,EX_SUF) \
 	if ( cntx == NULL ) cntx = bli_gks_query_cntx(); \
 \
 	PASTECH(opname,_ker_ft) f = bli_cntx_get_ukr_dt( dt, kerid, cntx ); \
+\
+	/* Use multiple threads if the rntm_t requests them and the vectors are
+	   long enough for each thread to be given a worthwhile amount of work. */ \
+	rntm_t rntm_l; \
+	if ( bli_l1v_thread_nt( dt, n, cntx, rntm, &rntm_l ) > 1 ) \
+	{ \
+		l1v_decor_params_t params = \
+		{ \
+		  .body  = bli_l1v_body_axby, \
+		  .conjx = conjx, \
+		  .alpha = alpha, \
+		  .x     = x, .incx = incx, \
+		  .beta  = beta, \
+		  .y     = y, .incy = incy, \
+		  .f     = ( void_fp )f, \
+		  .dt    = dt, \
+		  .n     = n, \
+		  .cntx  = cntx, \
+		}; \
+\
+		bli_l1v_thread_decorator( &params, &rntm_l ); \
+		return; \
+	} \
 \
 	f \
 	( \
@@ -176,6 +274,28 @@ void PASTEMAC2(ch,opname,EX_SUF) \
 		cntx = bli_gks_query_cntx(); \
 \
 	PASTECH(opname,_ker_ft) f = bli_cntx_get_ukr_dt( dt, kerid, cntx ); \
+\
+	/* Use multiple threads if the rntm_t requests them and the vectors are
+	   long enough for each thread to be given a worthwhile amount of work. */ \
+	rntm_t rntm_l; \
+	if ( bli_l1v_thread_nt( dt, n, cntx, rntm, &rntm_l ) > 1 ) \
+	{ \
+		l1v_decor_params_t params = \
+		{ \
+		  .body  = bli_l1v_body_axy, \
+		  .conjx = conjx, \
+		  .alpha = alpha, \
+		  .x     = x, .incx = incx, \
+		  .y     = y, .incy = incy, \
+		  .f     = ( void_fp )f, \
+		  .dt    = dt, \
+		  .n     = n, \
+		  .cntx  = cntx, \
+		}; \
+\
+		bli_l1v_thread_decorator( &params, &rntm_l ); \
+		return; \
+	} \
 \
 	f \
 	( \
@@ -216,6 +336,41 @@ void PASTEMAC2(ch,opname,EX_SUF) \
 	if ( cntx == NULL ) cntx = bli_gks_query_cntx(); \
 \
 	PASTECH(opname,_ker_ft) f = bli_cntx_get_ukr_dt( dt, kerid, cntx ); \
+\
+	/* Use multiple threads if the rntm_t requests them and the vectors are
+	   long enough for each thread to be given a worthwhile amount of work. */ \
+	rntm_t rntm_l; \
+	dim_t  nt = bli_l1v_thread_nt( dt, n, cntx, rntm, &rntm_l ); \
+	if ( nt > 1 ) \
+	{ \
+		err_t  r_val; \
+		ctype* part = bli_malloc_intl( nt * sizeof( ctype ), &r_val ); \
+\
+		l1v_decor_params_t params = \
+		{ \
+		  .body  = bli_l1v_body_dotv, \
+		  .f     = ( void_fp )f, \
+		  .dt    = dt, \
+		  .n     = n, \
+		  .conjx = conjx, \
+		  .conjy = conjy, \
+		  .x     = x, .incx = incx, \
+		  .y     = ( void* )y, .incy = incy, \
+		  .part  = part, \
+		  .cntx  = cntx, \
+		}; \
+\
+		bli_l1v_thread_decorator( &params, &rntm_l ); \
+\
+		/* Sum the threads' partial results in a fixed order so that the
+		   result does not depend on how the threads were scheduled. */ \
+		PASTEMAC(ch,set0s)( *rho ); \
+		for ( dim_t t = 0; t < bli_rntm_num_threads( &rntm_l ); ++t ) \
+			PASTEMAC(ch,adds)( part[ t ], *rho ); \
+\
+		bli_free_intl( part ); \
+		return; \
+	} \
 \
 	f \
 	( \
@@ -258,6 +413,54 @@ void PASTEMAC2(ch,opname,EX_SUF) \
 	if ( cntx == NULL ) cntx = bli_gks_query_cntx(); \
 \
 	PASTECH(opname,_ker_ft) f = bli_cntx_get_ukr_dt( dt, kerid, cntx ); \
+\
+	/* Use multiple threads if the rntm_t requests them and the vectors are
+	   long enough for each thread to be given a worthwhile amount of work. */ \
+	rntm_t rntm_l; \
+	dim_t  nt = bli_l1v_thread_nt( dt, n, cntx, rntm, &rntm_l ); \
+	if ( nt > 1 && !PASTEMAC(ch,eq0)( *alpha ) ) \
+	{ \
+		err_t  r_val; \
+		ctype* part = bli_malloc_intl( nt * sizeof( ctype ), &r_val ); \
+\
+		/* Each thread computes alpha times the dot product of its
+		   subvectors, so beta is applied only once, below. */ \
+		l1v_decor_params_t params = \
+		{ \
+		  .body  = bli_l1v_body_dotxv, \
+		  .f     = ( void_fp )f, \
+		  .dt    = dt, \
+		  .n     = n, \
+		  .conjx = conjx, \
+		  .conjy = conjy, \
+		  .alpha = alpha, \
+		  .x     = x, .incx = incx, \
+		  .y     = ( void* )y, .incy = incy, \
+		  .beta  = PASTEMAC(ch,0), \
+		  .part  = part, \
+		  .cntx  = cntx, \
+		}; \
+\
+		bli_l1v_thread_decorator( &params, &rntm_l ); \
+\
+		/* Scale rho by beta and then add the threads' partial results in a
+		   fixed order so that the result does not depend on how the threads
+		   were scheduled. */ \
+		if ( PASTEMAC(ch,eq0)( *beta ) ) \
+		{ \
+			PASTEMAC(ch,set0s)( *rho ); \
+		} \
+		else \
+		{ \
+			PASTEMAC(ch,scals)( *beta, *rho ); \
+		} \
+\
+		for ( dim_t t = 0; t < bli_rntm_num_threads( &rntm_l ); ++t ) \
+			PASTEMAC(ch,adds)( part[ t ], *rho ); \
+\
+		bli_free_intl( part ); \
+		return; \
+	} \
 \
 	f \
 	( \
@@ -330,6 +533,27 @@ void PASTEMAC2(ch,opname,EX_SUF) \
 	if ( cntx == NULL ) cntx = bli_gks_query_cntx(); \
 \
 	PASTECH(opname,_ker_ft) f = bli_cntx_get_ukr_dt( dt, kerid, cntx ); \
+\
+	/* Use multiple threads if the rntm_t requests them and the vectors are
+	   long enough for each thread to be given a worthwhile amount of work. */ \
+	rntm_t rntm_l; \
+	if ( bli_l1v_thread_nt( dt, n, cntx, rntm, &rntm_l ) > 1 ) \
+	{ \
+		l1v_decor_params_t params = \
+		{ \
+		  .body  = bli_l1v_body_ax, \
+		  .conjx = conjalpha, \
+		  .alpha = alpha, \
+		  .y     = x, .incy = incx, \
+		  .f     = ( void_fp )f, \
+		  .dt    = dt, \
+		  .n     = n, \
+		  .cntx  = cntx, \
+		}; \
+\
+		bli_l1v_thread_decorator( &params, &rntm_l ); \
+		return; \
+	} \
 \
 	f \
 	( \
@@ -72,3 +72,6 @@
 #include "bli_trmv.h"
 #include "bli_trsv.h"
 
+// Multithreading support.
+#include "bli_l2_decor.h"
+
@@ -0,0 +1,701 @@
+/*
+
+   BLIS
+   An object-based framework for developing high-performance BLAS-like
+   libraries.
+
+   Copyright (C) 2014, The University of Texas at Austin
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are
+   met:
+    - Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    - Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    - Neither the name(s) of the copyright holder(s) nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include "blis.h"
+
+// Return a pointer to element i of a vector with element size dt_size.
+BLIS_INLINE char* bli_l2_velem( const void* x, dim_t i, inc_t incx, siz_t dt_size )
+{
+	return ( char* )x + i * incx * ( inc_t )dt_size;
+}
+
+// Return a pointer to element (i,j) of a matrix with element size dt_size.
+BLIS_INLINE char* bli_l2_melem( const void* a, dim_t i, dim_t j, inc_t rs_a, inc_t cs_a, siz_t dt_size )
+{
+	return ( char* )a + ( i * rs_a + j * cs_a ) * ( inc_t )dt_size;
+}
+
+// The number of elements of datatype dt that fit in one cache line. Threads
+// are assigned whole multiples of this many rows or columns.
+BLIS_INLINE dim_t bli_l2_thread_bf( num_t dt )
+{
+	return bli_max( BLIS_CACHE_LINE_SIZE / ( dim_t )bli_dt_size( dt ), 1 );
+}
+
+// Compute the range [i0,i1) of n indices assigned to thread tid of nt, in
+// units of bf.
+static void bli_l2_thread_range
+     (
+       dim_t  tid,
+       dim_t  nt,
+       dim_t  n,
+       dim_t  bf,
+       dim_t* i0,
+       dim_t* i1
+     )
+{
+	const dim_t n_units = ( n + bf - 1 ) / bf;
+
+	*i0 = bli_min( ( ( n_units * ( tid     ) ) / nt ) * bf, n );
+	*i1 = bli_min( ( ( n_units * ( tid + 1 ) ) / nt ) * bf, n );
+}
+
+// Return the first column of the triangle of an m x m matrix assigned to
+// thread t of nt, such that each thread is assigned roughly the same number
+// of elements in the stored triangle. Column boundaries are rounded to a
+// multiple of bf.
+static dim_t bli_l2_thread_tri_bound
+     (
+       bool  lower,
+       dim_t m,
+       dim_t t,
+       dim_t nt,
+       dim_t bf
+     )
+{
+	if ( t <= 0  ) return 0;
+	if ( t >= nt ) return m;
+
+	// The number of elements in columns [0,b) of the triangle is
+	// b(2m-b+1)/2 if the lower triangle is stored and b(b+1)/2 if the
+	// upper triangle is stored. Solve for the b at which this equals the
+	// fraction t/nt of the m(m+1)/2 elements in the triangle.
+	const double md     = ( double )m;
+	const double target = ( md * ( md + 1.0 ) / 2.0 ) * ( double )t / ( double )nt;
+	      double b;
+
+	if ( lower ) b = ( ( 2.0 * md + 1.0 ) - sqrt( ( 2.0 * md + 1.0 ) * ( 2.0 * md + 1.0 ) - 8.0 * target ) ) / 2.0;
+	else         b = ( sqrt( 1.0 + 8.0 * target ) - 1.0 ) / 2.0;
+
+	const dim_t bi = ( ( dim_t )( b + ( double )bf / 2.0 ) / bf ) * bf;
+
+	return bli_min( bli_max( bi, 0 ), m );
+}
+
+// Set the vector segment [i0,i1) of y to beta*y plus the sum of the
+// corresponding segments of the nt partial results in params->part.
+static void bli_l2_thread_reduce
+     (
+             dim_t              i0,
+             dim_t              i1,
+             dim_t              nt,
+       const l2_decor_params_t* params
+     )
+{
+	if ( i1 <= i0 ) return;
+
+	const num_t  dt      = params->dt;
+	const siz_t  dt_size = bli_dt_size( dt );
+	const void*  one     = bli_obj_buffer_for_const( dt, &BLIS_ONE );
+	      void*  y       = bli_l2_velem( params->y, i0, params->incy, dt_size );
+
+	scalv_ex_vft scalv = bli_scalv_ex_qfp( dt );
+	axpyv_ex_vft axpyv = bli_axpyv_ex_qfp( dt );
+
+	scalv( BLIS_NO_CONJUGATE, i1 - i0, params->beta, y, params->incy,
+	       params->cntx, NULL );
+
+	// Accumulate the partial results in thread order so that the result
+	// does not depend on the order in which the threads finish.
+	for ( dim_t t = 0; t < nt; ++t )
+	{
+		const void* part_t = bli_l2_velem( params->part, t * params->ld_p + i0, 1, dt_size );
+
+		axpyv( BLIS_NO_CONJUGATE, i1 - i0, one, part_t, 1, y, params->incy,
+		       params->cntx, NULL );
+	}
+}
+
+// -----------------------------------------------------------------------------
+
+// gemv: partition the elements of y (the rows of op(A)) across threads.
+void bli_l2_body_gemv_rows( thrcomm_t* gl_comm, dim_t tid, const l2_decor_params_t* params )
+{
+	const num_t dt      = params->dt;
+	const siz_t dt_size = bli_dt_size( dt );
+	const dim_t nt      = bli_thrcomm_num_threads( gl_comm );
+	const bool  notrans = bli_does_notrans( params->transa );
+	const dim_t m_y     = ( notrans ? params->m : params->n );
+
+	dim_t i0, i1;
+	bli_l2_thread_range( tid, nt, m_y, bli_l2_thread_bf( dt ), &i0, &i1 );
+
+	if ( i1 <= i0 ) return;
+
+	// Rows [i0,i1) of op(A) are either rows or columns of A.
+	const dim_t m_sub = ( notrans ? i1 - i0 : params->m );
+	const dim_t n_sub = ( notrans ? params->n : i1 - i0 );
+	const inc_t off_a = ( notrans ? params->rs_a : params->cs_a );
+
+	( ( gemv_unb_vft )params->f )
+	(
+	  params->transa,
+	  params->conjx,
+	  m_sub,
+	  n_sub,
+	  ( void* )params->alpha,
+	  bli_l2_velem( params->a, i0, off_a, dt_size ), params->rs_a, params->cs_a,
+	  ( void* )params->x, params->incx,
+	  ( void* )params->beta,
+	  bli_l2_velem( params->y, i0, params->incy, dt_size ), params->incy,
+	  ( cntx_t* )params->cntx
+	);
+}
+
+// gemv: partition the elements of x (the columns of op(A)) across threads,
+// each of which computes a partial result into its own vector. The partial
+// results are then summed in parallel.
+void bli_l2_body_gemv_red( thrcomm_t* gl_comm, dim_t tid, const l2_decor_params_t* params )
+{
+	const num_t dt      = params->dt;
+	const siz_t dt_size = bli_dt_size( dt );
+	const dim_t bf      = bli_l2_thread_bf( dt );
+	const dim_t nt      = bli_thrcomm_num_threads( gl_comm );
+	const bool  notrans = bli_does_notrans( params->transa );
+	const dim_t m_y     = ( notrans ? params->m : params->n );
+	const dim_t n_x     = ( notrans ? params->n : params->m );
+	      void* part_t  = bli_l2_velem( params->part, tid * params->ld_p, 1, dt_size );
+	const void* zero    = bli_obj_buffer_for_const( dt, &BLIS_ZERO );
+
+	// Initialize the partial result so that a thread that is assigned no
+	// columns contributes zero, and so that the variant never reads
+	// uninitialized memory.
+	bli_setv_ex_qfp( dt )( BLIS_NO_CONJUGATE, m_y, zero, part_t, 1,
+	                       params->cntx, NULL );
+
+	dim_t j0, j1;
+	bli_l2_thread_range( tid, nt, n_x, bf, &j0, &j1 );
+
+	if ( j0 < j1 )
+	{
+		// Columns [j0,j1) of op(A) are either columns or rows of A.
+		const dim_t m_sub = ( notrans ? params->m : j1 - j0 );
+		const dim_t n_sub = ( notrans ? j1 - j0 : params->n );
+		const inc_t off_a = ( notrans ? params->cs_a : params->rs_a );
+
+		( ( gemv_unb_vft )params->f )
+		(
+		  params->transa,
+		  params->conjx,
+		  m_sub,
+		  n_sub,
+		  ( void* )params->alpha,
+		  bli_l2_velem( params->a, j0, off_a, dt_size ), params->rs_a, params->cs_a,
+		  bli_l2_velem( params->x, j0, params->incx, dt_size ), params->incx,
+		  ( void* )zero,
+		  part_t, 1,
+		  ( cntx_t* )params->cntx
+		);
+	}
+
+	bli_thrcomm_barrier( tid, gl_comm );
+
+	dim_t i0, i1;
+	bli_l2_thread_range( tid, nt, m_y, bf, &i0, &i1 );
+
+	bli_l2_thread_reduce( i0, i1, nt, params );
+}
+
+// ger: partition the rows of A across threads if A is row-stored, and the
+// columns otherwise, so that each thread updates contiguous memory.
+void bli_l2_body_ger( thrcomm_t* gl_comm, dim_t tid, const l2_decor_params_t* params )
+{
+	const num_t dt      = params->dt;
+	const siz_t dt_size = bli_dt_size( dt );
+	const dim_t nt      = bli_thrcomm_num_threads( gl_comm );
+	const bool  by_rows = bli_is_row_stored( params->rs_a, params->cs_a );
+
+	dim_t i0, i1;
+	bli_l2_thread_range( tid, nt, ( by_rows ? params->m : params->n ),
+	                     bli_l2_thread_bf( dt ), &i0, &i1 );
+
+	if ( i1 <= i0 ) return;
+
+	const dim_t m_sub = ( by_rows ? i1 - i0   : params->m );
+	const dim_t n_sub = ( by_rows ? params->n : i1 - i0   );
+	const dim_t ix    = ( by_rows ? i0 : 0  );
+	const dim_t iy    = ( by_rows ? 0  : i0 );
+
+	( ( ger_unb_vft )params->f )
+	(
+	  params->conjx,
+	  params->conjy,
+	  m_sub,
+	  n_sub,
+	  ( void* )params->alpha,
+	  bli_l2_velem( params->x, ix, params->incx, dt_size ), params->incx,
+	  bli_l2_velem( params->y, iy, params->incy, dt_size ), params->incy,
+	  bli_l2_melem( params->a, ix, iy, params->rs_a, params->cs_a, dt_size ),
+	  params->rs_a, params->cs_a,
+	  ( cntx_t* )params->cntx
+	);
+}
+
+// hemv/symv: partition the columns of the stored triangle across threads,
+// balancing the number of elements each thread reads. Each thread computes
+// the product of its columns (and their reflection across the diagonal)
+// with x into its own vector, and the partial results are then summed in
+// parallel.
+void bli_l2_body_hemv( thrcomm_t* gl_comm, dim_t tid, const l2_decor_params_t* params )
+{
+	const num_t  dt      = params->dt;
+	const siz_t  dt_size = bli_dt_size( dt );
+	const dim_t  bf      = bli_l2_thread_bf( dt );
+	const dim_t  nt      = bli_thrcomm_num_threads( gl_comm );
+	const dim_t  m       = params->m;
+	const bool   lower   = bli_is_lower( params->uploa );
+	const inc_t  rs_a    = params->rs_a;
+	const inc_t  cs_a    = params->cs_a;
+	      void*  part_t  = bli_l2_velem( params->part, tid * params->ld_p, 1, dt_size );
+	const void*  zero    = bli_obj_buffer_for_const( dt, &BLIS_ZERO );
+	const void*  one     = bli_obj_buffer_for_const( dt, &BLIS_ONE );
+
+	bli_setv_ex_qfp( dt )( BLIS_NO_CONJUGATE, m, zero, part_t, 1,
+	                       params->cntx, NULL );
+
+	const dim_t j0 = bli_l2_thread_tri_bound( lower, m, tid,     nt, bf );
+	const dim_t j1 = bli_l2_thread_tri_bound( lower, m, tid + 1, nt, bf );
+	const dim_t b  = j1 - j0;
+
+	if ( 0 < b )
+	{
+		gemv_ex_vft gemv = bli_gemv_ex_qfp( dt );
+
+		// The rectangular part of the thread's columns is R = A(i0:i1,j0:j1).
+		// It contributes conja(R) x(j0:j1) to y(i0:i1), and, via the other
+		// triangle, conj^(conja^conjh)(R)^T x(i0:i1) to y(j0:j1).
+		const dim_t   i0     = ( lower ? j1 : 0  );
+		const dim_t   i1     = ( lower ? m  : j0 );
+		const conj_t  conjat = bli_apply_conj( params->conjh, params->conja );
+		const trans_t transn = ( bli_is_conj( params->conja ) ? BLIS_CONJ_NO_TRANSPOSE
+		                                                      : BLIS_NO_TRANSPOSE );
+		const trans_t transt = ( bli_is_conj( conjat ) ? BLIS_CONJ_TRANSPOSE
+		                                               : BLIS_TRANSPOSE );
+
+		// Compute the diagonal block's contribution to y(j0:j1).
+		( ( hemv_unb_vft )params->f )
+		(
+		  params->uploa,
+		  params->conja,
+		  params->conjx,
+		  params->conjh,
+		  b,
+		  ( void* )params->alpha,
+		  bli_l2_melem( params->a, j0, j0, rs_a, cs_a, dt_size ), rs_a, cs_a,
+		  bli_l2_velem( params->x, j0, params->incx, dt_size ), params->incx,
+		  ( void* )zero,
+		  bli_l2_velem( part_t, j0, 1, dt_size ), 1,
+		  ( cntx_t* )params->cntx
+		);
+
+		if ( i0 < i1 )
+		{
+			const void* r = bli_l2_melem( params->a, i0, j0, rs_a, cs_a, dt_size );
+
+			gemv( transn, params->conjx, i1 - i0, b, params->alpha,
+			      r, rs_a, cs_a,
+			      bli_l2_velem( params->x, j0, params->incx, dt_size ), params->incx,
+			      one, bli_l2_velem( part_t, i0, 1, dt_size ), 1,
+			      params->cntx, NULL );
+
+			gemv( transt, params->conjx, i1 - i0, b, params->alpha,
+			      r, rs_a, cs_a,
+			      bli_l2_velem( params->x, i0, params->incx, dt_size ), params->incx,
+			      one, bli_l2_velem( part_t, j0, 1, dt_size ), 1,
+			      params->cntx, NULL );
+		}
+	}
+
+	bli_thrcomm_barrier( tid, gl_comm );
+
+	dim_t i0, i1;
+	bli_l2_thread_range( tid, nt, m, bf, &i0, &i1 );
+
+	bli_l2_thread_reduce( i0, i1, nt, params );
+}
+
+// her/syr: partition the columns of the stored triangle across threads,
+// balancing the number of elements each thread updates.
+void bli_l2_body_her( thrcomm_t* gl_comm, dim_t tid, const l2_decor_params_t* params )
+{
+	const num_t dt      = params->dt;
+	const siz_t dt_size = bli_dt_size( dt );
+	const dim_t bf      = bli_l2_thread_bf( dt );
+	const dim_t nt      = bli_thrcomm_num_threads( gl_comm );
+	const dim_t m       = params->m;
+	const bool  lower   = bli_is_lower( params->uploa );
+	const inc_t rs_a    = params->rs_a;
+	const inc_t cs_a    = params->cs_a;
+
+	const dim_t j0 = bli_l2_thread_tri_bound( lower, m, tid,     nt, bf );
+	const dim_t j1 = bli_l2_thread_tri_bound( lower, m, tid + 1, nt, bf );
+	const dim_t b  = j1 - j0;
+
+	if ( b <= 0 ) return;
+
+	// Update the diagonal block.
+	( ( her_unb_vft )params->f )
+	(
+	  params->uploa,
+	  params->conjx,
+	  params->conjh,
+	  b,
+	  ( void* )params->alpha,
+	  bli_l2_velem( params->x, j0, params->incx, dt_size ), params->incx,
+	  bli_l2_melem( params->a, j0, j0, rs_a, cs_a, dt_size ), rs_a, cs_a,
+	  ( cntx_t* )params->cntx
+	);
+
+	// Update the rectangular part of the thread's columns, A(i0:i1,j0:j1),
+	// with the outer product of x(i0:i1) and x(j0:j1).
+	const dim_t i0 = ( lower ? j1 : 0  );
+	const dim_t i1 = ( lower ? m  : j0 );
+
+	if ( i1 <= i0 ) return;
+
+	bli_ger_ex_qfp( dt )
+	(
+	  params->conjx,
+	  bli_apply_conj( params->conjh, params->conjx ),
+	  i1 - i0,
+	  b,
+	  params->alpha,
+	  bli_l2_velem( params->x, i0, params->incx, dt_size ), params->incx,
+	  bli_l2_velem( params->x, j0, params->incx, dt_size ), params->incx,
+	  bli_l2_melem( params->a, i0, j0, rs_a, cs_a, dt_size ), rs_a, cs_a,
+	  params->cntx,
+	  NULL
+	);
+}
+
+// trsv: a blocked algorithm in which, for each diagonal block, one thread
+// solves the triangular system and then all threads apply the solution to
+// their share of the remaining elements of x. A has been transformed so
+// that no transposition is needed, leaving only a conjugation.
+void bli_l2_body_trsv( thrcomm_t* gl_comm, dim_t tid, const l2_decor_params_t* params )
+{
+	const num_t   dt        = params->dt;
+	const siz_t   dt_size   = bli_dt_size( dt );
+	const dim_t   bf        = bli_l2_thread_bf( dt );
+	const dim_t   nt        = bli_thrcomm_num_threads( gl_comm );
+	const dim_t   m         = params->m;
+	const dim_t   nb        = params->n;
+	const bool    lower     = bli_is_lower( params->uploa );
+	const inc_t   rs_a      = params->rs_a;
+	const inc_t   cs_a      = params->cs_a;
+	const inc_t   incx      = params->incy;
+	const void*   one       = bli_obj_buffer_for_const( dt, &BLIS_ONE );
+	const void*   minus_one = bli_obj_buffer_for_const( dt, &BLIS_MINUS_ONE );
+	const trans_t transa    = ( bli_is_conj( params->conja ) ? BLIS_CONJ_NO_TRANSPOSE
+	                                                         : BLIS_NO_TRANSPOSE );
+
+	trsv_ex_vft trsv = bli_trsv_ex_qfp( dt );
+	gemv_ex_vft gemv = bli_gemv_ex_qfp( dt );
+
+	// Proceed forward through the diagonal blocks if A is lower triangular
+	// and backward if it is upper triangular.
+	for ( dim_t k = 0; k < m; k += nb )
+	{
+		const dim_t b  = bli_min( nb, m - k );
+		const dim_t j0 = ( lower ? k : m - k - b );
+
+		// Elements [r0,r1) of x remain to be updated with x(j0:j0+b).
+		const dim_t r0 = ( lower ? j0 + b : 0  );
+		const dim_t r1 = ( lower ? m      : j0 );
+
+		void* x1 = bli_l2_velem( params->y, j0, incx, dt_size );
+
+		if ( tid == 0 )
+		{
+			trsv( params->uploa, transa, params->diaga, b, one,
+			      bli_l2_melem( params->a, j0, j0, rs_a, cs_a, dt_size ), rs_a, cs_a,
+			      x1, incx, params->cntx, NULL );
+		}
+
+		bli_thrcomm_barrier( tid, gl_comm );
+
+		dim_t i0, i1;
+		bli_l2_thread_range( tid, nt, r1 - r0, bf, &i0, &i1 );
+
+		if ( i0 < i1 )
+		{
+			gemv( transa, BLIS_NO_CONJUGATE, i1 - i0, b, minus_one,
+			      bli_l2_melem( params->a, r0 + i0, j0, rs_a, cs_a, dt_size ), rs_a, cs_a,
+			      x1, incx,
+			      one, bli_l2_velem( params->y, r0 + i0, incx, dt_size ), incx,
+			      params->cntx, NULL );
+		}
+
+		bli_thrcomm_barrier( tid, gl_comm );
+	}
+}
+
+// -----------------------------------------------------------------------------
+
+static void bli_l2_thread_decorator_entry( thrcomm_t* gl_comm, dim_t tid, const void* data_void )
+{
+	const l2_decor_params_t* params = data_void;
+
+	// Resolve any mismatch between the number of threads requested and the
+	// number created, just as is done for level-1v operations.
+	bli_l3_thread_decorator_thread_check( gl_comm, params->rntm );
+
+	params->body( gl_comm, tid, params );
+}
+
+static void bli_l2_thread_decorator
+     (
+       l2_decor_params_t* params,
+       rntm_t*            rntm_l
+     )
+{
+	params->rntm = rntm_l;
+
+	bli_thread_launch_rntm( rntm_l, bli_l2_thread_decorator_entry, params );
+}
+
+// Allocate space for one partial result of length m per thread, padding
+// each to a whole number of cache lines.
+static void* bli_l2_thread_part_alloc
+     (
+       num_t  dt,
+       dim_t  m,
+       dim_t  nt,
+       dim_t* ld_p
+     )
+{
+	err_t       r_val;
+	const dim_t bf = bli_l2_thread_bf( dt );
+
+	*ld_p = ( ( m + bf - 1 ) / bf ) * bf;
+
+	return bli_malloc_intl( nt * *ld_p * bli_dt_size( dt ), &r_val );
+}
+
+dim_t bli_l2_thread_nt
+     (
+             num_t   dt,
+             dim_t   n_elem,
+       const cntx_t* cntx,
+       const rntm_t* rntm,
+             rntm_t* rntm_l
+     )
+{
+	// Level-2 operations are bound by the rate at which the matrix can be
+	// read, so the threshold for using multiple threads is expressed in
+	// matrix elements and shared with the level-1v operations.
+	return bli_l1v_thread_nt( dt, n_elem, cntx, rntm, rntm_l );
+}
+
+void bli_l2_thread_gemv
+     (
+             num_t   dt,
+             void_fp f,
+             trans_t transa,
+             conj_t  conjx,
+             dim_t   m,
+             dim_t   n,
+       const void*   alpha,
+       const void*   a, inc_t rs_a, inc_t cs_a,
+       const void*   x, inc_t incx,
+       const void*   beta,
+             void*   y, inc_t incy,
+       const cntx_t* cntx,
+             rntm_t* rntm_l
+     )
+{
+	const dim_t nt  = bli_rntm_num_threads( rntm_l );
+	const dim_t m_y = ( bli_does_notrans( transa ) ? m : n );
+
+	l2_decor_params_t params =
+	{
+	  .body = bli_l2_body_gemv_rows, .f = f, .dt = dt,
+	  .transa = transa, .conjx = conjx, .m = m, .n = n,
+	  .alpha = alpha, .beta = beta,
+	  .a = ( void* )a, .rs_a = rs_a, .cs_a = cs_a,
+	  .x = x, .incx = incx, .y = y, .incy = incy,
+	  .cntx = cntx,
+	};
+
+	// Partition y across threads if it is long enough to give each thread
+	// several cache lines of it. Otherwise, y is too short to be split
+	// efficiently, so partition x instead and sum the partial results.
+	if ( m_y >= 4 * nt * bli_l2_thread_bf( dt ) )
+	{
+		bli_l2_thread_decorator( &params, rntm_l );
+	}
+	else
+	{
+		params.body = bli_l2_body_gemv_red;
+		params.part = bli_l2_thread_part_alloc( dt, m_y, nt, &params.ld_p );
+
+		bli_l2_thread_decorator( &params, rntm_l );
+
+		bli_free_intl( params.part );
+	}
+}
+
+void bli_l2_thread_ger
+     (
+             num_t   dt,
+             void_fp f,
+             conj_t  conjx,
+             conj_t  conjy,
+             dim_t   m,
+             dim_t   n,
+       const void*   alpha,
+       const void*   x, inc_t incx,
+       const void*   y, inc_t incy,
+             void*   a, inc_t rs_a, inc_t cs_a,
+       const cntx_t* cntx,
+             rntm_t* rntm_l
+     )
+{
+	l2_decor_params_t params =
+	{
+	  .body = bli_l2_body_ger, .f = f, .dt = dt,
+	  .conjx = conjx, .conjy = conjy, .m = m, .n = n,
+	  .alpha = alpha,
+	  .a = a, .rs_a = rs_a, .cs_a = cs_a,
+	  .x = x, .incx = incx, .y = ( void* )y, .incy = incy,
+	  .cntx = cntx,
+	};
+
+	bli_l2_thread_decorator( &params, rntm_l );
+}
+
+void bli_l2_thread_hemv
+     (
+             num_t   dt,
+             void_fp f,
+             uplo_t  uploa,
+             conj_t  conja,
+             conj_t  conjx,
+             conj_t  conjh,
+             dim_t   m,
+       const void*   alpha,
+       const void*   a, inc_t rs_a, inc_t cs_a,
+       const void*   x, inc_t incx,
+       const void*   beta,
+             void*   y, inc_t incy,
+       const cntx_t* cntx,
+             rntm_t* rntm_l
+     )
+{
+	l2_decor_params_t params =
+	{
+	  .body = bli_l2_body_hemv, .f = f, .dt = dt,
+	  .uploa = uploa, .conja = conja, .conjx = conjx, .conjh = conjh,
+	  .m = m, .n = m,
+	  .alpha = alpha, .beta = beta,
+	  .a = ( void* )a, .rs_a = rs_a, .cs_a = cs_a,
+	  .x = x, .incx = incx, .y = y, .incy = incy,
+	  .cntx = cntx,
+	};
+
+	params.part = bli_l2_thread_part_alloc( dt, m, bli_rntm_num_threads( rntm_l ),
+	                                        &params.ld_p );
+
+	bli_l2_thread_decorator( &params, rntm_l );
+
+	bli_free_intl( params.part );
+}
+
+void bli_l2_thread_her
+     (
+             num_t   dt,
+             void_fp f,
+             uplo_t  uploa,
+             conj_t  conjx,
+             conj_t  conjh,
+             dim_t   m,
+       const void*   alpha,
+       const void*   x, inc_t incx,
+             void*   a, inc_t rs_a, inc_t cs_a,
+       const cntx_t* cntx,
+             rntm_t* rntm_l
+     )
+{
+	l2_decor_params_t params =
+	{
+	  .body = bli_l2_body_her, .f = f, .dt = dt,
+	  .uploa = uploa, .conjx = conjx, .conjh = conjh,
+	  .m = m, .n = m,
+	  .alpha = alpha,
+	  .a = a, .rs_a = rs_a, .cs_a = cs_a,
+	  .x = x, .incx = incx,
+	  .cntx = cntx,
+	};
+
+	bli_l2_thread_decorator( &params, rntm_l );
+}
+
+void bli_l2_thread_trsv
+     (
+             num_t   dt,
+             uplo_t  uploa,
+             trans_t transa,
+             diag_t  diaga,
+             dim_t   m,
+       const void*   a, inc_t rs_a, inc_t cs_a,
+             void*   x, inc_t incx,
+       const cntx_t* cntx,
+             rntm_t* rntm_l
+     )
+{
+	// Solving with A^T (A^H) is equivalent to solving with the matrix A'
+	// that is A stored with its strides swapped, the triangle of which is
+	// the opposite of that of A.
+	if ( bli_does_trans( transa ) )
+	{
+		bli_toggle_uplo( &uploa );
+		bli_swap_incs( &rs_a, &cs_a );
+	}
+
+	// The diagonal blocks are of the size used by the blocked level-2
+	// variants; pass it to the body in n.
+	l2_decor_params_t params =
+	{
+	  .body = bli_l2_body_trsv, .dt = dt,
+	  .uploa = uploa, .conja = bli_extract_conj( transa ), .diaga = diaga,
+	  .m = m, .n = bli_cntx_get_blksz_def_dt( dt, BLIS_M2, cntx ),
+	  .a = ( void* )a, .rs_a = rs_a, .cs_a = cs_a,
+	  .y = x, .incy = incx,
+	  .cntx = cntx,
+	};
+
+	bli_l2_thread_decorator( &params, rntm_l );
+}
+
@@ -0,0 +1,189 @@
+/*
+
+   BLIS
+   An object-based framework for developing high-performance BLAS-like
+   libraries.
+
+   Copyright (C) 2014, The University of Texas at Austin
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are
+   met:
+    - Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    - Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    - Neither the name(s) of the copyright holder(s) nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef BLIS_L2_DECOR_H
+#define BLIS_L2_DECOR_H
+
+struct l2_decor_params_s;
+
+// Level-2 thread body type. Unlike level-1v bodies, a level-2 body is given
+// the thread communicator so that it may partition the operation itself and
+// synchronize with the other threads between phases.
+typedef void (*l2_body_ft)
+     (
+             thrcomm_t*                gl_comm,
+             dim_t                     tid,
+       const struct l2_decor_params_s* params
+     );
+
+// The operands of a multithreaded level-2 operation. Not every field is
+// used by every body. The matrix and vectors are described as they are
+// passed to the variant f, and the object that is updated is either a or y.
+// Bodies that reduce partial results store one vector of length (up to)
+// ld_p per thread in part.
+struct l2_decor_params_s
+{
+	      l2_body_ft body;
+	      void_fp    f;
+	      num_t      dt;
+	      uplo_t     uploa;
+	      trans_t    transa;
+	      diag_t     diaga;
+	      conj_t     conja;
+	      conj_t     conjx;
+	      conj_t     conjy;
+	      conj_t     conjh;
+	      dim_t      m;
+	      dim_t      n;
+	const void*      alpha;
+	const void*      beta;
+	      void*      a; inc_t rs_a; inc_t cs_a;
+	const void*      x; inc_t incx;
+	      void*      y; inc_t incy;
+	      void*      part; dim_t ld_p;
+	const cntx_t*    cntx;
+	      rntm_t*    rntm;
+};
+typedef struct l2_decor_params_s l2_decor_params_t;
+
+// Level-2 thread bodies.
+void bli_l2_body_gemv_rows( thrcomm_t* gl_comm, dim_t tid, const l2_decor_params_t* params );
+void bli_l2_body_gemv_red ( thrcomm_t* gl_comm, dim_t tid, const l2_decor_params_t* params );
+void bli_l2_body_ger      ( thrcomm_t* gl_comm, dim_t tid, const l2_decor_params_t* params );
+void bli_l2_body_hemv     ( thrcomm_t* gl_comm, dim_t tid, const l2_decor_params_t* params );
+void bli_l2_body_her      ( thrcomm_t* gl_comm, dim_t tid, const l2_decor_params_t* params );
+void bli_l2_body_trsv     ( thrcomm_t* gl_comm, dim_t tid, const l2_decor_params_t* params );
+
+// Return the number of threads that should be used to compute a level-2
+// operation that accesses n_elem matrix elements. If the result is greater
+// than one, rntm_l is initialized for use with the functions below.
+dim_t bli_l2_thread_nt
+     (
+             num_t   dt,
+             dim_t   n_elem,
+       const cntx_t* cntx,
+       const rntm_t* rntm,
+             rntm_t* rntm_l
+     );
+
+// Multithreaded level-2 operations. Each is called from the typed API once
+// the operands have been checked, the trivial cases handled, and the
+// variant f chosen. The threads compute the operation by calling f (and,
+// where necessary, other typed APIs) on disjoint submatrices.
+
+void bli_l2_thread_gemv
+     (
+             num_t   dt,
+             void_fp f,
+             trans_t transa,
+             conj_t  conjx,
+             dim_t   m,
+             dim_t   n,
+       const void*   alpha,
+       const void*   a, inc_t rs_a, inc_t cs_a,
+       const void*   x, inc_t incx,
+       const void*   beta,
+             void*   y, inc_t incy,
+       const cntx_t* cntx,
+             rntm_t* rntm_l
+     );
+
+void bli_l2_thread_ger
+     (
+             num_t   dt,
+             void_fp f,
+             conj_t  conjx,
+             conj_t  conjy,
+             dim_t   m,
+             dim_t   n,
+       const void*   alpha,
+       const void*   x, inc_t incx,
+       const void*   y, inc_t incy,
+             void*   a, inc_t rs_a, inc_t cs_a,
+       const cntx_t* cntx,
+             rntm_t* rntm_l
+     );
+
+void bli_l2_thread_hemv
+     (
+             num_t   dt,
+             void_fp f,
+             uplo_t  uploa,
+             conj_t  conja,
+             conj_t  conjx,
+             conj_t  conjh,
+             dim_t   m,
+       const void*   alpha,
+       const void*   a, inc_t rs_a, inc_t cs_a,
+       const void*   x, inc_t incx,
+       const void*   beta,
+             void*   y, inc_t incy,
+       const cntx_t* cntx,
+             rntm_t* rntm_l
+     );
+
+// Note that alpha must be of the (possibly complex) datatype dt, just as it
+// is when passed to the her variants.
+void bli_l2_thread_her
+     (
+             num_t   dt,
+             void_fp f,
+             uplo_t  uploa,
+             conj_t  conjx,
+             conj_t  conjh,
+             dim_t   m,
+       const void*   alpha,
+       const void*   x, inc_t incx,
+             void*   a, inc_t rs_a, inc_t cs_a,
+       const cntx_t* cntx,
+             rntm_t* rntm_l
+     );
+
+// Note that trsv takes no alpha; the caller must scale x beforehand.
+void bli_l2_thread_trsv
+     (
+             num_t   dt,
+             uplo_t  uploa,
+             trans_t transa,
+             diag_t  diaga,
+             dim_t   m,
+       const void*   a, inc_t rs_a, inc_t cs_a,
+             void*   x, inc_t incx,
+       const cntx_t* cntx,
+             rntm_t* rntm_l
+     );
+
+#endif
+
@@ -102,6 +102,22 @@ void PASTEMAC2(ch,opname,EX_SUF) \
 		if ( bli_is_row_stored( rs_a, cs_a ) ) f = PASTEMAC(ch,cvarname); \
 		else /* column or general stored */    f = PASTEMAC(ch,rvarname); \
 	} \
+\
+	/* Use multiple threads if the rntm_t requests them and A is
+	   large enough for each thread to be given a worthwhile amount of
+	   work. */ \
+	rntm_t rntm_l; \
+	if ( bli_l2_thread_nt( PASTEMAC(ch,type), m * n, cntx, rntm, &rntm_l ) > 1 ) \
+	{ \
+		bli_l2_thread_gemv \
+		( \
+		  PASTEMAC(ch,type), ( void_fp )f, \
+		  transa, conjx, m, n, \
+		  alpha, a, rs_a, cs_a, x, incx, beta, y, incy, \
+		  cntx, &rntm_l \
+		); \
+		return; \
+	} \
 \
 	/* Invoke the variant chosen above, which loops over a level-1v or
 	   level-1f kernel to implement the current operation. */ \
@@ -155,6 +171,22 @@ void PASTEMAC2(ch,opname,EX_SUF) \
 	/* Choose the underlying implementation. */ \
 	if ( bli_is_row_stored( rs_a, cs_a ) ) f = PASTEMAC(ch,rvarname); \
 	else /* column or general stored */    f = PASTEMAC(ch,cvarname); \
+\
+	/* Use multiple threads if the rntm_t requests them and A is
+	   large enough for each thread to be given a worthwhile amount of
+	   work. */ \
+	rntm_t rntm_l; \
+	if ( bli_l2_thread_nt( PASTEMAC(ch,type), m * n, cntx, rntm, &rntm_l ) > 1 ) \
+	{ \
+		bli_l2_thread_ger \
+		( \
+		  PASTEMAC(ch,type), ( void_fp )f, \
+		  conjx, conjy, m, n, \
+		  alpha, x, incx, y, incy, a, rs_a, cs_a, \
+		  cntx, &rntm_l \
+		); \
+		return; \
+	} \
 \
 	/* Invoke the variant chosen above, which loops over a level-1v or
 	   level-1f kernel to implement the current operation. */ \
@@ -229,6 +261,22 @@ void PASTEMAC2(ch,opname,EX_SUF) \
 		if ( bli_is_row_stored( rs_a, cs_a ) ) f = PASTEMAC(ch,cvarname); \
 		else /* column or general stored */    f = PASTEMAC(ch,rvarname); \
 	} \
+\
+	/* Use multiple threads if the rntm_t requests them and the stored
+	   triangle of A is large enough for each thread to be given a
+	   worthwhile amount of work. */ \
+	rntm_t rntm_l; \
+	if ( bli_l2_thread_nt( PASTEMAC(ch,type), m * m / 2, cntx, rntm, &rntm_l ) > 1 ) \
+	{ \
+		bli_l2_thread_hemv \
+		( \
+		  PASTEMAC(ch,type), ( void_fp )f, \
+		  uploa, conja, conjx, conjh, m, \
+		  alpha, a, rs_a, cs_a, x, incx, beta, y, incy, \
+		  cntx, &rntm_l \
+		); \
+		return; \
+	} \
 \
 	/* Invoke the variant chosen above, which loops over a level-1v or
 	   level-1f kernel to implement the current operation. */ \
@@ -297,6 +345,22 @@ void PASTEMAC2(ch,opname,EX_SUF) \
 		if ( bli_is_row_stored( rs_a, cs_a ) ) f = PASTEMAC(ch,cvarname); \
 		else /* column or general stored */    f = PASTEMAC(ch,rvarname); \
 	} \
+\
+	/* Use multiple threads if the rntm_t requests them and the stored
+	   triangle of A is large enough for each thread to be given a
+	   worthwhile amount of work. */ \
+	rntm_t rntm_l; \
+	if ( bli_l2_thread_nt( PASTEMAC(ch,type), m * m / 2, cntx, rntm, &rntm_l ) > 1 ) \
+	{ \
+		bli_l2_thread_her \
+		( \
+		  PASTEMAC(ch,type), ( void_fp )f, \
+		  uploa, conjx, conjh, m, \
+		  &alpha_local, x, incx, a, rs_a, cs_a, \
+		  cntx, &rntm_l \
+		); \
+		return; \
+	} \
 \
 	/* Invoke the variant chosen above, which loops over a level-1v or
 	   level-1f kernel to implement the current operation. */ \
@@ -354,6 +418,22 @@ void PASTEMAC2(ch,opname,EX_SUF) \
 		if ( bli_is_row_stored( rs_a, cs_a ) ) f = PASTEMAC(ch,cvarname); \
 		else /* column or general stored */    f = PASTEMAC(ch,rvarname); \
 	} \
+\
+	/* Use multiple threads if the rntm_t requests them and the stored
+	   triangle of A is large enough for each thread to be given a
+	   worthwhile amount of work. */ \
+	rntm_t rntm_l; \
+	if ( bli_l2_thread_nt( PASTEMAC(ch,type), m * m / 2, cntx, rntm, &rntm_l ) > 1 ) \
+	{ \
+		bli_l2_thread_her \
+		( \
+		  PASTEMAC(ch,type), ( void_fp )f, \
+		  uploa, conjx, conjh, m, \
+		  alpha, x, incx, a, rs_a, cs_a, \
+		  cntx, &rntm_l \
+		); \
+		return; \
+	} \
 \
 	/* Invoke the variant chosen above, which loops over a level-1v or
 	   level-1f kernel to implement the current operation. */ \
@@ -506,6 +586,106 @@ void PASTEMAC2(ch,opname,EX_SUF) \
 }
 
 INSERT_GENTFUNC_BASIC( trmv, trmv, trmv_unf_var1, trmv_unf_var2 )
+
+
+#undef  GENTFUNC
+#define GENTFUNC( ctype, ch, opname, ftname, rvarname, cvarname ) \
+\
+void PASTEMAC2(ch,opname,EX_SUF) \
+     ( \
+             uplo_t  uploa, \
+             trans_t transa, \
+             diag_t  diaga, \
+             dim_t   m, \
+       const ctype*  alpha, \
+       const ctype*  a, inc_t rs_a, inc_t cs_a, \
+             ctype*  x, inc_t incx  \
+       BLIS_TAPI_EX_PARAMS  \
+     ) \
+{ \
+	bli_init_once(); \
+\
+	BLIS_TAPI_EX_DECLS \
+\
+	/* If x has zero elements, return early. */ \
+	if ( bli_zero_dim1( m ) ) return; \
+\
+	/* Obtain a valid context from the gks if necessary. */ \
+	if ( cntx == NULL ) cntx = bli_gks_query_cntx(); \
+\
+	/* If alpha is zero, set x to zero and return early. */ \
+	if ( PASTEMAC(ch,eq0)( *alpha ) ) \
+	{ \
+		PASTEMAC2(ch,setv,BLIS_TAPI_EX_SUF) \
+		( \
+		  BLIS_NO_CONJUGATE, \
+		  m, \
+		  alpha, \
+		  x, incx, \
+		  cntx, \
+		  NULL  \
+		); \
+		return; \
+	} \
+\
+	/* Declare a void function pointer for the current operation. */ \
+	PASTECH2(ch,ftname,_unb_ft) f; \
+\
+	/* Choose the underlying implementation. */ \
+	if ( bli_does_notrans( transa ) ) \
+	{ \
+		if ( bli_is_row_stored( rs_a, cs_a ) ) f = PASTEMAC(ch,rvarname); \
+		else /* column or general stored */    f = PASTEMAC(ch,cvarname); \
+	} \
+	else /* if ( bli_does_trans( transa ) ) */ \
+	{ \
+		if ( bli_is_row_stored( rs_a, cs_a ) ) f = PASTEMAC(ch,cvarname); \
+		else /* column or general stored */    f = PASTEMAC(ch,rvarname); \
+	} \
+\
+	/* Use multiple threads if the rntm_t requests them and A is large
+	   enough to be divided into at least two diagonal blocks and for each
+	   thread to be given a worthwhile amount of work. */ \
+	rntm_t rntm_l; \
+	if ( m >= 2 * bli_cntx_get_blksz_def_dt( PASTEMAC(ch,type), BLIS_M2, cntx ) && \
+	     bli_l2_thread_nt( PASTEMAC(ch,type), m * m / 2, cntx, rntm, &rntm_l ) > 1 ) \
+	{ \
+		/* The threads solve with A in blocks, so apply alpha up front. */ \
+		PASTEMAC2(ch,scalv,BLIS_TAPI_EX_SUF) \
+		( \
+		  BLIS_NO_CONJUGATE, \
+		  m, \
+		  alpha, \
+		  x, incx, \
+		  cntx, \
+		  NULL  \
+		); \
+\
+		bli_l2_thread_trsv \
+		( \
+		  PASTEMAC(ch,type), \
+		  uploa, transa, diaga, m, \
+		  a, rs_a, cs_a, x, incx, \
+		  cntx, &rntm_l \
+		); \
+		return; \
+	} \
+\
+	/* Invoke the variant chosen above, which loops over a level-1v or
+	   level-1f kernel to implement the current operation. */ \
+	f \
+	( \
+	  uploa, \
+	  transa, \
+	  diaga, \
+	  m, \
+	  ( ctype* )alpha, \
+	  ( ctype* )a, rs_a, cs_a, \
+	            x, incx, \
+	  ( cntx_t* )cntx \
+	); \
+}
+
 INSERT_GENTFUNC_BASIC( trsv, trmv, trsv_unf_var1, trsv_unf_var2 )
 
 
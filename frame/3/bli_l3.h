@@ -36,6 +36,7 @@
 #include "bli_l3_thrinfo.h"
 #include "bli_l3_decor.h"
 #include "bli_l3_sup_decor.h"
+#include "bli_l3_workspace.h"
 
 #include "bli_l3_cntl.h"
 #include "bli_l3_check.h"
@@ -47,6 +48,8 @@
 #include "bli_l3_oft.h"
 #include "bli_l3_oft_var.h"
 
+#include "bli_l3_postops.h"
+
 #include "bli_l3_blocksize.h"
 #include "bli_l3_direct.h"
 #include "bli_l3_prune.h"
@@ -92,3 +95,6 @@
 #include "bli_trmm3.h"
 #include "bli_trsm.h"
 #include "bli_gemmt.h"
+
+// Operations on batches of tiny matrices in the compact format.
+#include "bli_compact.h"
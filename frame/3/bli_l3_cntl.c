@@ -35,6 +35,130 @@
 
 #include "blis.h"
 
+// -- Default control tree cache -----------------------------------------------
+
+// The default control trees depend only on the operation family, the side
+// (for trsm), the pack schemas of A and B (which also encode the induced
+// method, if any), and the macrokernel function pointer, and they are never
+// modified once built: everything that a thread caches during the course of
+// an operation (such as pack buffers) lives in its thrinfo_t tree. Thus,
+// rather than having every thread build and free its own copy of the tree
+// for every level-3 call, each distinct tree is built once and shared.
+//
+// Entries are only ever appended (until bli_l3_cntl_finalize() empties the
+// table), so the table may be searched without acquiring the lock. A new
+// entry only becomes visible to other threads once n_entries has been
+// published (with release semantics) after the entry is filled in.
+
+#define BLIS_L3_CNTL_CACHE_SIZE 32
+
+typedef struct
+{
+	opid_t  family;
+	side_t  side;
+	pack_t  schema_a;
+	pack_t  schema_b;
+	void_fp ker;
+	cntl_t* cntl;
+} l3_cntl_cache_entry_t;
+
+static l3_cntl_cache_entry_t cntl_cache[ BLIS_L3_CNTL_CACHE_SIZE ];
+static dim_t                 cntl_cache_n     = 0;
+static bli_pthread_mutex_t   cntl_cache_mutex = BLIS_PTHREAD_MUTEX_INITIALIZER;
+
+static cntl_t* bli_l3_cntl_cache_find
+     (
+       dim_t   n_entries,
+       opid_t  family,
+       side_t  side,
+       pack_t  schema_a,
+       pack_t  schema_b,
+       void_fp ker
+     )
+{
+	for ( dim_t i = 0; i < n_entries; ++i )
+	{
+		const l3_cntl_cache_entry_t* e = &cntl_cache[ i ];
+
+		if ( e->family   == family   && e->side     == side     &&
+		     e->schema_a == schema_a && e->schema_b == schema_b &&
+		     e->ker      == ker ) return e->cntl;
+	}
+
+	return NULL;
+}
+
+const cntl_t* bli_l3_cntl_query
+     (
+             opid_t family,
+             pack_t schema_a,
+             pack_t schema_b,
+       const obj_t* a,
+       const obj_t* c
+     )
+{
+	// Only trsm distinguishes between the left and right sides.
+	const side_t  side = ( family == BLIS_TRSM && !bli_obj_is_triangular( a )
+	                       ? BLIS_RIGHT : BLIS_LEFT );
+	const void_fp ker  = bli_obj_ker_fn( c );
+
+	dim_t   n_entries = __atomic_load_n( &cntl_cache_n, __ATOMIC_ACQUIRE );
+	cntl_t* cntl      = bli_l3_cntl_cache_find( n_entries, family, side,
+	                                            schema_a, schema_b, ker );
+
+	if ( cntl != NULL ) return cntl;
+
+	bli_pthread_mutex_lock( &cntl_cache_mutex );
+
+	// Search the entries that were added since we last looked, in case
+	// another thread built the same tree in the meantime.
+	n_entries = cntl_cache_n;
+	cntl      = bli_l3_cntl_cache_find( n_entries, family, side,
+	                                    schema_a, schema_b, ker );
+
+	if ( cntl == NULL && n_entries < BLIS_L3_CNTL_CACHE_SIZE )
+	{
+		// Build the tree outside of any sba pool since it will outlive the
+		// current operation.
+		if ( family == BLIS_TRSM )
+			cntl = bli_trsm_cntl_create( NULL, side, schema_a, schema_b, ker );
+		else
+			cntl = bli_gemm_cntl_create( NULL, family, schema_a, schema_b, ker );
+
+		l3_cntl_cache_entry_t* e = &cntl_cache[ n_entries ];
+
+		e->family   = family;
+		e->side     = side;
+		e->schema_a = schema_a;
+		e->schema_b = schema_b;
+		e->ker      = ker;
+		e->cntl     = cntl;
+
+		__atomic_store_n( &cntl_cache_n, n_entries + 1, __ATOMIC_RELEASE );
+	}
+
+	bli_pthread_mutex_unlock( &cntl_cache_mutex );
+
+	// If the cache is full, cntl is NULL, and the caller must build its own
+	// tree via bli_l3_cntl_create_if().
+	return cntl;
+}
+
+void bli_l3_cntl_finalize( void )
+{
+	bli_pthread_mutex_lock( &cntl_cache_mutex );
+
+	for ( dim_t i = 0; i < cntl_cache_n; ++i )
+	{
+		bli_l3_cntl_free( NULL, cntl_cache[ i ].cntl );
+	}
+
+	cntl_cache_n = 0;
+
+	bli_pthread_mutex_unlock( &cntl_cache_mutex );
+}
+
+// -----------------------------------------------------------------------------
 
 void bli_l3_cntl_create_if
      (
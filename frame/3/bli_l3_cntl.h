@@ -38,6 +38,21 @@
 // Prototype conditional control tree creation functions.
 //
 
+// Return the (shared, read-only) default control tree for the given
+// operation, building it first if necessary. Returns NULL if the tree is
+// not in the cache and the cache is full.
+const cntl_t* bli_l3_cntl_query
+     (
+             opid_t family,
+             pack_t schema_a,
+             pack_t schema_b,
+       const obj_t* a,
+       const obj_t* c
+     );
+
+// Free all cached control trees. Called from bli_finalize().
+void bli_l3_cntl_finalize( void );
+
 void bli_l3_cntl_create_if
      (
              opid_t   family,
@@ -46,6 +46,15 @@ struct l3_decor_params_s
 	const cntx_t*  cntx;
 	      rntm_t*  rntm;
 	      array_t* array;
+
+	// The caller-supplied workspace, if any, in which case array is NULL.
+	      l3_wspace_t*       wspace;
+
+	// The shared control tree and thrinfo_t skeleton, if available, and
+	// the number of threads for which the skeleton was checked out.
+	const cntl_t*            cntl;
+	      l3_thrinfo_skel_t* skel;
+	      dim_t              nt;
 };
 typedef struct l3_decor_params_s l3_decor_params_t;
 
@@ -63,9 +72,17 @@ static void bli_l3_thread_decorator_entry( thrcomm_t* gl_comm, dim_t tid, const
 	const cntx_t*            cntx    = data->cntx;
 	      rntm_t*            rntm    = data->rntm;
 	      array_t*           array   = data->array;
+	      l3_wspace_t*       wspace  = data->wspace;
+	const cntl_t*            cntl    = data->cntl;
+	      l3_thrinfo_skel_t* skel    = data->skel;
 
 	bli_l3_thread_decorator_thread_check( gl_comm, rntm );
 
+	// The skeleton was checked out for the number of threads requested. If
+	// a different number of threads was created, grow new trees instead.
+	if ( skel != NULL && bli_thrcomm_num_threads( gl_comm ) != data->nt )
+		skel = NULL;
+
 	// Alias thread-local copies of A, B, and C. These will be the objects
 	// we pass down the algorithmic function stack. Making thread-local
 	// aliases is highly recommended in case a thread needs to change any
@@ -87,16 +104,33 @@ static void bli_l3_thread_decorator_entry( thrcomm_t* gl_comm, dim_t tid, const
 	bli_obj_set_pack_schema( BLIS_NOT_PACKED, &a_t );
 	bli_obj_set_pack_schema( BLIS_NOT_PACKED, &b_t );
 
-	// Create a default control tree for the operation, if needed.
-	cntl_t* cntl_use;
-	pool_t* sba_pool = bli_apool_array_elem( tid, array );
-	bli_l3_cntl_create_if( family, schema_a, schema_b,
-	                       &a_t, &b_t, &c_t, sba_pool, NULL, &cntl_use );
-
-	// Create the root node of the current thread's thrinfo_t structure.
-	// The root node is the *parent* of the node corresponding to the first
-	// control tree node.
-	thrinfo_t* thread = bli_l3_thrinfo_create( tid, gl_comm, array, rntm, cntl_use );
+	// Use the shared default control tree for the operation if there is
+	// one. Otherwise, create a default control tree.
+	cntl_t* cntl_use = ( cntl_t* )cntl;
+	pool_t* sba_pool = ( wspace != NULL ? bli_l3_workspace_sba_pool( tid, wspace )
+	                                    : bli_apool_array_elem( tid, array ) );
+	if ( cntl_use == NULL )
+		bli_l3_cntl_create_if( family, schema_a, schema_b,
+		                       &a_t, &b_t, &c_t, sba_pool, NULL, &cntl_use );
+
+	// Create the root node of the current thread's thrinfo_t structure (or
+	// reuse the one held by the skeleton). The root node is the *parent* of
+	// the node corresponding to the first control tree node.
+	thrinfo_t* thread;
+	if ( skel != NULL )
+	{
+		thread = bli_l3_thrinfo_skel_root( skel, tid, gl_comm, rntm );
+	}
+	else if ( wspace != NULL )
+	{
+		thread = bli_thrinfo_create_root( gl_comm, tid, sba_pool,
+		                                  bli_l3_workspace_pba( wspace ) );
+		bli_l3_thrinfo_grow( thread, rntm, cntl_use );
+	}
+	else
+	{
+		thread = bli_l3_thrinfo_create( tid, gl_comm, array, rntm, cntl_use );
+	}
 
 	func
 	(
@@ -110,16 +144,21 @@ static void bli_l3_thread_decorator_entry( thrcomm_t* gl_comm, dim_t tid, const
 	  thread
 	);
 
-	// Free the thread's local control tree.
-	bli_l3_cntl_free( sba_pool, cntl_use );
+	// Free the thread's local control tree, if it has one.
+	if ( cntl == NULL )
+		bli_l3_cntl_free( sba_pool, cntl_use );
 
-	// Free the current thread's thrinfo_t structure.
+	// Free the current thread's thrinfo_t structure (or, if it belongs to
+	// the skeleton, just the packing buffers it acquired).
 	// NOTE: The barrier here is very important as it prevents memory being
 	// released by the chief of some thread sub-group before its peers are done
 	// using it. See PR #702 for more info [1].
 	// [1] https://github.com/flame/blis/pull/702
 	bli_thrinfo_barrier( thread );
-	bli_thrinfo_free( thread );
+	if ( skel != NULL )
+		bli_l3_thrinfo_skel_release( thread );
+	else
+		bli_thrinfo_free( thread );
 }
 
 void bli_l3_thread_decorator
@@ -182,11 +221,21 @@ void bli_l3_thread_decorator
 	        ( ti == BLIS_OPENMP ? "openmp" : "pthreads" ) ) );
 #endif
 
-	// Check out an array_t from the small block allocator. This is done
-	// with an internal lock to ensure only one application thread accesses
-	// the sba at a time. bli_sba_checkout_array() will also automatically
-	// resize the array_t, if necessary.
-	array_t* array = bli_sba_checkout_array( nt );
+	// If the caller supplied a workspace, carve the packing buffers and the
+	// nodes of each thread's trees from it instead of acquiring them from
+	// the pba and sba. (If the workspace is too small even for the latter,
+	// it is ignored.)
+	l3_wspace_t* wspace = NULL;
+	if ( bli_rntm_workspace_buf( &rntm_l ) != NULL )
+		wspace = bli_l3_workspace_init( family, a, b, c, cntx, &rntm_l, nt );
+
+	// Otherwise, check out an array_t from the small block allocator. This
+	// is done with an internal lock to ensure only one application thread
+	// accesses the sba at a time. bli_sba_checkout_array() will also
+	// automatically resize the array_t, if necessary.
+	array_t* array = NULL;
+	if ( wspace == NULL )
+		array = bli_sba_checkout_array( nt );
 
 	l3_decor_params_t params;
 	params.func     = func;
@@ -199,16 +248,38 @@ void bli_l3_thread_decorator
 	params.cntx     = cntx;
 	params.rntm     = &rntm_l;
 	params.array    = array;
+	params.wspace   = wspace;
+
+	// Look up the default control tree for the operation and a thrinfo_t
+	// skeleton that matches it, so that the threads need not build their
+	// own. The pack schemas are read from A and B just as they are in
+	// bli_l3_thread_decorator_entry(). Since the skeleton is allocated, it
+	// is not used along with a workspace.
+	params.cntl     = ( wspace == NULL
+	                    ? bli_l3_cntl_query( family,
+	                                         bli_obj_pack_schema( a ),
+	                                         bli_obj_pack_schema( b ),
+	                                         a, c )
+	                    : NULL );
+	params.skel     = ( params.cntl != NULL
+	                    ? bli_l3_thrinfo_skel_checkout( &rntm_l, params.cntl )
+	                    : NULL );
+	params.nt       = nt;
 
 	// Launch the threads using the threading implementation specified by ti,
 	// and use bli_l3_thread_decorator_entry() as their entry points. The
 	// params struct will be passed along to each thread.
-	bli_thread_launch( ti, nt, bli_l3_thread_decorator_entry, &params );
+	bli_thread_launch_rntm( &rntm_l, bli_l3_thread_decorator_entry, &params );
+
+	bli_l3_thrinfo_skel_checkin( params.skel );
 
 	// Check the array_t back into the small block allocator. Similar to the
 	// check-out, this is done using a lock embedded within the sba to ensure
 	// mutual exclusion.
-	bli_sba_checkin_array( array );
+	if ( wspace == NULL )
+		bli_sba_checkin_array( array );
+	else
+		bli_l3_workspace_finalize( wspace );
 }
 
 void bli_l3_thread_decorator_check
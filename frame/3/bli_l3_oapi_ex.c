@@ -58,20 +58,34 @@ void PASTEMAC(gemm,BLIS_OAPI_EX_SUF)
 	// If C has a zero dimension, return early.
 	if ( bli_obj_has_zero_dim( c ) ) return;
 
+	// Check any post-ops that were requested.
+	const postops_t* postops = bli_l3_postops_query( rntm );
+	if ( postops != NULL && bli_error_checking_is_enabled() )
+		bli_l3_postops_check( c, postops );
+
 	// If alpha is zero, or if A or B has a zero dimension, scale C by beta
-	// and return early.
+	// (and apply any post-ops) and return early.
 	if ( bli_obj_equals( alpha, &BLIS_ZERO ) ||
 	     bli_obj_has_zero_dim( a ) ||
 	     bli_obj_has_zero_dim( b ) )
 	{
 		bli_scalm( beta, c );
+		if ( postops != NULL )
+			bli_l3_postops_apply_obj
+			(
+			  FALSE, postops, c,
+			  cntx != NULL ? cntx : bli_gks_query_cntx()
+			);
 		return;
 	}
 
 	// If the rntm is non-NULL, it may indicate that we should forgo sup
-	// handling altogether.
+	// handling altogether. This is also the case if it holds a workspace,
+	// from which only the conventional implementation can carve its
+	// packing buffers.
 	bool enable_sup = TRUE;
-	if ( rntm != NULL ) enable_sup = bli_rntm_l3_sup( rntm );
+	if ( rntm != NULL ) enable_sup = bli_rntm_l3_sup( rntm ) &&
+	                                 bli_rntm_workspace_buf( rntm ) == NULL;
 
 	if ( enable_sup )
 	{
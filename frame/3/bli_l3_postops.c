@@ -0,0 +1,195 @@
+/*
+
+   BLIS
+   An object-based framework for developing high-performance BLAS-like
+   libraries.
+
+   Copyright (C) 2014, The University of Texas at Austin
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are
+   met:
+    - Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    - Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    - Neither the name(s) of the copyright holder(s) nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "blis.h"
+
+void bli_postops_init( postops_t* postops )
+{
+	postops->n_ops = 0;
+}
+
+static postop_desc_t* bli_postops_append( postop_t op, postops_t* postops )
+{
+	if ( postops->n_ops >= BLIS_POSTOPS_MAX )
+		bli_check_error_code( BLIS_EXHAUSTED_POSTOPS );
+
+	postop_desc_t* desc = &postops->ops[ postops->n_ops ];
+
+	postops->n_ops += 1;
+
+	desc->op   = op;
+	desc->dim  = BLIS_M;
+	desc->dt_v = BLIS_DOUBLE;
+	desc->n_v  = 0;
+	desc->v    = NULL;
+	desc->incv = 1;
+	desc->lo   = 0.0;
+	desc->hi   = 0.0;
+
+	return desc;
+}
+
+static void bli_postops_append_vec
+     (
+             postop_t   op,
+             mdim_t     dim,
+       const obj_t*     v,
+             postops_t* postops
+     )
+{
+	if ( bli_error_checking_is_enabled() )
+	{
+		err_t e_val;
+
+		e_val = bli_check_vector_object( v );
+		bli_check_error_code( e_val );
+
+		e_val = bli_check_real_object( v );
+		bli_check_error_code( e_val );
+	}
+
+	postop_desc_t* desc = bli_postops_append( op, postops );
+
+	desc->dim  = dim;
+	desc->dt_v = bli_obj_dt( v );
+	desc->n_v  = bli_obj_vector_dim( v );
+	desc->v    = bli_obj_buffer_at_off( v );
+	desc->incv = bli_obj_vector_inc( v );
+}
+
+void bli_postops_append_bias
+     (
+             mdim_t     dim,
+       const obj_t*     v,
+             postops_t* postops
+     )
+{
+	bli_postops_append_vec( BLIS_POSTOP_BIAS, dim, v, postops );
+}
+
+void bli_postops_append_scale
+     (
+             mdim_t     dim,
+       const obj_t*     v,
+             postops_t* postops
+     )
+{
+	bli_postops_append_vec( BLIS_POSTOP_SCALE, dim, v, postops );
+}
+
+void bli_postops_append_relu( postops_t* postops )
+{
+	bli_postops_append( BLIS_POSTOP_RELU, postops );
+}
+
+void bli_postops_append_gelu_tanh( postops_t* postops )
+{
+	bli_postops_append( BLIS_POSTOP_GELU_TANH, postops );
+}
+
+void bli_postops_append_gelu_erf( postops_t* postops )
+{
+	bli_postops_append( BLIS_POSTOP_GELU_ERF, postops );
+}
+
+void bli_postops_append_clip
+     (
+             double     lo,
+             double     hi,
+             postops_t* postops
+     )
+{
+	postop_desc_t* desc = bli_postops_append( BLIS_POSTOP_CLIP, postops );
+
+	desc->lo = lo;
+	desc->hi = hi;
+}
+
+// -----------------------------------------------------------------------------
+
+void bli_l3_postops_check
+     (
+       const obj_t*     c,
+       const postops_t* postops
+     )
+{
+	err_t e_val;
+
+	// Post-ops are only defined for real matrices.
+	e_val = bli_check_real_object( c );
+	bli_check_error_code( e_val );
+
+	for ( dim_t i = 0; i < postops->n_ops; ++i )
+	{
+		const postop_desc_t* desc = &postops->ops[ i ];
+
+		if ( desc->op != BLIS_POSTOP_BIAS &&
+		     desc->op != BLIS_POSTOP_SCALE ) continue;
+
+		// The vector operand must be of the same datatype as C and span
+		// the dimension of C by which it is indexed.
+		e_val = bli_check_consistent_datatypes( desc->dt_v, bli_obj_dt( c ) );
+		bli_check_error_code( e_val );
+
+		const dim_t n_c = ( desc->dim == BLIS_M ? bli_obj_length( c )
+		                                        : bli_obj_width( c ) );
+
+		if ( desc->n_v != n_c )
+			bli_check_error_code( BLIS_UNEXPECTED_VECTOR_DIM );
+	}
+}
+
+void bli_l3_postops_apply_obj
+     (
+             bool       trans,
+       const postops_t* postops,
+       const obj_t*     c,
+       const cntx_t*    cntx
+     )
+{
+	bli_l3_postops_apply
+	(
+	  bli_obj_dt( c ),
+	  trans,
+	  bli_obj_length( c ),
+	  bli_obj_width( c ),
+	  0, 0,
+	  postops,
+	  bli_obj_buffer_at_off( c ),
+	  bli_obj_row_stride( c ),
+	  bli_obj_col_stride( c ),
+	  cntx
+	);
+}
+
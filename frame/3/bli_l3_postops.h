@@ -0,0 +1,121 @@
+/*
+
+   BLIS
+   An object-based framework for developing high-performance BLAS-like
+   libraries.
+
+   Copyright (C) 2014, The University of Texas at Austin
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are
+   met:
+    - Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    - Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    - Neither the name(s) of the copyright holder(s) nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef BLIS_L3_POSTOPS_H
+#define BLIS_L3_POSTOPS_H
+
+// Post-ops ("epilogues") are elementwise operations that gemm applies to
+// C after computing alpha * A * B + beta * C. Rather than making another
+// pass over C, each microtile is passed through the post-ops right after
+// the kernel that computed it has written it out (while it is still in
+// the L1 cache). A postops_t holds an ordered list of up to
+// BLIS_POSTOPS_MAX post-ops and is requested via bli_rntm_set_postops().
+
+BLIS_EXPORT_BLIS void bli_postops_init( postops_t* postops );
+
+BLIS_EXPORT_BLIS void bli_postops_append_bias
+     (
+             mdim_t     dim,
+       const obj_t*     v,
+             postops_t* postops
+     );
+
+BLIS_EXPORT_BLIS void bli_postops_append_scale
+     (
+             mdim_t     dim,
+       const obj_t*     v,
+             postops_t* postops
+     );
+
+BLIS_EXPORT_BLIS void bli_postops_append_relu( postops_t* postops );
+BLIS_EXPORT_BLIS void bli_postops_append_gelu_tanh( postops_t* postops );
+BLIS_EXPORT_BLIS void bli_postops_append_gelu_erf( postops_t* postops );
+
+BLIS_EXPORT_BLIS void bli_postops_append_clip
+     (
+             double     lo,
+             double     hi,
+             postops_t* postops
+     );
+
+void bli_l3_postops_check
+     (
+       const obj_t*     c,
+       const postops_t* postops
+     );
+
+// Return the post-ops held by rntm, or NULL if there are none to apply.
+BLIS_INLINE const postops_t* bli_l3_postops_query( const rntm_t* rntm )
+{
+	const postops_t* postops = ( rntm != NULL ? bli_rntm_postops( rntm )
+	                                          : NULL );
+
+	if ( postops != NULL && postops->n_ops == 0 ) postops = NULL;
+
+	return postops;
+}
+
+// Apply the post-ops to the m x n submatrix of C at (off_m, off_n). If
+// trans is TRUE, the submatrix is that of C^T (ie: the caller transposed
+// the operation), in which case it is transposed back before indexing the
+// vector operands of the post-ops.
+BLIS_INLINE void bli_l3_postops_apply
+     (
+             num_t      dt,
+             bool       trans,
+             dim_t      m,
+             dim_t      n,
+             dim_t      off_m,
+             dim_t      off_n,
+       const postops_t* postops,
+             void*      c, inc_t rs_c, inc_t cs_c,
+       const cntx_t*    cntx
+     )
+{
+	postops_ker_ft f = bli_cntx_get_ukr_dt( dt, BLIS_POSTOPS_KER, cntx );
+
+	if ( trans ) f( n, m, off_n, off_m, postops, c, cs_c, rs_c, cntx );
+	else         f( m, n, off_m, off_n, postops, c, rs_c, cs_c, cntx );
+}
+
+void bli_l3_postops_apply_obj
+     (
+             bool       trans,
+       const postops_t* postops,
+       const obj_t*     c,
+       const cntx_t*    cntx
+     );
+
+#endif
+
@@ -34,6 +34,57 @@
 
 #include "blis.h"
 
+static dim_t bli_l3_sup_num_threads( const rntm_t* rntm )
+{
+	// Return the total number of threads requested, whether it was given
+	// directly or as the ways of parallelism of the individual loops.
+	dim_t nt = bli_rntm_num_threads( rntm );
+
+	if ( nt < 1 ) nt = bli_rntm_calc_num_threads( rntm );
+
+	return bli_max( nt, 1 );
+}
+
+bool bli_gemmsup_is_small
+     (
+       const obj_t*  a,
+       const obj_t*  b,
+       const obj_t*  c,
+       const cntx_t* cntx,
+       const rntm_t* rntm
+     )
+{
+	// Mixed-datatype computations are never small.
+	if ( bli_obj_dt( c ) != bli_obj_dt( a ) ||
+	     bli_obj_dt( c ) != bli_obj_dt( b ) ||
+	     bli_obj_comp_prec( c ) != bli_obj_prec( c ) ) return FALSE;
+
+	const num_t dt = bli_obj_dt( c );
+	const dim_t m  = bli_obj_length( c );
+	const dim_t n  = bli_obj_width( c );
+	const dim_t k  = bli_obj_width_after_trans( a );
+
+	// If the context carries a calibrated sup dispatch map with a decision
+	// for this problem, that decision stands. Otherwise, fall back to the
+	// sup thresholds.
+	const supdec_t dec = bli_cntx_l3_sup_map_query
+	(
+	  BLIS_GEMM, dt, bli_obj_stor3_from_strides( c, a, b ),
+	  m, n, k, bli_l3_sup_num_threads( rntm ), cntx
+	);
+
+	if ( dec == BLIS_SUP_MAP_CONV ) return FALSE;
+	if ( dec != BLIS_SUP_MAP_UNSET ) return TRUE;
+
+	// A microkernel preference-induced transposition would shift the
+	// dimensions, so in that case we pass in m and n reversed, which
+	// simulates a transposition of the entire operation.
+	if ( bli_cntx_dislikes_storage_of( c, BLIS_GEMM_VIR_UKR, cntx ) )
+		return bli_cntx_l3_sup_thresh_is_met( dt, n, m, k, cntx );
+	else
+		return bli_cntx_l3_sup_thresh_is_met( dt, m, n, k, cntx );
+}
+
 err_t bli_gemmsup
      (
        const obj_t*  alpha,
@@ -50,48 +101,24 @@ err_t bli_gemmsup
 	return BLIS_FAILURE;
 	#endif
 
-	// Return early if this is a mixed-datatype computation.
-	if ( bli_obj_dt( c ) != bli_obj_dt( a ) ||
-	     bli_obj_dt( c ) != bli_obj_dt( b ) ||
-	     bli_obj_comp_prec( c ) != bli_obj_prec( c ) ) return BLIS_FAILURE;
-
 	// Obtain a valid (native) context from the gks if necessary.
 	// NOTE: This must be done before calling the _check() function, since
 	// that function assumes the context pointer is valid.
 	if ( cntx == NULL ) cntx = bli_gks_query_cntx();
 
-	// Return early if a microkernel preference-induced transposition would
-	// have been performed and shifted the dimensions outside of the space
-	// of sup-handled problems.
-	if ( bli_cntx_dislikes_storage_of( c, BLIS_GEMM_VIR_UKR, cntx ) )
-	{
-		const num_t dt = bli_obj_dt( c );
-		const dim_t m  = bli_obj_length( c );
-		const dim_t n  = bli_obj_width( c );
-		const dim_t k  = bli_obj_width_after_trans( a );
-
-		// Pass in m and n reversed, which simulates a transposition of the
-		// entire operation pursuant to the microkernel storage preference.
-		if ( !bli_cntx_l3_sup_thresh_is_met( dt, n, m, k, cntx ) )
-			return BLIS_FAILURE;
-	}
-	else // ukr_prefers_storage_of( c, ... )
-	{
-		const num_t dt = bli_obj_dt( c );
-		const dim_t m  = bli_obj_length( c );
-		const dim_t n  = bli_obj_width( c );
-		const dim_t k  = bli_obj_width_after_trans( a );
-
-		if ( !bli_cntx_l3_sup_thresh_is_met( dt, m, n, k, cntx ) )
-			return BLIS_FAILURE;
-	}
-
 	// Initialize a local runtime with global settings if necessary. Note
 	// that in the case that a runtime is passed in, we make a local copy.
 	rntm_t rntm_l;
 	if ( rntm == NULL ) { bli_rntm_init_from_global( &rntm_l ); }
 	else                { rntm_l = *rntm;                       }
 
+	// Return early if this is a mixed-datatype computation, or if the
+	// calibrated sup dispatch map (if any) prefers the conventional
+	// implementation, or, absent a decision from the map, if the problem
+	// dimensions (after any microkernel preference-induced transposition)
+	// exceed their sup thresholds.
+	if ( !bli_gemmsup_is_small( a, b, c, cntx, &rntm_l ) ) return BLIS_FAILURE;
+
 #if 0
 const num_t dt = bli_obj_dt( c );
 const dim_t m  = bli_obj_length( c );
@@ -158,25 +185,35 @@ err_t bli_gemmtsup
 	// that function assumes the context pointer is valid.
 	if ( cntx == NULL ) cntx = bli_gks_query_cntx();
 
-	// Return early if the problem dimensions exceed their sup thresholds.
-	// Notice that we do not bother to check whether the microkernel
-	// prefers or dislikes the storage of C, since the same check is called
-	// for either way.
+	// Initialize a local runtime with global settings if necessary. Note
+	// that in the case that a runtime is passed in, we make a local copy.
+	rntm_t rntm_l;
+	if ( rntm == NULL ) { bli_rntm_init_from_global( &rntm_l ); }
+	else                { rntm_l = *rntm;                       }
+
+	// Return early if the calibrated sup dispatch map (if any) prefers the
+	// conventional implementation or, absent a decision from the map, if the
+	// problem dimensions exceed their sup thresholds. Notice that we do not
+	// bother to check whether the microkernel prefers or dislikes the
+	// storage of C, since the same check is called for either way.
 	{
 		const num_t dt = bli_obj_dt( c );
 		const dim_t m  = bli_obj_length( c );
 		const dim_t k  = bli_obj_width_after_trans( a );
 
-		if ( !bli_cntx_l3_sup_thresh_is_met( dt, m, m, k, cntx ) )
+		const supdec_t dec = bli_cntx_l3_sup_map_query
+		(
+		  BLIS_GEMMT, dt, bli_obj_stor3_from_strides( c, a, b ),
+		  m, m, k, bli_l3_sup_num_threads( &rntm_l ), cntx
+		);
+
+		if ( dec == BLIS_SUP_MAP_CONV ) return BLIS_FAILURE;
+
+		if ( dec == BLIS_SUP_MAP_UNSET &&
+		     !bli_cntx_l3_sup_thresh_is_met( dt, m, m, k, cntx ) )
 			return BLIS_FAILURE;
 	}
 
-	// Initialize a local runtime with global settings if necessary. Note
-	// that in the case that a runtime is passed in, we make a local copy.
-	rntm_t rntm_l;
-	if ( rntm == NULL ) { bli_rntm_init_from_global( &rntm_l ); }
-	else                { rntm_l = *rntm;                       }
-
 	// We've now ruled out the possibility that the sup thresholds are
 	// unsatisfied.
 	// This implies that the sup thresholds (at least one of them) are met.
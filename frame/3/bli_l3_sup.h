@@ -32,6 +32,17 @@
 
 */
 
+// Return whether bli_gemmsup() would consider the given gemm problem small,
+// and thus hand it to the small/unpacked handler.
+bool bli_gemmsup_is_small
+     (
+       const obj_t*  a,
+       const obj_t*  b,
+       const obj_t*  c,
+       const cntx_t* cntx,
+       const rntm_t* rntm
+     );
+
 err_t bli_gemmsup
      (
        const obj_t*  alpha,
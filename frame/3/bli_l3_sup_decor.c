@@ -171,7 +171,7 @@ err_t bli_l3_sup_thread_decorator
 	params.rntm   = &rntm_l;
 	params.array  = array;
 
-	bli_thread_launch( ti, nt, bli_l3_sup_thread_decorator_entry, &params );
+	bli_thread_launch_rntm( &rntm_l, bli_l3_sup_thread_decorator_entry, &params );
 
 	bli_sba_checkin_array( array );
 
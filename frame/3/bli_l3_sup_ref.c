@@ -91,9 +91,11 @@ err_t bli_gemmsup_ref
 	// set the ways of parallelism for each loop.
 	bli_rntm_factorize_sup
 	(
+	  bli_obj_exec_dt( c ),
 	  bli_obj_length( c ),
 	  bli_obj_width( c ),
 	  bli_obj_width( a ),
+	  cntx,
 	  rntm
 	);
 
@@ -165,9 +167,11 @@ err_t bli_gemmtsup_ref
 	// set the ways of parallelism for each loop.
 	bli_rntm_factorize_sup
 	(
+	  bli_obj_exec_dt( c ),
 	  bli_obj_length( c ),
 	  bli_obj_width( c ),
 	  bli_obj_width( a ),
+	  cntx,
 	  rntm
 	);
 
@@ -229,6 +229,13 @@ void bli_gemmsup_ref_var1n
 	      char* c_00       = buf_c;
 	const void* one        = bli_obj_buffer_for_const( dt, &BLIS_ONE );
 
+	// Query any post-ops that are to be applied to C. Each block of C is
+	// passed through them right after the last millikernel call that
+	// updates it (ie: in the last iteration of the pc loop). NOTE: If the
+	// operation was transposed above, the post-ops must be told.
+	const postops_t* postops  = bli_l3_postops_query( rntm );
+	const bool       po_trans = bli_is_trans( trans );
+
 	auxinfo_t aux;
 
 	// Determine whether we are using more than one thread.
@@ -423,6 +430,16 @@ void bli_gemmsup_ref_var1n
 						  &aux,
 						  ( cntx_t* )cntx
 						);
+
+						if ( postops && pp + kc_cur == k )
+							bli_l3_postops_apply
+							(
+							  dt, po_trans,
+							  nr_cur, mc_cur, jj + j * MR, ii,
+							  postops,
+							  c_jr, rs_c, cs_c,
+							  cntx
+							);
 					}
 				}
 			}
@@ -631,6 +648,13 @@ void bli_gemmsup_ref_var2m
 	      char* c_00       = buf_c;
 	const void* one        = bli_obj_buffer_for_const( dt, &BLIS_ONE );
 
+	// Query any post-ops that are to be applied to C. Each block of C is
+	// passed through them right after the last millikernel call that
+	// updates it (ie: in the last iteration of the pc loop). NOTE: If the
+	// operation was transposed above, the post-ops must be told.
+	const postops_t* postops  = bli_l3_postops_query( rntm );
+	const bool       po_trans = bli_is_trans( trans );
+
 	auxinfo_t aux;
 
 	// Determine whether we are using more than one thread.
@@ -821,6 +845,16 @@ void bli_gemmsup_ref_var2m
 						  &aux,
 						  ( cntx_t* )cntx
 						);
+
+						if ( postops && pp + kc_cur == k )
+							bli_l3_postops_apply
+							(
+							  dt, po_trans,
+							  mc_cur, nr_cur, ii, jj + j * NR,
+							  postops,
+							  c_jr, rs_c, cs_c,
+							  cntx
+							);
 					}
 				}
 			}
@@ -75,6 +75,45 @@ void PASTEMAC(ch,opname) \
 INSERT_GENTFUNC_BASIC( gemm )
 
 
+#undef  GENTFUNC
+#define GENTFUNC( ctype, ch, opname ) \
+\
+void PASTEMAC(ch,opname) \
+     ( \
+             trans_t transa, \
+             trans_t transb, \
+             dim_t   m, \
+             dim_t   n, \
+             dim_t   k, \
+       const ctype*  alpha, \
+       const ctype*  a, inc_t rs_a, inc_t cs_a, inc_t stride_a, \
+       const ctype*  b, inc_t rs_b, inc_t cs_b, inc_t stride_b, \
+       const ctype*  beta, \
+             ctype*  c, inc_t rs_c, inc_t cs_c, inc_t stride_c, \
+             dim_t   batch_count  \
+     ) \
+{ \
+	/* Invoke the expert interface and request default cntx_t and rntm_t
+	   objects. */ \
+	PASTEMAC2(ch,opname,BLIS_TAPI_EX_SUF) \
+	( \
+	  transa, \
+	  transb, \
+	  m, n, k, \
+	  alpha, \
+	  a, rs_a, cs_a, stride_a, \
+	  b, rs_b, cs_b, stride_b, \
+	  beta, \
+	  c, rs_c, cs_c, stride_c, \
+	  batch_count, \
+	  NULL, \
+	  NULL  \
+	); \
+}
+
+INSERT_GENTFUNC_BASIC( gemm_batch_strided )
+
+
 #undef  GENTFUNC
 #define GENTFUNC( ctype, ch, opname ) \
 \
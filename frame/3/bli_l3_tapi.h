@@ -57,6 +57,27 @@ BLIS_EXPORT_BLIS void PASTEMAC(ch,opname) \
 
 INSERT_GENTPROT_BASIC( gemm )
 
+
+#undef  GENTPROT
+#define GENTPROT( ctype, ch, opname ) \
+\
+BLIS_EXPORT_BLIS void PASTEMAC(ch,opname) \
+     ( \
+             trans_t transa, \
+             trans_t transb, \
+             dim_t   m, \
+             dim_t   n, \
+             dim_t   k, \
+       const ctype*  alpha, \
+       const ctype*  a, inc_t rs_a, inc_t cs_a, inc_t stride_a, \
+       const ctype*  b, inc_t rs_b, inc_t cs_b, inc_t stride_b, \
+       const ctype*  beta, \
+             ctype*  c, inc_t rs_c, inc_t cs_c, inc_t stride_c, \
+             dim_t   batch_count  \
+     );
+
+INSERT_GENTPROT_BASIC( gemm_batch_strided )
+
 #undef  GENTPROT
 #define GENTPROT( ctype, ch, opname ) \
 \
@@ -59,6 +59,15 @@ void PASTEMAC2(ch,opname,BLIS_OAPI_EX_SUF) \
      ) \
 { \
 	bli_init_once(); \
+\
+	/* Compute tiny problems directly with the sup millikernels, without
+	   building objects. */ \
+	if ( PASTEMAC2(ch,opname,_tiny) \
+	     ( \
+	       transa, transb, m, n, k, \
+	       alpha, a, rs_a, cs_a, b, rs_b, cs_b, \
+	       beta,  c, rs_c, cs_c, cntx, rntm \
+	     ) == BLIS_SUCCESS ) return; \
 \
 	const num_t dt = PASTEMAC(ch,type); \
 \
@@ -98,6 +107,85 @@ void PASTEMAC2(ch,opname,BLIS_OAPI_EX_SUF) \
 
 INSERT_GENTFUNC_BASIC( gemm )
 
+
+#undef  GENTFUNC
+#define GENTFUNC( ctype, ch, opname ) \
+\
+void PASTEMAC2(ch,opname,BLIS_OAPI_EX_SUF) \
+     ( \
+             trans_t transa, \
+             trans_t transb, \
+             dim_t   m, \
+             dim_t   n, \
+             dim_t   k, \
+       const ctype*  alpha, \
+       const ctype*  a, inc_t rs_a, inc_t cs_a, inc_t stride_a, \
+       const ctype*  b, inc_t rs_b, inc_t cs_b, inc_t stride_b, \
+       const ctype*  beta, \
+             ctype*  c, inc_t rs_c, inc_t cs_c, inc_t stride_c, \
+             dim_t   batch_count, \
+       const cntx_t* cntx, \
+       const rntm_t* rntm  \
+     ) \
+{ \
+	bli_init_once(); \
+\
+	/* Since the members are written concurrently, reject a negative batch
+	   size and strides at which the members of C would overlap. */ \
+	if ( bli_error_checking_is_enabled() ) \
+	{ \
+		err_t e_val = bli_check_batch_stride( batch_count, m, n, \
+		                                      rs_c, cs_c, stride_c ); \
+		bli_check_error_code( e_val ); \
+	} \
+\
+	const num_t dt = PASTEMAC(ch,type); \
+\
+	obj_t       alphao = BLIS_OBJECT_INITIALIZER_1X1; \
+	obj_t       ao     = BLIS_OBJECT_INITIALIZER; \
+	obj_t       bo     = BLIS_OBJECT_INITIALIZER; \
+	obj_t       betao  = BLIS_OBJECT_INITIALIZER_1X1; \
+	obj_t       co     = BLIS_OBJECT_INITIALIZER; \
+\
+	dim_t       m_a, n_a; \
+	dim_t       m_b, n_b; \
+\
+	bli_set_dims_with_trans( transa, m, k, &m_a, &n_a ); \
+	bli_set_dims_with_trans( transb, k, n, &m_b, &n_b ); \
+\
+	bli_obj_init_finish_1x1( dt, ( void* )alpha, &alphao ); \
+	bli_obj_init_finish_1x1( dt, ( void* )beta,  &betao  ); \
+\
+	bli_obj_init_finish( dt, m_a, n_a, ( void* )a, rs_a, cs_a, &ao ); \
+	bli_obj_init_finish( dt, m_b, n_b, ( void* )b, rs_b, cs_b, &bo ); \
+	bli_obj_init_finish( dt, m,   n,            c, rs_c, cs_c, &co ); \
+\
+	bli_obj_set_conjtrans( transa, &ao ); \
+	bli_obj_set_conjtrans( transb, &bo ); \
+\
+	/* The batch is a single group whose members lie at constant strides
+	   from the first. */ \
+	gemm_batch_group_t group; \
+\
+	group.alpha = alphao; \
+	group.a     = ao; \
+	group.b     = bo; \
+	group.beta  = betao; \
+	group.c     = co; \
+\
+	group.size  = batch_count; \
+	group.buf_a = NULL; \
+	group.buf_b = NULL; \
+	group.buf_c = NULL; \
+	group.str_a = stride_a; \
+	group.str_b = stride_b; \
+	group.str_c = stride_c; \
+\
+	bli_gemm_batch_ex( 1, &group, cntx, rntm ); \
+}
+
+INSERT_GENTFUNC_BASIC( gemm_batch_strided )
+
 #undef  GENTFUNC
 #define GENTFUNC( ctype, ch, opname, struca ) \
 \
@@ -117,6 +117,239 @@ void bli_l3_thrinfo_grow
 	}
 }
 
+// -- thrinfo_t skeleton cache -------------------------------------------------
+
+// Growing a thrinfo_t tree requires each thread to allocate a node per level
+// of the control tree and the teams at each level to allocate, broadcast,
+// and synchronize on new communicators. None of this depends on the operands
+// themselves, only on the control tree, the threading implementation, and
+// the factorization of the threads into ways of parallelism. So once a team
+// of threads has grown its trees, they are kept in a "skeleton" and reused
+// by the next team that asks for the same configuration.
+//
+// A skeleton may be in use by only one team at a time, so skeletons are
+// checked out before the threads are launched and checked back in once they
+// have finished. The only state that survives between uses is that of the
+// communicators, which the threads always leave at rest (every barrier is
+// reached by all of a communicator's threads before the operation returns).
+// The exception is the global communicator, which is created anew for each
+// launch and must therefore be substituted into the trees upon reuse.
+
+#define BLIS_L3_THRINFO_CACHE_SIZE 8
+
+struct l3_thrinfo_skel_s
+{
+	const cntl_t*     cntl;
+	      timpl_t     ti;
+	      dim_t       nt;
+	      dim_t       ways[ 5 ];
+	      wpol_t      wait_policy;
+	      jrir_t      jrir_sched;
+
+	      bool        busy;
+	      thrinfo_t** roots;
+};
+
+static l3_thrinfo_skel_t   thrinfo_cache[ BLIS_L3_THRINFO_CACHE_SIZE ];
+static bli_pthread_mutex_t thrinfo_cache_mutex = BLIS_PTHREAD_MUTEX_INITIALIZER;
+
+static void bli_l3_thrinfo_skel_set_key
+     (
+       const rntm_t*            rntm,
+       const cntl_t*            cntl,
+             l3_thrinfo_skel_t* skel
+     )
+{
+	skel->cntl        = cntl;
+	skel->ti          = bli_rntm_thread_impl( rntm );
+	skel->nt          = bli_rntm_num_threads( rntm );
+	skel->ways[ 0 ]   = bli_rntm_jc_ways( rntm );
+	skel->ways[ 1 ]   = bli_rntm_pc_ways( rntm );
+	skel->ways[ 2 ]   = bli_rntm_ic_ways( rntm );
+	skel->ways[ 3 ]   = bli_rntm_jr_ways( rntm );
+	skel->ways[ 4 ]   = bli_rntm_ir_ways( rntm );
+	skel->wait_policy = bli_rntm_wait_policy( rntm );
+	skel->jrir_sched  = bli_rntm_jrir_sched( rntm );
+}
+
+static bool bli_l3_thrinfo_skel_matches
+     (
+       const l3_thrinfo_skel_t* skel,
+       const l3_thrinfo_skel_t* key
+     )
+{
+	return skel->roots       != NULL              &&
+	       skel->cntl        == key->cntl         &&
+	       skel->ti          == key->ti           &&
+	       skel->nt          == key->nt           &&
+	       skel->ways[ 0 ]   == key->ways[ 0 ]    &&
+	       skel->ways[ 1 ]   == key->ways[ 1 ]    &&
+	       skel->ways[ 2 ]   == key->ways[ 2 ]    &&
+	       skel->ways[ 3 ]   == key->ways[ 3 ]    &&
+	       skel->ways[ 4 ]   == key->ways[ 4 ]    &&
+	       skel->wait_policy == key->wait_policy  &&
+	       skel->jrir_sched  == key->jrir_sched;
+}
+
+// Free the trees held by a skeleton that is not in use.
+static void bli_l3_thrinfo_skel_clear
+     (
+       l3_thrinfo_skel_t* skel
+     )
+{
+	if ( skel->roots == NULL ) return;
+
+	// Each communicator is freed by the tree of the thread that was its
+	// chief, so the trees may be freed one after another.
+	for ( dim_t i = 0; i < skel->nt; ++i )
+		bli_thrinfo_free( skel->roots[ i ] );
+
+	bli_free_intl( skel->roots );
+	skel->roots = NULL;
+}
+
+l3_thrinfo_skel_t* bli_l3_thrinfo_skel_checkout
+     (
+       const rntm_t* rntm,
+       const cntl_t* cntl
+     )
+{
+	err_t             r_val;
+	l3_thrinfo_skel_t key;
+	l3_thrinfo_skel_t* skel = NULL;
+
+	bli_l3_thrinfo_skel_set_key( rntm, cntl, &key );
+
+	bli_pthread_mutex_lock( &thrinfo_cache_mutex );
+
+	// Look for an idle skeleton with the same configuration.
+	for ( dim_t i = 0; i < BLIS_L3_THRINFO_CACHE_SIZE; ++i )
+	{
+		l3_thrinfo_skel_t* s = &thrinfo_cache[ i ];
+
+		if ( !s->busy && bli_l3_thrinfo_skel_matches( s, &key ) ) { skel = s; break; }
+	}
+
+	// Otherwise, claim an empty slot or, failing that, recycle an idle one.
+	if ( skel == NULL )
+	{
+		for ( dim_t i = 0; i < BLIS_L3_THRINFO_CACHE_SIZE; ++i )
+		{
+			l3_thrinfo_skel_t* s = &thrinfo_cache[ i ];
+
+			if ( s->busy ) continue;
+			if ( skel == NULL || s->roots == NULL ) skel = s;
+			if ( s->roots == NULL ) break;
+		}
+
+		if ( skel != NULL )
+		{
+			bli_l3_thrinfo_skel_clear( skel );
+
+			key.busy  = FALSE;
+			key.roots = bli_calloc_intl( key.nt * sizeof( thrinfo_t* ), &r_val );
+			*skel     = key;
+		}
+	}
+
+	// If every skeleton is in use, the caller must grow its own trees.
+	if ( skel != NULL ) skel->busy = TRUE;
+
+	bli_pthread_mutex_unlock( &thrinfo_cache_mutex );
+
+	return skel;
+}
+
+void bli_l3_thrinfo_skel_checkin
+     (
+       l3_thrinfo_skel_t* skel
+     )
+{
+	if ( skel == NULL ) return;
+
+	bli_pthread_mutex_lock( &thrinfo_cache_mutex );
+	skel->busy = FALSE;
+	bli_pthread_mutex_unlock( &thrinfo_cache_mutex );
+}
+
+// Replace comm_old with comm_new throughout a thrinfo_t tree.
+static void bli_l3_thrinfo_rebind
+     (
+       thrcomm_t* comm_old,
+       thrcomm_t* comm_new,
+       thrinfo_t* thread
+     )
+{
+	if ( thread == NULL ) return;
+
+	if ( bli_thrinfo_comm( thread ) == comm_old )
+	{
+		bli_thrinfo_set_comm( comm_new, thread );
+
+		// The new communicator's work counter starts from zero.
+		bli_thrinfo_set_dyn_base( 0, thread );
+	}
+
+	bli_l3_thrinfo_rebind( comm_old, comm_new, bli_thrinfo_sub_prenode( thread ) );
+	bli_l3_thrinfo_rebind( comm_old, comm_new, bli_thrinfo_sub_node( thread ) );
+}
+
+thrinfo_t* bli_l3_thrinfo_skel_root
+     (
+             l3_thrinfo_skel_t* skel,
+             dim_t              id,
+             thrcomm_t*         gl_comm,
+       const rntm_t*            rntm
+     )
+{
+	thrinfo_t* root = skel->roots[ id ];
+
+	if ( root == NULL )
+	{
+		// Grow the tree outside of any sba pool since it will outlive the
+		// current operation.
+		root = bli_l3_thrinfo_create( id, gl_comm, NULL, rntm, skel->cntl );
+		skel->roots[ id ] = root;
+	}
+	else
+	{
+		bli_l3_thrinfo_rebind( bli_thrinfo_comm( root ), gl_comm, root );
+	}
+
+	return root;
+}
+
+void bli_l3_thrinfo_skel_release
+     (
+       thrinfo_t* thread
+     )
+{
+	if ( thread == NULL ) return;
+
+	bli_l3_thrinfo_skel_release( bli_thrinfo_sub_prenode( thread ) );
+	bli_l3_thrinfo_skel_release( bli_thrinfo_sub_node( thread ) );
+
+	// Return any packing buffer to the pba, just as bli_thrinfo_free()
+	// would. Every thread holds a copy of its chief's mem_t, so every thread
+	// must clear its copy.
+	mem_t* mem_p = bli_thrinfo_mem( thread );
+
+	if ( bli_mem_is_alloc( mem_p ) && bli_thrinfo_am_chief( thread ) )
+		bli_pba_release( bli_thrinfo_pba( thread ), mem_p );
+
+	bli_mem_clear( mem_p );
+}
+
+void bli_l3_thrinfo_finalize( void )
+{
+	bli_pthread_mutex_lock( &thrinfo_cache_mutex );
+
+	for ( dim_t i = 0; i < BLIS_L3_THRINFO_CACHE_SIZE; ++i )
+		bli_l3_thrinfo_skel_clear( &thrinfo_cache[ i ] );
+
+	bli_pthread_mutex_unlock( &thrinfo_cache_mutex );
+}
+
 // -----------------------------------------------------------------------------
 
 thrinfo_t* bli_l3_sup_thrinfo_create
@@ -86,6 +86,43 @@ void bli_l3_thrinfo_grow
        const cntl_t*     cntl
      );
 
+// A set of thrinfo_t trees, one per thread of a team, that may be reused by
+// later teams with the same configuration. See bli_l3_thrinfo.c.
+typedef struct l3_thrinfo_skel_s l3_thrinfo_skel_t;
+
+// Check out the skeleton for the control tree cntl and the threading
+// configuration in rntm, or return NULL if none is available.
+l3_thrinfo_skel_t* bli_l3_thrinfo_skel_checkout
+     (
+       const rntm_t* rntm,
+       const cntl_t* cntl
+     );
+
+void bli_l3_thrinfo_skel_checkin
+     (
+       l3_thrinfo_skel_t* skel
+     );
+
+// Return the root of thread id's tree within the skeleton, growing it if
+// this is the skeleton's first use.
+thrinfo_t* bli_l3_thrinfo_skel_root
+     (
+             l3_thrinfo_skel_t* skel,
+             dim_t              id,
+             thrcomm_t*         gl_comm,
+       const rntm_t*            rntm
+     );
+
+// Release the resources acquired by a thread during an operation (i.e.,
+// packing buffers) while leaving its tree intact.
+void bli_l3_thrinfo_skel_release
+     (
+       thrinfo_t* thread
+     );
+
+// Free all cached skeletons. Called from bli_finalize().
+void bli_l3_thrinfo_finalize( void );
+
 thrinfo_t* bli_l3_sup_thrinfo_create
      (
              dim_t      id,
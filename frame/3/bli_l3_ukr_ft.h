@@ -55,5 +55,39 @@ GENTDEF( gemmtrsm )
 GENTDEF( trsm )
 
 
+//
+// -- Level-3 post-op kernel function types ------------------------------------
+//
+
+#undef  GENTDEF
+#define GENTDEF( opname ) \
+\
+typedef void (*PASTECH(opname,_ker_ft)) \
+     ( \
+       PASTECH(opname,_params), \
+       BLIS_CNTX_PARAM  \
+     );
+
+GENTDEF( postops )
+
+
+//
+// -- Level-3 compact kernel function types ------------------------------------
+//
+
+#undef  GENTDEF
+#define GENTDEF( opname ) \
+\
+typedef void (*PASTECH(opname,_compact_ker_ft)) \
+     ( \
+       PASTECH(opname,_compact_params), \
+       BLIS_CNTX_PARAM  \
+     );
+
+GENTDEF( gemm )
+GENTDEF( trsm )
+GENTDEF( getrfnp )
+
+
 #endif
 
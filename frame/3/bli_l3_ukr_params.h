@@ -65,6 +65,42 @@
              void*  b, \
              void*  c, inc_t rs_c, inc_t cs_c
 
+#define postops_params \
+\
+             dim_t      m, \
+             dim_t      n, \
+             dim_t      off_m, \
+             dim_t      off_n, \
+       const postops_t* postops, \
+             void*      c, inc_t rs_c, inc_t cs_c
+
+#define gemm_compact_params \
+\
+             dim_t  m, \
+             dim_t  n, \
+             dim_t  k, \
+       const void*  alpha, \
+       const void*  a, inc_t rs_a, inc_t cs_a, \
+       const void*  b, inc_t rs_b, inc_t cs_b, \
+       const void*  beta, \
+             void*  c, inc_t rs_c, inc_t cs_c
+
+#define trsm_compact_params \
+\
+             uplo_t uploa, \
+             diag_t diaga, \
+             dim_t  m, \
+             dim_t  n, \
+       const void*  alpha, \
+       const void*  a, inc_t rs_a, inc_t cs_a, \
+             void*  b, inc_t rs_b, inc_t cs_b
+
+#define getrfnp_compact_params \
+\
+             dim_t  m, \
+             dim_t  n, \
+             void*  a, inc_t rs_a, inc_t cs_a
+
 
 #endif
 
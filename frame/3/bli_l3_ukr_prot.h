@@ -53,6 +53,38 @@ void PASTEMAC(ch,funcname) \
 #define GEMMTRSM_UKR_PROT( ctype, ch, fn )  L3TPROT( ctype, ch, fn, gemmtrsm );
 #define TRSM_UKR_PROT(     ctype, ch, fn )  L3TPROT( ctype, ch, fn, trsm );
 
+//
+// Define template prototypes for level-3 post-op kernels.
+//
+
+#undef  L3POPROT
+#define L3POPROT( ctype, ch, funcname, opname ) \
+\
+void PASTEMAC(ch,funcname) \
+     ( \
+       PASTECH(opname,_params), \
+       BLIS_CNTX_PARAM  \
+     );
+
+#define POSTOPS_KER_PROT(  ctype, ch, fn )  L3POPROT( ctype, ch, fn, postops );
+
+//
+// Define template prototypes for level-3 compact kernels.
+//
+
+#undef  L3CPROT
+#define L3CPROT( ctype, ch, funcname, opname ) \
+\
+void PASTEMAC(ch,funcname) \
+     ( \
+       PASTECH(opname,_compact_params), \
+       BLIS_CNTX_PARAM  \
+     );
+
+#define GEMM_COMPACT_KER_PROT(    ctype, ch, fn )  L3CPROT( ctype, ch, fn, gemm );
+#define TRSM_COMPACT_KER_PROT(    ctype, ch, fn )  L3CPROT( ctype, ch, fn, trsm );
+#define GETRFNP_COMPACT_KER_PROT( ctype, ch, fn )  L3CPROT( ctype, ch, fn, getrfnp );
+
 
 #endif
 
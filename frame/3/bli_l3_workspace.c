@@ -0,0 +1,402 @@
+/*
+
+   BLIS
+   An object-based framework for developing high-performance BLAS-like
+   libraries.
+
+   Copyright (C) 2014, The University of Texas at Austin
+   Copyright (C) 2018, Advanced Micro Devices, Inc.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are
+   met:
+    - Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    - Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    - Neither the name(s) of the copyright holder(s) nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "blis.h"
+
+struct l3_wspace_s
+{
+	// A packing block allocator whose pools hold the blocks carved from
+	// the workspace. Since these pools cannot grow, any request they cannot
+	// satisfy is forwarded to the global pba (see bli_pba_acquire_m()).
+	pba_t   pba;
+
+	// One small block pool per thread, from which the thread's control tree
+	// and thrinfo_t tree (and its communicators) are built.
+	dim_t   nt;
+	pool_t* sba_pools;
+};
+
+// Carve a region of size bytes, aligned to align bytes, from the buffer at
+// base, the first *off bytes of which are already taken. If base is NULL,
+// only tally the space. Either way, the worst-case padding is counted so
+// that the tally does not depend on the address of the buffer.
+static void* bli_l3_workspace_carve
+     (
+       char*  base,
+       siz_t* off,
+       siz_t  size,
+       siz_t  align
+     )
+{
+	void* p = NULL;
+
+	if ( base != NULL )
+	{
+		uintptr_t addr = ( uintptr_t )( base + *off );
+
+		p = ( void* )( ( addr + align - 1 ) / align * align );
+	}
+
+	*off += size + align - 1;
+
+	return p;
+}
+
+// Carve num_blocks blocks of block_size bytes, along with the pblk_t array
+// through which a pool refers to them, and initialize pool to hold them
+// (unless base, and thus pool, is NULL). The pool has no means of allocating
+// or freeing blocks, which bli_pba_acquire_m() and bli_sba_acquire() take
+// into account.
+static void bli_l3_workspace_carve_pool
+     (
+       char*   base,
+       siz_t*  off,
+       siz_t   num_blocks,
+       siz_t   block_size,
+       siz_t   align_size,
+       siz_t   offset_size,
+       pool_t* pool
+     )
+{
+	const siz_t block_ptrs_len = bli_max( num_blocks, 1 );
+
+	pblk_t* block_ptrs = bli_l3_workspace_carve( base, off,
+	                                             block_ptrs_len * sizeof( pblk_t ),
+	                                             sizeof( void* ) );
+
+	for ( siz_t i = 0; i < num_blocks; ++i )
+	{
+		char* buf = bli_l3_workspace_carve( base, off,
+		                                    block_size + offset_size,
+		                                    align_size );
+
+		if ( base == NULL ) continue;
+
+		bli_pblk_set_buf( buf + offset_size, &block_ptrs[ i ] );
+		bli_pblk_set_block_size( block_size, &block_ptrs[ i ] );
+	}
+
+	if ( pool == NULL ) return;
+
+	memset( pool, 0, sizeof( pool_t ) );
+
+	bli_pool_set_block_ptrs( block_ptrs, pool );
+	bli_pool_set_block_ptrs_len( block_ptrs_len, pool );
+	bli_pool_set_top_index( 0, pool );
+	bli_pool_set_num_blocks( num_blocks, pool );
+	bli_pool_set_block_size( block_size, pool );
+	bli_pool_set_align_size( align_size, pool );
+	bli_pool_set_offset_size( offset_size, pool );
+	bli_pool_set_malloc_fp( NULL, pool );
+	bli_pool_set_free_fp( NULL, pool );
+}
+
+// Lay out a workspace for nt threads with num_a blocks of A of size_a bytes
+// and num_b panels of B of size_b bytes in the buffer at base (or, if base
+// is NULL, only tally the space), and return its size.
+static siz_t bli_l3_workspace_layout
+     (
+       char*         base,
+       dim_t         nt,
+       siz_t         size_a,
+       dim_t         num_a,
+       siz_t         size_b,
+       dim_t         num_b,
+       l3_wspace_t** wspace
+     )
+{
+	siz_t off = 0;
+
+	l3_wspace_t* ws = bli_l3_workspace_carve( base, &off,
+	                                          sizeof( l3_wspace_t ),
+	                                          BLIS_CACHE_LINE_SIZE );
+	pool_t* sba_pools = bli_l3_workspace_carve( base, &off,
+	                                            nt * sizeof( pool_t ),
+	                                            BLIS_CACHE_LINE_SIZE );
+
+	if ( base != NULL )
+	{
+		memset( ws, 0, sizeof( l3_wspace_t ) );
+
+		ws->nt        = nt;
+		ws->sba_pools = sba_pools;
+	}
+
+	// Align the small blocks as bli_apool_array_elem() does.
+	const siz_t sba_size = bli_apool_elem_block_size();
+
+	for ( dim_t t = 0; t < nt; ++t )
+		bli_l3_workspace_carve_pool( base, &off,
+		                             BLIS_WSPACE_SBA_BLOCKS, sba_size, 16, 0,
+		                             base != NULL ? &sba_pools[ t ] : NULL );
+
+	pba_t* pba = ( base != NULL ? &ws->pba : NULL );
+
+	bli_l3_workspace_carve_pool( base, &off,
+	                             num_a, size_a,
+	                             BLIS_POOL_ADDR_ALIGN_SIZE_A,
+	                             BLIS_POOL_ADDR_OFFSET_SIZE_A,
+	                             pba != NULL ? bli_pba_pool( 0, pba ) : NULL );
+	bli_l3_workspace_carve_pool( base, &off,
+	                             num_b, size_b,
+	                             BLIS_POOL_ADDR_ALIGN_SIZE_B,
+	                             BLIS_POOL_ADDR_OFFSET_SIZE_B,
+	                             pba != NULL ? bli_pba_pool( 1, pba ) : NULL );
+	bli_l3_workspace_carve_pool( base, &off,
+	                             0, 0,
+	                             BLIS_POOL_ADDR_ALIGN_SIZE_C,
+	                             BLIS_POOL_ADDR_OFFSET_SIZE_C,
+	                             pba != NULL ? bli_pba_pool( 2, pba ) : NULL );
+
+	if ( wspace != NULL ) *wspace = ws;
+
+	return off;
+}
+
+// Return the size of a block of A (bszid equal to BLIS_MC) or a panel of B
+// (BLIS_NC) packed from a matrix whose dimensions are mn and k. As in
+// bli_pba_compute_pool_block_sizes_dt(), leave room for the register
+// blocksizes to be swapped and for kc to be nudged to a multiple of them
+// for triangular operations.
+static siz_t bli_l3_workspace_block_size
+     (
+             num_t   dt,
+             bszid_t bszid,
+             dim_t   mn,
+             dim_t   k,
+       const cntx_t* cntx
+     )
+{
+	const dim_t mr      = bli_cntx_get_blksz_def_dt( dt, BLIS_MR, cntx );
+	const dim_t nr      = bli_cntx_get_blksz_def_dt( dt, BLIS_NR, cntx );
+	const dim_t packmr  = bli_cntx_get_blksz_max_dt( dt, BLIS_MR, cntx );
+	const dim_t packnr  = bli_cntx_get_blksz_max_dt( dt, BLIS_NR, cntx );
+	const dim_t mn_max  = bli_cntx_get_blksz_max_dt( dt, bszid, cntx );
+	const dim_t kc_max  = bli_cntx_get_blksz_max_dt( dt, BLIS_KC, cntx );
+
+	const dim_t mn_c    = bli_min( mn, mn_max );
+	const dim_t mn_p    = bli_max( ( ( mn_c + mr - 1 ) / mr ) * packmr,
+	                               ( ( mn_c + nr - 1 ) / nr ) * packnr );
+	const dim_t k_p     = bli_min( k, kc_max ) + bli_max( mr, nr );
+
+	return ( siz_t )mn_p * k_p * bli_dt_size( dt );
+}
+
+// Return the sizes of the blocks of A and panels of B packed for a problem
+// whose dimensions are m, n, and k.
+static void bli_l3_workspace_pack_sizes
+     (
+             num_t   dt_a,
+             num_t   dt_b,
+             dim_t   m,
+             dim_t   n,
+             dim_t   k,
+       const cntx_t* cntx,
+             siz_t*  size_a,
+             siz_t*  size_b
+     )
+{
+	// An operation may swap the roles of A and B (and thus of m and n) by
+	// inducing a transposition, so size both for the larger of m and n.
+	const dim_t mn = bli_max( m, n );
+
+	*size_a = bli_l3_workspace_block_size( dt_a, BLIS_MC, mn, k, cntx );
+	*size_b = bli_l3_workspace_block_size( dt_b, BLIS_NC, mn, k, cntx );
+}
+
+// Return the number of blocks of A and panels of B packed at once by an
+// operation of the given family with the ways of parallelism in rntm.
+static void bli_l3_workspace_num_blocks
+     (
+             opid_t  family,
+       const rntm_t* rntm,
+             dim_t*  num_a,
+             dim_t*  num_b
+     )
+{
+	// One block of A is packed per thread group in the ic loop, and one
+	// panel of B per thread group in the jc (and pc) loop.
+	*num_b = bli_rntm_jc_ways( rntm ) * bli_rntm_pc_ways( rntm );
+	*num_a = bli_rntm_ic_ways( rntm ) * *num_b;
+
+	// The control tree of trsm packs A separately for the gemm and trsm
+	// subproblems.
+	if ( family == BLIS_TRSM ) *num_a *= 2;
+}
+
+// -----------------------------------------------------------------------------
+
+siz_t bli_l3_workspace_size
+     (
+       opid_t op,
+       num_t  dt,
+       dim_t  m,
+       dim_t  n,
+       dim_t  k,
+       dim_t  nt
+     )
+{
+	bli_init_once();
+
+	// Operations with a structured matrix A may be induced to compute from
+	// either side, in which case k may be either m or n.
+	if ( op == BLIS_HEMM || op == BLIS_SYMM || op == BLIS_TRMM ||
+	     op == BLIS_TRMM3 || op == BLIS_TRSM )
+		k = bli_max( k, bli_max( m, n ) );
+
+	const cntx_t* cntx = bli_gks_query_ind_cntx( bli_l3_ind_oper_find_avail( op, dt ) );
+
+	siz_t size_a, size_b;
+	bli_l3_workspace_pack_sizes( dt, dt, m, n, k, cntx, &size_a, &size_b );
+
+	// Only the factorization of nt matters here, for which any threading
+	// implementation other than BLIS_SINGLE will do.
+	rntm_t rntm;
+	bli_rntm_init_from_global( &rntm );
+	if ( bli_rntm_thread_impl( &rntm ) == BLIS_SINGLE )
+		bli_rntm_set_thread_impl( BLIS_POSIX, &rntm );
+	bli_rntm_set_num_threads( nt, &rntm );
+
+	// The ways of parallelism, and thus the number of blocks of A and panels
+	// of B, may depend on the side and on whether the operation transposes
+	// the problem, so take the largest workspace needed by any of these.
+	siz_t size = 0;
+
+	for ( dim_t s = 0; s < 2; ++s )
+	for ( dim_t t = 0; t < 2; ++t )
+	{
+		const side_t side = ( s == 0 ? BLIS_LEFT : BLIS_RIGHT );
+		const dim_t  m_t  = ( t == 0 ? m : n );
+		const dim_t  n_t  = ( t == 0 ? n : m );
+
+		rntm_t rntm_l = rntm;
+		bli_rntm_factorize_model( dt, m_t, n_t, k, cntx, &rntm_l );
+		bli_rntm_set_ways_for_op( op, side, m_t, n_t, k, &rntm_l );
+
+		dim_t num_b, num_a;
+		bli_l3_workspace_num_blocks( op, &rntm_l, &num_a, &num_b );
+
+		size = bli_max( size,
+		                bli_l3_workspace_layout( NULL,
+		                                         bli_rntm_num_threads( &rntm_l ),
+		                                         size_a, num_a,
+		                                         size_b, num_b, NULL ) );
+	}
+
+	return size;
+}
+
+l3_wspace_t* bli_l3_workspace_init
+     (
+             opid_t  family,
+       const obj_t*  a,
+       const obj_t*  b,
+       const obj_t*  c,
+       const cntx_t* cntx,
+       const rntm_t* rntm,
+             dim_t   nt
+     )
+{
+	char* buf  = bli_rntm_workspace_buf( rntm );
+	siz_t size = bli_rntm_workspace_size( rntm );
+
+	siz_t size_a, size_b;
+	bli_l3_workspace_pack_sizes( bli_obj_target_dt( a ),
+	                             bli_obj_target_dt( b ),
+	                             bli_obj_length( c ),
+	                             bli_obj_width( c ),
+	                             bli_obj_width( a ),
+	                             cntx, &size_a, &size_b );
+
+	dim_t num_b, num_a;
+	bli_l3_workspace_num_blocks( family, rntm, &num_a, &num_b );
+
+	// If the workspace is too small, carve fewer of the packing blocks
+	// (starting with the larger ones), leaving the rest to the global pba.
+	// The small blocks, however, cannot be left to anyone else.
+	while ( size < bli_l3_workspace_layout( NULL, nt, size_a, num_a,
+	                                        size_b, num_b, NULL ) )
+	{
+		if ( num_a == 0 && num_b == 0 ) return NULL;
+
+		if ( num_b > 0 && ( size_a <= size_b || num_a == 0 ) ) num_b -= 1;
+		else                                                   num_a -= 1;
+	}
+
+	l3_wspace_t* wspace;
+	bli_l3_workspace_layout( buf, nt, size_a, num_a, size_b, num_b, &wspace );
+
+	pba_t* pba      = &wspace->pba;
+	pba_t* pba_glob = bli_pba_query();
+
+	bli_pba_set_num_nodes( 1, pba );
+	bli_pba_set_hugepages( BLIS_HUGEPAGES_NONE, pba );
+	bli_pba_set_cache_slots( 0, pba );
+	bli_pba_set_in_wspace( TRUE, pba );
+	bli_pba_set_align_size( bli_pba_align_size( pba_glob ), pba );
+	bli_pba_set_malloc_fp( bli_pba_malloc_fp( pba_glob ), pba );
+	bli_pba_set_free_fp( bli_pba_free_fp( pba_glob ), pba );
+	bli_pthread_mutex_init( &pba->mutex, NULL );
+
+	return wspace;
+}
+
+void bli_l3_workspace_finalize
+     (
+       l3_wspace_t* wspace
+     )
+{
+	if ( wspace == NULL ) return;
+
+	bli_pthread_mutex_destroy( &wspace->pba.mutex );
+}
+
+pba_t* bli_l3_workspace_pba
+     (
+       l3_wspace_t* wspace
+     )
+{
+	return &wspace->pba;
+}
+
+pool_t* bli_l3_workspace_sba_pool
+     (
+       dim_t        tid,
+       l3_wspace_t* wspace
+     )
+{
+	return &wspace->sba_pools[ tid ];
+}
+
@@ -0,0 +1,89 @@
+/*
+
+   BLIS
+   An object-based framework for developing high-performance BLAS-like
+   libraries.
+
+   Copyright (C) 2014, The University of Texas at Austin
+   Copyright (C) 2018, Advanced Micro Devices, Inc.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are
+   met:
+    - Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    - Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    - Neither the name(s) of the copyright holder(s) nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef BLIS_L3_WORKSPACE_H
+#define BLIS_L3_WORKSPACE_H
+
+// A caller-supplied workspace from which a level-3 operation carves its
+// packing buffers and the nodes of its control and thrinfo_t trees, so
+// that it need not allocate them. See bli_rntm_set_workspace().
+typedef struct l3_wspace_s l3_wspace_t;
+
+// Return the size (in bytes) of a workspace large enough that operation
+// op, computing in datatype dt with nt threads on an m x n matrix C with
+// inner dimension k, carves all of its packing buffers from it. (For
+// hemm, symm, trmm, trmm3, and trsm, k is the order of A.)
+BLIS_EXPORT_BLIS siz_t bli_l3_workspace_size
+     (
+       opid_t op,
+       num_t  dt,
+       dim_t  m,
+       dim_t  n,
+       dim_t  k,
+       dim_t  nt
+     );
+
+// Lay out the workspace held by rntm for an operation of the given family
+// on A, B, and C with nt threads. NULL is returned if the workspace is too
+// small to hold the trees of every thread.
+l3_wspace_t* bli_l3_workspace_init
+     (
+             opid_t  family,
+       const obj_t*  a,
+       const obj_t*  b,
+       const obj_t*  c,
+       const cntx_t* cntx,
+       const rntm_t* rntm,
+             dim_t   nt
+     );
+
+void bli_l3_workspace_finalize
+     (
+       l3_wspace_t* wspace
+     );
+
+pba_t* bli_l3_workspace_pba
+     (
+       l3_wspace_t* wspace
+     );
+
+pool_t* bli_l3_workspace_sba_pool
+     (
+       dim_t        tid,
+       l3_wspace_t* wspace
+     );
+
+#endif
+
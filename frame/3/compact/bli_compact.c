@@ -0,0 +1,668 @@
+/*
+
+   BLIS
+   An object-based framework for developing high-performance BLAS-like
+   libraries.
+
+   Copyright (C) 2014, The University of Texas at Austin
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are
+   met:
+    - Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    - Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    - Neither the name(s) of the copyright holder(s) nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "blis.h"
+
+// Each operation is applied to a range of groups of a compact batch by a
+// function of this type, so that the groups may be divided among threads.
+typedef void (*compact_groups_ft)( dim_t g_beg, dim_t g_end, const void* params );
+
+// The operands and parameters of an operation on a compact batch. The
+// strides of the compact operands (a, b, c) are in elements, and gs_? is the
+// stride from one group to the next. For packing and unpacking, mats holds
+// the nb standard matrices, with strides rs_s and cs_s.
+typedef struct
+{
+	      siz_t              dt_size;
+	      dim_t              v;
+	      dim_t              m;
+	      dim_t              n;
+	      dim_t              k;
+	      uplo_t             uploa;
+	      diag_t             diaga;
+
+	const void*              alpha;
+	const void*              beta;
+
+	const void*              a;
+	      inc_t              rs_a;
+	      inc_t              cs_a;
+	      inc_t              gs_a;
+	const void*              b;
+	      inc_t              rs_b;
+	      inc_t              cs_b;
+	      inc_t              gs_b;
+	      void*              c;
+	      inc_t              rs_c;
+	      inc_t              cs_c;
+	      inc_t              gs_c;
+
+	const void* const*       mats;
+	      inc_t              rs_s;
+	      inc_t              cs_s;
+	      dim_t              nb;
+
+	      void_fp            ker;
+	const cntx_t*            cntx;
+} compact_params_t;
+
+typedef struct
+{
+	      dim_t             n_groups;
+	      compact_groups_ft func;
+	const void*             params;
+} compact_thread_params_t;
+
+// -----------------------------------------------------------------------------
+
+dim_t bli_compact_width
+     (
+             num_t   dt,
+       const cntx_t* cntx
+     )
+{
+	bli_init_once();
+
+	if ( cntx == NULL ) cntx = bli_gks_query_cntx();
+
+	return bli_cntx_get_blksz_def_dt( dt, BLIS_CV, cntx );
+}
+
+siz_t bli_compact_size
+     (
+             num_t   dt,
+             dim_t   m,
+             dim_t   n,
+             dim_t   nb,
+       const cntx_t* cntx
+     )
+{
+	const dim_t v        = bli_compact_width( dt, cntx );
+	const dim_t n_groups = ( nb + v - 1 ) / v;
+
+	return ( siz_t )( n_groups * v * m * n ) * bli_dt_size( dt );
+}
+
+// -----------------------------------------------------------------------------
+
+static void bli_compact_thread_entry
+     (
+             thrcomm_t* gl_comm,
+             dim_t      tid,
+       const void*      data_void
+     )
+{
+	const compact_thread_params_t* data = data_void;
+
+	const dim_t nt    = bli_thrcomm_num_threads( gl_comm );
+	const dim_t g_beg = ( data->n_groups * ( tid     ) ) / nt;
+	const dim_t g_end = ( data->n_groups * ( tid + 1 ) ) / nt;
+
+	data->func( g_beg, g_end, data->params );
+}
+
+// Apply func to the n_groups groups of a compact batch, dividing them evenly
+// among the threads requested by rntm. The groups are independent, so the
+// threads never need to synchronize.
+static void bli_compact_launch
+     (
+             dim_t             n_groups,
+             compact_groups_ft func,
+       const void*             params,
+       const rntm_t*           rntm
+     )
+{
+	rntm_t rntm_l;
+	if ( rntm == NULL ) { bli_rntm_init_from_global( &rntm_l ); }
+	else                { rntm_l = *rntm;                       }
+
+	dim_t nt = bli_rntm_num_threads( &rntm_l );
+	if ( nt < 1 ) nt = bli_rntm_calc_num_threads( &rntm_l );
+	if ( bli_rntm_thread_impl( &rntm_l ) == BLIS_SINGLE ||
+	     bli_thread_in_region() ) nt = 1;
+
+	nt = bli_min( nt, n_groups );
+
+	if ( nt <= 1 )
+	{
+		func( 0, n_groups, params );
+		return;
+	}
+
+	bli_rntm_set_num_threads( nt, &rntm_l );
+
+	const compact_thread_params_t data =
+	{
+		.n_groups = n_groups,
+		.func     = func,
+		.params   = params,
+	};
+
+	bli_thread_launch_rntm( &rntm_l, bli_compact_thread_entry, &data );
+}
+
+// Set the strides of a matrix that is stored with m rows in the compact
+// format, transposing it if trans calls for it.
+static void bli_compact_set_strides
+     (
+       trans_t trans,
+       dim_t   m,
+       dim_t   v,
+       inc_t*  rs,
+       inc_t*  cs
+     )
+{
+	*rs = v;
+	*cs = m * v;
+
+	if ( bli_does_trans( trans ) ) bli_swap_incs( rs, cs );
+}
+
+// -----------------------------------------------------------------------------
+
+#undef  GENTFUNCRO
+#define GENTFUNCRO( ctype, ch, opname ) \
+\
+static void PASTEMAC2(ch,opname,_groups) \
+     ( \
+             dim_t g_beg, \
+             dim_t g_end, \
+       const void* params0 \
+     ) \
+{ \
+	const compact_params_t*    params = params0; \
+	const dim_t                v      = params->v; \
+	const dim_t                m      = params->m; \
+	const dim_t                n      = params->n; \
+	const dim_t                nb     = params->nb; \
+	const inc_t                rs_s   = params->rs_s; \
+	const inc_t                cs_s   = params->cs_s; \
+	const ctype* const*        mats   = ( const ctype* const* )params->mats; \
+	      ctype*               ap     = params->c; \
+\
+	for ( dim_t g = g_beg; g < g_end; ++g ) \
+	for ( dim_t l = 0; l < v; ++l ) \
+	{ \
+		/* The lanes of the last group that lie past the end of the batch
+		   are filled with copies of the last member, so that operating on
+		   them is harmless (for example, it does not divide by zero). */ \
+		const ctype* restrict a_l  = mats[ bli_min( g*v + l, nb - 1 ) ]; \
+		      ctype* restrict ap_l = ap + g*params->gs_c + l; \
+\
+		for ( dim_t j = 0; j < n; ++j ) \
+		for ( dim_t i = 0; i < m; ++i ) \
+			ap_l[ ( i + j*m )*v ] = a_l[ i*rs_s + j*cs_s ]; \
+	} \
+} \
+\
+void PASTEMAC2(ch,opname,BLIS_TAPI_EX_SUF) \
+     ( \
+             dim_t         m, \
+             dim_t         n, \
+       const ctype* const* a, inc_t rs_a, inc_t cs_a, \
+             dim_t         nb, \
+             ctype*        ap, \
+       const cntx_t*       cntx, \
+       const rntm_t*       rntm  \
+     ) \
+{ \
+	bli_init_once(); \
+\
+	if ( bli_zero_dim3( m, n, nb ) ) return; \
+\
+	const dim_t v = bli_compact_width( PASTEMAC(ch,type), cntx ); \
+\
+	compact_params_t params; \
+\
+	params.v    = v; \
+	params.m    = m; \
+	params.n    = n; \
+	params.c    = ap; \
+	params.gs_c = m * n * v; \
+	params.mats = ( const void* const* )a; \
+	params.rs_s = rs_a; \
+	params.cs_s = cs_a; \
+	params.nb   = nb; \
+\
+	bli_compact_launch( ( nb + v - 1 ) / v, PASTEMAC2(ch,opname,_groups), &params, rntm ); \
+} \
+\
+void PASTEMAC(ch,opname) \
+     ( \
+             dim_t         m, \
+             dim_t         n, \
+       const ctype* const* a, inc_t rs_a, inc_t cs_a, \
+             dim_t         nb, \
+             ctype*        ap  \
+     ) \
+{ \
+	PASTEMAC2(ch,opname,BLIS_TAPI_EX_SUF)( m, n, a, rs_a, cs_a, nb, ap, NULL, NULL ); \
+}
+
+INSERT_GENTFUNCRO_BASIC( gepack_compact )
+
+
+#undef  GENTFUNCRO
+#define GENTFUNCRO( ctype, ch, opname ) \
+\
+static void PASTEMAC2(ch,opname,_groups) \
+     ( \
+             dim_t g_beg, \
+             dim_t g_end, \
+       const void* params0 \
+     ) \
+{ \
+	const compact_params_t*    params = params0; \
+	const dim_t                v      = params->v; \
+	const dim_t                m      = params->m; \
+	const dim_t                n      = params->n; \
+	const dim_t                nb     = params->nb; \
+	const inc_t                rs_s   = params->rs_s; \
+	const inc_t                cs_s   = params->cs_s; \
+	const ctype*               ap     = params->a; \
+\
+	for ( dim_t g = g_beg; g < g_end; ++g ) \
+	for ( dim_t l = 0; l < v && g*v + l < nb; ++l ) \
+	{ \
+		const ctype* restrict ap_l = ap + g*params->gs_a + l; \
+		      ctype* restrict a_l  = ( ctype* )params->mats[ g*v + l ]; \
+\
+		for ( dim_t j = 0; j < n; ++j ) \
+		for ( dim_t i = 0; i < m; ++i ) \
+			a_l[ i*rs_s + j*cs_s ] = ap_l[ ( i + j*m )*v ]; \
+	} \
+} \
+\
+void PASTEMAC2(ch,opname,BLIS_TAPI_EX_SUF) \
+     ( \
+             dim_t         m, \
+             dim_t         n, \
+       const ctype*        ap, \
+             dim_t         nb, \
+             ctype* const* a, inc_t rs_a, inc_t cs_a, \
+       const cntx_t*       cntx, \
+       const rntm_t*       rntm  \
+     ) \
+{ \
+	bli_init_once(); \
+\
+	if ( bli_zero_dim3( m, n, nb ) ) return; \
+\
+	const dim_t v = bli_compact_width( PASTEMAC(ch,type), cntx ); \
+\
+	compact_params_t params; \
+\
+	params.v    = v; \
+	params.m    = m; \
+	params.n    = n; \
+	params.a    = ap; \
+	params.gs_a = m * n * v; \
+	params.mats = ( const void* const* )a; \
+	params.rs_s = rs_a; \
+	params.cs_s = cs_a; \
+	params.nb   = nb; \
+\
+	bli_compact_launch( ( nb + v - 1 ) / v, PASTEMAC2(ch,opname,_groups), &params, rntm ); \
+} \
+\
+void PASTEMAC(ch,opname) \
+     ( \
+             dim_t         m, \
+             dim_t         n, \
+       const ctype*        ap, \
+             dim_t         nb, \
+             ctype* const* a, inc_t rs_a, inc_t cs_a  \
+     ) \
+{ \
+	PASTEMAC2(ch,opname,BLIS_TAPI_EX_SUF)( m, n, ap, nb, a, rs_a, cs_a, NULL, NULL ); \
+}
+
+INSERT_GENTFUNCRO_BASIC( geunpack_compact )
+
+// -----------------------------------------------------------------------------
+
+static void bli_gemm_compact_groups
+     (
+             dim_t g_beg,
+             dim_t g_end,
+       const void* params0
+     )
+{
+	const compact_params_t*   params  = params0;
+	const siz_t               dt_size = params->dt_size;
+	      gemm_compact_ker_ft ker     = ( gemm_compact_ker_ft )params->ker;
+
+	for ( dim_t g = g_beg; g < g_end; ++g )
+	{
+		ker
+		(
+		  params->m,
+		  params->n,
+		  params->k,
+		  params->alpha,
+		  ( const char* )params->a + g*params->gs_a*dt_size, params->rs_a, params->cs_a,
+		  ( const char* )params->b + g*params->gs_b*dt_size, params->rs_b, params->cs_b,
+		  params->beta,
+		  (       char* )params->c + g*params->gs_c*dt_size, params->rs_c, params->cs_c,
+		  params->cntx
+		);
+	}
+}
+
+#undef  GENTFUNCRO
+#define GENTFUNCRO( ctype, ch, opname ) \
+\
+void PASTEMAC2(ch,opname,BLIS_TAPI_EX_SUF) \
+     ( \
+             trans_t transa, \
+             trans_t transb, \
+             dim_t   m, \
+             dim_t   n, \
+             dim_t   k, \
+       const ctype*  alpha, \
+       const ctype*  ap, \
+       const ctype*  bp, \
+       const ctype*  beta, \
+             ctype*  cp, \
+             dim_t   nb, \
+       const cntx_t* cntx, \
+       const rntm_t* rntm  \
+     ) \
+{ \
+	bli_init_once(); \
+\
+	if ( bli_zero_dim3( m, n, nb ) ) return; \
+\
+	if ( cntx == NULL ) cntx = bli_gks_query_cntx(); \
+\
+	const num_t dt = PASTEMAC(ch,type); \
+	const dim_t v  = bli_compact_width( dt, cntx ); \
+\
+	dim_t m_a, n_a; \
+	dim_t m_b, n_b; \
+\
+	bli_set_dims_with_trans( transa, m, k, &m_a, &n_a ); \
+	bli_set_dims_with_trans( transb, k, n, &m_b, &n_b ); \
+\
+	compact_params_t params; \
+\
+	params.dt_size = sizeof( ctype ); \
+	params.m       = m; \
+	params.n       = n; \
+	params.alpha   = alpha; \
+	params.beta    = beta; \
+\
+	/* If alpha is zero, C is only scaled by beta. */ \
+	params.k       = PASTEMAC(ch,eq0)( *alpha ) ? 0 : k; \
+\
+	params.a       = ap; \
+	params.gs_a    = m_a * n_a * v; \
+	params.b       = bp; \
+	params.gs_b    = m_b * n_b * v; \
+	params.c       = cp; \
+	params.gs_c    = m * n * v; \
+\
+	bli_compact_set_strides( transa, m_a, v, &params.rs_a, &params.cs_a ); \
+	bli_compact_set_strides( transb, m_b, v, &params.rs_b, &params.cs_b ); \
+	bli_compact_set_strides( BLIS_NO_TRANSPOSE, m, v, &params.rs_c, &params.cs_c ); \
+\
+	params.ker     = bli_cntx_get_ukr_dt( dt, BLIS_GEMM_COMPACT_KER, cntx ); \
+	params.cntx    = cntx; \
+\
+	bli_compact_launch( ( nb + v - 1 ) / v, bli_gemm_compact_groups, &params, rntm ); \
+} \
+\
+void PASTEMAC(ch,opname) \
+     ( \
+             trans_t transa, \
+             trans_t transb, \
+             dim_t   m, \
+             dim_t   n, \
+             dim_t   k, \
+       const ctype*  alpha, \
+       const ctype*  ap, \
+       const ctype*  bp, \
+       const ctype*  beta, \
+             ctype*  cp, \
+             dim_t   nb  \
+     ) \
+{ \
+	PASTEMAC2(ch,opname,BLIS_TAPI_EX_SUF) \
+	( \
+	  transa, transb, m, n, k, alpha, ap, bp, beta, cp, nb, NULL, NULL \
+	); \
+}
+
+INSERT_GENTFUNCRO_BASIC( gemm_compact )
+
+// -----------------------------------------------------------------------------
+
+static void bli_trsm_compact_groups
+     (
+             dim_t g_beg,
+             dim_t g_end,
+       const void* params0
+     )
+{
+	const compact_params_t*   params  = params0;
+	const siz_t               dt_size = params->dt_size;
+	      trsm_compact_ker_ft ker     = ( trsm_compact_ker_ft )params->ker;
+
+	for ( dim_t g = g_beg; g < g_end; ++g )
+	{
+		ker
+		(
+		  params->uploa,
+		  params->diaga,
+		  params->m,
+		  params->n,
+		  params->alpha,
+		  ( const char* )params->a + g*params->gs_a*dt_size, params->rs_a, params->cs_a,
+		  (       char* )params->c + g*params->gs_c*dt_size, params->rs_c, params->cs_c,
+		  params->cntx
+		);
+	}
+}
+
+#undef  GENTFUNCRO
+#define GENTFUNCRO( ctype, ch, opname ) \
+\
+void PASTEMAC2(ch,opname,BLIS_TAPI_EX_SUF) \
+     ( \
+             side_t  side, \
+             uplo_t  uploa, \
+             trans_t transa, \
+             diag_t  diaga, \
+             dim_t   m, \
+             dim_t   n, \
+       const ctype*  alpha, \
+       const ctype*  ap, \
+             ctype*  bp, \
+             dim_t   nb, \
+       const cntx_t* cntx, \
+       const rntm_t* rntm  \
+     ) \
+{ \
+	bli_init_once(); \
+\
+	if ( bli_zero_dim3( m, n, nb ) ) return; \
+\
+	if ( cntx == NULL ) cntx = bli_gks_query_cntx(); \
+\
+	const num_t dt = PASTEMAC(ch,type); \
+	const dim_t v  = bli_compact_width( dt, cntx ); \
+\
+	dim_t mn_a; \
+\
+	bli_set_dim_with_side( side, m, n, &mn_a ); \
+\
+	compact_params_t params; \
+\
+	params.dt_size = sizeof( ctype ); \
+	params.m       = m; \
+	params.n       = n; \
+	params.uploa   = uploa; \
+	params.diaga   = diaga; \
+	params.alpha   = alpha; \
+\
+	params.a       = ap; \
+	params.gs_a    = mn_a * mn_a * v; \
+	params.c       = bp; \
+	params.gs_c    = m * n * v; \
+\
+	bli_compact_set_strides( BLIS_NO_TRANSPOSE, mn_a, v, &params.rs_a, &params.cs_a ); \
+	bli_compact_set_strides( BLIS_NO_TRANSPOSE, m,    v, &params.rs_c, &params.cs_c ); \
+\
+	/* The kernel solves from the left. X * op(A) = alpha * B is solved as
+	   op(A)^T * X^T = alpha * B^T, and transposing A also swaps the
+	   triangle in which it is stored. */ \
+	bool trans = bli_does_trans( transa ); \
+\
+	if ( bli_is_right( side ) ) \
+	{ \
+		trans = !trans; \
+		bli_swap_dims( &params.m, &params.n ); \
+		bli_swap_incs( &params.rs_c, &params.cs_c ); \
+	} \
+\
+	if ( trans ) \
+	{ \
+		bli_swap_incs( &params.rs_a, &params.cs_a ); \
+		bli_toggle_uplo( &params.uploa ); \
+	} \
+\
+	params.ker     = bli_cntx_get_ukr_dt( dt, BLIS_TRSM_COMPACT_KER, cntx ); \
+	params.cntx    = cntx; \
+\
+	bli_compact_launch( ( nb + v - 1 ) / v, bli_trsm_compact_groups, &params, rntm ); \
+} \
+\
+void PASTEMAC(ch,opname) \
+     ( \
+             side_t  side, \
+             uplo_t  uploa, \
+             trans_t transa, \
+             diag_t  diaga, \
+             dim_t   m, \
+             dim_t   n, \
+       const ctype*  alpha, \
+       const ctype*  ap, \
+             ctype*  bp, \
+             dim_t   nb  \
+     ) \
+{ \
+	PASTEMAC2(ch,opname,BLIS_TAPI_EX_SUF) \
+	( \
+	  side, uploa, transa, diaga, m, n, alpha, ap, bp, nb, NULL, NULL \
+	); \
+}
+
+INSERT_GENTFUNCRO_BASIC( trsm_compact )
+
+// -----------------------------------------------------------------------------
+
+static void bli_getrfnp_compact_groups
+     (
+             dim_t g_beg,
+             dim_t g_end,
+       const void* params0
+     )
+{
+	const compact_params_t*      params  = params0;
+	const siz_t                  dt_size = params->dt_size;
+	      getrfnp_compact_ker_ft ker     = ( getrfnp_compact_ker_ft )params->ker;
+
+	for ( dim_t g = g_beg; g < g_end; ++g )
+	{
+		ker
+		(
+		  params->m,
+		  params->n,
+		  ( char* )params->c + g*params->gs_c*dt_size, params->rs_c, params->cs_c,
+		  params->cntx
+		);
+	}
+}
+
+#undef  GENTFUNCRO
+#define GENTFUNCRO( ctype, ch, opname ) \
+\
+void PASTEMAC2(ch,opname,BLIS_TAPI_EX_SUF) \
+     ( \
+             dim_t   m, \
+             dim_t   n, \
+             ctype*  ap, \
+             dim_t   nb, \
+       const cntx_t* cntx, \
+       const rntm_t* rntm  \
+     ) \
+{ \
+	bli_init_once(); \
+\
+	if ( bli_zero_dim3( m, n, nb ) ) return; \
+\
+	if ( cntx == NULL ) cntx = bli_gks_query_cntx(); \
+\
+	const num_t dt = PASTEMAC(ch,type); \
+	const dim_t v  = bli_compact_width( dt, cntx ); \
+\
+	compact_params_t params; \
+\
+	params.dt_size = sizeof( ctype ); \
+	params.m       = m; \
+	params.n       = n; \
+	params.c       = ap; \
+	params.gs_c    = m * n * v; \
+\
+	bli_compact_set_strides( BLIS_NO_TRANSPOSE, m, v, &params.rs_c, &params.cs_c ); \
+\
+	params.ker     = bli_cntx_get_ukr_dt( dt, BLIS_GETRFNP_COMPACT_KER, cntx ); \
+	params.cntx    = cntx; \
+\
+	bli_compact_launch( ( nb + v - 1 ) / v, bli_getrfnp_compact_groups, &params, rntm ); \
+} \
+\
+void PASTEMAC(ch,opname) \
+     ( \
+             dim_t   m, \
+             dim_t   n, \
+             ctype*  ap, \
+             dim_t   nb  \
+     ) \
+{ \
+	PASTEMAC2(ch,opname,BLIS_TAPI_EX_SUF)( m, n, ap, nb, NULL, NULL ); \
+}
+
+INSERT_GENTFUNCRO_BASIC( getrfnp_compact )
+
@@ -0,0 +1,242 @@
+/*
+
+   BLIS
+   An object-based framework for developing high-performance BLAS-like
+   libraries.
+
+   Copyright (C) 2014, The University of Texas at Austin
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are
+   met:
+    - Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    - Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    - Neither the name(s) of the copyright holder(s) nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef BLIS_COMPACT_H
+#define BLIS_COMPACT_H
+
+//
+// Compact batch format.
+//
+// A batch of many tiny matrices (say, m and n below 16) of the same
+// dimensions is poorly served by calling a level-3 operation once per
+// member, or even by bli_gemm_batch(): each member is too small to fill the
+// vector registers along its own rows or columns. The compact format
+// instead interleaves the members so that SIMD instructions run across the
+// batch. Groups of V consecutive members are stored one after another, and
+// within a group, element (i,j) of member g*V + l is found at
+//
+//   ap[ g*m*n*V + ( i + j*m )*V + l ]
+//
+// so that element (i,j) of the V members of a group fills one vector. V is
+// the BLIS_CV blocksize of the context (bli_compact_width()): the number of
+// elements in a vector register of the architecture. A batch whose size is
+// not a multiple of V is padded out to one, and bli_?gepack_compact() fills
+// the padding with copies of the last member.
+//
+// The operations on compact batches apply the same scalar algorithm to all
+// members of a group at once, and so pivoting (which would differ from one
+// member to the next) is not available: bli_?getrfnp_compact() factors each
+// member without it. Only real domain types are supported.
+//
+
+// Return the number of members interleaved in each group of a compact batch
+// of datatype dt.
+BLIS_EXPORT_BLIS dim_t bli_compact_width
+     (
+             num_t   dt,
+       const cntx_t* cntx
+     );
+
+// Return the size, in bytes, of a compact batch of nb m x n matrices of
+// datatype dt, including padding.
+BLIS_EXPORT_BLIS siz_t bli_compact_size
+     (
+             num_t   dt,
+             dim_t   m,
+             dim_t   n,
+             dim_t   nb,
+       const cntx_t* cntx
+     );
+
+//
+// Prototype typed APIs (basic and expert).
+//
+
+#undef  GENTPROTRO
+#define GENTPROTRO( ctype, ch, opname ) \
+\
+BLIS_EXPORT_BLIS void PASTEMAC(ch,opname) \
+     ( \
+             dim_t         m, \
+             dim_t         n, \
+       const ctype* const* a, inc_t rs_a, inc_t cs_a, \
+             dim_t         nb, \
+             ctype*        ap  \
+     ); \
+\
+BLIS_EXPORT_BLIS void PASTEMAC2(ch,opname,BLIS_TAPI_EX_SUF) \
+     ( \
+             dim_t         m, \
+             dim_t         n, \
+       const ctype* const* a, inc_t rs_a, inc_t cs_a, \
+             dim_t         nb, \
+             ctype*        ap, \
+       const cntx_t*       cntx, \
+       const rntm_t*       rntm  \
+     );
+
+GENTPROTRO( float,  s, gepack_compact )
+GENTPROTRO( double, d, gepack_compact )
+
+
+#undef  GENTPROTRO
+#define GENTPROTRO( ctype, ch, opname ) \
+\
+BLIS_EXPORT_BLIS void PASTEMAC(ch,opname) \
+     ( \
+             dim_t         m, \
+             dim_t         n, \
+       const ctype*        ap, \
+             dim_t         nb, \
+             ctype* const* a, inc_t rs_a, inc_t cs_a  \
+     ); \
+\
+BLIS_EXPORT_BLIS void PASTEMAC2(ch,opname,BLIS_TAPI_EX_SUF) \
+     ( \
+             dim_t         m, \
+             dim_t         n, \
+       const ctype*        ap, \
+             dim_t         nb, \
+             ctype* const* a, inc_t rs_a, inc_t cs_a, \
+       const cntx_t*       cntx, \
+       const rntm_t*       rntm  \
+     );
+
+GENTPROTRO( float,  s, geunpack_compact )
+GENTPROTRO( double, d, geunpack_compact )
+
+
+#undef  GENTPROTRO
+#define GENTPROTRO( ctype, ch, opname ) \
+\
+BLIS_EXPORT_BLIS void PASTEMAC(ch,opname) \
+     ( \
+             trans_t transa, \
+             trans_t transb, \
+             dim_t   m, \
+             dim_t   n, \
+             dim_t   k, \
+       const ctype*  alpha, \
+       const ctype*  ap, \
+       const ctype*  bp, \
+       const ctype*  beta, \
+             ctype*  cp, \
+             dim_t   nb  \
+     ); \
+\
+BLIS_EXPORT_BLIS void PASTEMAC2(ch,opname,BLIS_TAPI_EX_SUF) \
+     ( \
+             trans_t transa, \
+             trans_t transb, \
+             dim_t   m, \
+             dim_t   n, \
+             dim_t   k, \
+       const ctype*  alpha, \
+       const ctype*  ap, \
+       const ctype*  bp, \
+       const ctype*  beta, \
+             ctype*  cp, \
+             dim_t   nb, \
+       const cntx_t* cntx, \
+       const rntm_t* rntm  \
+     );
+
+GENTPROTRO( float,  s, gemm_compact )
+GENTPROTRO( double, d, gemm_compact )
+
+
+#undef  GENTPROTRO
+#define GENTPROTRO( ctype, ch, opname ) \
+\
+BLIS_EXPORT_BLIS void PASTEMAC(ch,opname) \
+     ( \
+             side_t  side, \
+             uplo_t  uploa, \
+             trans_t transa, \
+             diag_t  diaga, \
+             dim_t   m, \
+             dim_t   n, \
+       const ctype*  alpha, \
+       const ctype*  ap, \
+             ctype*  bp, \
+             dim_t   nb  \
+     ); \
+\
+BLIS_EXPORT_BLIS void PASTEMAC2(ch,opname,BLIS_TAPI_EX_SUF) \
+     ( \
+             side_t  side, \
+             uplo_t  uploa, \
+             trans_t transa, \
+             diag_t  diaga, \
+             dim_t   m, \
+             dim_t   n, \
+       const ctype*  alpha, \
+       const ctype*  ap, \
+             ctype*  bp, \
+             dim_t   nb, \
+       const cntx_t* cntx, \
+       const rntm_t* rntm  \
+     );
+
+GENTPROTRO( float,  s, trsm_compact )
+GENTPROTRO( double, d, trsm_compact )
+
+
+#undef  GENTPROTRO
+#define GENTPROTRO( ctype, ch, opname ) \
+\
+BLIS_EXPORT_BLIS void PASTEMAC(ch,opname) \
+     ( \
+             dim_t   m, \
+             dim_t   n, \
+             ctype*  ap, \
+             dim_t   nb  \
+     ); \
+\
+BLIS_EXPORT_BLIS void PASTEMAC2(ch,opname,BLIS_TAPI_EX_SUF) \
+     ( \
+             dim_t   m, \
+             dim_t   n, \
+             ctype*  ap, \
+             dim_t   nb, \
+       const cntx_t* cntx, \
+       const rntm_t* rntm  \
+     );
+
+GENTPROTRO( float,  s, getrfnp_compact )
+GENTPROTRO( double, d, getrfnp_compact )
+
+
+#endif
+
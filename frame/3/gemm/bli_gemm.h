@@ -34,6 +34,9 @@
 
 #include "bli_gemm_cntl.h"
 #include "bli_gemm_front.h"
+#include "bli_gemm_pack.h"
+#include "bli_gemm_batch.h"
+#include "bli_gemm_tiny.h"
 
 #include "bli_gemm_var.h"
 
@@ -0,0 +1,560 @@
+/*
+
+   BLIS
+   An object-based framework for developing high-performance BLAS-like
+   libraries.
+
+   Copyright (C) 2014, The University of Texas at Austin
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are
+   met:
+    - Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    - Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    - Neither the name(s) of the copyright holder(s) nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "blis.h"
+
+// How the members of a group are computed.
+typedef enum
+{
+	BLIS_GEMM_BATCH_SKIP = 0, // C is empty; nothing to do
+	BLIS_GEMM_BATCH_CONV,     // bli_gemm_ex()
+	BLIS_GEMM_BATCH_SUP,      // bli_gemmsup_int()
+	BLIS_GEMM_BATCH_PACKED    // with the group's shared operand pre-packed
+} gemm_batch_kind_t;
+
+typedef struct
+{
+	gemm_batch_kind_t kind;
+
+	// For BLIS_GEMM_BATCH_PACKED: the pre-packed shared operand, whether it
+	// is op(A)^T rather than op(B) (in which case each member computes
+	// C^T := beta * C^T + alpha * op(B)^T * op(A)^T), and whether the
+	// members may be computed by the sup millikernels directly.
+	obj_t             bp;
+	bool              share_a;
+	bool              packed_sup;
+
+	// The runtime with which the members are computed: single-threaded,
+	// or with the threads of one team (see bli_gemm_batch_ex()).
+	rntm_t            rntm;
+} gemm_batch_plan_t;
+
+typedef struct
+{
+	const gemm_batch_group_t* groups;
+	const gemm_batch_plan_t*  plans;
+	      dim_t               n_members;
+	      dim_t               chunk;
+	      dim_t               nt_team;
+	const cntx_t*             cntx;
+	const cntx_t*             cntx_nat;
+	const rntm_t*             rntm;
+	      array_t*            array;
+} gemm_batch_params_t;
+
+// Return the number of members of a group that need to be computed.
+static dim_t bli_gemm_batch_group_size( const gemm_batch_group_t* group )
+{
+	if ( bli_obj_has_zero_dim( &group->c ) ) return 0;
+
+	return bli_max( group->size, 0 );
+}
+
+// Return the buffer of an operand of member i of a group.
+static void* bli_gemm_batch_buf
+     (
+       const void* const* bufs,
+       const obj_t*       obj,
+             inc_t        str,
+             dim_t        i
+     )
+{
+	if ( bufs != NULL ) return ( void* )bufs[ i ];
+
+	return ( char* )bli_obj_buffer( obj ) + i * str * bli_obj_elem_size( obj );
+}
+
+// Initialize a, b, and c as the operands of member i of a group.
+static void bli_gemm_batch_member_init
+     (
+       const gemm_batch_group_t* group,
+             dim_t               i,
+             obj_t*              a,
+             obj_t*              b,
+             obj_t*              c
+     )
+{
+	// The templates may have been copied into the group, so the members do
+	// not refer back to them as their roots.
+	*a = group->a;
+	*b = group->b;
+	*c = group->c;
+
+	bli_obj_set_as_root( a );
+	bli_obj_set_as_root( b );
+	bli_obj_set_as_root( c );
+
+	bli_obj_set_buffer( bli_gemm_batch_buf( group->buf_a, &group->a, group->str_a, i ), a );
+	bli_obj_set_buffer( bli_gemm_batch_buf( group->buf_b, &group->b, group->str_b, i ), b );
+	bli_obj_set_buffer( bli_gemm_batch_buf( ( const void* const* )group->buf_c, &group->c, group->str_c, i ), c );
+}
+
+// Offer nt threads to the members of a group that go to the sup
+// millikernels, and factorize the number of threads they take (which may
+// be fewer) into the ways of parallelism after which their thrinfo_t trees
+// are shaped.
+static void bli_gemm_batch_plan_threads
+     (
+       const gemm_batch_group_t* group,
+             gemm_batch_plan_t*  plan,
+       const cntx_t*             cntx,
+             dim_t               nt
+     )
+{
+	// A member that shares A computes the transposed product.
+	const dim_t m = bli_obj_length( &group->c );
+	const dim_t n = bli_obj_width( &group->c );
+	const dim_t k = bli_obj_width_after_trans( &group->a );
+
+	bli_rntm_set_num_threads_only( nt, &plan->rntm );
+
+	bli_rntm_factorize_sup
+	(
+	  bli_obj_dt( &group->c ),
+	  plan->share_a ? n : m,
+	  plan->share_a ? m : n,
+	  k,
+	  cntx,
+	  &plan->rntm
+	);
+}
+
+static void bli_gemm_batch_plan
+     (
+       const gemm_batch_group_t* group,
+       const cntx_t*             cntx,
+       const rntm_t*             rntm,
+             gemm_batch_plan_t*  plan
+     )
+{
+	plan->kind       = BLIS_GEMM_BATCH_CONV;
+	plan->share_a    = FALSE;
+	plan->packed_sup = FALSE;
+	plan->rntm       = *rntm;
+
+	const dim_t size = bli_gemm_batch_group_size( group );
+
+	if ( size == 0 ) { plan->kind = BLIS_GEMM_BATCH_SKIP; return; }
+
+	obj_t a, b, c;
+	bli_gemm_batch_member_init( group, 0, &a, &b, &c );
+
+	const postops_t* postops = bli_l3_postops_query( rntm );
+
+	if ( bli_error_checking_is_enabled() )
+	{
+		bli_gemm_check( &group->alpha, &a, &b, &group->beta, &c, cntx );
+		if ( postops != NULL ) bli_l3_postops_check( &c, postops );
+	}
+
+	// Leave the scaling of C by beta, mixed-datatype computation, and
+	// induced methods to bli_gemm_ex().
+	if ( bli_obj_equals( &group->alpha, &BLIS_ZERO ) ||
+	     bli_obj_has_zero_dim( &a ) ||
+	     bli_obj_has_zero_dim( &b ) ) return;
+
+	if ( bli_obj_dt( &c ) != bli_obj_dt( &a ) ||
+	     bli_obj_dt( &c ) != bli_obj_dt( &b ) ||
+	     bli_obj_comp_prec( &c ) != bli_obj_prec( &c ) ) return;
+
+	const num_t dt = bli_obj_dt( &c );
+
+	// The members are handed to the default sup handler's thread entry
+	// point, so a configuration that registered a different handler gets
+	// bli_gemm_ex() instead.
+	bool sup = bli_rntm_l3_sup( rntm ) &&
+	           bli_cntx_get_l3_sup_handler( BLIS_GEMM, cntx ) == ( void_fp )bli_gemmsup_ref &&
+	           bli_obj_stor3_from_strides( &c, &a, &b ) != BLIS_XXX &&
+	           bli_gemmsup_is_small( &a, &b, &c, cntx, rntm );
+
+	#ifdef BLIS_DISABLE_SUP_HANDLING
+	sup = FALSE;
+	#endif
+
+	// Find out whether every member reads the same A or the same B.
+	bool same_a = 1 < size;
+	bool same_b = 1 < size;
+	if ( group->buf_a == NULL ) same_a = same_a && group->str_a == 0;
+	if ( group->buf_b == NULL ) same_b = same_b && group->str_b == 0;
+	for ( dim_t i = 1; i < size && ( same_a || same_b ); ++i )
+	{
+		same_a = same_a && ( group->buf_a == NULL || group->buf_a[ i ] == group->buf_a[ 0 ] );
+		same_b = same_b && ( group->buf_b == NULL || group->buf_b[ i ] == group->buf_b[ 0 ] );
+	}
+
+	// Sharing A means computing the transposed product, to which any
+	// post-ops (indexed relative to C) do not apply as given. And since
+	// the packed format is that of the native context, complex members
+	// are only computed from a packed operand if they would not have used
+	// an induced method anyway.
+	if ( postops != NULL ) same_a = FALSE;
+	if ( !sup && bli_is_complex( dt ) ) same_a = same_b = FALSE;
+
+	if ( same_b || same_a )
+	{
+		plan->kind    = BLIS_GEMM_BATCH_PACKED;
+		plan->share_a = !same_b;
+
+		if ( plan->share_a )
+		{
+			bli_obj_toggle_trans( &a );
+			bli_gemm_pack_ex( &a, &plan->bp, cntx );
+
+			bli_obj_toggle_trans( &b );
+			bli_obj_induce_trans( &c );
+			a = b;
+		}
+		else
+		{
+			bli_gemm_pack_ex( &b, &plan->bp, cntx );
+		}
+
+		plan->packed_sup = sup &&
+		                   bli_gemm_compute_sup_is_avail( &a, &plan->bp, &c, cntx );
+	}
+	else if ( sup )
+	{
+		plan->kind = BLIS_GEMM_BATCH_SUP;
+	}
+
+	if ( plan->kind == BLIS_GEMM_BATCH_SUP || plan->packed_sup )
+		bli_gemm_batch_plan_threads( group, plan, cntx, bli_rntm_num_threads( rntm ) );
+}
+
+static void bli_gemm_batch_member
+     (
+       const gemm_batch_group_t* group,
+       const gemm_batch_plan_t*  plan,
+             dim_t               i,
+       const cntx_t*             cntx,
+       const cntx_t*             cntx_nat,
+       const rntm_t*             rntm,
+             thrinfo_t*          thread
+     )
+{
+	obj_t a, b, c;
+	bli_gemm_batch_member_init( group, i, &a, &b, &c );
+
+	// Without a thrinfo_t, the member is computed on its own, with all of
+	// the threads of rntm.
+	if ( thread == NULL )
+	{
+		if ( plan->kind == BLIS_GEMM_BATCH_PACKED )
+		{
+			if ( plan->share_a )
+			{
+				bli_obj_toggle_trans( &b );
+				bli_obj_induce_trans( &c );
+				a = b;
+			}
+
+			bli_gemm_compute_ex( &group->alpha, &a, &plan->bp, &group->beta, &c,
+			                     cntx_nat, rntm );
+		}
+		else if ( plan->kind != BLIS_GEMM_BATCH_SKIP )
+		{
+			bli_gemm_ex( &group->alpha, &a, &b, &group->beta, &c, cntx, rntm );
+		}
+		return;
+	}
+
+	switch ( plan->kind )
+	{
+		case BLIS_GEMM_BATCH_SUP:
+			bli_gemmsup_int( &group->alpha, &a, &b, &group->beta, &c,
+			                 cntx_nat, &plan->rntm, thread );
+			break;
+
+		case BLIS_GEMM_BATCH_PACKED:
+			if ( plan->share_a )
+			{
+				bli_obj_toggle_trans( &b );
+				bli_obj_induce_trans( &c );
+				a = b;
+			}
+
+			if ( plan->packed_sup )
+				bli_gemm_compute_sup_int( &group->alpha, &a, &plan->bp, &group->beta, &c,
+				                          cntx_nat, &plan->rntm, thread );
+			else
+				bli_gemm_compute_ex( &group->alpha, &a, &plan->bp, &group->beta, &c,
+				                     cntx_nat, &plan->rntm );
+			break;
+
+		case BLIS_GEMM_BATCH_CONV:
+			bli_gemm_ex( &group->alpha, &a, &b, &group->beta, &c,
+			             cntx, &plan->rntm );
+			break;
+
+		default:
+			break;
+	}
+}
+
+// Locate member e of the batch: the index of its group, and its index
+// within that group. The search starts from the group g, whose first
+// member is member g_off of the batch, and which must not come after the
+// group of member e.
+static void bli_gemm_batch_locate
+     (
+       const gemm_batch_group_t* groups,
+             dim_t               e,
+             dim_t*              g,
+             dim_t*              g_off
+     )
+{
+	while ( *g_off + bli_gemm_batch_group_size( &groups[ *g ] ) <= e )
+	{
+		*g_off += bli_gemm_batch_group_size( &groups[ *g ] );
+		++(*g);
+	}
+}
+
+static void bli_gemm_batch_thread_entry( thrcomm_t* gl_comm, dim_t tid, const void* data_void )
+{
+	const gemm_batch_params_t* data = data_void;
+
+	const gemm_batch_group_t*  groups    = data->groups;
+	const gemm_batch_plan_t*   plans     = data->plans;
+	const dim_t                n_members = data->n_members;
+	const dim_t                chunk     = data->chunk;
+
+	pool_t* pool = bli_apool_array_elem( tid, data->array );
+
+	thrinfo_t* root = bli_thrinfo_create_root( gl_comm, tid, pool, bli_pba_query() );
+
+	dim_t g     = 0;
+	dim_t g_off = 0;
+
+	if ( 1 < data->nt_team )
+	{
+		// The threads are divided into one team per member, and the members
+		// of a team share the work of their member through the thrinfo_t
+		// tree of the sup millikernels, rooted at the team's communicator.
+		thrinfo_t* team = bli_thrinfo_split( n_members, root );
+
+		const dim_t e = bli_thrinfo_work_id( team );
+		bli_gemm_batch_locate( groups, e, &g, &g_off );
+
+		thrinfo_t* thread = bli_l3_sup_thrinfo_create
+		(
+		  bli_thrinfo_thread_id( team ),
+		  bli_thrinfo_comm( team ),
+		  pool,
+		  &plans[ g ].rntm
+		);
+
+		bli_gemm_batch_member( &groups[ g ], &plans[ g ], e - g_off,
+		                       data->cntx, data->cntx_nat, NULL, thread );
+
+		// The team's communicator is freed along with the team node, so
+		// every member of the team must be done with it first.
+		bli_thrinfo_barrier( thread );
+		bli_thrinfo_free( thread );
+		bli_thrinfo_free( team );
+		bli_thrinfo_free( root );
+		return;
+	}
+
+	// Chunks of consecutive members are claimed from a counter shared by
+	// all threads via the root node on the global communicator, and each
+	// member is then computed with a thrinfo_t of its own.
+	thrinfo_t* thread = bli_l3_sup_thrinfo_create( 0, &BLIS_SINGLE_COMM, pool, data->rntm );
+
+	const dim_t n_chunks = ( n_members + chunk - 1 ) / chunk;
+
+	// Since each thread's claims are increasing, the group containing the
+	// current member is found by moving forward from that of the previous
+	// member.
+	for ( dim_t ch; ( ch = bli_thread_range_dyn( root, n_chunks ) ) < n_chunks; )
+	{
+		const dim_t e_end = bli_min( ( ch + 1 ) * chunk, n_members );
+
+		for ( dim_t e = ch * chunk; e < e_end; ++e )
+		{
+			bli_gemm_batch_locate( groups, e, &g, &g_off );
+
+			bli_gemm_batch_member( &groups[ g ], &plans[ g ], e - g_off,
+			                       data->cntx, data->cntx_nat, NULL, thread );
+		}
+	}
+
+	bli_thrinfo_free( thread );
+	bli_thrinfo_free( root );
+}
+
+// -----------------------------------------------------------------------------
+
+void bli_gemm_batch
+     (
+             dim_t               n_groups,
+       const gemm_batch_group_t* groups
+     )
+{
+	bli_gemm_batch_ex( n_groups, groups, NULL, NULL );
+}
+
+void bli_gemm_batch_ex
+     (
+             dim_t               n_groups,
+       const gemm_batch_group_t* groups,
+       const cntx_t*             cntx,
+       const rntm_t*             rntm
+     )
+{
+	bli_init_once();
+
+	dim_t n_members = 0;
+	for ( dim_t g = 0; g < n_groups; ++g )
+		n_members += bli_gemm_batch_group_size( &groups[ g ] );
+
+	if ( n_members == 0 ) return;
+
+	// Initialize a local runtime with global settings if necessary. Note
+	// that in the case that a runtime is passed in, we make a local copy.
+	rntm_t rntm_l;
+	if ( rntm == NULL ) { bli_rntm_init_from_global( &rntm_l ); }
+	else                { rntm_l = *rntm;                       }
+
+	dim_t nt = bli_rntm_num_threads( &rntm_l );
+	if ( nt < 1 ) nt = bli_rntm_calc_num_threads( &rntm_l );
+	if ( bli_rntm_thread_impl( &rntm_l ) == BLIS_SINGLE ||
+	     bli_thread_in_region() ) nt = 1;
+
+	// With at least as many members as threads, each member is computed by
+	// a single thread. Otherwise, the threads are better spent within each
+	// member, and each member gets a team with an equal share of them.
+	dim_t nt_team = n_members < nt ? nt / n_members : 1;
+
+	// A workspace may not be used by more than one operation at once, so it
+	// is left out of the runtime with which the members are computed.
+	rntm_t rntm_team = rntm_l;
+	bli_rntm_set_num_threads( nt_team, &rntm_team );
+	bli_rntm_clear_workspace( &rntm_team );
+
+	// The sup millikernels and the packed format call for the native
+	// context.
+	const cntx_t* cntx_nat = cntx != NULL ? cntx : bli_gks_query_cntx();
+
+	err_t r_val;
+	gemm_batch_plan_t* plans = bli_malloc_intl( n_groups * sizeof( gemm_batch_plan_t ), &r_val );
+
+	bool all_sup = TRUE;
+	for ( dim_t g = 0; g < n_groups; ++g )
+	{
+		bli_gemm_batch_plan( &groups[ g ], cntx_nat, &rntm_team, &plans[ g ] );
+
+		all_sup = all_sup &&
+		          ( plans[ g ].kind == BLIS_GEMM_BATCH_SKIP ||
+		            plans[ g ].kind == BLIS_GEMM_BATCH_SUP  ||
+		            ( plans[ g ].kind == BLIS_GEMM_BATCH_PACKED && plans[ g ].packed_sup ) );
+	}
+
+	// The sup handler may take fewer threads than it is offered, but the
+	// teams must all be of the same size. So they are shrunk to fit the
+	// member that takes the fewest, and the members are offered that many
+	// threads again, for as long as any of them takes fewer still.
+	for ( bool refit = all_sup; refit && 1 < nt_team; )
+	{
+		refit = FALSE;
+
+		for ( dim_t g = 0; g < n_groups; ++g )
+		{
+			if ( plans[ g ].kind == BLIS_GEMM_BATCH_SKIP ) continue;
+
+			const dim_t nt_g = bli_rntm_num_threads( &plans[ g ].rntm );
+			if ( nt_g < nt_team ) { nt_team = nt_g; refit = TRUE; }
+		}
+
+		for ( dim_t g = 0; g < n_groups && refit; ++g )
+			if ( plans[ g ].kind != BLIS_GEMM_BATCH_SKIP &&
+			     bli_rntm_num_threads( &plans[ g ].rntm ) != nt_team )
+				bli_gemm_batch_plan_threads( &groups[ g ], &plans[ g ], cntx_nat, nt_team );
+	}
+
+	if ( 1 < nt_team && !all_sup )
+	{
+		// Only the sup millikernels can be handed the thrinfo_t of a team,
+		// so the members are instead computed one after another, each with
+		// all of the threads.
+		for ( dim_t g = 0; g < n_groups; ++g )
+		{
+			const dim_t size = bli_gemm_batch_group_size( &groups[ g ] );
+
+			for ( dim_t i = 0; i < size; ++i )
+				bli_gemm_batch_member( &groups[ g ], &plans[ g ], i,
+				                       cntx, cntx_nat, &rntm_l, NULL );
+		}
+	}
+	else
+	{
+		// Hand out the members in chunks, several per thread, to balance the
+		// load without having every member contend for the shared counter.
+		const dim_t chunk = bli_max( n_members / ( 8 * nt ), 1 );
+
+		// Any threads left over after an equal division into teams are not
+		// launched.
+		nt = bli_min( nt, nt_team * n_members );
+
+		bli_rntm_set_num_threads( nt, &rntm_l );
+
+		// The runtime after which the thrinfo_t of each single thread is
+		// shaped.
+		rntm_t rntm_1 = rntm_team;
+		bli_rntm_set_num_threads( 1, &rntm_1 );
+
+		array_t* array = bli_sba_checkout_array( nt );
+
+		gemm_batch_params_t params;
+		params.groups    = groups;
+		params.plans     = plans;
+		params.n_members = n_members;
+		params.chunk     = chunk;
+		params.nt_team   = nt_team;
+		params.cntx      = cntx;
+		params.cntx_nat  = cntx_nat;
+		params.rntm      = &rntm_1;
+		params.array     = array;
+
+		bli_thread_launch_rntm( &rntm_l, bli_gemm_batch_thread_entry, &params );
+
+		bli_sba_checkin_array( array );
+	}
+
+	for ( dim_t g = 0; g < n_groups; ++g )
+		if ( plans[ g ].kind == BLIS_GEMM_BATCH_PACKED )
+			bli_gemm_pack_free( &plans[ g ].bp );
+
+	bli_free_intl( plans );
+}
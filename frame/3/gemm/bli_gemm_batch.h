@@ -0,0 +1,87 @@
+/*
+
+   BLIS
+   An object-based framework for developing high-performance BLAS-like
+   libraries.
+
+   Copyright (C) 2014, The University of Texas at Austin
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are
+   met:
+    - Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    - Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    - Neither the name(s) of the copyright holder(s) nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+//
+// Batched gemm.
+//
+// bli_gemm_batch_ex() computes a batch of independent gemm operations,
+// organized into groups whose members share their dimensions, strides,
+// transposition, and scalars and differ only in the buffers of A, B, and C.
+// Rather than parallelizing each member in turn, as a sequence of
+// bli_gemm_ex() calls would, the engine launches its threads once and lets
+// them claim members (in chunks) from a shared counter, computing each one
+// single-threaded. Small members go straight to the sup millikernels, with
+// no per-call threading setup at all. If every member of a group reads the
+// same A or the same B, that operand is packed once, up front, and shared
+// by all threads (see bli_gemm_pack()). If the batch holds fewer members
+// than there are threads, the threads are instead divided into one team per
+// member, each of which computes its member in parallel (or, if not every
+// member goes to the sup millikernels, the members are computed one after
+// another with all of the threads).
+//
+
+typedef struct
+{
+	// The scalars and operand "templates" of the group. The buffer of A
+	// for member i is buf_a[i] or, if buf_a is NULL, the buffer of a offset
+	// by i * str_a elements (and likewise for B and C).
+	obj_t              alpha;
+	obj_t              a;
+	obj_t              b;
+	obj_t              beta;
+	obj_t              c;
+
+	dim_t              size;
+	const void* const* buf_a;
+	const void* const* buf_b;
+	      void* const* buf_c;
+	inc_t              str_a;
+	inc_t              str_b;
+	inc_t              str_c;
+} gemm_batch_group_t;
+
+BLIS_EXPORT_BLIS void bli_gemm_batch
+     (
+             dim_t               n_groups,
+       const gemm_batch_group_t* groups
+     );
+
+BLIS_EXPORT_BLIS void bli_gemm_batch_ex
+     (
+             dim_t               n_groups,
+       const gemm_batch_group_t* groups,
+       const cntx_t*             cntx,
+       const rntm_t*             rntm
+     );
+
@@ -75,6 +75,29 @@ void bli_gemm_blk_var3
 		bli_acquire_mpart_mdim( direct, BLIS_SUBPART1,
 		                        i, b_alg, &bp, &b1 );
 
+		// Any post-ops attached to C (see bli_gemm_front()) may only be
+		// applied once C holds the complete product, so we withhold them
+		// from all but the last rank-k update.
+		const obj_t*      c1 = &cs;
+		obj_t             cs_nopo;
+		gemm_ker_params_t params_nopo;
+
+		if ( bli_cntl_family( cntl ) == BLIS_GEMM && i + b_alg < k_trans )
+		{
+			const gemm_ker_params_t* params = bli_obj_ker_params( &cs );
+
+			if ( params != NULL && params->postops != NULL )
+			{
+				params_nopo         = *params;
+				params_nopo.postops = NULL;
+
+				bli_obj_alias_to( &cs, &cs_nopo );
+				bli_obj_set_ker_params( &params_nopo, &cs_nopo );
+
+				c1 = &cs_nopo;
+			}
+		}
+
 		// Perform gemm subproblem.
 		bli_l3_int
 		(
@@ -82,7 +105,7 @@ void bli_gemm_blk_var3
 		  &a1,
 		  &b1,
 		  &BLIS_ONE,
-		  &cs,
+		  c1,
 		  cntx,
 		  bli_cntl_sub_node( cntl ),
 		  thread
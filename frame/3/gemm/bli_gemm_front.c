@@ -81,9 +81,15 @@ void bli_gemm_front
 	// An optimization: If C is stored by rows and the micro-kernel prefers
 	// contiguous columns, or if C is stored by columns and the micro-kernel
 	// prefers contiguous rows, transpose the entire operation to allow the
-	// micro-kernel to access elements of C in its preferred manner.
-	if ( bli_cntx_dislikes_storage_of( &c_local, BLIS_GEMM_VIR_UKR, cntx ) )
+	// micro-kernel to access elements of C in its preferred manner. A
+	// pre-packed B (see bli_gemm_pack()) is packed as B, so in that case
+	// we leave the operation as is.
+	bool trans = FALSE;
+	if ( bli_cntx_dislikes_storage_of( &c_local, BLIS_GEMM_VIR_UKR, cntx ) &&
+	     !bli_gemm_obj_is_prepacked( &b_local ) )
 	{
+		trans = TRUE;
+
 		bli_obj_swap( &a_local, &b_local );
 
 		bli_obj_induce_trans( &a_local );
@@ -133,6 +139,18 @@ void bli_gemm_front
 	alpha = &BLIS_ONE;
 	beta  = &BLIS_ONE;
 
+	// If only the total number of threads was requested, choose how many of
+	// them to use, and how, based on the size of the problem.
+	bli_rntm_factorize_model
+	(
+	  bli_obj_exec_dt( &c_local ),
+	  bli_obj_length( &c_local ),
+	  bli_obj_width( &c_local ),
+	  bli_obj_width( &a_local ),
+	  cntx,
+	  rntm
+	);
+
 	// Parse and interpret the contents of the rntm_t object to properly
 	// set the ways of parallelism for each loop, and then make any
 	// additional modifications necessary for the current operation.
@@ -232,6 +250,26 @@ void bli_gemm_front
 #endif
 #endif
 
+	// If post-ops were requested, hand them to the macrokernel via the
+	// kernel params of C so that they are applied to each microtile as it
+	// is computed. (If the product is being accumulated in a temporary
+	// matrix, they are instead applied to C below, once it is complete.)
+	const postops_t*  postops = bli_l3_postops_query( rntm );
+	gemm_ker_params_t params;
+
+	if ( postops != NULL && cp == &c_local )
+	{
+		const gemm_ker_params_t* params_c = bli_obj_ker_params( &c_local );
+
+		if ( params_c != NULL ) params = *params_c;
+		else                    params.ukr = NULL;
+
+		params.postops       = postops;
+		params.postops_trans = trans;
+
+		bli_obj_set_ker_params( &params, &c_local );
+	}
+
 	// Invoke the internal back-end via the thread handler.
 	bli_l3_thread_decorator
 	(
@@ -260,6 +298,9 @@ void bli_gemm_front
 		bli_xpbym( &ct, &beta_local, &c_local );
 
 		bli_obj_free( &ct );
+
+		if ( postops != NULL )
+			bli_l3_postops_apply_obj( trans, postops, &c_local, cntx );
 	}
 #endif
 #endif
@@ -74,6 +74,78 @@ INSERT_GENTFUNC2_MIX_DP(xpbys_mxn_fn);
 
 static xpbys_mxn_vft GENARRAY2_ALL(xpbys_mxn, xpbys_mxn_fn);
 
+// Compute a single microtile of C, accumulating through the temporary
+// microtile ct when the execution and storage datatypes of C differ.
+BLIS_INLINE void bli_gemm_ker_var2_ukr
+     (
+             num_t       dt_exec,
+             num_t       dt_c,
+             dim_t       m_cur,
+             dim_t       n_cur,
+             dim_t       mr,
+             dim_t       nr,
+             dim_t       k,
+       const char*       alpha,
+       const char*       a1,
+       const char*       b1,
+       const char*       beta,
+             char*       c11, inc_t rs_c,  inc_t cs_c,
+             char*       ct,  inc_t rs_ct, inc_t cs_ct,
+       const char*       zero,
+             gemm_ukr_ft gemm_ukr,
+             auxinfo_t*  aux,
+       const cntx_t*     cntx
+     )
+{
+	// Edge case handling now occurs within the microkernel itself, but
+	// we must still explicitly accumulate to a temporary microtile in
+	// situations where a virtual microkernel is being used, such as
+	// during the 1m method or some cases of mixed datatypes.
+	if ( dt_exec == dt_c )
+	{
+		// Invoke the gemm micro-kernel.
+		gemm_ukr
+		(
+		  m_cur,
+		  n_cur,
+		  k,
+		  ( void* )alpha,
+		  ( void* )a1,
+		  ( void* )b1,
+		  ( void* )beta,
+		           c11, rs_c, cs_c,
+		  aux,
+		  ( cntx_t* )cntx
+		);
+	}
+	else
+	{
+		// Invoke the gemm micro-kernel.
+		gemm_ukr
+		(
+		  mr,
+		  nr,
+		  k,
+		  ( void* )alpha,
+		  ( void* )a1,
+		  ( void* )b1,
+		  ( void* )zero,
+		           ct, rs_ct, cs_ct,
+		  aux,
+		  ( cntx_t* )cntx
+		);
+
+		// Accumulate to C with typecasting.
+		xpbys_mxn[ dt_exec ][ dt_c ]
+		(
+		  m_cur, n_cur,
+		  ct, rs_ct, cs_ct,
+		  ( void* )beta,
+		  c11, rs_c, cs_c
+		);
+	}
+}
+
 
 void bli_gemm_ker_var2
      (
@@ -189,6 +261,16 @@ void bli_gemm_ker_var2
 	gemm_ukr_ft user_ukr = params ? params->ukr : NULL;
 	if ( user_ukr ) gemm_ukr = user_ukr;
 
+	// Query any post-ops that are to be applied to each microtile once it
+	// has been computed, along with the offsets of the current block of C
+	// (relative to the matrix C to which the post-ops refer). NOTE: These
+	// are only present when this block of C is being computed for the last
+	// time (see bli_gemm_blk_var3()).
+	const postops_t* postops  = params ? params->postops : NULL;
+	const bool       po_trans = params ? params->postops_trans : FALSE;
+	const dim_t      off_m    = bli_obj_row_off( c );
+	const dim_t      off_n    = bli_obj_col_off( c );
+
 	// Temporary C buffer for edge cases. Note that the strides of this
 	// temporary buffer are set so that they match the storage of the
 	// original C matrix. For example, if C is column-stored, ct will be
@@ -244,6 +326,71 @@ void bli_gemm_ker_var2
 	bli_auxinfo_set_ukr( gemm_ukr, &aux );
 	bli_auxinfo_set_params( params, &aux );
 
+	// If requested, have all of the threads executing this macro-kernel claim
+	// microtiles one at a time from a shared counter rather than dividing
+	// them up in advance. This keeps threads that were slowed down (e.g. by
+	// running on a slower core or by being preempted) from holding up the
+	// others at the next barrier.
+	if ( bli_thrinfo_num_threads( thread_par ) > 1 &&
+	     bli_thrcomm_jrir_sched( bli_thrinfo_comm( thread_par ) ) == BLIS_JRIR_DYNAMIC )
+	{
+		const dim_t n_ut = m_iter * n_iter;
+
+		// Microtiles are numbered column by column so that microtiles
+		// claimed at about the same time share a micropanel of B.
+		for ( dim_t t = bli_thread_range_dyn( thread_par, n_ut ); t < n_ut;
+		      t = bli_thread_range_dyn( thread_par, n_ut ) )
+		{
+			const dim_t i = t % m_iter;
+			const dim_t j = t / m_iter;
+
+			const char* a1  = a_cast + i * rstep_a;
+			const char* b1  = b_cast + j * cstep_b;
+			      char* c11 = c_cast + i * rstep_c + j * cstep_c;
+
+			// Compute the current microtile's dimensions.
+			const dim_t m_cur = ( bli_is_not_edge_f( i, m_iter, m_left )
+			                      ? MR : m_left );
+			const dim_t n_cur = ( bli_is_not_edge_f( j, n_iter, n_left )
+			                      ? NR : n_left );
+
+			// Prefetch the micropanels of the next microtile in the
+			// numbering, which is the one most likely to be claimed next.
+			const char* a2 = bli_gemm_get_next_a_upanel( a1, rstep_a, 1 );
+			const char* b2 = b1;
+			if ( i == m_iter - 1 )
+			{
+				a2 = a_cast;
+				b2 = bli_gemm_get_next_b_upanel( b1, cstep_b, 1 );
+			}
+
+			bli_auxinfo_set_next_a( a2, &aux );
+			bli_auxinfo_set_next_b( b2, &aux );
+
+			bli_gemm_ker_var2_ukr
+			(
+			  dt_exec, dt_c,
+			  m_cur, n_cur, MR, NR, k,
+			  alpha_cast, a1, b1, beta_cast,
+			  c11, rs_c,  cs_c,
+			  ct,  rs_ct, cs_ct,
+			  zero, gemm_ukr, &aux, cntx
+			);
+
+			if ( postops )
+				bli_l3_postops_apply
+				(
+				  dt_c, po_trans,
+				  m_cur, n_cur, off_m + i * MR, off_n + j * NR,
+				  postops,
+				  c11, rs_c, cs_c,
+				  cntx
+				);
+		}
+
+		return;
+	}
+
 	dim_t jr_start, jr_end, jr_inc;
 	dim_t ir_start, ir_end, ir_inc;
 
@@ -340,53 +487,25 @@ void bli_gemm_ker_var2
 			bli_auxinfo_set_next_a( a2, &aux );
 			bli_auxinfo_set_next_b( b2, &aux );
 
-			// Edge case handling now occurs within the microkernel itself, but
-			// we must still explicitly accumulate to a temporary microtile in
-			// situations where a virtual microkernel is being used, such as
-			// during the 1m method or some cases of mixed datatypes.
-			if ( dt_exec == dt_c )
-			{
-				// Invoke the gemm micro-kernel.
-				gemm_ukr
+			bli_gemm_ker_var2_ukr
+			(
+			  dt_exec, dt_c,
+			  m_cur, n_cur, MR, NR, k,
+			  alpha_cast, a1, b1, beta_cast,
+			  c11, rs_c,  cs_c,
+			  ct,  rs_ct, cs_ct,
+			  zero, gemm_ukr, &aux, cntx
+			);
+
+			if ( postops )
+				bli_l3_postops_apply
 				(
-				  m_cur,
-				  n_cur,
-				  k,
-				  ( void* )alpha_cast,
-				  ( void* )a1,
-				  ( void* )b1,
-				  ( void* )beta_cast,
-				           c11, rs_c, cs_c,
-				  &aux,
-				  ( cntx_t* )cntx
+				  dt_c, po_trans,
+				  m_cur, n_cur, off_m + i * MR, off_n + j * NR,
+				  postops,
+				  c11, rs_c, cs_c,
+				  cntx
 				);
-			}
-			else
-			{
-				// Invoke the gemm micro-kernel.
-				gemm_ukr
-				(
-				  MR,
-				  NR,
-				  k,
-				  ( void* )alpha_cast,
-				  ( void* )a1,
-				  ( void* )b1,
-				  ( void* )zero,
-				           &ct, rs_ct, cs_ct,
-				  &aux,
-				  ( cntx_t* )cntx
-				);
-
-				// Accumulate to C with typecasting.
-				xpbys_mxn[ dt_exec ][ dt_c ]
-				(
-				  m_cur, n_cur,
-				  &ct, rs_ct, cs_ct,
-				  ( void* )beta_cast,
-				  c11, rs_c, cs_c
-				);
-			}
 
 			// Decrement the number of microtiles assigned to the thread; once
 			// it reaches zero, return immediately.
@@ -0,0 +1,586 @@
+/*
+
+   BLIS
+   An object-based framework for developing high-performance BLAS-like
+   libraries.
+
+   Copyright (C) 2014, The University of Texas at Austin
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are
+   met:
+    - Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    - Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    - Neither the name(s) of the copyright holder(s) nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "blis.h"
+
+static void_fp GENARRAY(packm_struc_cxk_fp,packm_struc_cxk);
+
+// Return the panel stride of a KC block of length kc_cur.
+static inc_t bli_gemm_pack_ps( const gemm_pack_params_t* params, dim_t kc_cur )
+{
+	inc_t ps = params->ldp * bli_align_dim_to_mult( kc_cur, params->kr );
+
+	// As in packm_init, we don't want micropanel strides to be odd.
+	if ( bli_is_odd( ps ) ) ps += 1;
+
+	return ps;
+}
+
+// Return the address of the first micro-panel of the KC block containing
+// columns [off_k, off_k+kc_cur) of B^T, offset to column off_k, along with
+// the block's panel stride. If the columns straddle two KC blocks, which
+// happens only if the KC blocksizes changed after packing, return NULL.
+static char* bli_gemm_pack_block
+     (
+       const gemm_pack_params_t* params,
+             dim_t               off_k,
+             dim_t               kc_cur,
+             inc_t*              ps
+     )
+{
+	const dim_t b0 = bli_min( ( off_k / params->kc ) * params->kc, params->k_last );
+	const dim_t b1 = ( b0 == params->k_last ? params->k : b0 + params->kc );
+
+	if ( off_k + kc_cur > b1 ) return NULL;
+
+	*ps = bli_gemm_pack_ps( params, b1 - b0 );
+
+	// Every KC block before the final one is exactly KC long.
+	return ( char* )params->buf
+	       + ( ( b0 / params->kc ) * bli_gemm_pack_ps( params, params->kc ) * params->n_pan
+	       +   ( off_k - b0 ) * params->ldp ) * bli_dt_size( params->dt );
+}
+
+void bli_gemm_pack
+     (
+       const obj_t*  b,
+             obj_t*  bp
+     )
+{
+	bli_gemm_pack_ex( b, bp, NULL );
+}
+
+void bli_gemm_pack_ex
+     (
+       const obj_t*  b,
+             obj_t*  bp,
+       const cntx_t* cntx
+     )
+{
+	bli_init_once();
+
+	// The packed format is that of the native (non-induced) context, which
+	// bli_gemm_compute_ex() insists upon as well.
+	if ( cntx == NULL ) cntx = bli_gks_query_cntx();
+
+	if ( bli_error_checking_is_enabled() )
+	{
+		bli_check_error_code( bli_check_floating_object( b ) );
+		bli_check_error_code( bli_check_general_object( b ) );
+	}
+
+	num_t dt      = bli_obj_dt( b );
+	siz_t dt_size = bli_dt_size( dt );
+
+	// Like bli_l3_packb(), we pack B^T into row micro-panels, so that the
+	// result is indistinguishable from what packm would produce for B.
+	obj_t bt;
+	bli_obj_alias_to( b, &bt );
+	if ( bli_obj_has_trans( b ) ) bli_obj_set_onlytrans( BLIS_NO_TRANSPOSE, &bt );
+	else                          bli_obj_induce_trans( &bt );
+
+	dim_t n = bli_obj_length( &bt );
+	dim_t k = bli_obj_width( &bt );
+
+	err_t r_val;
+	gemm_pack_params_t* params = bli_malloc_user( sizeof( gemm_pack_params_t ), &r_val );
+
+	params->dt     = dt;
+	params->pd     = bli_cntx_get_blksz_def_dt( dt, BLIS_NR, cntx );
+	params->ldp    = bli_cntx_get_blksz_max_dt( dt, BLIS_NR, cntx );
+	params->n_pan  = bli_align_dim_to_mult( n, params->pd ) / params->pd;
+	params->k      = k;
+	params->kc     = bli_cntx_get_blksz_def_dt( dt, BLIS_KC, cntx );
+	params->kc_max = bli_cntx_get_blksz_max_dt( dt, BLIS_KC, cntx );
+	params->kr     = bli_cntx_get_blksz_def_dt( dt, BLIS_KR, cntx );
+
+	// Walk the KC blocks the way bli_gemm_blk_var3() will, noting where the
+	// final one begins and how much space they need altogether.
+	siz_t size = 0;
+	dim_t kc_cur;
+	params->k_last = 0;
+	for ( dim_t pp = 0; pp < k; pp += kc_cur )
+	{
+		kc_cur = bli_determine_blocksize_f_sub( pp, k, params->kc, params->kc_max );
+		size  += bli_gemm_pack_ps( params, kc_cur ) * params->n_pan * dt_size;
+		params->k_last = pp;
+	}
+
+	params->buf = size != 0 ? bli_malloc_user( size, &r_val ) : NULL;
+
+	packm_ker_ft f          = packm_struc_cxk_fp[ dt ];
+	void*        kappa_cast = ( void* )bli_obj_buffer_for_const( dt, &BLIS_ONE );
+	conj_t       conjb      = bli_obj_conj_status( &bt );
+	char*        b_cast     = bli_obj_buffer_at_off( &bt );
+	inc_t        incb       = bli_obj_row_stride( &bt );
+	inc_t        ldb        = bli_obj_col_stride( &bt );
+	char*        p          = params->buf;
+
+	for ( dim_t pp = 0; pp < k; pp += kc_cur )
+	{
+		kc_cur = bli_determine_blocksize_f_sub( pp, k, params->kc, params->kc_max );
+
+		inc_t ps = bli_gemm_pack_ps( params, kc_cur );
+
+		for ( dim_t j = 0; j < n; j += params->pd )
+		{
+			dim_t pd_j = bli_min( params->pd, n - j );
+
+			f
+			(
+			  BLIS_GENERAL,
+			  BLIS_NONUNIT_DIAG,
+			  BLIS_DENSE,
+			  conjb,
+			  BLIS_PACKED_COL_PANELS,
+			  FALSE,
+			  pd_j,
+			  kc_cur,
+			  params->pd,
+			  bli_align_dim_to_mult( kc_cur, params->kr ),
+			  j,
+			  pp,
+			  kappa_cast,
+			  b_cast + ( j*incb + pp*ldb )*dt_size, incb, ldb,
+			  p,                                    params->ldp, 1,
+			  NULL,
+			  ( cntx_t* )cntx
+			);
+
+			p += ps*dt_size;
+		}
+	}
+
+	// Describe the packed B to the rest of BLIS as an ordinary k x n matrix
+	// whose pack_fn knows where to find its micro-panels. The buffer and
+	// strides are never used to read elements; they only need to satisfy
+	// the object checks.
+	bli_obj_create_without_buffer( dt, bli_obj_length_after_trans( b ),
+	                                   bli_obj_width_after_trans( b ), bp );
+	bli_obj_attach_buffer( params->buf, 1, bli_max( k, 1 ), 1, bp );
+	bli_obj_set_pack_fn( bli_packm_prepacked, bp );
+	bli_obj_set_pack_params( params, bp );
+}
+
+void bli_gemm_pack_free
+     (
+       obj_t* bp
+     )
+{
+	gemm_pack_params_t* params = bli_obj_pack_params( bp );
+
+	if ( params == NULL ) return;
+
+	bli_free_user( params->buf );
+	bli_free_user( params );
+
+	bli_obj_set_pack_params( NULL, bp );
+	bli_obj_set_buffer( NULL, bp );
+}
+
+// -----------------------------------------------------------------------------
+
+// The sup millikernels accept B with unit column stride and an arbitrary row
+// stride, and the "n" millikernels step from one NR-wide micro-panel of B to
+// the next by the panel stride in the auxinfo_t, which is exactly how the
+// pre-packed micro-panels are laid out. Thus, small problems can read the
+// pre-packed B directly, with A and C left in place as sup would have them.
+
+err_t bli_gemm_compute_sup_int
+     (
+       const obj_t*     alpha,
+       const obj_t*     a,
+       const obj_t*     bp,
+       const obj_t*     beta,
+       const obj_t*     c,
+       const cntx_t*    cntx,
+       const rntm_t*    rntm,
+             thrinfo_t* thread
+     )
+{
+	const gemm_pack_params_t* params = bli_obj_pack_params( bp );
+
+	const num_t  dt      = bli_obj_dt( c );
+	const dim_t  dt_size = bli_dt_size( dt );
+
+	const conj_t conja   = bli_obj_conj_status( a );
+
+	const dim_t  m       = bli_obj_length( c );
+	const dim_t  n       = bli_obj_width( c );
+	const dim_t  k       = bli_obj_width_after_trans( a );
+
+	const char*  buf_a   = bli_obj_buffer_at_off( a );
+	const inc_t  rs_a    = bli_obj_has_notrans( a ) ? bli_obj_row_stride( a )
+	                                                : bli_obj_col_stride( a );
+	const inc_t  cs_a    = bli_obj_has_notrans( a ) ? bli_obj_col_stride( a )
+	                                                : bli_obj_row_stride( a );
+
+	      char*  buf_c   = bli_obj_buffer_at_off( c );
+	const inc_t  rs_c    = bli_obj_row_stride( c );
+	const inc_t  cs_c    = bli_obj_col_stride( c );
+
+	const inc_t  rs_b    = params->ldp;
+
+	const void*  buf_alpha = bli_obj_buffer_for_1x1( dt, alpha );
+	const void*  buf_beta  = bli_obj_buffer_for_1x1( dt, beta );
+	const void*  one       = bli_obj_buffer_for_const( dt, &BLIS_ONE );
+
+	const dim_t  MR = bli_cntx_get_l3_sup_blksz_def_dt( dt, BLIS_MR, cntx );
+	const dim_t  NR = bli_cntx_get_l3_sup_blksz_def_dt( dt, BLIS_NR, cntx );
+
+	const stor3_t stor_id = bli_stor3_from_strides( rs_c, cs_c, rs_a, cs_a, rs_b, 1 );
+
+	gemmsup_ker_ft gemmsup_ker = bli_cntx_get_l3_sup_ker_dt( dt, stor_id, cntx );
+
+	// Any post-ops are applied to each tile after its last update.
+	const postops_t* postops = bli_l3_postops_query( rntm );
+
+	auxinfo_t aux;
+	bli_auxinfo_set_ps_a( MR * rs_a, &aux );
+
+	// Each thread updates its own contiguous range of MR x NR tiles of C.
+	// The tiles are enumerated along the columns or rows of C, whichever
+	// keeps consecutive tiles adjacent in memory. (Enumerating down each
+	// column panel also reuses the current micro-panel of B across tiles.)
+	const bool  row_c  = bli_is_row_stored( rs_c, cs_c );
+	const dim_t m_iter = ( m + MR - 1 ) / MR;
+	const dim_t n_iter = ( n + NR - 1 ) / NR;
+	const dim_t nt     = bli_thrinfo_num_threads( thread );
+	const dim_t tid    = bli_thrinfo_thread_id( thread );
+	const dim_t t_beg  = ( ( m_iter * n_iter ) *   tid       ) / nt;
+	const dim_t t_end  = ( ( m_iter * n_iter ) * ( tid + 1 ) ) / nt;
+
+	// Loop over the KC blocks of the packed B.
+	dim_t kc_cur;
+	for ( dim_t pp = 0; pp < k; pp += kc_cur )
+	{
+		kc_cur = bli_determine_blocksize_f_sub( pp, k, params->kc, params->kc_max );
+
+		const void* beta_use = ( pp == 0 ? buf_beta : one );
+
+		inc_t       ps_b;
+		const char* b_pc = bli_gemm_pack_block( params, pp, kc_cur, &ps_b );
+
+		bli_auxinfo_set_ps_b( ps_b, &aux );
+
+		for ( dim_t t = t_beg; t < t_end; ++t )
+		{
+			const dim_t i = ( row_c ? t / n_iter : t % m_iter ) * MR;
+			const dim_t j = ( row_c ? t % n_iter : t / m_iter ) * NR;
+
+			const dim_t mr_cur = bli_min( MR, m - i );
+			const dim_t nr_cur = bli_min( NR, n - j );
+
+			const char* a_ip = buf_a + ( i*rs_a + pp*cs_a ) * dt_size;
+			const char* b_pj = b_pc  + ( j / NR ) * ps_b * dt_size;
+			      char* c_ij = buf_c + ( i*rs_c + j*cs_c ) * dt_size;
+
+			gemmsup_ker
+			(
+			  conja,
+			  BLIS_NO_CONJUGATE,
+			  mr_cur,
+			  nr_cur,
+			  kc_cur,
+			  ( void* )buf_alpha,
+			  ( void* )a_ip, rs_a, cs_a,
+			  ( void* )b_pj, rs_b, 1,
+			  ( void* )beta_use,
+			  ( void* )c_ij, rs_c, cs_c,
+			  &aux,
+			  ( cntx_t* )cntx
+			);
+
+			if ( postops && pp + kc_cur == k )
+				bli_l3_postops_apply
+				(
+				  dt, FALSE,
+				  mr_cur, nr_cur, i, j,
+				  postops,
+				  c_ij, rs_c, cs_c,
+				  cntx
+				);
+		}
+	}
+
+	return BLIS_SUCCESS;
+}
+
+bool bli_gemm_compute_sup_is_avail
+     (
+       const obj_t*  a,
+       const obj_t*  bp,
+       const obj_t*  c,
+       const cntx_t* cntx
+     )
+{
+	const gemm_pack_params_t* params = bli_obj_pack_params( bp );
+
+	const num_t dt = bli_obj_dt( c );
+
+	// B's micro-panels look like a row-stored matrix to the millikernels.
+	inc_t rs_a = bli_obj_has_notrans( a ) ? bli_obj_row_stride( a )
+	                                      : bli_obj_col_stride( a );
+	inc_t cs_a = bli_obj_has_notrans( a ) ? bli_obj_col_stride( a )
+	                                      : bli_obj_row_stride( a );
+
+	const stor3_t stor_id = bli_stor3_from_strides( bli_obj_row_stride( c ),
+	                                                bli_obj_col_stride( c ),
+	                                                rs_a, cs_a, params->ldp, 1 );
+
+	return stor_id != BLIS_XXX &&
+	       bli_cntx_get_l3_sup_ker_dt( dt, stor_id, cntx ) != NULL &&
+	       bli_cntx_get_l3_sup_blksz_def_dt( dt, BLIS_NR, cntx ) == params->pd;
+}
+
+static err_t bli_gemm_compute_sup
+     (
+       const obj_t*  alpha,
+       const obj_t*  a,
+       const obj_t*  bp,
+       const obj_t*  beta,
+       const obj_t*  c,
+       const cntx_t* cntx,
+             rntm_t* rntm
+     )
+{
+	#ifdef BLIS_DISABLE_SUP_HANDLING
+	return BLIS_FAILURE;
+	#endif
+
+	const gemm_pack_params_t* params = bli_obj_pack_params( bp );
+
+	const num_t dt = bli_obj_dt( c );
+	const dim_t m  = bli_obj_length( c );
+	const dim_t n  = bli_obj_width( c );
+	const dim_t k  = bli_obj_width_after_trans( a );
+
+	if ( !bli_rntm_l3_sup( rntm ) ||
+	     !bli_gemm_compute_sup_is_avail( a, bp, c, cntx ) )
+		return BLIS_FAILURE;
+
+	inc_t rs_a = bli_obj_has_notrans( a ) ? bli_obj_row_stride( a )
+	                                      : bli_obj_col_stride( a );
+	inc_t cs_a = bli_obj_has_notrans( a ) ? bli_obj_col_stride( a )
+	                                      : bli_obj_row_stride( a );
+
+	const stor3_t stor_id = bli_stor3_from_strides( bli_obj_row_stride( c ),
+	                                                bli_obj_col_stride( c ),
+	                                                rs_a, cs_a, params->ldp, 1 );
+
+	// Decide between sup and the conventional path the same way bli_gemmsup()
+	// does, except that the operation is never transposed here.
+	dim_t nt = bli_rntm_num_threads( rntm );
+	if ( nt < 1 ) nt = bli_rntm_calc_num_threads( rntm );
+
+	const supdec_t dec = bli_cntx_l3_sup_map_query
+	(
+	  BLIS_GEMM, dt, stor_id, m, n, k, bli_max( nt, 1 ), cntx
+	);
+
+	if ( dec == BLIS_SUP_MAP_CONV ) return BLIS_FAILURE;
+	if ( dec == BLIS_SUP_MAP_UNSET &&
+	     !bli_cntx_l3_sup_thresh_is_met( dt, m, n, k, cntx ) )
+		return BLIS_FAILURE;
+
+	bli_rntm_factorize_sup( dt, m, n, k, cntx, rntm );
+
+	return
+	bli_l3_sup_thread_decorator
+	(
+	  bli_gemm_compute_sup_int,
+	  BLIS_GEMM,
+	  alpha,
+	  a,
+	  bp,
+	  beta,
+	  c,
+	  cntx,
+	  rntm
+	);
+}
+
+// -----------------------------------------------------------------------------
+
+void bli_gemm_compute
+     (
+       const obj_t*  alpha,
+       const obj_t*  a,
+       const obj_t*  bp,
+       const obj_t*  beta,
+       const obj_t*  c
+     )
+{
+	bli_gemm_compute_ex( alpha, a, bp, beta, c, NULL, NULL );
+}
+
+void bli_gemm_compute_ex
+     (
+       const obj_t*  alpha,
+       const obj_t*  a,
+       const obj_t*  bp,
+       const obj_t*  beta,
+       const obj_t*  c,
+       const cntx_t* cntx,
+       const rntm_t* rntm
+     )
+{
+	bli_init_once();
+
+	// If C has a zero dimension, return early.
+	if ( bli_obj_has_zero_dim( c ) ) return;
+
+	// Check any post-ops that were requested.
+	const postops_t* postops = bli_l3_postops_query( rntm );
+	if ( postops != NULL && bli_error_checking_is_enabled() )
+		bli_l3_postops_check( c, postops );
+
+	// If alpha is zero, or if A or B has a zero dimension, scale C by beta
+	// (and apply any post-ops) and return early.
+	if ( bli_obj_equals( alpha, &BLIS_ZERO ) ||
+	     bli_obj_has_zero_dim( a ) ||
+	     bli_obj_has_zero_dim( bp ) )
+	{
+		bli_scalm( beta, c );
+		if ( postops != NULL )
+			bli_l3_postops_apply_obj
+			(
+			  FALSE, postops, c,
+			  cntx != NULL ? cntx : bli_gks_query_cntx()
+			);
+		return;
+	}
+
+	// Initialize a local runtime with global settings if necessary. Note
+	// that in the case that a runtime is passed in, we make a local copy.
+	rntm_t rntm_l;
+	if ( rntm == NULL ) { bli_rntm_init_from_global( &rntm_l ); }
+	else                { rntm_l = *rntm;                       }
+
+	// The micro-panels were packed for native execution.
+	if ( cntx == NULL ) cntx = bli_gks_query_cntx();
+
+	if ( bli_error_checking_is_enabled() )
+	{
+		const gemm_pack_params_t* params = bli_obj_pack_params( bp );
+		num_t                     dt     = bli_obj_dt( c );
+
+		bli_gemm_check( alpha, a, bp, beta, c, cntx );
+
+		if ( !bli_gemm_obj_is_prepacked( bp ) || params == NULL )
+			bli_check_error_code( BLIS_EXPECTED_NONNULL_OBJECT_BUFFER );
+
+		// Mixed-domain/precision computation, induced methods, and other
+		// blocksizes would all call for a different packed format than the
+		// one bli_gemm_pack() made.
+		bli_check_error_code( bli_check_consistent_object_datatypes( a, bp ) );
+		bli_check_error_code( bli_check_consistent_object_datatypes( c, bp ) );
+		if ( bli_obj_comp_prec( c ) != bli_obj_prec( c ) )
+			bli_check_error_code( BLIS_INCONSISTENT_PRECISIONS );
+		if ( bli_cntx_method( cntx ) != BLIS_NAT ||
+		     bli_cntx_get_blksz_def_dt( dt, BLIS_NR, cntx ) != params->pd ||
+		     bli_cntx_get_blksz_def_dt( dt, BLIS_KC, cntx ) != params->kc ||
+		     bli_cntx_get_blksz_max_dt( dt, BLIS_KC, cntx ) != params->kc_max ||
+		     bli_obj_has_trans( bp ) || bli_obj_has_conj( bp ) )
+			bli_check_error_code( BLIS_NOT_YET_IMPLEMENTED );
+	}
+
+	// Small problems are computed by the sup millikernels directly from the
+	// pre-packed B. If the problem is not deemed small (or the sup blocksizes
+	// do not match the packed format), proceed with the conventional code
+	// path, where bli_packm_prepacked() stands in for the packing of B.
+	if ( bli_gemm_compute_sup( alpha, a, bp, beta, c, cntx, &rntm_l ) == BLIS_SUCCESS )
+		return;
+
+	bli_gemm_front( alpha, a, bp, beta, c, cntx, &rntm_l );
+}
+
+// -----------------------------------------------------------------------------
+
+void bli_packm_prepacked
+     (
+       const obj_t*     c,
+             obj_t*     p,
+       const cntx_t*    cntx,
+       const cntl_t*    cntl,
+             thrinfo_t* thread
+     )
+{
+	const gemm_pack_params_t* params = bli_obj_pack_params( c );
+
+	// The pre-packed micro-panels can only stand in for B (that is, packed
+	// B^T), and then only if the block starts on a micro-panel boundary.
+	// bli_gemm_front() never swaps a pre-packed B into the role of A, and
+	// the n-dimension partitioning always proceeds in multiples of NR.
+	dim_t off_n = bli_obj_row_off( c );
+	dim_t off_k = bli_obj_col_off( c );
+
+	if ( bli_cntl_packm_params_bmid_m( cntl ) != BLIS_NR ||
+	     off_n % params->pd != 0 )
+		bli_check_error_code( BLIS_NOT_YET_IMPLEMENTED );
+
+	// Begin with the fields of C so that P inherits its dimensions and its
+	// attached scalar. As with packm_init, the scalar is applied later by
+	// the macro-kernel, not during packing.
+	bli_obj_alias_to( c, p );
+
+	dim_t m_p = bli_obj_length( p );
+	dim_t n_p = bli_obj_width( p );
+
+	bli_obj_set_pack_schema( bli_cntl_packm_params_pack_schema( cntl ), p );
+	bli_obj_set_conj( BLIS_NO_CONJUGATE, p );
+	bli_obj_set_uplo( BLIS_DENSE, p );
+	bli_obj_set_offs( 0, 0, p );
+	bli_obj_set_padded_dims( bli_align_dim_to_mult( m_p, params->pd ),
+	                         bli_align_dim_to_mult( n_p, params->kr ), p );
+
+	// Locate the block: find the KC block that holds it, and then skip the
+	// micro-panels above it and the columns that precede it.
+	inc_t ps;
+	char* buf = bli_gemm_pack_block( params, off_k, n_p, &ps );
+
+	if ( buf == NULL )
+		bli_check_error_code( BLIS_NOT_YET_IMPLEMENTED );
+
+	buf += ( off_n / params->pd ) * ps * bli_dt_size( params->dt );
+
+	bli_obj_set_buffer( buf, p );
+	bli_obj_set_strides( 1, params->ldp, p );
+	bli_obj_set_imag_stride( 1, p );
+	bli_obj_set_panel_dim( params->pd, p );
+	bli_obj_set_panel_stride( ps, p );
+	bli_obj_set_panel_length( params->pd, p );
+	bli_obj_set_panel_width( n_p, p );
+}
+
@@ -0,0 +1,142 @@
+/*
+
+   BLIS
+   An object-based framework for developing high-performance BLAS-like
+   libraries.
+
+   Copyright (C) 2014, The University of Texas at Austin
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are
+   met:
+    - Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    - Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    - Neither the name(s) of the copyright holder(s) nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+//
+// Pre-packed gemm operands.
+//
+// bli_gemm_pack() packs a matrix B once into the micro-panel format that
+// the gemm macro-kernel reads, and bli_gemm_compute() multiplies any number
+// of matrices A by that packed B without repacking it. The packed buffer
+// holds all of B as a sequence of KC blocks (partitioned along k exactly as
+// the blocked gemm variants partition it), each of which holds the NR-wide
+// micro-panels for the full n dimension. Thus, every KC x NC block that the
+// blocked variants visit, whatever the ways of parallelism, is a contiguous
+// range of micro-panels within the buffer. Since the buffer is never
+// written after bli_gemm_pack() returns, a single packed B may be shared
+// by concurrent bli_gemm_compute() calls from many application threads.
+//
+
+typedef struct
+{
+	num_t dt;     // storage datatype of the packed micro-panels
+	dim_t pd;     // panel dimension (NR)
+	inc_t ldp;    // leading dimension within a micro-panel (packed NR)
+	dim_t n_pan;  // number of micro-panels in each KC block
+	dim_t k;      // k dimension of B
+	dim_t kc;     // KC and its maximum as of packing; together they
+	dim_t kc_max; // determine the KC blocks along k
+	dim_t k_last; // offset of the final (possibly extended) KC block
+	dim_t kr;     // KR as of packing, to which each block is padded
+	void* buf;    // the packed micro-panels
+} gemm_pack_params_t;
+
+BLIS_EXPORT_BLIS void bli_gemm_pack
+     (
+       const obj_t*  b,
+             obj_t*  bp
+     );
+
+BLIS_EXPORT_BLIS void bli_gemm_pack_ex
+     (
+       const obj_t*  b,
+             obj_t*  bp,
+       const cntx_t* cntx
+     );
+
+BLIS_EXPORT_BLIS void bli_gemm_pack_free
+     (
+       obj_t* bp
+     );
+
+BLIS_EXPORT_BLIS void bli_gemm_compute
+     (
+       const obj_t*  alpha,
+       const obj_t*  a,
+       const obj_t*  bp,
+       const obj_t*  beta,
+       const obj_t*  c
+     );
+
+BLIS_EXPORT_BLIS void bli_gemm_compute_ex
+     (
+       const obj_t*  alpha,
+       const obj_t*  a,
+       const obj_t*  bp,
+       const obj_t*  beta,
+       const obj_t*  c,
+       const cntx_t* cntx,
+       const rntm_t* rntm
+     );
+
+// Compute with a pre-packed B using the sup millikernels, which is possible
+// only if bli_gemm_compute_sup_is_avail() returns TRUE. This is the thread
+// entry point of the small-problem path of bli_gemm_compute_ex(), exposed
+// so that callers with their own threads (e.g. bli_gemm_batch_ex()) may
+// invoke it with a single-threaded thrinfo_t.
+bool bli_gemm_compute_sup_is_avail
+     (
+       const obj_t*  a,
+       const obj_t*  bp,
+       const obj_t*  c,
+       const cntx_t* cntx
+     );
+
+err_t bli_gemm_compute_sup_int
+     (
+       const obj_t*     alpha,
+       const obj_t*     a,
+       const obj_t*     bp,
+       const obj_t*     beta,
+       const obj_t*     c,
+       const cntx_t*    cntx,
+       const rntm_t*    rntm,
+             thrinfo_t* thread
+     );
+
+// The packm variant installed as the pack_fn of a pre-packed object. Rather
+// than packing, it aliases the current block to its window in the buffer.
+void bli_packm_prepacked
+     (
+       const obj_t*     c,
+             obj_t*     p,
+       const cntx_t*    cntx,
+       const cntl_t*    cntl,
+             thrinfo_t* thread
+     );
+
+BLIS_INLINE bool bli_gemm_obj_is_prepacked( const obj_t* obj )
+{
+	return bli_obj_pack_fn( obj ) == bli_packm_prepacked;
+}
+
@@ -0,0 +1,190 @@
+/*
+
+   BLIS
+   An object-based framework for developing high-performance BLAS-like
+   libraries.
+
+   Copyright (C) 2014, The University of Texas at Austin
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are
+   met:
+    - Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    - Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    - Neither the name(s) of the copyright holder(s) nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "blis.h"
+
+// The fast path calls the sup millikernels, and so it is unavailable when
+// sup handling is disabled. It is also unavailable with a sandbox, which
+// supplies its own bli_gemm_ex().
+#if defined( BLIS_DISABLE_SUP_HANDLING ) || defined( BLIS_ENABLE_SANDBOX )
+static const bool bli_gemm_tiny_enabled = FALSE;
+#else
+static const bool bli_gemm_tiny_enabled = TRUE;
+#endif
+
+#undef  GENTFUNC
+#define GENTFUNC( ctype, ch, opname ) \
+\
+err_t PASTEMAC(ch,opname) \
+     ( \
+             trans_t transa, \
+             trans_t transb, \
+             dim_t   m, \
+             dim_t   n, \
+             dim_t   k, \
+       const ctype*  alpha, \
+       const ctype*  a, inc_t rs_a, inc_t cs_a, \
+       const ctype*  b, inc_t rs_b, inc_t cs_b, \
+       const ctype*  beta, \
+             ctype*  c, inc_t rs_c, inc_t cs_c, \
+       const cntx_t* cntx, \
+       const rntm_t* rntm  \
+     ) \
+{ \
+	if ( !bli_gemm_tiny_enabled ) return BLIS_FAILURE; \
+\
+	/* Leave empty problems, and those that only scale C by beta, to the
+	   object API. */ \
+	if ( m < 1 || n < 1 || k < 1 || PASTEMAC(ch,eq0)( *alpha ) ) \
+		return BLIS_FAILURE; \
+\
+	/* Honor a request to forgo sup handling, and leave workspaces and
+	   post-ops to the object API. */ \
+	if ( rntm != NULL && \
+	     ( !bli_rntm_l3_sup( rntm ) || \
+	       bli_rntm_workspace_buf( rntm ) != NULL || \
+	       bli_l3_postops_query( rntm ) != NULL ) ) return BLIS_FAILURE; \
+\
+	if ( cntx == NULL ) cntx = bli_gks_query_cntx(); \
+\
+	const num_t dt = PASTEMAC(ch,type); \
+	const dim_t tt = bli_cntx_get_blksz_def_dt( dt, BLIS_TT, cntx ); \
+\
+	if ( tt < m || tt < n || tt < k ) return BLIS_FAILURE; \
+\
+	/* Let the object API report any invalid strides. */ \
+	if ( bli_error_checking_is_enabled() ) \
+	{ \
+		dim_t m_a, n_a; \
+		dim_t m_b, n_b; \
+\
+		bli_set_dims_with_trans( transa, m, k, &m_a, &n_a ); \
+		bli_set_dims_with_trans( transb, k, n, &m_b, &n_b ); \
+\
+		if ( bli_check_matrix_strides( m_a, n_a, rs_a, cs_a, 1 ) != BLIS_SUCCESS || \
+		     bli_check_matrix_strides( m_b, n_b, rs_b, cs_b, 1 ) != BLIS_SUCCESS || \
+		     bli_check_matrix_strides( m,   n,   rs_c, cs_c, 1 ) != BLIS_SUCCESS ) \
+			return BLIS_FAILURE; \
+	} \
+\
+	conj_t conja = bli_extract_conj( transa ); \
+	conj_t conjb = bli_extract_conj( transb ); \
+\
+	if ( bli_does_trans( transa ) ) bli_swap_incs( &rs_a, &cs_a ); \
+	if ( bli_does_trans( transb ) ) bli_swap_incs( &rs_b, &cs_b ); \
+\
+	stor3_t stor_id = bli_stor3_from_strides( rs_c, cs_c, rs_a, cs_a, rs_b, cs_b ); \
+\
+	if ( stor_id == BLIS_XXX ) return BLIS_FAILURE; \
+\
+	/* Take only the problems that bli_gemmsup() would take: those for which
+	   the calibrated sup dispatch map (if any), queried for the one thread
+	   used here, does not prefer the conventional path, or, absent a
+	   decision from the map, those that meet the sup thresholds (after any
+	   microkernel preference-induced transposition). */ \
+	const supdec_t dec = bli_cntx_l3_sup_map_query \
+	( \
+	  BLIS_GEMM, dt, stor_id, m, n, k, 1, cntx \
+	); \
+\
+	if ( dec == BLIS_SUP_MAP_CONV ) return BLIS_FAILURE; \
+	if ( dec == BLIS_SUP_MAP_UNSET ) \
+	{ \
+		const bool ukr_prefers_rows = bli_cntx_ukr_prefers_rows_dt( dt, BLIS_GEMM_VIR_UKR, cntx ); \
+		const bool ukr_dislikes_c   = ukr_prefers_rows ? !bli_is_row_stored( rs_c, cs_c ) \
+		                                               : !bli_is_col_stored( rs_c, cs_c ); \
+\
+		if ( ukr_dislikes_c ? !bli_cntx_l3_sup_thresh_is_met( dt, n, m, k, cntx ) \
+		                    : !bli_cntx_l3_sup_thresh_is_met( dt, m, n, k, cntx ) ) \
+			return BLIS_FAILURE; \
+	} \
+\
+	/* As bli_gemmsup_int() does, compute C^T = B^T * A^T instead if the
+	   millikernel for this storage combination does not prefer it, so that
+	   the millikernel always iterates over m (as in var2m). */ \
+	const bool is_rrr_rrc_rcr_crr = ( stor_id == BLIS_RRR || \
+	                                  stor_id == BLIS_RRC || \
+	                                  stor_id == BLIS_RCR || \
+	                                  stor_id == BLIS_CRR ); \
+	const bool row_pref           = bli_cntx_ukr_prefers_rows_dt( dt, bli_stor3_ukr( stor_id ), cntx ); \
+\
+	if ( row_pref != is_rrr_rrc_rcr_crr ) \
+	{ \
+		      conj_t conjtmp = conja; conja = conjb; conjb = conjtmp; \
+		      dim_t  len_tmp =     m;     m =     n;     n = len_tmp; \
+		const ctype* buf_tmp =     a;     a =     b;     b = buf_tmp; \
+		      inc_t  str_tmp =  rs_a;  rs_a =  cs_b;  cs_b = str_tmp; \
+		             str_tmp =  cs_a;  cs_a =  rs_b;  rs_b = str_tmp; \
+		             str_tmp =  rs_c;  rs_c =  cs_c;  cs_c = str_tmp; \
+\
+		stor_id = bli_stor3_trans( stor_id ); \
+	} \
+\
+	gemmsup_ker_ft gemmsup_ker = bli_cntx_get_l3_sup_ker_dt( dt, stor_id, cntx ); \
+\
+	const dim_t    MR          = bli_cntx_get_l3_sup_blksz_def_dt( dt, BLIS_MR, cntx ); \
+	const dim_t    NR          = bli_cntx_get_l3_sup_blksz_def_dt( dt, BLIS_NR, cntx ); \
+\
+	/* Many configurations register no sup blocksizes (and thus cannot use
+	   the sup millikernels) for some or all datatypes. */ \
+	if ( gemmsup_ker == NULL || MR < 1 || NR < 1 ) return BLIS_FAILURE; \
+\
+	/* A is used in place, so its micropanels lie MR rows apart. */ \
+	auxinfo_t aux; \
+	bli_auxinfo_set_ps_a( MR * rs_a, &aux ); \
+\
+	for ( dim_t j = 0; j < n; j += NR ) \
+	{ \
+		gemmsup_ker \
+		( \
+		  conja, \
+		  conjb, \
+		  m, \
+		  bli_min( NR, n - j ), \
+		  k, \
+		  alpha, \
+		  a,          rs_a, cs_a, \
+		  b + j*cs_b, rs_b, cs_b, \
+		  beta, \
+		  c + j*cs_c, rs_c, cs_c, \
+		  &aux, \
+		  cntx  \
+		); \
+	} \
+\
+	return BLIS_SUCCESS; \
+}
+
+INSERT_GENTFUNC_BASIC( gemm_tiny )
+
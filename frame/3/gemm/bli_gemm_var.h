@@ -40,7 +40,13 @@
 
 typedef struct
 {
-	gemm_ukr_ft ukr;
+	gemm_ukr_ft      ukr;
+
+	// Post-ops to apply to each microtile of C once it has been computed,
+	// and whether the operation was transposed relative to the post-ops
+	// (in which case their row and column indices are swapped).
+	const postops_t* postops;
+	bool             postops_trans;
 } gemm_ker_params_t;
 
 
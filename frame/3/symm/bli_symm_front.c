@@ -135,6 +135,18 @@ void bli_symm_front
 	// Set the pack schemas within the objects.
 	bli_l3_set_schemas( &a_local, &b_local, &c_local, cntx );
 
+	// If only the total number of threads was requested, choose how many of
+	// them to use, and how, based on the size of the problem.
+	bli_rntm_factorize_model
+	(
+	  bli_obj_exec_dt( &c_local ),
+	  bli_obj_length( &c_local ),
+	  bli_obj_width( &c_local ),
+	  bli_obj_width( &a_local ),
+	  cntx,
+	  rntm
+	);
+
 	// Parse and interpret the contents of the rntm_t object to properly
 	// set the ways of parallelism for each loop, and then make any
 	// additional modifications necessary for the current operation.
@@ -137,6 +137,28 @@ void bli_apool_init
 	bli_pool_set_free_fp( NULL, pool );
 }
 
+siz_t bli_apool_elem_block_size( void )
+{
+	// Each small block pool should contain blocks large enough to
+	// accommodate any of the data structures for which they will be
+	// used.
+	const siz_t n_sizes        = 4;
+	siz_t       sizes[4]       = { sizeof( cntl_t ),
+	                               sizeof( packm_params_t ),
+	                               sizeof( thrcomm_t ),
+	                               sizeof( thrinfo_t ) };
+	siz_t       block_size     = 0;
+
+	// Find the largest of the sizes above and use that as the block_size
+	// for the pool.
+	for ( dim_t i = 0; i < n_sizes; ++i )
+	{
+		if ( block_size < sizes[i] ) block_size = sizes[i];
+	}
+
+	return block_size;
+}
+
 void bli_apool_alloc_block
      (
        siz_t     num_elem,
@@ -405,22 +427,7 @@ pool_t* bli_apool_array_elem
 		malloc_ft   malloc_fp      = BLIS_MALLOC_POOL;
 		free_ft     free_fp        = BLIS_FREE_POOL;
 
-		// Each small block pool should contain blocks large enough to
-		// accommodate any of the data structures for which they will be
-		// used.
-		const siz_t n_sizes        = 4;
-		siz_t       sizes[4]       = { sizeof( cntl_t ),
-		                               sizeof( packm_params_t ),
-		                               sizeof( thrcomm_t ),
-		                               sizeof( thrinfo_t ) };
-		siz_t       block_size     = 0;
-
-		// Find the largest of the sizes above and use that as the block_size
-		// for the pool.
-		for ( dim_t i = 0; i < n_sizes; ++i )
-		{
-			if ( block_size < sizes[i] ) block_size = sizes[i];
-		}
+		const siz_t block_size     = bli_apool_elem_block_size();
 
 		#ifdef BLIS_ENABLE_MEM_TRACING
 		printf( "bli_apool_array_elem(): pool_t for tid %d is NULL; allocating pool_t.\n",
@@ -563,3 +570,63 @@ void bli_apool_grow
 	bli_pool_set_num_blocks( num_blocks_new, pool );
 }
 
+void bli_apool_stats
+     (
+       apool_t*      apool,
+       dim_t*        num_arrays,
+       dim_t*        num_checked_out,
+       pool_stats_t* stats
+     )
+{
+	memset( stats, 0, sizeof( pool_stats_t ) );
+
+	// Acquire the apool_t's mutex.
+	bli_apool_lock( apool );
+
+	// ----------------------------------------------------------------------------
+
+	// Query the underlying pool_t from the apool_t.
+	pool_t*   pool       = bli_apool_pool( apool );
+	array_t** block_ptrs = bli_pool_block_ptrs( pool );
+
+	const siz_t num_blocks = bli_pool_num_blocks( pool );
+	const siz_t top_index  = bli_pool_top_index( pool );
+
+	*num_arrays      = num_blocks;
+	*num_checked_out = top_index;
+
+	// Accumulate the statistics of the pool_t's within the array_t's that
+	// are not checked out. (The array_t's that are checked out are owned by
+	// the threads that checked them out, and so we cannot inspect them.)
+	for ( dim_t i = top_index; i < num_blocks; ++i )
+	{
+		const siz_t    num_elem = bli_array_num_elem( block_ptrs[i] );
+		      pool_t** buf      = bli_array_buf( block_ptrs[i] );
+
+		for ( dim_t j = 0; j < num_elem; ++j )
+		{
+			pool_stats_t elem_stats;
+
+			if ( buf[j] == NULL ) continue;
+
+			bli_pool_stats( buf[j], &elem_stats );
+
+			stats->block_size             = bli_max( stats->block_size,
+			                                         elem_stats.block_size );
+			stats->num_blocks            += elem_stats.num_blocks;
+			stats->num_checked_out       += elem_stats.num_checked_out;
+			stats->size_reserved         += elem_stats.size_reserved;
+			stats->size_checked_out      += elem_stats.size_checked_out;
+			stats->peak_size_checked_out += elem_stats.peak_size_checked_out;
+			stats->num_grows             += elem_stats.num_grows;
+			stats->num_shrinks           += elem_stats.num_shrinks;
+			stats->num_reinits           += elem_stats.num_reinits;
+		}
+	}
+
+	// ----------------------------------------------------------------------------
+
+	// Release the apool_t's mutex.
+	bli_apool_unlock( apool );
+}
+
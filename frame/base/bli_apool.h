@@ -124,6 +124,16 @@ void bli_apool_grow
        apool_t* apool
      );
 
+void bli_apool_stats
+     (
+       apool_t*      apool,
+       dim_t*        num_arrays,
+       dim_t*        num_checked_out,
+       pool_stats_t* stats
+     );
+
+siz_t bli_apool_elem_block_size( void );
+
 void bli_apool_alloc_block
      (
        siz_t     num_elem,
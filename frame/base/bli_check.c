@@ -610,6 +610,28 @@ err_t bli_check_matrix_strides( dim_t m, dim_t n, inc_t rs, inc_t cs, inc_t is )
 	return e_val;
 }
 
+err_t bli_check_batch_stride( dim_t size, dim_t m, dim_t n, inc_t rs, inc_t cs, inc_t str )
+{
+	err_t e_val = BLIS_SUCCESS;
+
+	// Prohibit negative batch sizes.
+	if ( size < 0 )
+		return BLIS_NEGATIVE_DIMENSION;
+
+	// Members that are empty, or a lone member, cannot overlap.
+	if ( size <= 1 || m <= 0 || n <= 0 )
+		return e_val;
+
+	// Require consecutive members to be at least one member's extent apart,
+	// so that writing one member never touches another.
+	const inc_t extent = ( m - 1 ) * bli_abs( rs ) + ( n - 1 ) * bli_abs( cs ) + 1;
+
+	if ( bli_abs( str ) < extent )
+		return BLIS_OVERLAPPING_BATCH_MEMBERS;
+
+	return e_val;
+}
+
 // -- Structure-related checks -------------------------------------------------
 
 err_t bli_check_general_object( const obj_t* a )
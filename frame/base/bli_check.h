@@ -79,6 +79,7 @@ err_t bli_check_vector_dim_equals( const obj_t* a, dim_t n );
 err_t bli_check_object_diag_offset_equals( const obj_t* a, doff_t offset );
 
 err_t bli_check_matrix_strides( dim_t m, dim_t n, inc_t rs, inc_t cs, inc_t is );
+err_t bli_check_batch_stride( dim_t size, dim_t m, dim_t n, inc_t rs, inc_t cs, inc_t str );
 
 err_t bli_check_general_object( const obj_t* a );
 err_t bli_check_hermitian_object( const obj_t* a );
@@ -386,6 +386,342 @@ void bli_cntx_set_l3_sup_handlers( cntx_t* cntx, ... )
 
 // -----------------------------------------------------------------------------
 
+static void bli_cntx_set_cache_blksz
+     (
+       num_t    dt,
+       dim_t    bs,
+       dim_t    mult,
+       blksz_t* blksz
+     )
+{
+	const dim_t def = bli_blksz_get_def( dt, blksz );
+	const dim_t ext = bli_blksz_get_max( dt, blksz ) - def;
+
+	// Keep the derived blocksize within a factor of four of the registered
+	// value. This guards against implausible geometries (e.g. a virtualized
+	// L3 reported as hundreds of megabytes) while still letting the
+	// blocksizes track the cache sizes of the part at hand.
+	bs = bli_min( bs, 4 * def );
+	bs = bli_max( bs, def / 4 );
+
+	// Round the derived blocksize down to a whole multiple of mult. If the
+	// cache is too small to hold even one multiple, keep the registered
+	// value. Otherwise, preserve whatever extension of the maximum beyond
+	// the default was registered for edge cases.
+	bs = ( bs / mult ) * mult;
+
+	if ( bs < mult ) return;
+
+	bli_blksz_set_def( bs,                      dt, blksz );
+	bli_blksz_set_max( bs + bli_max( ext, 0 ), dt, blksz );
+}
+
+void bli_cntx_set_cache_blkszs( cntx_t* cntx )
+{
+	cpuid_cache_t l1, l2, l3;
+
+	// Derive the cache blocksizes KC, MC, and NC from the geometry of the
+	// cache hierarchy with the analytical model of Low et al. [1]:
+	//   - a kc x nr micropanel of B stays in L1 while mr x kc micropanels of
+	//     A stream through it, with one way left over for C;
+	//   - an mc x kc block of A fills L2, less one way and the ways occupied
+	//     by a micropanel of B;
+	//   - a kc x nc panel of B fills L3, less one way and the ways occupied
+	//     by the blocks of A of every core that shares it.
+	// The register blocksizes (and the multiples registered for MC, NC, and
+	// KC) are taken from the context as set by its initialization function,
+	// and any blocksize that cannot be derived keeps its registered value.
+	//
+	// [1] T. M. Low, F. D. Igual, T. M. Smith, E. S. Quintana-Orti.
+	//     "Analytical Modeling Is Enough for High-Performance BLIS."
+	//     ACM TOMS 43(2), 2016.
+
+	if ( !bli_cpuid_query_cache( 1, &l1 ) ) return;
+	if ( !bli_cpuid_query_cache( 2, &l2 ) ) return;
+
+	const bool has_l3 = bli_cpuid_query_cache( 3, &l3 );
+
+	const dim_t w1   = l1.assoc;
+	const dim_t w2   = l2.assoc;
+	const dim_t way1 = ( dim_t )l1.sets * l1.line;
+	const dim_t way2 = ( dim_t )l2.sets * l2.line;
+
+	for ( num_t dt = BLIS_DT_LO; dt <= BLIS_DT_HI; ++dt )
+	{
+		const dim_t mr = bli_cntx_get_blksz_def_dt( dt, BLIS_MR, cntx );
+		const dim_t nr = bli_cntx_get_blksz_def_dt( dt, BLIS_NR, cntx );
+		const dim_t dt_size = ( dim_t )bli_dt_size( dt );
+
+		if ( mr <= 0 || nr <= 0 || w1 < 2 || w2 < 2 ) continue;
+
+		dim_t mc_mult = bli_cntx_get_bmult_dt( dt, BLIS_MC, cntx );
+		dim_t nc_mult = bli_cntx_get_bmult_dt( dt, BLIS_NC, cntx );
+		dim_t kc_mult = bli_cntx_get_bmult_dt( dt, BLIS_KC, cntx );
+
+#ifndef BLIS_RELAX_MCNR_NCMR_CONSTRAINTS
+		// See the constraints verified in bli_gks_register_cntx().
+		mc_mult = bli_lcm( mc_mult, nr );
+		nc_mult = bli_lcm( nc_mult, mr );
+#endif
+
+		// L1: the ways given to the micropanel of A, out of those not
+		// reserved for C, in proportion mr : nr with B.
+		const dim_t ca_r = ( ( w1 - 1 ) * mr ) / ( mr + nr );
+		const dim_t kc   = ( ca_r * way1 ) / ( mr * dt_size );
+
+		if ( kc < kc_mult ) continue;
+
+		bli_cntx_set_cache_blksz( dt, kc, kc_mult, &cntx->blkszs[ BLIS_KC ] );
+
+		const dim_t kc_use = bli_cntx_get_blksz_def_dt( dt, BLIS_KC, cntx );
+
+		// L2: the ways left to the block of A.
+		const dim_t cb_r = ( kc_use * nr * dt_size + way2 - 1 ) / way2;
+		const dim_t ca_c = w2 - 1 - cb_r;
+
+		if ( ca_c > 0 )
+			bli_cntx_set_cache_blksz( dt, ( ca_c * way2 ) / ( kc_use * dt_size ),
+			                          mc_mult, &cntx->blkszs[ BLIS_MC ] );
+
+		if ( !has_l3 || l3.assoc < 2 ) continue;
+
+		const dim_t mc_use = bli_cntx_get_blksz_def_dt( dt, BLIS_MC, cntx );
+
+		// L3: the ways left to the panel of B. The number of cores sharing
+		// L3 is estimated as the ratio of its sharers to those of L2 (which
+		// accounts for SMT siblings).
+		const dim_t w3    = l3.assoc;
+		const dim_t way3  = ( dim_t )l3.sets * l3.line;
+		const dim_t cores = bli_max( 1, ( dim_t )( l3.sharing /
+		                                           bli_max( 1, l2.sharing ) ) );
+		const dim_t ca_3  = ( cores * mc_use * kc_use * dt_size + way3 - 1 ) / way3;
+		const dim_t cb_c  = w3 - 1 - ca_3;
+
+		if ( cb_c > 0 )
+			bli_cntx_set_cache_blksz( dt, ( cb_c * way3 ) / ( kc_use * dt_size ),
+			                          nc_mult, &cntx->blkszs[ BLIS_NC ] );
+	}
+}
+
+// -----------------------------------------------------------------------------
+
+// Record a "sup" line of a tuning profile (see bli_cntx_apply_tuning_file())
+// in the sup dispatch map of a context, allocating the map if needed. Return
+// FALSE if the line cannot be parsed.
+static bool bli_cntx_set_l3_sup_map_entry( const char* line, cntx_t* cntx )
+{
+	char      op_str[ 8 ], dt_str[ 2 ], stor_str[ 4 ], dec_str[ 8 ];
+	long long nt, m, n, k;
+
+	if ( sscanf( line, "%*s %7s %1s %3s %lld %lld %lld %lld %7s",
+	             op_str, dt_str, stor_str, &nt, &m, &n, &k, dec_str ) != 8 )
+		return FALSE;
+
+	dim_t op_i;
+	if      ( strcmp( op_str, "gemm"  ) == 0 ) op_i = 0;
+	else if ( strcmp( op_str, "gemmt" ) == 0 ) op_i = 1;
+	else return FALSE;
+
+	if ( strchr( "sdcz", dt_str[0] ) == NULL ) return FALSE;
+
+	num_t dt;
+	bli_param_map_char_to_blis_dt( dt_str[0], &dt );
+
+	// The storage combinations are enumerated in the order rrr, rrc, ...,
+	// ccc (see stor3_t), i.e. as the binary number with c as one.
+	if ( strlen( stor_str ) != 3 ) return FALSE;
+
+	dim_t stor_id = 0;
+	for ( int i = 0; i < 3; ++i )
+	{
+		if      ( stor_str[ i ] == 'c' ) stor_id = 2 * stor_id + 1;
+		else if ( stor_str[ i ] == 'r' ) stor_id = 2 * stor_id;
+		else return FALSE;
+	}
+
+	supdec_t dec;
+	if      ( strcmp( dec_str, "sup"  ) == 0 ) dec = BLIS_SUP_MAP_SUP;
+	else if ( strcmp( dec_str, "conv" ) == 0 ) dec = BLIS_SUP_MAP_CONV;
+	else return FALSE;
+
+	if ( nt < 1 || m < 1 || n < 1 || k < 1 ) return FALSE;
+
+	if ( cntx->l3_sup_map == NULL )
+	{
+		err_t r_val;
+		cntx->l3_sup_map = bli_calloc_intl( sizeof( sup_map_t ), &r_val );
+	}
+
+	cntx->l3_sup_map->dec[ op_i ]
+	                     [ dt ]
+	                     [ stor_id ]
+	                     [ bli_cntx_l3_sup_map_bucket( nt, 0, BLIS_SUP_MAP_NUM_NT ) ]
+	                     [ bli_cntx_l3_sup_map_bucket( m, BLIS_SUP_MAP_DIM_SHIFT, BLIS_SUP_MAP_NUM_DIM ) ]
+	                     [ bli_cntx_l3_sup_map_bucket( n, BLIS_SUP_MAP_DIM_SHIFT, BLIS_SUP_MAP_NUM_DIM ) ]
+	                     [ bli_cntx_l3_sup_map_bucket( k, BLIS_SUP_MAP_DIM_SHIFT, BLIS_SUP_MAP_NUM_DIM ) ]
+	                     = ( uint8_t )dec;
+
+	return TRUE;
+}
+
+void bli_cntx_free_l3_sup_map( cntx_t* cntx )
+{
+	// Free the sup dispatch map, if any, allocated when a tuning profile was
+	// applied to the context.
+	if ( cntx->l3_sup_map != NULL )
+	{
+		bli_free_intl( cntx->l3_sup_map );
+		cntx->l3_sup_map = NULL;
+	}
+}
+
+// The blocksizes that may be set from a tuning profile. Register blocksizes
+// are tied to the microkernels and therefore are not tunable.
+static struct
+{
+	const char* name;
+	bszid_t     bs_id;
+} tunable_blkszs[] =
+{
+	{ "MC",     BLIS_MC     },
+	{ "KC",     BLIS_KC     },
+	{ "NC",     BLIS_NC     },
+	{ "MT",     BLIS_MT     },
+	{ "NT",     BLIS_NT     },
+	{ "KT",     BLIS_KT     },
+	{ "TT",     BLIS_TT     },
+	{ "MC_SUP", BLIS_MC_SUP },
+	{ "KC_SUP", BLIS_KC_SUP },
+	{ "NC_SUP", BLIS_NC_SUP },
+};
+
+void bli_cntx_apply_tuning_file( const char* path, const char* arch, cntx_t* cntx )
+{
+	// Apply a tuning profile (as written by test/tune) over the blocksizes of
+	// a context. The profile is a text file of lines of the form
+	//
+	//   arch zen3
+	//   #        s      d      c      z
+	//   MC     144     72     72     36
+	//   KC     256    256    256    256
+	//
+	// where '#' starts a comment, and the values are given in the same order
+	// and with the same convention as bli_blksz_init_easy(): a value of zero
+	// (or less) leaves the corresponding blocksize untouched. Entries that
+	// follow an 'arch' line apply only to the context of the sub-configuration
+	// of that name; entries before any 'arch' line apply to every context. A
+	// cache blocksize must be a multiple of its registered multiple (e.g. MC
+	// of MR); any value that is not is skipped with a warning, as are lines
+	// that cannot be parsed.
+	//
+	// The profile may also carry entries of the sup dispatch map, one per
+	// calibrated problem, of the form
+	//
+	//   sup gemm d rcc 4 64 2048 2048 conv
+	//
+	// giving the operation (gemm or gemmt), datatype, storage of C, A, and B
+	// (r or c for each), number of threads, m, n, k, and the implementation
+	// that was faster there (sup or conv). Each entry decides for the
+	// buckets of the map (see sup_map_t) into which its sizes fall.
+
+	FILE* stream = fopen( path, "r" );
+
+	if ( stream == NULL )
+	{
+		fprintf( stderr, "libblis: could not open tuning file '%s'.\n", path );
+		return;
+	}
+
+	char line[ 256 ];
+	bool in_section = TRUE;
+	int  line_num   = 0;
+
+	while ( fgets( line, sizeof( line ), stream ) != NULL )
+	{
+		char      name[ 32 ];
+		long long v[ BLIS_NUM_FP_TYPES ];
+
+		++line_num;
+
+		char* comment = strchr( line, '#' );
+		if ( comment != NULL ) *comment = '\0';
+
+		if ( sscanf( line, "%31s", name ) != 1 ) continue;
+
+		if ( strcmp( name, "arch" ) == 0 )
+		{
+			char arch_name[ 32 ];
+
+			in_section = sscanf( line, "%*s %31s", arch_name ) == 1 &&
+			             strcmp( arch_name, arch ) == 0;
+			continue;
+		}
+
+		if ( !in_section ) continue;
+
+		if ( strcmp( name, "sup" ) == 0 )
+		{
+			if ( !bli_cntx_set_l3_sup_map_entry( line, cntx ) )
+				fprintf( stderr, "libblis: %s:%d: ignoring malformed entry.\n",
+				         path, line_num );
+			continue;
+		}
+
+		bszid_t bs_id = BLIS_NO_PART;
+
+		for ( size_t i = 0; i < sizeof( tunable_blkszs ) / sizeof( tunable_blkszs[0] ); ++i )
+			if ( strcmp( name, tunable_blkszs[ i ].name ) == 0 )
+				bs_id = tunable_blkszs[ i ].bs_id;
+
+		if ( bs_id == BLIS_NO_PART ||
+		     sscanf( line, "%*s %lld %lld %lld %lld",
+		             &v[ BLIS_FLOAT ],    &v[ BLIS_DOUBLE ],
+		             &v[ BLIS_SCOMPLEX ], &v[ BLIS_DCOMPLEX ] ) != 4 )
+		{
+			fprintf( stderr, "libblis: %s:%d: ignoring malformed entry.\n",
+			         path, line_num );
+			continue;
+		}
+
+		blksz_t* blksz = &cntx->blkszs[ bs_id ];
+		bszid_t  bm_id = cntx->bmults[ bs_id ];
+
+		for ( num_t dt = BLIS_DT_LO; dt <= BLIS_DT_HI; ++dt )
+		{
+			const dim_t bs = ( dim_t )v[ dt ];
+
+			if ( bs <= 0 ) continue;
+
+			// Thresholds are their own multiples and need not be checked, nor
+			// do blocksizes whose multiple was left unset (e.g. KR_SUP).
+			const dim_t mult = ( bm_id != bs_id
+			                     ? bli_max( bli_blksz_get_def( dt, &cntx->blkszs[ bm_id ] ), 1 )
+			                     : 1 );
+
+			if ( bs % mult != 0 )
+			{
+				fprintf( stderr, "libblis: %s:%d: ignoring %s = %ld, which is "
+				                 "not a multiple of %ld.\n",
+				         path, line_num, name, ( long )bs, ( long )mult );
+				continue;
+			}
+
+			// As with the cache blocksizes derived by
+			// bli_cntx_set_cache_blkszs(), keep any registered extension of
+			// the maximum beyond the default.
+			const dim_t ext = bli_blksz_get_max( dt, blksz ) -
+			                  bli_blksz_get_def( dt, blksz );
+
+			bli_blksz_set_def( bs,                      dt, blksz );
+			bli_blksz_set_max( bs + bli_max( ext, 0 ), dt, blksz );
+		}
+	}
+
+	fclose( stream );
+}
+
+// -----------------------------------------------------------------------------
+
 void bli_cntx_print( const cntx_t* cntx )
 {
 	dim_t i;
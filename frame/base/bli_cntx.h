@@ -43,15 +43,16 @@
 /*
 typedef struct cntx_s
 {
-	blksz_t   blkszs[ BLIS_NUM_BLKSZS ];
-	bszid_t   bmults[ BLIS_NUM_BLKSZS ];
+	blksz_t    blkszs[ BLIS_NUM_BLKSZS ];
+	bszid_t    bmults[ BLIS_NUM_BLKSZS ];
 
-	func_t    ukrs[ BLIS_NUM_UKRS ];
-	mbool_t   ukr_prefs[ BLIS_NUM_UKR_PREFS ];
+	func_t     ukrs[ BLIS_NUM_UKRS ];
+	mbool_t    ukr_prefs[ BLIS_NUM_UKR_PREFS ];
 
-	void_fp   l3_sup_handlers[ BLIS_NUM_LEVEL3_OPS ];
+	void_fp    l3_sup_handlers[ BLIS_NUM_LEVEL3_OPS ];
+	sup_map_t* l3_sup_map;
 
-	ind_t     method;
+	ind_t      method;
 
 } cntx_t;
 */
@@ -183,6 +184,32 @@ BLIS_INLINE bool bli_cntx_l3_sup_thresh_is_met( num_t dt, dim_t m, dim_t n, dim_
 	return FALSE;
 }
 
+BLIS_INLINE dim_t bli_cntx_l3_sup_map_bucket( dim_t x, dim_t shift, dim_t n_bkts )
+{
+	// Return floor( log2( x ) ) - shift, clamped to [ 0, n_bkts ).
+	dim_t b = -shift;
+
+	for ( ; x > 1 && b < n_bkts - 1; x >>= 1 ) ++b;
+
+	return bli_max( b, 0 );
+}
+
+BLIS_INLINE supdec_t bli_cntx_l3_sup_map_query( opid_t op, num_t dt, stor3_t stor_id, dim_t m, dim_t n, dim_t k, dim_t nt, const cntx_t* cntx )
+{
+	const sup_map_t* map = cntx->l3_sup_map;
+
+	if ( map == NULL || stor_id == BLIS_XXX ) return BLIS_SUP_MAP_UNSET;
+	if ( op != BLIS_GEMM && op != BLIS_GEMMT ) return BLIS_SUP_MAP_UNSET;
+
+	return ( supdec_t )map->dec[ op == BLIS_GEMMT ? 1 : 0 ]
+	                           [ dt ]
+	                           [ stor_id ]
+	                           [ bli_cntx_l3_sup_map_bucket( nt, 0, BLIS_SUP_MAP_NUM_NT ) ]
+	                           [ bli_cntx_l3_sup_map_bucket( m, BLIS_SUP_MAP_DIM_SHIFT, BLIS_SUP_MAP_NUM_DIM ) ]
+	                           [ bli_cntx_l3_sup_map_bucket( n, BLIS_SUP_MAP_DIM_SHIFT, BLIS_SUP_MAP_NUM_DIM ) ]
+	                           [ bli_cntx_l3_sup_map_bucket( k, BLIS_SUP_MAP_DIM_SHIFT, BLIS_SUP_MAP_NUM_DIM ) ];
+}
+
 // -----------------------------------------------------------------------------
 
 BLIS_INLINE void_fp bli_cntx_get_l3_sup_handler( opid_t op, const cntx_t* cntx )
@@ -353,6 +380,10 @@ BLIS_EXPORT_BLIS void bli_cntx_set_ind_blkszs( ind_t method, num_t dt, cntx_t* c
 BLIS_EXPORT_BLIS void bli_cntx_set_ukrs( cntx_t* cntx, ... );
 BLIS_EXPORT_BLIS void bli_cntx_set_ukr_prefs( cntx_t* cntx, ... );
 
+BLIS_EXPORT_BLIS void bli_cntx_set_cache_blkszs( cntx_t* cntx );
+BLIS_EXPORT_BLIS void bli_cntx_apply_tuning_file( const char* path, const char* arch, cntx_t* cntx );
+BLIS_EXPORT_BLIS void bli_cntx_free_l3_sup_map( cntx_t* cntx );
+
 BLIS_EXPORT_BLIS void bli_cntx_print( const cntx_t* cntx );
 
 BLIS_EXPORT_BLIS void bli_cntx_set_l3_sup_handlers( cntx_t* cntx, ... );
@@ -67,6 +67,11 @@
   // is normally defined in bli_config_macro_defs.h.)
   #define BLIS_EXPORT_BLIS
 
+  // Some of the structures defined in bli_type_defs.h are sized by the cache
+  // line size and the maximum number of NUMA nodes. (This header is normally
+  // included via bli_config_macro_defs.h.)
+  #include "bli_mem_macro_defs.h"
+
   #include "bli_system.h"
   #include "bli_type_defs.h"
   #include "bli_arch.h"
@@ -1372,3 +1377,182 @@ char* find_string_in( char* target, char* buffer, size_t buf_len, char* filepath
 
 #endif
 
+
+// -----------------------------------------------------------------------------
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386) || defined(_M_IX86)
+
+static bool bli_cpuid_query_cache_leaf( uint32_t level, cpuid_cache_t* cache )
+{
+	uint32_t eax, ebx, ecx, edx;
+	uint32_t family, model, features;
+	uint32_t leaf;
+
+	// Intel enumerates its deterministic cache parameters via leaf 4, and
+	// AMD via leaf 0x8000001D (which is only valid if the topology extensions
+	// are advertised in cpuid[eax=0x80000001]:ecx[22]). Both leaves share the
+	// same register layout.
+	uint32_t vendor = bli_cpuid_query( &family, &model, &features );
+
+	if ( vendor == VENDOR_INTEL )
+	{
+		if ( __get_cpuid_max( 0, 0 ) < 4 ) return FALSE;
+		leaf = 4;
+	}
+	else if ( vendor == VENDOR_AMD )
+	{
+		if ( __get_cpuid_max( 0x80000000u, 0 ) < 0x8000001Du ) return FALSE;
+		__cpuid( 0x80000001u, eax, ebx, ecx, edx );
+		if ( !bli_cpuid_has_features( ecx, ( 1u<<22 ) ) ) return FALSE;
+		leaf = 0x8000001Du;
+	}
+	else return FALSE;
+
+	for ( uint32_t i = 0; i < 32; ++i )
+	{
+		__cpuid_count( leaf, i, eax, ebx, ecx, edx );
+
+		// Cache type is given by eax[4:0]: 0 = no more caches, 1 = data,
+		// 2 = instruction, 3 = unified. The cache level is given by eax[7:5].
+		const uint32_t type = ( eax      ) & 0x1f;
+		const uint32_t lvl  = ( eax >> 5 ) & 0x07;
+
+		if ( type == 0 ) break;
+		if ( type == 2 || lvl != level ) continue;
+
+		const uint32_t ways  = ( ( ebx >> 22 ) & 0x3ff ) + 1;
+		const uint32_t parts = ( ( ebx >> 12 ) & 0x3ff ) + 1;
+		const uint32_t line  = ( ( ebx       ) & 0xfff ) + 1;
+		const uint32_t sets  = ecx + 1;
+
+		cache->line    = line;
+		cache->size    = ways * parts * line * sets;
+		cache->sharing = ( ( eax >> 14 ) & 0xfff ) + 1;
+
+		// A fully associative cache (eax[9]) is modeled as a single set.
+		if ( eax & ( 1u<<9 ) )
+		{
+			cache->assoc = cache->size / line;
+			cache->sets  = 1;
+		}
+		else
+		{
+			cache->assoc = ways * parts;
+			cache->sets  = sets;
+		}
+
+		return TRUE;
+	}
+
+	return FALSE;
+}
+
+#endif
+
+#ifdef __linux__
+
+static bool bli_cpuid_sysfs_read( uint32_t index, const char* name, char* buf, size_t len )
+{
+	char path[ 128 ];
+
+	snprintf( path, sizeof( path ),
+	          "/sys/devices/system/cpu/cpu0/cache/index%u/%s",
+	          ( unsigned )index, name );
+
+	FILE* stream = fopen( path, "r" );
+	if ( stream == NULL ) return FALSE;
+
+	char* r_val = fgets( buf, len, stream );
+
+	fclose( stream );
+
+	return r_val != NULL;
+}
+
+static uint32_t bli_cpuid_sysfs_read_uint( uint32_t index, const char* name )
+{
+	char buf[ 64 ];
+
+	if ( !bli_cpuid_sysfs_read( index, name, buf, sizeof( buf ) ) ) return 0;
+
+	// Sizes are reported with a unit suffix, e.g. "32K".
+	char*         end;
+	unsigned long val = strtoul( buf, &end, 10 );
+
+	if      ( *end == 'K' ) val *= 1024;
+	else if ( *end == 'M' ) val *= 1024 * 1024;
+
+	return ( uint32_t )val;
+}
+
+static bool bli_cpuid_query_cache_sysfs( uint32_t level, cpuid_cache_t* cache )
+{
+	char buf[ 1024 ];
+
+	for ( uint32_t i = 0; i < 16; ++i )
+	{
+		if ( !bli_cpuid_sysfs_read( i, "type", buf, sizeof( buf ) ) ) break;
+
+		if ( strncmp( buf, "Instruction", 11 ) == 0 ) continue;
+		if ( bli_cpuid_sysfs_read_uint( i, "level" ) != level ) continue;
+
+		cache->size  = bli_cpuid_sysfs_read_uint( i, "size" );
+		cache->assoc = bli_cpuid_sysfs_read_uint( i, "ways_of_associativity" );
+		cache->line  = bli_cpuid_sysfs_read_uint( i, "coherency_line_size" );
+		cache->sets  = bli_cpuid_sysfs_read_uint( i, "number_of_sets" );
+
+		if ( cache->size == 0 || cache->line == 0 ) return FALSE;
+
+		// Some kernels omit the geometry for certain caches; fill in what
+		// can be inferred from the capacity.
+		if ( cache->assoc == 0 && cache->sets != 0 )
+			cache->assoc = cache->size / ( cache->sets * cache->line );
+		if ( cache->assoc == 0 )
+			cache->assoc = 1;
+		if ( cache->sets == 0 )
+			cache->sets = cache->size / ( cache->assoc * cache->line );
+
+		// Count the processors sharing this cache from the hex mask in
+		// shared_cpu_map, e.g. "00000000,000000ff".
+		cache->sharing = 0;
+		if ( bli_cpuid_sysfs_read( i, "shared_cpu_map", buf, sizeof( buf ) ) )
+		{
+			for ( char* c = buf; *c != '\0'; ++c )
+			{
+				if ( !isxdigit( ( unsigned char )*c ) ) continue;
+				const uint32_t d = isdigit( ( unsigned char )*c )
+				                   ? ( uint32_t )( *c - '0' )
+				                   : ( uint32_t )( tolower( ( unsigned char )*c ) - 'a' + 10 );
+				cache->sharing += __builtin_popcount( d );
+			}
+		}
+		if ( cache->sharing == 0 ) cache->sharing = 1;
+
+		return TRUE;
+	}
+
+	return FALSE;
+}
+
+#endif
+
+bool bli_cpuid_query_cache( uint32_t level, cpuid_cache_t* cache )
+{
+	// Query the geometry of the level-'level' data (or unified) cache as seen
+	// by the calling processor, returning FALSE if it cannot be determined.
+	// On x86 we ask the processor directly; elsewhere, or if that fails, we
+	// fall back to what the Linux kernel reports in sysfs.
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386) || defined(_M_IX86)
+	if ( bli_cpuid_query_cache_leaf( level, cache ) ) return TRUE;
+#endif
+
+#ifdef __linux__
+	if ( bli_cpuid_query_cache_sysfs( level, cache ) ) return TRUE;
+#endif
+
+	( void )level;
+	( void )cache;
+
+	return FALSE;
+}
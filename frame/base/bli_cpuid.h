@@ -80,6 +80,19 @@ bool bli_cpuid_is_cortexa9( uint32_t model, uint32_t part, uint32_t features );
 
 uint32_t bli_cpuid_query( uint32_t* family, uint32_t* model, uint32_t* features );
 
+// The geometry of one level of the data cache hierarchy, as reported by
+// bli_cpuid_query_cache().
+typedef struct
+{
+	uint32_t size;    // total capacity, in bytes
+	uint32_t assoc;   // ways of associativity
+	uint32_t line;    // line size, in bytes
+	uint32_t sets;    // number of sets
+	uint32_t sharing; // number of logical processors sharing the cache
+} cpuid_cache_t;
+
+bool bli_cpuid_query_cache( uint32_t level, cpuid_cache_t* cache );
+
 // -----------------------------------------------------------------------------
 
 //
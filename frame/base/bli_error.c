@@ -112,6 +112,10 @@ static const char *bli_error_string[-BLIS_ERROR_CODE_MAX] =
 	[-BLIS_NC_MAX_NONMULTIPLE_OF_NR]             = "Maximum NC is non-multiple of NR for one or more datatypes.",
 	[-BLIS_KC_DEF_NONMULTIPLE_OF_KR]             = "Default KC is non-multiple of KR for one or more datatypes.",
 	[-BLIS_KC_MAX_NONMULTIPLE_OF_KR]             = "Maximum KC is non-multiple of KR for one or more datatypes.",
+
+	[-BLIS_EXHAUSTED_POSTOPS]                    = "Attempted to append more than BLIS_POSTOPS_MAX post-ops to a postops_t.",
+
+	[-BLIS_OVERLAPPING_BATCH_MEMBERS]            = "Stride between batch members is too small; the output matrices of the members overlap.",
 };
 
 // -----------------------------------------------------------------------------
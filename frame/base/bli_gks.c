@@ -290,9 +290,13 @@ void bli_gks_finalize( void )
 				{
 					cntx_t* gks_id_ind = gks_id[ ind ];
 
-					// If the current context was allocated, free it.
+					// If the current context was allocated, free it. The
+					// induced method contexts share the sup dispatch map
+					// (if any) of the native context, which owns it.
 					if ( gks_id_ind != NULL )
 					{
+						if ( ind == BLIS_NAT ) bli_cntx_free_l3_sup_map( gks_id_ind );
+
 						#ifdef BLIS_ENABLE_MEM_TRACING
 						printf( "bli_gks_finalize(): cntx for ind_t %d: ", ( int )ind );
 						#endif
@@ -481,6 +485,17 @@ void bli_gks_register_cntx
 	// allocated array corresponding to native execution.
 	f( gks_id_nat );
 
+	// Optionally replace the registered cache blocksizes with values derived
+	// from the cache hierarchy of the processor we are running on.
+	if ( bli_env_get_var( "BLIS_CACHE_BLKSZ", BLIS_CACHE_BLKSZ_DEFAULT ) != 0 )
+		bli_cntx_set_cache_blkszs( gks_id_nat );
+
+	// Apply a tuning profile, if one was given, over the registered (or
+	// derived) blocksizes, along with any sup dispatch map it carries.
+	const char* tuning_file = bli_env_get_str( "BLIS_TUNING_FILE" );
+	if ( tuning_file != NULL && tuning_file[0] != '\0' )
+		bli_cntx_apply_tuning_file( tuning_file, bli_arch_string( id ), gks_id_nat );
+
 	// Verify that cache blocksizes are whole multiples of register blocksizes.
 	// Specifically, verify that:
 	//   - MC is a whole multiple of MR.
@@ -0,0 +1,209 @@
+/*
+
+   BLIS
+   An object-based framework for developing high-performance BLAS-like
+   libraries.
+
+   Copyright (C) 2014, The University of Texas at Austin
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are
+   met:
+    - Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    - Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    - Neither the name of The University of Texas nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+// Define _GNU_SOURCE so that MAP_ANONYMOUS, MAP_HUGETLB, and MADV_HUGEPAGE
+// are declared.
+#ifdef __linux__
+  #ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+  #endif
+#endif
+
+#include "blis.h"
+
+#if defined(BLIS_OS_LINUX)
+  #include <sys/mman.h>
+#endif
+
+// Each block handed out by the functions below is preceded by a header that
+// records how the block was obtained, so that bli_hugepage_free() knows how
+// to release it. The header occupies a full cache line so that the address
+// returned to the caller is at least as aligned as one returned by malloc().
+typedef struct
+{
+	void*  base;
+	size_t map_size;
+
+} hpg_header_t;
+
+#define BLIS_HUGEPAGE_HEADER_SIZE  64
+
+// -----------------------------------------------------------------------------
+
+hpg_t bli_hugepage_query_mode( void )
+{
+	// The BLIS_HUGEPAGES environment variable overrides the mode chosen at
+	// configure-time: 0 disables huge pages, 1 selects transparent huge
+	// pages, and 2 selects hugetlbfs pages (with fallback to 1).
+	gint_t mode = bli_env_get_var( "BLIS_HUGEPAGES", BLIS_HUGEPAGES_DEFAULT );
+
+	if ( mode < 0 || BLIS_NUM_HUGEPAGE_MODES <= mode )
+		mode = BLIS_HUGEPAGES_NONE;
+
+	return ( hpg_t )mode;
+}
+
+void bli_hugepage_query_fps
+     (
+       hpg_t      mode,
+       malloc_ft* malloc_fp,
+       free_ft*   free_fp
+     )
+{
+	if      ( mode == BLIS_HUGEPAGES_THP )
+	{
+		*malloc_fp = bli_hugepage_malloc_thp;
+		*free_fp   = bli_hugepage_free;
+	}
+	else if ( mode == BLIS_HUGEPAGES_HUGETLB )
+	{
+		*malloc_fp = bli_hugepage_malloc_hugetlb;
+		*free_fp   = bli_hugepage_free;
+	}
+	else
+	{
+		*malloc_fp = BLIS_MALLOC_POOL;
+		*free_fp   = BLIS_FREE_POOL;
+	}
+}
+
+// -----------------------------------------------------------------------------
+
+static void* bli_hugepage_finish
+     (
+       void*  base,
+       size_t map_size
+     )
+{
+	hpg_header_t* header = base;
+
+	header->base     = base;
+	header->map_size = map_size;
+
+	return ( char* )base + BLIS_HUGEPAGE_HEADER_SIZE;
+}
+
+static void* bli_hugepage_malloc_fallback( size_t size )
+{
+	void* base = BLIS_MALLOC_POOL( size + BLIS_HUGEPAGE_HEADER_SIZE );
+
+	if ( base == NULL ) return NULL;
+
+	// A map size of zero marks a block that came from BLIS_MALLOC_POOL.
+	return bli_hugepage_finish( base, 0 );
+}
+
+void* bli_hugepage_malloc_thp( size_t size )
+{
+#if defined(BLIS_OS_LINUX) && defined(MADV_HUGEPAGE)
+
+	const size_t hp_size  = BLIS_HUGEPAGE_SIZE;
+	const size_t map_size = ( size + BLIS_HUGEPAGE_HEADER_SIZE + hp_size - 1 )
+	                        / hp_size * hp_size;
+
+	// Over-allocate by one huge page so that we can trim the mapping down to
+	// one that starts on a huge page boundary. Only huge page-aligned ranges
+	// can be backed by huge pages, so this way no part of the block is left
+	// in base pages.
+	const size_t raw_size = map_size + hp_size;
+
+	char* raw = mmap( NULL, raw_size, PROT_READ | PROT_WRITE,
+	                  MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+
+	if ( raw == MAP_FAILED ) return bli_hugepage_malloc_fallback( size );
+
+	char*  base = ( char* )( ( ( uintptr_t )raw + hp_size - 1 ) / hp_size * hp_size );
+	size_t head = base - raw;
+	size_t tail = raw_size - head - map_size;
+
+	if ( head > 0 ) munmap( raw, head );
+	if ( tail > 0 ) munmap( base + map_size, tail );
+
+	// The advice is only a hint; if the kernel has transparent huge pages
+	// disabled, the block is simply backed by base pages.
+	madvise( base, map_size, MADV_HUGEPAGE );
+
+	return bli_hugepage_finish( base, map_size );
+
+#else
+
+	return bli_hugepage_malloc_fallback( size );
+
+#endif
+}
+
+void* bli_hugepage_malloc_hugetlb( size_t size )
+{
+#if defined(BLIS_OS_LINUX) && defined(MAP_HUGETLB)
+
+	const size_t hp_size  = BLIS_HUGEPAGE_SIZE;
+	const size_t map_size = ( size + BLIS_HUGEPAGE_HEADER_SIZE + hp_size - 1 )
+	                        / hp_size * hp_size;
+
+	// Huge pages are reserved when the mapping is created, so this fails
+	// up front (rather than at first touch) if too few huge pages were set
+	// aside via /proc/sys/vm/nr_hugepages. In that case, fall back to
+	// transparent huge pages.
+	void* base = mmap( NULL, map_size, PROT_READ | PROT_WRITE,
+	                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0 );
+
+	if ( base == MAP_FAILED ) return bli_hugepage_malloc_thp( size );
+
+	return bli_hugepage_finish( base, map_size );
+
+#else
+
+	return bli_hugepage_malloc_thp( size );
+
+#endif
+}
+
+void bli_hugepage_free( void* p )
+{
+	if ( p == NULL ) return;
+
+	hpg_header_t* header = ( hpg_header_t* )( ( char* )p - BLIS_HUGEPAGE_HEADER_SIZE );
+
+	if ( header->map_size == 0 )
+	{
+		BLIS_FREE_POOL( header->base );
+		return;
+	}
+
+#if defined(BLIS_OS_LINUX)
+	munmap( header->base, header->map_size );
+#endif
+}
+
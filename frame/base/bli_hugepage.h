@@ -0,0 +1,63 @@
+/*
+
+   BLIS
+   An object-based framework for developing high-performance BLAS-like
+   libraries.
+
+   Copyright (C) 2014, The University of Texas at Austin
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are
+   met:
+    - Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    - Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    - Neither the name of The University of Texas nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef BLIS_HUGEPAGE_H
+#define BLIS_HUGEPAGE_H
+
+// Huge-page backed allocation used by the packing block allocator (pba) so
+// that the microkernels stream packed blocks of A and B through fewer TLB
+// entries.
+
+// The huge page size for which blocks are aligned and padded. This matches
+// the default huge page size on x86_64 and aarch64 Linux.
+#ifndef BLIS_HUGEPAGE_SIZE
+#define BLIS_HUGEPAGE_SIZE  ( 2 * 1024 * 1024 )
+#endif
+
+hpg_t bli_hugepage_query_mode( void );
+
+void  bli_hugepage_query_fps
+     (
+       hpg_t      mode,
+       malloc_ft* malloc_fp,
+       free_ft*   free_fp
+     );
+
+void* bli_hugepage_malloc_thp( size_t size );
+void* bli_hugepage_malloc_hugetlb( size_t size );
+void  bli_hugepage_free( void* p );
+
+#endif
+
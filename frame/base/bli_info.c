@@ -196,6 +196,22 @@ gint_t bli_info_get_enable_memkind( void )
 	return 0;
 #endif
 }
+gint_t bli_info_get_enable_libnuma( void )
+{
+#ifdef BLIS_ENABLE_LIBNUMA
+	return 1;
+#else
+	return 0;
+#endif
+}
+gint_t bli_info_get_enable_hugepages( void )
+{
+#ifdef BLIS_ENABLE_HUGEPAGES
+	return 1;
+#else
+	return 0;
+#endif
+}
 gint_t bli_info_get_enable_sandbox( void )
 {
 #ifdef BLIS_ENABLE_SANDBOX
@@ -47,6 +47,51 @@ void bli_finalize( void )
 	bli_finalize_once();
 }
 
+void bli_init_prewarm( dim_t nt, dim_t dt_mask )
+{
+	bli_init_once();
+
+	// Prepare to use nt threads, all of them in the jc loop so that each
+	// thread packs its own block of A and panel of B below.
+	rntm_t rntm;
+	bli_rntm_init_from_global( &rntm );
+	bli_rntm_set_ways( bli_max( nt, 1 ), 1, 1, 1, 1, &rntm );
+	bli_rntm_disable_l3_sup( &rntm );
+
+	nt = bli_rntm_num_threads( &rntm );
+
+	// Have each thread fault in a block of A and a panel of B, leaving the
+	// pools with one block of each per thread.
+	bli_pba_prewarm( bli_pba_query(), &rntm );
+
+	// Perform a gemm of order 16*nt with nt threads in each datatype whose
+	// bit is set in dt_mask (i.e., bit dt for each num_t dt), which costs
+	// 2*(16*nt)^3 flops per datatype. This sets up the contexts
+	// (including those of induced methods), the threads, the small block
+	// allocator's pools, and the default control trees and thrinfo_t
+	// skeletons that later operations will use.
+	for ( num_t dt = BLIS_DT_LO; dt <= BLIS_DT_HI; ++dt )
+	{
+		if ( ( dt_mask & ( 1 << dt ) ) == 0 ) continue;
+
+		const dim_t mnk = 16 * nt;
+
+		obj_t a, b, c;
+		bli_obj_create( dt, mnk, mnk, 0, 0, &a );
+		bli_obj_create( dt, mnk, mnk, 0, 0, &b );
+		bli_obj_create( dt, mnk, mnk, 0, 0, &c );
+		bli_setm( &BLIS_ZERO, &a );
+		bli_setm( &BLIS_ZERO, &b );
+		bli_setm( &BLIS_ZERO, &c );
+
+		bli_gemm_ex( &BLIS_ONE, &a, &b, &BLIS_ZERO, &c, NULL, &rntm );
+
+		bli_obj_free( &a );
+		bli_obj_free( &b );
+		bli_obj_free( &c );
+	}
+}
+
 // -----------------------------------------------------------------------------
 
 void bli_init_auto( void )
@@ -68,7 +113,10 @@ static bli_pthread_switch_t lib_state = BLIS_PTHREAD_SWITCH_INIT;
 
 void bli_init_once( void )
 {
-	bli_pthread_switch_on( &lib_state, bli_init_apis );
+	// Pre-warm BLIS, if requested via the environment, each time it is
+	// initialized. Since pre-warming calls BLIS (and thus bli_init_once())
+	// itself, it is done only once the switch is on and its lock released.
+	bli_pthread_switch_on_post( &lib_state, bli_init_apis, bli_init_prewarm_env );
 }
 
 void bli_finalize_once( void )
@@ -90,9 +138,23 @@ int bli_init_apis( void )
 	return 0;
 }
 
+void bli_init_prewarm_env( void )
+{
+	// BLIS_PREWARM gives the number of threads for which to pre-warm (zero
+	// disables pre-warming) and BLIS_PREWARM_DT the mask of datatypes, as
+	// for bli_init_prewarm().
+	const dim_t nt      = bli_env_get_var( "BLIS_PREWARM", 0 );
+	const dim_t dt_mask = bli_env_get_var( "BLIS_PREWARM_DT",
+	                                       ( 1 << BLIS_NUM_FP_TYPES ) - 1 );
+
+	if ( nt > 0 ) bli_init_prewarm( nt, dt_mask );
+}
+
 int bli_finalize_apis( void )
 {
 	// Finalize various sub-APIs.
+	bli_l3_thrinfo_finalize();
+	bli_l3_cntl_finalize();
 	bli_memsys_finalize();
 	bli_pack_finalize();
 	bli_thread_finalize();
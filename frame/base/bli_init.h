@@ -35,12 +35,16 @@
 BLIS_EXPORT_BLIS void bli_init( void );
 BLIS_EXPORT_BLIS void bli_finalize( void );
 
+BLIS_EXPORT_BLIS void bli_init_prewarm( dim_t nt, dim_t dt_mask );
+
 void bli_init_auto( void );
 void bli_finalize_auto( void );
 
 void bli_init_once( void );
 void bli_finalize_once( void );
 
+void bli_init_prewarm_env( void );
+
 int  bli_init_apis( void );
 int  bli_finalize_apis( void );
 
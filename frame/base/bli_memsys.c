@@ -60,3 +60,32 @@ void bli_memsys_finalize( void )
 	bli_pba_finalize();
 }
 
+void bli_memsys_trim( void )
+{
+	// Initialize BLIS if necessary so that we never operate on pools that
+	// were finalized.
+	bli_init_once();
+
+	// Free the blocks in the packing block allocator's pools that are not
+	// currently checked out. The pools grow again on demand.
+	bli_pba_trim( bli_pba_query() );
+}
+
+void bli_memsys_stats( memsys_stats_t* stats )
+{
+	bli_init_once();
+
+	// Take a snapshot of the packing block allocator's pools, followed by
+	// one of the small block allocator's pools. Each is consistent on its
+	// own, but the two are not taken atomically with respect to each other.
+	bli_pba_stats( bli_pba_query(), stats );
+
+	bli_apool_stats
+	(
+	  bli_sba_query(),
+	  &(stats->sba_num_arrays),
+	  &(stats->sba_num_checked_out),
+	  &(stats->sba)
+	);
+}
+
@@ -42,6 +42,9 @@
 void bli_memsys_init( void );
 void bli_memsys_finalize( void );
 
+BLIS_EXPORT_BLIS void bli_memsys_trim( void );
+BLIS_EXPORT_BLIS void bli_memsys_stats( memsys_stats_t* stats );
+
 
 #endif
 
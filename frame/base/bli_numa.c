@@ -0,0 +1,217 @@
+/*
+
+   BLIS
+   An object-based framework for developing high-performance BLAS-like
+   libraries.
+
+   Copyright (C) 2014, The University of Texas at Austin
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are
+   met:
+    - Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    - Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    - Neither the name of The University of Texas nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+// Define _GNU_SOURCE so that sched_getcpu() and syscall() are declared.
+#ifdef __linux__
+  #ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+  #endif
+#endif
+
+#include "blis.h"
+
+#if defined(BLIS_ENABLE_LIBNUMA)
+  #include <sched.h>
+  #include <numa.h>
+#elif defined(BLIS_OS_LINUX)
+  #include <sched.h>
+  #include <sys/syscall.h>
+#endif
+
+#if !defined(BLIS_OS_WINDOWS) && !defined(BLIS_OS_NONE)
+  #include <unistd.h>
+#endif
+
+#if !defined(BLIS_ENABLE_LIBNUMA) && defined(BLIS_OS_LINUX)
+
+// Without libnuma, the node of each cpu is read from sysfs once, when the
+// number of nodes is queried, so that bli_numa_node_of_caller() only needs
+// sched_getcpu(), which glibc implements via the vDSO without a system call.
+// The node of a cpu beyond the table is queried with the getcpu system call.
+#define BLIS_NUMA_CPUS_MAX 4096
+
+static uint8_t cpu_node[ BLIS_NUMA_CPUS_MAX ];
+
+static void bli_numa_read_cpu_nodes( dim_t n_nodes )
+{
+	for ( dim_t node = 0; node < n_nodes; node++ )
+	{
+		char path[ 64 ];
+
+		sprintf( path, "/sys/devices/system/node/node%d/cpulist", ( int )node );
+
+		FILE* fp = fopen( path, "r" );
+
+		if ( fp == NULL ) continue;
+
+		// Read the list of cpu ranges (e.g. "0-7,16-23").
+		int first;
+
+		while ( fscanf( fp, "%d", &first ) == 1 )
+		{
+			int last = first;
+			int sep  = fgetc( fp );
+
+			if ( sep == '-' )
+			{
+				if ( fscanf( fp, "%d", &last ) != 1 ) break;
+				sep = fgetc( fp );
+			}
+
+			for ( int cpu = bli_max( first, 0 );
+			      cpu <= last && cpu < BLIS_NUMA_CPUS_MAX; cpu++ )
+				cpu_node[ cpu ] = ( uint8_t )( node % BLIS_NUMA_NODES_MAX );
+
+			if ( sep != ',' ) break;
+		}
+
+		fclose( fp );
+	}
+}
+
+#endif
+
+// -----------------------------------------------------------------------------
+
+dim_t bli_numa_query_num_nodes( void )
+{
+	dim_t n_nodes = 1;
+
+#if defined(BLIS_ENABLE_LIBNUMA)
+
+	if ( numa_available() >= 0 )
+		n_nodes = ( dim_t )numa_max_node() + 1;
+
+#elif defined(BLIS_OS_LINUX)
+
+	// Without libnuma, read the list of possible node ids (e.g. "0-1" or
+	// "0,2-3") from sysfs and use the largest id to size the node range.
+	FILE* fp = fopen( "/sys/devices/system/node/possible", "r" );
+
+	if ( fp != NULL )
+	{
+		int id;
+		int max_id = 0;
+
+		while ( fscanf( fp, "%d", &id ) == 1 )
+		{
+			if ( id > max_id ) max_id = id;
+
+			// Skip the '-' or ',' separating this id from the next one.
+			if ( fgetc( fp ) == EOF ) break;
+		}
+
+		fclose( fp );
+
+		n_nodes = ( dim_t )max_id + 1;
+
+		bli_numa_read_cpu_nodes( n_nodes );
+	}
+
+#endif
+
+	// Nodes with ids beyond the maximum are folded onto the existing nodes
+	// by bli_numa_node_of_caller(), so we cap the number of nodes here.
+	return bli_min( bli_max( n_nodes, 1 ), BLIS_NUMA_NODES_MAX );
+}
+
+dim_t bli_numa_node_of_caller( void )
+{
+	int node = 0;
+
+#if defined(BLIS_ENABLE_LIBNUMA)
+
+	const int cpu = sched_getcpu();
+
+	if ( cpu >= 0 ) node = numa_node_of_cpu( cpu );
+
+#elif defined(BLIS_OS_LINUX)
+
+	const int cpu = sched_getcpu();
+
+	if ( 0 <= cpu && cpu < BLIS_NUMA_CPUS_MAX )
+	{
+		node = cpu_node[ cpu ];
+	}
+	else
+	{
+		unsigned int cpu_l, node_l;
+
+		if ( syscall( SYS_getcpu, &cpu_l, &node_l, NULL ) == 0 )
+			node = ( int )node_l;
+	}
+
+#endif
+
+	if ( node < 0 ) node = 0;
+
+	return ( dim_t )node % BLIS_NUMA_NODES_MAX;
+}
+
+void bli_numa_place
+     (
+       void* buf,
+       siz_t size,
+       dim_t node
+     )
+{
+#if !defined(BLIS_OS_WINDOWS) && !defined(BLIS_OS_NONE)
+	const siz_t page_size = ( siz_t )sysconf( _SC_PAGESIZE );
+#else
+	const siz_t page_size = 4096;
+#endif
+
+	// Only pages that lie entirely within the block are placed so that
+	// neighboring allocations are left alone.
+	uintptr_t begin = ( ( uintptr_t )buf + page_size - 1 ) / page_size * page_size;
+	uintptr_t end   = ( ( uintptr_t )buf + size ) / page_size * page_size;
+
+	if ( end <= begin ) return;
+
+#ifdef BLIS_ENABLE_LIBNUMA
+	// Bind the pages to the requested node. This only affects pages that
+	// have not yet been faulted in, which is why we still touch them below.
+	if ( numa_available() >= 0 )
+		numa_tonode_memory( ( void* )begin, end - begin, ( int )node );
+#else
+	( void )node;
+#endif
+
+	// Touch each page from the calling thread (which is running on node
+	// 'node') so that, under the default first-touch policy, the pages are
+	// allocated from the node's local memory.
+	for ( uintptr_t p = begin; p < end; p += page_size )
+		*( volatile char* )p = 0;
+}
+
@@ -37,7 +37,32 @@
 #include "blis.h"
 
 // Statically initialize the mutex within the packing block allocator object.
-static pba_t global_pba = { .mutex = BLIS_PTHREAD_MUTEX_INITIALIZER };
+static pba_t global_pba = { .n_nodes = 1, .mutex = BLIS_PTHREAD_MUTEX_INITIALIZER };
+
+// Each thread is assigned a slot in the caches of released blocks the first
+// time it acquires or releases a block. Slots are handed out round-robin, so
+// when there are more threads than slots (or if TLS is disabled, in which
+// case all threads use the first slot), several threads share a slot. This
+// is why a slot is only ever accessed with atomic exchanges.
+static BLIS_THREAD_LOCAL dim_t cache_slot_id = -1;
+static                   dim_t cache_slot_next = 0;
+
+static pba_slot_t* bli_pba_cache_slot
+     (
+       dim_t  node,
+       dim_t  pool_index,
+       pba_t* pba
+     )
+{
+	pba_slot_t* cache = bli_pba_node_cache( node, pool_index, pba );
+
+	if ( cache == NULL ) return NULL;
+
+	if ( cache_slot_id < 0 )
+		cache_slot_id = __atomic_fetch_add( &cache_slot_next, 1, __ATOMIC_RELAXED );
+
+	return &cache[ cache_slot_id % bli_pba_cache_slots( pba ) ];
+}
 
 // -----------------------------------------------------------------------------
 
@@ -63,6 +88,28 @@ void bli_pba_init
 	bli_pba_set_malloc_fp( malloc_fp, pba );
 	bli_pba_set_free_fp( free_fp, pba );
 
+	// Determine the number of NUMA nodes for which we keep separate pools.
+	// Setting BLIS_NUMA_POOLS=0 in the environment disables the per-node
+	// pools, in which case all threads share the pools of the first node.
+	dim_t n_nodes = 1;
+
+	if ( bli_env_get_var( "BLIS_NUMA_POOLS", 1 ) != 0 )
+		n_nodes = bli_numa_query_num_nodes();
+
+	bli_pba_set_num_nodes( n_nodes, pba );
+
+	// Determine the number of slots in the caches of released blocks in
+	// front of each pool, if any.
+	const gint_t cache_slots = bli_env_get_var( "BLIS_PBA_CACHE_SLOTS",
+	                                            BLIS_PBA_CACHE_SLOTS );
+
+	bli_pba_set_cache_slots( bli_max( cache_slots, 0 ), pba );
+
+	// Determine whether the blocks in the pools are backed by huge pages.
+	// This is chosen at configure-time but may be overridden by setting
+	// BLIS_HUGEPAGES in the environment.
+	bli_pba_set_hugepages( bli_hugepage_query_mode(), pba );
+
 	// The mutex field of pba is initialized statically above. This
 	// keeps bli_pba_init() simpler and removes the possibility of
 	// something going wrong during mutex initialization.
@@ -138,20 +185,75 @@ void bli_pba_acquire_m
 		// from an internal memory pool, in which blocks are allocated once
 		// and then recycled.
 
+		// Select the pools of the NUMA node on which the calling thread is
+		// running (if there is more than one node) so that the packed
+		// blocks used by a thread reside in memory that is local to it.
+		const dim_t n_nodes = bli_pba_num_nodes( pba );
+		const dim_t node    = ( n_nodes > 1 ? bli_numa_node_of_caller() % n_nodes
+		                                    : 0 );
+
 		// Map the requested packed buffer type to a zero-based index, which
 		// we then use to select the corresponding memory pool.
 		dim_t   pi   = bli_packbuf_index( buf_type );
-		pool_t* pool = bli_pba_pool( pi, pba );
+		pool_t* pool = bli_pba_node_pool( node, pi, pba );
 
 		// Extract the address of the pblk_t struct within the mem_t.
 		pblk_t* pblk = bli_mem_pblk( mem );
 
+		// First, try to take a block from this thread's slot in the cache of
+		// released blocks. This requires no lock. (The slot may be shared with
+		// other threads, in which case the block may have been parked there by
+		// another thread.) The block's size is stored
+		// at the beginning of the block while it is in the cache.
+		pba_slot_t* slot = bli_pba_cache_slot( node, pi, pba );
+		void*       buf  = NULL;
+
+		if ( slot != NULL )
+			buf = __atomic_exchange_n( &slot->buf, NULL, __ATOMIC_ACQUIRE );
+
+		if ( buf != NULL )
+		{
+			bli_pblk_set_buf( buf, pblk );
+			bli_pblk_set_block_size( *( siz_t* )buf, pblk );
+
+			if ( req_size <= bli_pblk_block_size( pblk ) )
+			{
+				bli_mem_set_buf_type( buf_type, mem );
+				bli_mem_set_pool( pool, mem );
+				bli_mem_set_size( bli_pblk_block_size( pblk ), mem );
+				return;
+			}
+
+			// The cached block is too small, which means the pool has since
+			// been (or is about to be) reinitialized with larger blocks. Check
+			// the block back into the pool, which frees it, before checking
+			// out a new block below.
+			bli_pba_lock( pba );
+			bli_pool_checkin_block( pblk, pool );
+			bli_pba_unlock( pba );
+		}
+
+		// Keep track of whether checking out the block caused new blocks
+		// to be allocated.
+		bool    grew       = FALSE;
+		bool    use_global = FALSE;
+
 		// Acquire the mutex associated with the pba object.
 		bli_pba_lock( pba );
 
 		// BEGIN CRITICAL SECTION
 		{
 
+			const siz_t num_blocks_prev = bli_pool_num_blocks( pool );
+			const siz_t block_size_prev = bli_pool_block_size( pool );
+
+			// The pools of a pba whose blocks were carved from a workspace
+			// cannot grow. If such a pool cannot satisfy the request, the
+			// block is acquired from the global pba instead.
+			use_global = bli_pba_in_wspace( pba ) &&
+			             ( block_size_prev < req_size ||
+			               bli_pool_is_exhausted( pool ) );
+
 			// Checkout a block from the pool. If the pool's blocks are too
 			// small, it will be reinitialized with blocks large enough to
 			// accommodate the requested block size. If the pool is exhausted,
@@ -160,7 +262,14 @@ void bli_pba_acquire_m
 			// automatically, as-needed. Note that the addresses are stored
 			// directly into the mem_t struct since pblk is the address of
 			// the struct's pblk_t field.
-			bli_pool_checkout_block( req_size, pblk, pool );
+			if ( !use_global )
+				bli_pool_checkout_block( req_size, pblk, pool );
+
+			// Compare the pool's state with that before the checkout while
+			// the lock is still held, since other threads may change the
+			// pool as soon as it is released.
+			grew = ( bli_pool_num_blocks( pool ) != num_blocks_prev ||
+			         bli_pool_block_size( pool ) != block_size_prev );
 
 		}
 		// END CRITICAL SECTION
@@ -168,10 +277,24 @@ void bli_pba_acquire_m
 		// Release the mutex associated with the pba object.
 		bli_pba_unlock( pba );
 
+		if ( use_global )
+		{
+			bli_pba_acquire_m( bli_pba_query(), req_size, buf_type, mem );
+			return;
+		}
+
 		// Query the block_size from the pblk_t. This will be at least
 		// req_size, perhaps larger.
 		siz_t block_size = bli_pblk_block_size( pblk );
 
+		// If the block was freshly allocated (because the pool was exhausted
+		// or reinitialized with larger blocks), place its pages on the node
+		// of the calling thread before it is first written during packing.
+		// Blocks are checked back into the pool from which they came, so
+		// this only needs to happen once per block.
+		if ( n_nodes > 1 && grew )
+			bli_numa_place( bli_pblk_buf( pblk ), block_size, node );
+
 		// Initialize the mem_t object with:
 		// - the buffer type (a packbuf_t value),
 		// - the address of the memory pool to which it belongs,
@@ -218,23 +341,51 @@ void bli_pba_release
 		// allocated.
 		pool_t* pool = bli_mem_pool( mem );
 
+		// If a pba whose blocks were carved from a workspace could not
+		// satisfy the request, the block came from the global pba.
+		if ( !bli_pba_has_pool( pool, pba ) )
+			pba = bli_pba_query();
+
 		// Extract the address of the pblk_t struct within the mem_t struct.
 		pblk_t* pblk = bli_mem_pblk( mem );
 
-		// Acquire the mutex associated with the pba object.
-		bli_pba_lock( pba );
-
-		// BEGIN CRITICAL SECTION
+		// First, try to park the block in this thread's slot in the cache of
+		// released blocks in front of the pool, which requires no lock. The
+		// block remains checked out from the pool's point of view until the
+		// cache is drained. The block's size is stored at the beginning of
+		// the block (which is otherwise unused while it is in the cache) so
+		// that it can be recovered when the block is taken from the cache.
+		// Recover the node and pool index from the position of the pool
+		// within the pba's array of pools.
+		const dim_t node = ( pool - bli_pba_node_pool( 0, 0, pba ) ) / 3;
+		const dim_t pi   = ( pool - bli_pba_node_pool( 0, 0, pba ) ) % 3;
+
+		pba_slot_t* slot = bli_pba_cache_slot( node, pi, pba );
+		void*       buf  = bli_pblk_buf( pblk );
+		void*       null = NULL;
+
+		if ( slot != NULL )
+			*( siz_t* )buf = bli_pblk_block_size( pblk );
+
+		if ( slot == NULL ||
+		     !__atomic_compare_exchange_n( &slot->buf, &null, buf, FALSE,
+		                                   __ATOMIC_RELEASE, __ATOMIC_RELAXED ) )
 		{
+			// Acquire the mutex associated with the pba object.
+			bli_pba_lock( pba );
 
-			// Check the block back into the pool.
-			bli_pool_checkin_block( pblk, pool );
+			// BEGIN CRITICAL SECTION
+			{
 
-		}
-		// END CRITICAL SECTION
+				// Check the block back into the pool.
+				bli_pool_checkin_block( pblk, pool );
 
-		// Release the mutex associated with the pba object.
-		bli_pba_unlock( pba );
+			}
+			// END CRITICAL SECTION
+
+			// Release the mutex associated with the pba object.
+			bli_pba_unlock( pba );
+		}
 	}
 
 	// Clear the mem_t object so that it appears unallocated. This clears:
@@ -283,18 +434,20 @@ siz_t bli_pba_pool_size
 	}
 	else
 	{
-		dim_t   pool_index;
-		pool_t* pool;
-
-		// Acquire the pointer to the pool corresponding to the buf_type
-		// provided.
-		pool_index = bli_packbuf_index( buf_type );
-		pool       = bli_pba_pool( pool_index, ( pba_t* )pba );
-
-		// Compute the pool "size" as the product of the block size
-		// and the number of blocks in the pool.
-		r_val = bli_pool_block_size( pool ) *
-		        bli_pool_num_blocks( pool );
+		dim_t pool_index = bli_packbuf_index( buf_type );
+
+		r_val = 0;
+
+		// Compute the pool "size" as the product of the block size and
+		// the number of blocks in the pool corresponding to the buf_type
+		// provided, summed over the pools of all NUMA nodes.
+		for ( dim_t node = 0; node < bli_pba_num_nodes( pba ); node++ )
+		{
+			pool_t* pool = bli_pba_node_pool( node, pool_index, ( pba_t* )pba );
+
+			r_val += bli_pool_block_size( pool ) *
+			         bli_pool_num_blocks( pool );
+		}
 	}
 
 	return r_val;
@@ -307,6 +460,31 @@ void bli_pba_init_pools
        const cntx_t* cntx,
              pba_t*  pba
      )
+{
+	// Initialize one set of pools per NUMA node. The pools start out empty,
+	// so the pools of nodes that are never used do not consume any memory
+	// beyond their (short) block_ptrs arrays.
+	for ( dim_t node = 0; node < bli_pba_num_nodes( pba ); node++ )
+		bli_pba_init_node_pools( cntx, node, pba );
+}
+
+void bli_pba_finalize_pools
+     (
+       pba_t* pba
+     )
+{
+	bli_pba_drain_caches( pba );
+
+	for ( dim_t node = 0; node < bli_pba_num_nodes( pba ); node++ )
+		bli_pba_finalize_node_pools( node, pba );
+}
+
+void bli_pba_init_node_pools
+     (
+       const cntx_t* cntx,
+             dim_t   node,
+             pba_t*  pba
+     )
 {
 	// Map each of the packbuf_t values to an index starting at zero.
 	const dim_t index_a      = bli_packbuf_index( BLIS_BUFFER_FOR_A_BLOCK );
@@ -314,9 +492,9 @@ void bli_pba_init_pools
 	const dim_t index_c      = bli_packbuf_index( BLIS_BUFFER_FOR_C_PANEL );
 
 	// Alias the pool addresses to convenient identifiers.
-	pool_t*     pool_a       = bli_pba_pool( index_a, pba );
-	pool_t*     pool_b       = bli_pba_pool( index_b, pba );
-	pool_t*     pool_c       = bli_pba_pool( index_c, pba );
+	pool_t*     pool_a       = bli_pba_node_pool( node, index_a, pba );
+	pool_t*     pool_b       = bli_pba_node_pool( node, index_b, pba );
+	pool_t*     pool_c       = bli_pba_node_pool( node, index_c, pba );
 
 	// Start with empty pools.
 	const dim_t num_blocks_a = 0;
@@ -343,9 +521,12 @@ void bli_pba_init_pools
 	const siz_t offset_size_b = BLIS_POOL_ADDR_OFFSET_SIZE_B;
 	const siz_t offset_size_c = BLIS_POOL_ADDR_OFFSET_SIZE_C;
 
-	// Use the malloc() and free() designated (at configure-time) for pools.
-	malloc_ft malloc_fp  = BLIS_MALLOC_POOL;
-	free_ft   free_fp    = BLIS_FREE_POOL;
+	// Use the malloc() and free() designated (at configure-time) for pools,
+	// unless the pools are to be backed by huge pages.
+	malloc_ft malloc_fp;
+	free_ft   free_fp;
+
+	bli_hugepage_query_fps( bli_pba_hugepages( pba ), &malloc_fp, &free_fp );
 
 	// Determine the block size for each memory pool.
 	bli_pba_compute_pool_block_sizes( &block_size_a,
@@ -360,12 +541,234 @@ void bli_pba_init_pools
 	               offset_size_b, malloc_fp, free_fp, pool_b );
 	bli_pool_init( num_blocks_c, block_ptrs_len_c, block_size_c, align_size_c,
 	               offset_size_c, malloc_fp, free_fp, pool_c );
+
+	// Bound the pools and enable trimming as requested (at configure-time
+	// or via the environment). Negative values are treated as zero, which
+	// leaves the pools unbounded and untrimmed.
+	const gint_t max_blocks  = bli_env_get_var( "BLIS_POOL_MAX_BLOCKS",
+	                                            BLIS_POOL_MAX_BLOCKS );
+	const gint_t trim_period = bli_env_get_var( "BLIS_POOL_TRIM_PERIOD",
+	                                            BLIS_POOL_TRIM_PERIOD );
+
+	bli_pool_set_max_blocks( bli_max( max_blocks, 0 ), pool_a );
+	bli_pool_set_max_blocks( bli_max( max_blocks, 0 ), pool_b );
+	bli_pool_set_max_blocks( bli_max( max_blocks, 0 ), pool_c );
+
+	bli_pool_set_trim_period( bli_max( trim_period, 0 ), pool_a );
+	bli_pool_set_trim_period( bli_max( trim_period, 0 ), pool_b );
+	bli_pool_set_trim_period( bli_max( trim_period, 0 ), pool_c );
+
+	// Allocate and clear the caches of released blocks, if enabled. A block
+	// parked in a cache is never checked back into its pool, so a pool with
+	// blocks in its cache never becomes idle, and the excess above max_blocks
+	// is never freed. Therefore, the caches are disabled if either policy is
+	// enabled, in which case every released block is checked back into its
+	// pool.
+	const dim_t cache_slots = bli_pba_cache_slots( pba );
+	const bool  use_caches  = 0 < cache_slots &&
+	                          max_blocks <= 0 && trim_period <= 0;
+
+	for ( dim_t i = 0; i < 3; i++ )
+	{
+		pba_slot_t* cache = NULL;
+
+		if ( use_caches )
+		{
+			err_t r_val;
+
+			cache = bli_malloc_intl( cache_slots * sizeof( pba_slot_t ), &r_val );
+
+			for ( dim_t j = 0; j < cache_slots; j++ )
+				cache[ j ].buf = NULL;
+		}
+
+		bli_pba_set_node_cache( cache, node, i, pba );
+	}
 }
 
-void bli_pba_finalize_pools
+static void bli_pba_prewarm_thread
+     (
+             thrcomm_t* gl_comm,
+             dim_t      tid,
+       const void*      params
+     )
+{
+	pba_t* pba = ( pba_t* )params;
+
+	const packbuf_t buf_types[2] = { BLIS_BUFFER_FOR_A_BLOCK,
+	                                 BLIS_BUFFER_FOR_B_PANEL };
+	mem_t           mems[2];
+
+	// Check out a block from each pool and write to every page of it so
+	// that its pages are faulted in (and, with per-node pools, placed) by
+	// the thread that will pack into it.
+	for ( dim_t i = 0; i < 2; ++i )
+	{
+		bli_pba_acquire_m( pba, 1, buf_types[ i ], &mems[ i ] );
+
+		char* buf  = bli_mem_buffer( &mems[ i ] );
+		siz_t size = bli_mem_size( &mems[ i ] );
+
+		for ( siz_t j = 0; j < size; j += BLIS_PAGE_SIZE )
+			buf[ j ] = 0;
+	}
+
+	// Hold on to the blocks until every thread has checked out its own, so
+	// that the pools grow to one block per thread. Then release them. This
+	// only roughly targets the threads of later operations: blocks go back
+	// to the pools (or to cache slots, which are shared and assigned round-
+	// robin), so a thread may later take a block that another thread (of its
+	// NUMA node, with per-node pools) faulted in.
+	bli_thrcomm_barrier( tid, gl_comm );
+
+	for ( dim_t i = 0; i < 2; ++i )
+		bli_pba_release( pba, &mems[ i ] );
+}
+
+void bli_pba_prewarm
+     (
+             pba_t*  pba,
+       const rntm_t* rntm
+     )
+{
+#ifdef BLIS_ENABLE_PBA_POOLS
+	bli_thread_launch_rntm( rntm, bli_pba_prewarm_thread, pba );
+#endif
+}
+
+void bli_pba_trim
      (
        pba_t* pba
      )
+{
+#ifdef BLIS_ENABLE_PBA_POOLS
+	// Acquire the mutex associated with the pba object.
+	bli_pba_lock( pba );
+
+	// BEGIN CRITICAL SECTION
+	{
+		bli_pba_drain_caches( pba );
+
+		for ( dim_t node = 0; node < bli_pba_num_nodes( pba ); node++ )
+		for ( dim_t i = 0; i < 3; i++ )
+		{
+			bli_pool_trim( bli_pba_node_pool( node, i, pba ) );
+		}
+	}
+	// END CRITICAL SECTION
+
+	// Release the mutex associated with the pba object.
+	bli_pba_unlock( pba );
+#else
+	( void )pba;
+#endif
+}
+
+void bli_pba_drain_caches
+     (
+       pba_t* pba
+     )
+{
+	// NOTE: This function must be called with the pba's mutex held (or when
+	// no other threads may access the pba).
+
+	const dim_t cache_slots = bli_pba_cache_slots( pba );
+
+	for ( dim_t node = 0; node < bli_pba_num_nodes( pba ); node++ )
+	for ( dim_t i = 0; i < 3; i++ )
+	{
+		pba_slot_t* cache = bli_pba_node_cache( node, i, pba );
+		pool_t*     pool  = bli_pba_node_pool( node, i, pba );
+
+		if ( cache == NULL ) continue;
+
+		for ( dim_t j = 0; j < cache_slots; j++ )
+		{
+			void* buf = __atomic_exchange_n( &cache[ j ].buf, NULL, __ATOMIC_ACQUIRE );
+
+			if ( buf == NULL ) continue;
+
+			// Check the block back into the pool. (If the pool has since been
+			// reinitialized with larger blocks, this frees the block.)
+			pblk_t pblk;
+
+			bli_pblk_set_buf( buf, &pblk );
+			bli_pblk_set_block_size( *( siz_t* )buf, &pblk );
+
+			bli_pool_checkin_block( &pblk, pool );
+		}
+	}
+}
+
+void bli_pba_lock_wait
+     (
+       pba_t* pba
+     )
+{
+	const double t_start = bli_clock();
+
+	bli_pthread_mutex_lock( &(pba->mutex) );
+
+	// Now that the mutex is held, the statistics may be updated safely.
+	pba->num_lock_waits += 1;
+	pba->lock_wait_time += bli_clock() - t_start;
+}
+
+void bli_pba_stats
+     (
+       pba_t*          pba,
+       memsys_stats_t* stats
+     )
+{
+	// Acquire the mutex associated with the pba object.
+	bli_pba_lock( pba );
+
+	// BEGIN CRITICAL SECTION
+	{
+		const dim_t n_nodes = bli_pba_num_nodes( pba );
+
+		stats->pba_num_nodes = n_nodes;
+
+		for ( dim_t node = 0; node < n_nodes; node++ )
+		for ( dim_t i = 0; i < 3; i++ )
+		{
+#ifdef BLIS_ENABLE_PBA_POOLS
+			pool_stats_t* pstats = &(stats->pba[ node ][ i ]);
+			pba_slot_t*   cache  = bli_pba_node_cache( node, i, pba );
+
+			bli_pool_stats( bli_pba_node_pool( node, i, pba ), pstats );
+
+			// Blocks that are parked in the cache in front of the pool are
+			// reported as reserved, but not as checked out.
+			for ( dim_t j = 0; cache != NULL && j < bli_pba_cache_slots( pba ); j++ )
+			{
+				if ( __atomic_load_n( &cache[ j ].buf, __ATOMIC_RELAXED ) == NULL ||
+				     pstats->num_checked_out == 0 ) continue;
+
+				pstats->num_checked_out  -= 1;
+				pstats->size_checked_out -= pstats->block_size;
+			}
+#else
+			memset( &(stats->pba[ node ][ i ]), 0, sizeof( pool_stats_t ) );
+#endif
+		}
+
+		// Report the statistics for the mutex as of before this call.
+		stats->pba_num_lock_acquires = pba->num_lock_acquires - 1;
+		stats->pba_num_lock_waits    = pba->num_lock_waits;
+		stats->pba_lock_wait_time    = pba->lock_wait_time;
+	}
+	// END CRITICAL SECTION
+
+	// Release the mutex associated with the pba object.
+	bli_pba_unlock( pba );
+}
+
+void bli_pba_finalize_node_pools
+     (
+       dim_t  node,
+       pba_t* pba
+     )
 {
 	// Map each of the packbuf_t values to an index starting at zero.
 	dim_t   index_a = bli_packbuf_index( BLIS_BUFFER_FOR_A_BLOCK );
@@ -373,9 +776,18 @@ void bli_pba_finalize_pools
 	dim_t   index_c = bli_packbuf_index( BLIS_BUFFER_FOR_C_PANEL );
 
 	// Alias the pool addresses to convenient identifiers.
-	pool_t* pool_a  = bli_pba_pool( index_a, pba );
-	pool_t* pool_b  = bli_pba_pool( index_b, pba );
-	pool_t* pool_c  = bli_pba_pool( index_c, pba );
+	pool_t* pool_a  = bli_pba_node_pool( node, index_a, pba );
+	pool_t* pool_b  = bli_pba_node_pool( node, index_b, pba );
+	pool_t* pool_c  = bli_pba_node_pool( node, index_c, pba );
+
+	// Return any blocks in the caches to the pools and free the caches.
+	// (bli_pba_finalize_pools() drains the caches of all nodes before any
+	// of the pools are finalized.)
+	for ( dim_t i = 0; i < 3; i++ )
+	{
+		bli_free_intl( bli_pba_node_cache( node, i, pba ) );
+		bli_pba_set_node_cache( NULL, node, i, pba );
+	}
 
 	// Finalize the memory pools for A, B, and C.
 	bli_pool_finalize( pool_a, FALSE );
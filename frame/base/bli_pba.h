@@ -42,8 +42,19 @@
 /*
 typedef struct pba_s
 {
-	pool_t              pools[3];
+	pool_t              pools[ BLIS_NUMA_NODES_MAX ][3];
+	dim_t               n_nodes;
 	bli_pthread_mutex_t mutex;
+	hpg_t               hugepages;
+
+	dim_t               num_lock_acquires;
+	dim_t               num_lock_waits;
+	double              lock_wait_time;
+
+	dim_t               cache_slots;
+	pba_slot_t*         caches[ BLIS_NUMA_NODES_MAX ][3];
+
+	bool                in_wspace;
 
 	// These fields are used for general-purpose allocation.
 	siz_t               align_size;
@@ -68,9 +79,48 @@ typedef struct pba_s
 
 // pba query
 
+BLIS_INLINE pool_t* bli_pba_node_pool( dim_t node, dim_t pool_index, pba_t* pba )
+{
+	return &(pba->pools[ node ][ pool_index ]);
+}
+
 BLIS_INLINE pool_t* bli_pba_pool( dim_t pool_index, pba_t* pba )
 {
-	return &(pba->pools[ pool_index ]);
+	// Return the pool for the first NUMA node, which is the only node if
+	// per-node pools are not in use.
+	return bli_pba_node_pool( 0, pool_index, pba );
+}
+
+BLIS_INLINE dim_t bli_pba_num_nodes( const pba_t* pba )
+{
+	return pba->n_nodes;
+}
+
+BLIS_INLINE hpg_t bli_pba_hugepages( const pba_t* pba )
+{
+	return pba->hugepages;
+}
+
+BLIS_INLINE dim_t bli_pba_cache_slots( const pba_t* pba )
+{
+	return pba->cache_slots;
+}
+
+BLIS_INLINE pba_slot_t* bli_pba_node_cache( dim_t node, dim_t pool_index, pba_t* pba )
+{
+	return pba->caches[ node ][ pool_index ];
+}
+
+BLIS_INLINE bool bli_pba_in_wspace( const pba_t* pba )
+{
+	return pba->in_wspace;
+}
+
+BLIS_INLINE bool bli_pba_has_pool( const pool_t* pool, pba_t* pba )
+{
+	const pool_t* pools = bli_pba_node_pool( 0, 0, pba );
+
+	return pools <= pool && pool < pools + BLIS_NUMA_NODES_MAX * 3;
 }
 
 BLIS_INLINE siz_t bli_pba_align_size( const pba_t* pba )
@@ -90,6 +140,31 @@ BLIS_INLINE free_ft bli_pba_free_fp( const pba_t* pba )
 
 // pba modification
 
+BLIS_INLINE void bli_pba_set_num_nodes( dim_t n_nodes, pba_t* pba )
+{
+	pba->n_nodes = n_nodes;
+}
+
+BLIS_INLINE void bli_pba_set_hugepages( hpg_t hugepages, pba_t* pba )
+{
+	pba->hugepages = hugepages;
+}
+
+BLIS_INLINE void bli_pba_set_cache_slots( dim_t cache_slots, pba_t* pba )
+{
+	pba->cache_slots = cache_slots;
+}
+
+BLIS_INLINE void bli_pba_set_node_cache( pba_slot_t* cache, dim_t node, dim_t pool_index, pba_t* pba )
+{
+	pba->caches[ node ][ pool_index ] = cache;
+}
+
+BLIS_INLINE void bli_pba_set_in_wspace( bool in_wspace, pba_t* pba )
+{
+	pba->in_wspace = in_wspace;
+}
+
 BLIS_INLINE void bli_pba_set_align_size( siz_t align_size, pba_t* pba )
 {
 	pba->align_size = align_size;
@@ -107,9 +182,16 @@ BLIS_INLINE void bli_pba_set_free_fp( free_ft free_fp, pba_t* pba )
 
 // pba action
 
+void bli_pba_lock_wait( pba_t* pba );
+
 BLIS_INLINE void bli_pba_lock( pba_t* pba )
 {
-	bli_pthread_mutex_lock( &(pba->mutex) );
+	// Only fall back to a (timed) blocking acquisition if the mutex is held
+	// by another thread, so that the common, uncontended case stays cheap.
+	if ( bli_pthread_mutex_trylock( &(pba->mutex) ) != 0 )
+		bli_pba_lock_wait( pba );
+
+	pba->num_lock_acquires += 1;
 }
 
 BLIS_INLINE void bli_pba_unlock( pba_t* pba )
@@ -144,6 +226,28 @@ void bli_pba_release
        mem_t* mem
      );
 
+void bli_pba_trim
+     (
+       pba_t* pba
+     );
+
+void bli_pba_prewarm
+     (
+             pba_t*  pba,
+       const rntm_t* rntm
+     );
+
+void bli_pba_drain_caches
+     (
+       pba_t* pba
+     );
+
+void bli_pba_stats
+     (
+       pba_t*          pba,
+       memsys_stats_t* stats
+     );
+
 siz_t bli_pba_pool_size
      (
        const pba_t*    pba,
@@ -162,6 +266,18 @@ void bli_pba_finalize_pools
        pba_t* pba
      );
 
+void bli_pba_init_node_pools
+     (
+       const cntx_t* cntx,
+             dim_t   node,
+             pba_t*  pba
+     );
+void bli_pba_finalize_node_pools
+     (
+       dim_t  node,
+       pba_t* pba
+     );
+
 void bli_pba_compute_pool_block_sizes
      (
              siz_t*  bs_a,
@@ -111,6 +111,19 @@ void bli_pool_init
 	bli_pool_set_offset_size( offset_size, pool );
 	bli_pool_set_malloc_fp( malloc_fp, pool );
 	bli_pool_set_free_fp( free_fp, pool );
+
+	// By default, the pool retains every block it has ever allocated. The
+	// owner of the pool may enable a trimming policy after initialization.
+	bli_pool_set_max_blocks( 0, pool );
+	bli_pool_set_trim_period( 0, pool );
+	bli_pool_set_high_water( 0, pool );
+	bli_pool_set_num_idle( 0, pool );
+
+	// Reset the statistics.
+	bli_pool_set_num_grows( 0, pool );
+	bli_pool_set_num_shrinks( 0, pool );
+	bli_pool_set_num_reinits( 0, pool );
+	bli_pool_set_peak_size( 0, pool );
 }
 
 void bli_pool_finalize
@@ -208,6 +221,14 @@ void bli_pool_reinit
 	malloc_ft malloc_fp = bli_pool_malloc_fp( pool );
 	free_ft   free_fp   = bli_pool_free_fp( pool );
 
+	// Likewise, preserve the trimming policy and the statistics.
+	const siz_t max_blocks  = bli_pool_max_blocks( pool );
+	const siz_t trim_period = bli_pool_trim_period( pool );
+	const siz_t num_grows   = bli_pool_num_grows( pool );
+	const siz_t num_shrinks = bli_pool_num_shrinks( pool );
+	const siz_t num_reinits = bli_pool_num_reinits( pool );
+	const siz_t peak_size   = bli_pool_peak_size( pool );
+
 	// Finalize the pool as it is currently configured. If some blocks
 	// are still checked out to threads, those blocks are not freed
 	// here, and instead will be freed when the threads attempt to check
@@ -229,6 +250,13 @@ void bli_pool_reinit
 	  free_fp,
 	  pool
 	);
+
+	bli_pool_set_max_blocks( max_blocks, pool );
+	bli_pool_set_trim_period( trim_period, pool );
+	bli_pool_set_num_grows( num_grows, pool );
+	bli_pool_set_num_shrinks( num_shrinks, pool );
+	bli_pool_set_num_reinits( num_reinits + 1, pool );
+	bli_pool_set_peak_size( peak_size, pool );
 }
 
 void bli_pool_checkout_block
@@ -304,6 +332,17 @@ void bli_pool_checkout_block
 
 	// Increment the pool's top_index.
 	bli_pool_set_top_index( top_index + 1, pool );
+
+	// Track the largest number of blocks checked out at once since the pool
+	// was last trimmed.
+	if ( bli_pool_high_water( pool ) < top_index + 1 )
+		bli_pool_set_high_water( top_index + 1, pool );
+
+	// Likewise, track the largest amount of memory ever checked out at once.
+	const siz_t size_out = ( top_index + 1 ) * bli_pool_block_size( pool );
+
+	if ( bli_pool_peak_size( pool ) < size_out )
+		bli_pool_set_peak_size( size_out, pool );
 }
 
 void bli_pool_checkin_block
@@ -352,6 +391,43 @@ void bli_pool_checkin_block
 
 	// Decrement the pool's top_index.
 	bli_pool_set_top_index( top_index - 1, pool );
+
+	// If the pool is bounded and a burst of demand has left it holding more
+	// than max_blocks blocks, free the excess as the blocks come back.
+	const siz_t num_blocks = bli_pool_num_blocks( pool );
+	const siz_t max_blocks = bli_pool_max_blocks( pool );
+
+	if ( 0 < max_blocks && max_blocks < num_blocks )
+		bli_pool_shrink( num_blocks - max_blocks, pool );
+
+	// Each time the last block is checked back in, the pool is idle. After
+	// trim_period such idle periods, free the blocks that were never needed
+	// at once during those periods, i.e., those above the high-water mark.
+	const siz_t trim_period = bli_pool_trim_period( pool );
+
+	if ( 0 < trim_period && top_index - 1 == 0 )
+	{
+		const siz_t num_idle = bli_pool_num_idle( pool ) + 1;
+
+		if ( num_idle < trim_period )
+		{
+			bli_pool_set_num_idle( num_idle, pool );
+		}
+		else
+		{
+			const siz_t high_water = bli_pool_high_water( pool );
+
+			#ifdef BLIS_ENABLE_MEM_TRACING
+			printf( "bli_pool_checkin_block(): idle period %d; trimming to "
+			        "high-water mark %d.\n", ( int )num_idle, ( int )high_water );
+			fflush( stdout );
+			#endif
+
+			bli_pool_shrink( bli_pool_num_blocks( pool ) - high_water, pool );
+			bli_pool_set_high_water( 0, pool );
+			bli_pool_set_num_idle( 0, pool );
+		}
+	}
 }
 
 void bli_pool_grow
@@ -467,6 +543,8 @@ void bli_pool_grow
 	// Notice that top_index remains unchanged, as do the block_size and
 	// align_size fields.
 	bli_pool_set_num_blocks( num_blocks_new, pool );
+
+	bli_pool_set_num_grows( bli_pool_num_grows( pool ) + 1, pool );
 }
 
 void bli_pool_shrink
@@ -493,6 +571,8 @@ void bli_pool_shrink
 	// available.
 	num_blocks_sub = bli_min( num_blocks_sub, num_blocks_avail );
 
+	if ( num_blocks_sub == 0 ) return;
+
 	// Query the block_ptrs array.
 	pblk_t* block_ptrs = bli_pool_block_ptrs( pool );
 
@@ -514,11 +594,61 @@ void bli_pool_shrink
 	// Update the pool_t struct.
 	bli_pool_set_num_blocks( num_blocks_new, pool );
 
+	bli_pool_set_num_shrinks( bli_pool_num_shrinks( pool ) + 1, pool );
+
 	// Note that after shrinking the pool, num_blocks < block_ptrs_len.
 	// This means the pool can grow again by num_blocks_sub before
 	// a re-allocation of block_ptrs is triggered.
 }
 
+void bli_pool_trim
+     (
+       pool_t* pool
+     )
+{
+	// Free all of the blocks that are not currently checked out. Blocks that
+	// are checked out are unaffected and are returned to the pool as usual.
+	const siz_t num_blocks = bli_pool_num_blocks( pool );
+	const siz_t top_index  = bli_pool_top_index( pool );
+
+	#ifdef BLIS_ENABLE_MEM_TRACING
+	printf( "bli_pool_trim(): freeing %d of %d blocks of size %d.\n",
+	        ( int )( num_blocks - top_index ), ( int )num_blocks,
+	        ( int )bli_pool_block_size( pool ) );
+	fflush( stdout );
+	#endif
+
+	bli_pool_shrink( num_blocks - top_index, pool );
+
+	// Restart the tracking of the high-water mark.
+	bli_pool_set_high_water( top_index, pool );
+	bli_pool_set_num_idle( 0, pool );
+}
+
+void bli_pool_stats
+     (
+       const pool_t*       pool,
+             pool_stats_t* stats
+     )
+{
+	const siz_t block_size = bli_pool_block_size( pool );
+	const siz_t num_blocks = bli_pool_num_blocks( pool );
+	const siz_t top_index  = bli_pool_top_index( pool );
+
+	// Blocks that were checked out before the pool was last reinitialized
+	// (with a larger block size) are not counted, since the pool no longer
+	// tracks them; they are freed as soon as they are checked back in.
+	stats->block_size            = block_size;
+	stats->num_blocks            = num_blocks;
+	stats->num_checked_out       = top_index;
+	stats->size_reserved         = num_blocks * block_size;
+	stats->size_checked_out      = top_index * block_size;
+	stats->peak_size_checked_out = bli_pool_peak_size( pool );
+	stats->num_grows             = bli_pool_num_grows( pool );
+	stats->num_shrinks           = bli_pool_num_shrinks( pool );
+	stats->num_reinits           = bli_pool_num_reinits( pool );
+}
+
 void bli_pool_alloc_block
      (
        siz_t     block_size,
@@ -64,6 +64,16 @@ typedef struct
 	malloc_ft malloc_fp;
 	free_ft   free_fp;
 
+	dim_t     max_blocks;
+	dim_t     trim_period;
+	dim_t     high_water;
+	dim_t     num_idle;
+
+	dim_t     num_grows;
+	dim_t     num_shrinks;
+	dim_t     num_reinits;
+	siz_t     peak_size;
+
 } pool_t;
 */
 
@@ -160,6 +170,46 @@ BLIS_INLINE siz_t bli_pool_top_index( const pool_t* pool )
 	return pool->top_index;
 }
 
+BLIS_INLINE siz_t bli_pool_max_blocks( const pool_t* pool )
+{
+	return pool->max_blocks;
+}
+
+BLIS_INLINE siz_t bli_pool_trim_period( const pool_t* pool )
+{
+	return pool->trim_period;
+}
+
+BLIS_INLINE siz_t bli_pool_high_water( const pool_t* pool )
+{
+	return pool->high_water;
+}
+
+BLIS_INLINE siz_t bli_pool_num_idle( const pool_t* pool )
+{
+	return pool->num_idle;
+}
+
+BLIS_INLINE siz_t bli_pool_num_grows( const pool_t* pool )
+{
+	return pool->num_grows;
+}
+
+BLIS_INLINE siz_t bli_pool_num_shrinks( const pool_t* pool )
+{
+	return pool->num_shrinks;
+}
+
+BLIS_INLINE siz_t bli_pool_num_reinits( const pool_t* pool )
+{
+	return pool->num_reinits;
+}
+
+BLIS_INLINE siz_t bli_pool_peak_size( const pool_t* pool )
+{
+	return pool->peak_size;
+}
+
 BLIS_INLINE bool bli_pool_is_exhausted( const pool_t* pool )
 {
 	return ( bool )
@@ -213,6 +263,46 @@ BLIS_INLINE void bli_pool_set_top_index( siz_t top_index, pool_t* pool ) \
 	pool->top_index = top_index;
 }
 
+BLIS_INLINE void bli_pool_set_max_blocks( siz_t max_blocks, pool_t* pool ) \
+{
+	pool->max_blocks = max_blocks;
+}
+
+BLIS_INLINE void bli_pool_set_trim_period( siz_t trim_period, pool_t* pool ) \
+{
+	pool->trim_period = trim_period;
+}
+
+BLIS_INLINE void bli_pool_set_high_water( siz_t high_water, pool_t* pool ) \
+{
+	pool->high_water = high_water;
+}
+
+BLIS_INLINE void bli_pool_set_num_idle( siz_t num_idle, pool_t* pool ) \
+{
+	pool->num_idle = num_idle;
+}
+
+BLIS_INLINE void bli_pool_set_num_grows( siz_t num_grows, pool_t* pool ) \
+{
+	pool->num_grows = num_grows;
+}
+
+BLIS_INLINE void bli_pool_set_num_shrinks( siz_t num_shrinks, pool_t* pool ) \
+{
+	pool->num_shrinks = num_shrinks;
+}
+
+BLIS_INLINE void bli_pool_set_num_reinits( siz_t num_reinits, pool_t* pool ) \
+{
+	pool->num_reinits = num_reinits;
+}
+
+BLIS_INLINE void bli_pool_set_peak_size( siz_t peak_size, pool_t* pool ) \
+{
+	pool->peak_size = peak_size;
+}
+
 // -----------------------------------------------------------------------------
 
 void bli_pool_init
@@ -263,6 +353,16 @@ void bli_pool_shrink
        siz_t   num_blocks_sub,
        pool_t* pool
      );
+void bli_pool_trim
+     (
+       pool_t* pool
+     );
+
+void bli_pool_stats
+     (
+       const pool_t*       pool,
+             pool_stats_t* stats
+     );
 
 void bli_pool_alloc_block
      (
@@ -360,6 +360,86 @@ void bli_rntm_sanitize
 #endif
 }
 
+// Factorize nt threads into ways of parallelism for the jc, ic, jr, and ir
+// loops, where m_w and n_w are the (possibly weighted) amounts of work in the
+// m and n dimensions.
+static void bli_rntm_factorize_nt
+     (
+       dim_t   nt,
+       dim_t   m_w,
+       dim_t   n_w,
+       rntm_t* rntm
+     )
+{
+	dim_t jc = bli_rntm_jc_ways( rntm );
+	dim_t pc = bli_rntm_pc_ways( rntm );
+	dim_t ic = bli_rntm_ic_ways( rntm );
+	dim_t jr = bli_rntm_jr_ways( rntm );
+	dim_t ir = bli_rntm_ir_ways( rntm );
+
+	#ifdef BLIS_DISABLE_AUTO_PRIME_NUM_THREADS
+	// If use of prime numbers is disallowed for automatic thread
+	// factorizations, we first check if the number of threads requested
+	// is prime. If it is prime, and it exceeds a minimum threshold, then
+	// we reduce the number of threads by one so that the number is not
+	// prime. This will allow for automatic thread factorizations to span
+	// two dimensions (loops), which tends to be more efficient.
+	if ( bli_is_prime( nt ) && BLIS_NT_MAX_PRIME < nt ) nt -= 1;
+	#endif
+
+	//printf( "m n = %d %d  BLIS_THREAD_RATIO_M _N = %d %d\n",
+	//         (int)m, (int)n, (int)BLIS_THREAD_RATIO_M,
+	//                         (int)BLIS_THREAD_RATIO_N );
+
+	bli_thread_partition_2x2( nt, m_w*BLIS_THREAD_RATIO_M,
+	                              n_w*BLIS_THREAD_RATIO_N, &ic, &jc );
+
+	//printf( "jc ic = %d %d\n", (int)jc, (int)ic );
+
+	for ( ir = BLIS_THREAD_MAX_IR ; ir > 1 ; ir-- )
+	{
+		if ( ic % ir == 0 ) { ic /= ir; break; }
+	}
+
+	for ( jr = BLIS_THREAD_MAX_JR ; jr > 1 ; jr-- )
+	{
+		if ( jc % jr == 0 ) { jc /= jr; break; }
+	}
+
+	// Save the results back in the rntm_t object.
+	bli_rntm_set_num_threads_only( nt, rntm );
+	bli_rntm_set_ways_only( jc, pc, ic, jr, ir, rntm );
+}
+
+// Return the number of threads, at most nt, that can each be given at least
+// BLIS_THREAD_MIN_UT_K rank-1 microtile updates of an m x n x k problem.
+static dim_t bli_rntm_num_threads_model
+     (
+             dim_t   nt,
+             num_t   dt,
+             dim_t   m,
+             dim_t   n,
+             dim_t   k,
+       const cntx_t* cntx
+     )
+{
+	if ( cntx == NULL ) cntx = bli_gks_query_cntx();
+
+	const dim_t mr     = bli_cntx_get_blksz_def_dt( dt, BLIS_MR, cntx );
+	const dim_t nr     = bli_cntx_get_blksz_def_dt( dt, BLIS_NR, cntx );
+	const dim_t m_iter = ( m + mr - 1 ) / mr;
+	const dim_t n_iter = ( n + nr - 1 ) / nr;
+
+	// Compute in double precision to avoid overflow for large problems.
+	const double work  = ( double )m_iter * ( double )n_iter *
+	                     ( double )bli_max( k, 1 );
+	const double nt_w  = work / ( double )BLIS_THREAD_MIN_UT_K;
+
+	if ( nt_w < ( double )nt ) nt = bli_max( ( dim_t )nt_w, 1 );
+
+	return nt;
+}
+
 void bli_rntm_factorize
      (
        dim_t   m,
@@ -374,48 +454,61 @@ void bli_rntm_factorize
 	// when the rntm_t was sanitized after being updated by the user.
 	if ( bli_rntm_auto_factor( rntm ) )
 	{
-		dim_t nt = bli_rntm_num_threads( rntm );
-		dim_t jc = bli_rntm_jc_ways( rntm );
-		dim_t pc = bli_rntm_pc_ways( rntm );
-		dim_t ic = bli_rntm_ic_ways( rntm );
-		dim_t jr = bli_rntm_jr_ways( rntm );
-		dim_t ir = bli_rntm_ir_ways( rntm );
-
 		if ( 0 < m && 0 < n && 0 <= k )
 		{
-			#ifdef BLIS_DISABLE_AUTO_PRIME_NUM_THREADS
-			// If use of prime numbers is disallowed for automatic thread
-			// factorizations, we first check if the number of threads requested
-			// is prime. If it is prime, and it exceeds a minimum threshold, then
-			// we reduce the number of threads by one so that the number is not
-			// prime. This will allow for automatic thread factorizations to span
-			// two dimensions (loops), which tends to be more efficient.
-			if ( bli_is_prime( nt ) && BLIS_NT_MAX_PRIME < nt ) nt -= 1;
-			#endif
+			bli_rntm_factorize_nt( bli_rntm_num_threads( rntm ), m, n, rntm );
+		}
+	}
 
-			//printf( "m n = %d %d  BLIS_THREAD_RATIO_M _N = %d %d\n",
-			//         (int)m, (int)n, (int)BLIS_THREAD_RATIO_M,
-			//                         (int)BLIS_THREAD_RATIO_N );
+#else
 
-			bli_thread_partition_2x2( nt, m*BLIS_THREAD_RATIO_M,
-			                              n*BLIS_THREAD_RATIO_N, &ic, &jc );
+	// When multithreading is disabled at compile time, the rntm can keep its
+	// default initialization values since using one thread requires no
+	// factorization.
 
-			//printf( "jc ic = %d %d\n", (int)jc, (int)ic );
+#endif
+}
 
-			for ( ir = BLIS_THREAD_MAX_IR ; ir > 1 ; ir-- )
-			{
-				if ( ic % ir == 0 ) { ic /= ir; break; }
-			}
+void bli_rntm_factorize_model
+     (
+             num_t   dt,
+             dim_t   m,
+             dim_t   n,
+             dim_t   k,
+       const cntx_t* cntx,
+             rntm_t* rntm
+     )
+{
+#ifdef BLIS_ENABLE_MULTITHREADING
 
-			for ( jr = BLIS_THREAD_MAX_JR ; jr > 1 ; jr-- )
-			{
-				if ( jc % jr == 0 ) { jc /= jr; break; }
-			}
+	// The model only applies when the total number of threads, rather than
+	// the ways of parallelism, was set. Otherwise, leave the factorization
+	// (if any) to bli_rntm_factorize().
+	if ( bli_rntm_auto_factor( rntm ) && bli_rntm_auto_nt( rntm ) )
+	{
+		if ( 0 < m && 0 < n && 0 <= k )
+		{
+			if ( cntx == NULL ) cntx = bli_gks_query_cntx();
+
+			// Use only as many threads as can be kept busy.
+			const dim_t nt = bli_rntm_num_threads_model
+			(
+			  bli_rntm_num_threads( rntm ), dt, m, n, k, cntx
+			);
+
+			// Weigh the m and n dimensions by the number of microtiles
+			// rather than by the number of rows and columns, since threads
+			// in the ic and jc loops are assigned whole micropanels.
+			const dim_t mr = bli_cntx_get_blksz_def_dt( dt, BLIS_MR, cntx );
+			const dim_t nr = bli_cntx_get_blksz_def_dt( dt, BLIS_NR, cntx );
+
+			bli_rntm_factorize_nt( nt, ( m + mr - 1 ) / mr,
+			                           ( n + nr - 1 ) / nr, rntm );
+
+			// The ways of parallelism are now fixed, so prevent any
+			// subsequent call to bli_rntm_factorize() from overriding them.
+			bli_rntm_set_auto_factor_only( FALSE, rntm );
 		}
-
-		// Save the results back in the rntm_t object.
-		bli_rntm_set_num_threads_only( nt, rntm );
-		bli_rntm_set_ways_only( jc, pc, ic, jr, ir, rntm );
 	}
 
 #else
@@ -429,10 +522,12 @@ void bli_rntm_factorize
 
 void bli_rntm_factorize_sup
      (
-       dim_t   m,
-       dim_t   n,
-       dim_t   k,
-       rntm_t* rntm
+             num_t   dt,
+             dim_t   m,
+             dim_t   n,
+             dim_t   k,
+       const cntx_t* cntx,
+             rntm_t* rntm
      )
 {
 #ifdef BLIS_ENABLE_MULTITHREADING
@@ -450,6 +545,10 @@ void bli_rntm_factorize_sup
 
 		if ( 0 < m && 0 < n && 0 <= k )
 		{
+			// Use only as many threads as can be kept busy, if allowed.
+			if ( bli_rntm_auto_nt( rntm ) )
+				nt = bli_rntm_num_threads_model( nt, dt, m, n, k, cntx );
+
 			#ifdef BLIS_DISABLE_AUTO_PRIME_NUM_THREADS
 			// If use of prime numbers is disallowed for automatic thread
 			// factorizations, we first check if the number of threads requested
@@ -485,8 +584,12 @@ void bli_rntm_print
      )
 {
 	timpl_t ti = bli_rntm_thread_impl( rntm );
+	wpol_t  wp = bli_rntm_wait_policy( rntm );
+	aff_t   ay = bli_rntm_affinity( rntm );
+	jrir_t  js = bli_rntm_jrir_sched( rntm );
 
 	dim_t   af = bli_rntm_auto_factor( rntm );
+	dim_t   an = bli_rntm_auto_nt( rntm );
 
 	dim_t   nt = bli_rntm_num_threads( rntm );
 
@@ -497,6 +600,10 @@ void bli_rntm_print
 	dim_t   ir = bli_rntm_ir_ways( rntm );
 
 	printf( "thread impl: %d\n", ti );
+	printf( "wait policy: %d\n", wp );
+	printf( "affinity:    %d\n", ay );
+	printf( "jr/ir sched: %d\n", js );
+	printf( "auto nt:     %d\n", (int)an );
 	printf( "rntm contents    nt  jc  pc  ic  jr  ir\n" );
 	printf( "autofac? %1d | %4d%4d%4d%4d%4d%4d\n", (int)af,
 	                                               (int)nt, (int)jc, (int)pc,
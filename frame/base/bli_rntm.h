@@ -44,14 +44,25 @@
 typedef struct rntm_s
 {
 	timpl_t   thread_impl;
+	wpol_t    wait_policy;
+
+	aff_t     affinity;
+	const int* affinity_list;
+	dim_t     affinity_list_len;
+
+	jrir_t    jrir_sched;
 
 	dim_t     num_threads;
 	dim_t     thrloop[ BLIS_NUM_LOOPS ];
 
 	bool      auto_factor;
+	bool      auto_nt;
 	bool      pack_a;
 	bool      pack_b;
 	bool      l3_sup;
+
+	void*     wspace_buf;
+	siz_t     wspace_size;
 } rntm_t;
 */
 
@@ -64,11 +75,41 @@ BLIS_INLINE timpl_t bli_rntm_thread_impl( const rntm_t* rntm )
 	return rntm->thread_impl;
 }
 
+BLIS_INLINE wpol_t bli_rntm_wait_policy( const rntm_t* rntm )
+{
+	return rntm->wait_policy;
+}
+
+BLIS_INLINE aff_t bli_rntm_affinity( const rntm_t* rntm )
+{
+	return rntm->affinity;
+}
+
+BLIS_INLINE const int* bli_rntm_affinity_list( const rntm_t* rntm )
+{
+	return rntm->affinity_list;
+}
+
+BLIS_INLINE dim_t bli_rntm_affinity_list_len( const rntm_t* rntm )
+{
+	return rntm->affinity_list_len;
+}
+
+BLIS_INLINE jrir_t bli_rntm_jrir_sched( const rntm_t* rntm )
+{
+	return rntm->jrir_sched;
+}
+
 BLIS_INLINE bool bli_rntm_auto_factor( const rntm_t* rntm )
 {
 	return rntm->auto_factor;
 }
 
+BLIS_INLINE bool bli_rntm_auto_nt( const rntm_t* rntm )
+{
+	return rntm->auto_nt;
+}
+
 BLIS_INLINE dim_t bli_rntm_num_threads( const rntm_t* rntm )
 {
 	return rntm->num_threads;
@@ -118,6 +159,20 @@ BLIS_INLINE bool bli_rntm_l3_sup( const rntm_t* rntm )
 	return rntm->l3_sup;
 }
 
+BLIS_INLINE void* bli_rntm_workspace_buf( const rntm_t* rntm )
+{
+	return rntm->wspace_buf;
+}
+BLIS_INLINE siz_t bli_rntm_workspace_size( const rntm_t* rntm )
+{
+	return rntm->wspace_size;
+}
+
+BLIS_INLINE const postops_t* bli_rntm_postops( const rntm_t* rntm )
+{
+	return rntm->postops;
+}
+
 //
 // -- rntm_t modification (internal use only) ----------------------------------
 //
@@ -127,11 +182,37 @@ BLIS_INLINE void bli_rntm_set_thread_impl_only( timpl_t thread_impl, rntm_t* rnt
 	rntm->thread_impl = thread_impl;
 }
 
+BLIS_INLINE void bli_rntm_set_wait_policy_only( wpol_t wait_policy, rntm_t* rntm )
+{
+	rntm->wait_policy = wait_policy;
+}
+
+BLIS_INLINE void bli_rntm_set_affinity_only( aff_t affinity, rntm_t* rntm )
+{
+	rntm->affinity = affinity;
+}
+
+BLIS_INLINE void bli_rntm_set_affinity_list_only( dim_t n, const int* cpus, rntm_t* rntm )
+{
+	rntm->affinity_list     = cpus;
+	rntm->affinity_list_len = n;
+}
+
+BLIS_INLINE void bli_rntm_set_jrir_sched_only( jrir_t jrir_sched, rntm_t* rntm )
+{
+	rntm->jrir_sched = jrir_sched;
+}
+
 BLIS_INLINE void bli_rntm_set_auto_factor_only( bool auto_factor, rntm_t* rntm )
 {
 	rntm->auto_factor = auto_factor;
 }
 
+BLIS_INLINE void bli_rntm_set_auto_nt_only( bool auto_nt, rntm_t* rntm )
+{
+	rntm->auto_nt = auto_nt;
+}
+
 BLIS_INLINE void bli_rntm_set_num_threads_only( dim_t nt, rntm_t* rntm )
 {
 	rntm->num_threads = nt;
@@ -197,6 +278,33 @@ BLIS_INLINE void bli_rntm_set_thread_impl( timpl_t thread_impl, rntm_t* rntm )
 	bli_rntm_set_thread_impl_only( thread_impl, rntm );
 }
 
+BLIS_INLINE void bli_rntm_set_wait_policy( wpol_t wait_policy, rntm_t* rntm )
+{
+	// Set the policy used by threads waiting at barriers.
+	bli_rntm_set_wait_policy_only( wait_policy, rntm );
+}
+
+BLIS_INLINE void bli_rntm_set_affinity( aff_t affinity, rntm_t* rntm )
+{
+	// Set the policy used to pin threads to processors.
+	bli_rntm_set_affinity_only( affinity, rntm );
+}
+
+BLIS_INLINE void bli_rntm_set_affinity_list( dim_t n, const int* cpus, rntm_t* rntm )
+{
+	// Pin thread i to processor cpus[ i % n ]. NOTE: The rntm_t only refers
+	// to the array, so it must remain valid for as long as the rntm_t is
+	// used.
+	bli_rntm_set_affinity_only( BLIS_AFFINITY_LIST, rntm );
+	bli_rntm_set_affinity_list_only( n, cpus, rntm );
+}
+
+BLIS_INLINE void bli_rntm_set_jrir_sched( jrir_t jrir_sched, rntm_t* rntm )
+{
+	// Set how the microtiles of the macro-kernel are divided among threads.
+	bli_rntm_set_jrir_sched_only( jrir_sched, rntm );
+}
+
 BLIS_INLINE void bli_rntm_set_pack_a( bool pack_a, rntm_t* rntm )
 {
 	// Set the bool indicating whether matrix A should be packed.
@@ -208,6 +316,15 @@ BLIS_INLINE void bli_rntm_set_pack_b( bool pack_b, rntm_t* rntm )
 	rntm->pack_b = pack_b;
 }
 
+BLIS_INLINE void bli_rntm_set_auto_nt( bool auto_nt, rntm_t* rntm )
+{
+	// Set the bool indicating whether automatic factorization may use fewer
+	// threads than requested when the problem is too small to keep all of
+	// them busy. (This only applies when the total number of threads, rather
+	// than the ways of parallelism, was set.)
+	bli_rntm_set_auto_nt_only( auto_nt, rntm );
+}
+
 BLIS_INLINE void bli_rntm_set_l3_sup( bool l3_sup, rntm_t* rntm )
 {
 	// Set the bool indicating whether level-3 sup handling is enabled.
@@ -222,6 +339,26 @@ BLIS_INLINE void bli_rntm_disable_l3_sup( rntm_t* rntm )
 	bli_rntm_set_l3_sup( FALSE, rntm );
 }
 
+BLIS_INLINE void bli_rntm_set_workspace( void* buf, siz_t size, rntm_t* rntm )
+{
+	// Set the workspace from which level-3 operations carve their packing
+	// buffers and internal data structures instead of allocating them. See
+	// bli_l3_workspace_size() for how large it should be. NOTE: The rntm_t
+	// only refers to the buffer, which may not be used by more than one
+	// operation at a time.
+	rntm->wspace_buf  = buf;
+	rntm->wspace_size = size;
+}
+
+BLIS_INLINE void bli_rntm_set_postops( const postops_t* postops, rntm_t* rntm )
+{
+	// Set the post-ops that gemm applies to each microtile of C once it
+	// holds the final value of alpha * A * B + beta * C. NOTE: The rntm_t
+	// only refers to the postops_t, which must remain valid (and unmodified)
+	// for as long as the rntm_t is used.
+	rntm->postops = postops;
+}
+
 //
 // -- rntm_t modification (internal use only) ----------------------------------
 //
@@ -231,10 +368,30 @@ BLIS_INLINE void bli_rntm_clear_thread_impl( rntm_t* rntm )
 	bli_rntm_set_thread_impl_only( BLIS_SINGLE, rntm );
 }
 
+BLIS_INLINE void bli_rntm_clear_wait_policy( rntm_t* rntm )
+{
+	bli_rntm_set_wait_policy_only( BLIS_WAIT_POLICY_DEFAULT, rntm );
+}
+
+BLIS_INLINE void bli_rntm_clear_affinity( rntm_t* rntm )
+{
+	bli_rntm_set_affinity_only( BLIS_AFFINITY_NONE, rntm );
+	bli_rntm_set_affinity_list_only( 0, NULL, rntm );
+}
+
+BLIS_INLINE void bli_rntm_clear_jrir_sched( rntm_t* rntm )
+{
+	bli_rntm_set_jrir_sched_only( BLIS_JRIR_STATIC, rntm );
+}
+
 BLIS_INLINE void bli_rntm_clear_auto_factor( rntm_t* rntm )
 {
 	bli_rntm_set_auto_factor_only( FALSE, rntm );
 }
+BLIS_INLINE void bli_rntm_clear_auto_nt( rntm_t* rntm )
+{
+	bli_rntm_set_auto_nt_only( TRUE, rntm );
+}
 BLIS_INLINE void bli_rntm_clear_pack_a( rntm_t* rntm )
 {
 	bli_rntm_set_pack_a( FALSE, rntm );
@@ -247,6 +404,14 @@ BLIS_INLINE void bli_rntm_clear_l3_sup( rntm_t* rntm )
 {
 	bli_rntm_set_l3_sup( TRUE, rntm );
 }
+BLIS_INLINE void bli_rntm_clear_workspace( rntm_t* rntm )
+{
+	bli_rntm_set_workspace( NULL, 0, rntm );
+}
+BLIS_INLINE void bli_rntm_clear_postops( rntm_t* rntm )
+{
+	bli_rntm_set_postops( NULL, rntm );
+}
 
 //
 // -- rntm_t initialization ----------------------------------------------------
@@ -259,25 +424,40 @@ BLIS_INLINE void bli_rntm_clear_l3_sup( rntm_t* rntm )
 #define BLIS_RNTM_INITIALIZER \
         { \
           .thread_impl = BLIS_SINGLE, \
+          .wait_policy = BLIS_WAIT_POLICY_DEFAULT, \
+          .affinity    = BLIS_AFFINITY_NONE, \
+          .affinity_list     = NULL, \
+          .affinity_list_len = 0, \
+          .jrir_sched  = BLIS_JRIR_STATIC, \
           .num_threads = 1, \
           .thrloop     = { 1, 1, 1, 1, 1, 1 }, \
           .auto_factor = FALSE, \
+          .auto_nt     = TRUE, \
           .pack_a      = FALSE, \
           .pack_b      = FALSE, \
           .l3_sup      = TRUE, \
+          .wspace_buf  = NULL, \
+          .wspace_size = 0, \
+          .postops     = NULL, \
         }  \
 
 BLIS_INLINE void bli_rntm_init( rntm_t* rntm )
 {
 	bli_rntm_clear_thread_impl( rntm );
+	bli_rntm_clear_wait_policy( rntm );
+	bli_rntm_clear_affinity( rntm );
+	bli_rntm_clear_jrir_sched( rntm );
 
 	bli_rntm_clear_num_threads_only( rntm );
 	bli_rntm_clear_ways_only( rntm );
 
 	bli_rntm_clear_auto_factor( rntm );
+	bli_rntm_clear_auto_nt( rntm );
 	bli_rntm_clear_pack_a( rntm );
 	bli_rntm_clear_pack_b( rntm );
 	bli_rntm_clear_l3_sup( rntm );
+	bli_rntm_clear_workspace( rntm );
+	bli_rntm_clear_postops( rntm );
 }
 
 //
@@ -345,12 +525,24 @@ void bli_rntm_factorize
        rntm_t* rntm
      );
 
+void bli_rntm_factorize_model
+     (
+             num_t   dt,
+             dim_t   m,
+             dim_t   n,
+             dim_t   k,
+       const cntx_t* cntx,
+             rntm_t* rntm
+     );
+
 void bli_rntm_factorize_sup
      (
-       dim_t   m,
-       dim_t   n,
-       dim_t   k,
-       rntm_t* rntm
+             num_t   dt,
+             dim_t   m,
+             dim_t   n,
+             dim_t   k,
+       const cntx_t* cntx,
+             rntm_t* rntm
      );
 
 void bli_rntm_print
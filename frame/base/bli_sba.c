@@ -95,6 +95,16 @@ void* bli_sba_acquire
 			bli_abort();
 		}
 
+		// The pools carved from a caller-supplied workspace have no means
+		// of allocating (or freeing) blocks, and so they cannot grow.
+		if ( bli_pool_is_exhausted( pool ) &&
+		     bli_pool_malloc_fp( pool ) == NULL )
+		{
+			printf( "bli_sba_acquire(): ** workspace pool of %d blocks is exhausted.\n",
+			        ( int )bli_pool_num_blocks( pool ) );
+			bli_abort();
+		}
+
 		// Check out a block using the block_size queried above.
 		bli_pool_checkout_block( block_size, &pblk, pool );
 
@@ -218,6 +218,24 @@ void PASTEF77(ch,blasname) \
 		); \
 		return; \
 	} \
+\
+	/* Compute tiny problems directly with the sup millikernels, without
+	   building objects. */ \
+	if ( PASTEMAC2(ch,blisname,_tiny) \
+	     ( \
+	       blis_transa, blis_transb, m0, n0, k0, \
+	       ( ftype* )alpha, \
+	       ( ftype* )a, rs_a, cs_a, \
+	       ( ftype* )b, rs_b, cs_b, \
+	       ( ftype* )beta, \
+	                 c, rs_c, cs_c, \
+	       NULL, NULL \
+	     ) == BLIS_SUCCESS ) \
+	{ \
+		/* Finalize BLIS. */ \
+		bli_finalize_auto(); \
+		return; \
+	} \
 \
 	const num_t dt     = PASTEMAC(ch,type); \
 \
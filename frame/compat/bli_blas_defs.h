@@ -181,6 +181,7 @@
 // batch
 
 #include "bla_gemm_batch.h"
+#include "bla_gemm_batch_strided.h"
 
 // 3m
 
@@ -214,6 +214,10 @@
 #define F77_dgemm_batch  dgemm_batch_
 #define F77_cgemm_batch  cgemm_batch_
 #define F77_zgemm_batch  zgemm_batch_
+#define F77_sgemm_batch_strided  sgemm_batch_strided_
+#define F77_dgemm_batch_strided  dgemm_batch_strided_
+#define F77_cgemm_batch_strided  cgemm_batch_strided_
+#define F77_zgemm_batch_strided  zgemm_batch_strided_
 
 #define F77_cgemm3m    cgemm3m_
 #define F77_zgemm3m    zgemm3m_
@@ -39,7 +39,9 @@
 // Define BLAS-to-BLIS interfaces.
 //
 
-#ifdef BLIS_BLAS3_CALLS_TAPI
+// The groups are handed to bli_gemm_batch_ex(), which computes all of their
+// members within a single parallel region rather than parallelizing each
+// member in turn.
 
 #undef  GENTFUNC
 #define GENTFUNC( ftype, ch, blasname, blisname ) \
@@ -74,115 +76,35 @@ void PASTEF77(ch,blasname) \
 		( \
 		  MKSTR(ch), \
 		  MKSTR(blisname), \
-		  transa_array+gi, \
-		  transb_array+gi, \
-		  m_array+gi, \
-		  n_array+gi, \
-		  k_array+gi, \
-		  lda_array+gi, \
-		  ldb_array+gi, \
-		  ldc_array+gi \
+		  &transa_array[gi], \
+		  &transb_array[gi], \
+		  &m_array[gi], \
+		  &n_array[gi], \
+		  &k_array[gi], \
+		  &lda_array[gi], \
+		  &ldb_array[gi], \
+		  &ldc_array[gi] \
 		); \
 	} \
 \
-	f77_int idx = 0; \
-\
-	for ( f77_int i = 0; i < *group_count; i++ ) \
+	if ( *group_count <= 0 ) \
 	{ \
-		/* Map BLAS chars to their corresponding BLIS enumerated type value. */ \
-		bli_param_map_netlib_to_blis_trans( transa_array[i], &blis_transa ); \
-		bli_param_map_netlib_to_blis_trans( transb_array[i], &blis_transb ); \
-\
-		/* Typecast BLAS integers to BLIS integers. */ \
-		bli_convert_blas_dim1( m_array[i], m0 ); \
-		bli_convert_blas_dim1( n_array[i], n0 ); \
-		bli_convert_blas_dim1( k_array[i], k0 ); \
-\
-		/* Set the row and column strides of the matrix operands. */ \
-		const inc_t rs_a = 1; \
-		const inc_t cs_a = lda_array[i]; \
-		const inc_t rs_b = 1; \
-		const inc_t cs_b = ldb_array[i]; \
-		const inc_t rs_c = 1; \
-		const inc_t cs_c = ldc_array[i]; \
-\
-		for ( f77_int j = 0; j < group_size[i]; j++ ) \
-		{ \
-			/* Call BLIS interface. */ \
-			PASTEMAC2(ch,blisname,BLIS_TAPI_EX_SUF) \
-			( \
-			  blis_transa, \
-			  blis_transb, \
-			  m0, \
-			  n0, \
-			  k0, \
-			  (ftype*)(alpha_array + i), \
-			  (ftype*)*(a_array + idx), rs_a, cs_a, \
-			  (ftype*)*(b_array + idx), rs_b, cs_b, \
-			  (ftype*)(beta_array + i), \
-			  (ftype*)*(c_array + idx), rs_c, cs_c, \
-			  NULL, \
-			  NULL  \
-			); \
-\
-			idx++; \
-		} \
+		/* Finalize BLIS. */ \
+		bli_finalize_auto(); \
+		return; \
 	} \
 \
-	bli_finalize_auto(); \
-}
-
-#else
-
-#undef  GENTFUNC
-#define GENTFUNC( ftype, ch, blasname, blisname ) \
+	const num_t dt     = PASTEMAC(ch,type); \
 \
-void PASTEF77(ch,blasname) \
-     ( \
-       const f77_char* transa_array, \
-       const f77_char* transb_array, \
-       const f77_int*  m_array, \
-       const f77_int*  n_array, \
-       const f77_int*  k_array, \
-       const ftype*    alpha_array, \
-       const ftype**   a_array, const f77_int* lda_array, \
-       const ftype**   b_array, const f77_int* ldb_array, \
-       const ftype*    beta_array, \
-             ftype**   c_array, const f77_int* ldc_array, \
-       const f77_int* group_count, \
-       const f77_int* group_size ) \
-{ \
-	trans_t blis_transa; \
-	trans_t blis_transb; \
-	dim_t   m0, n0, k0; \
+	err_t               r_val; \
+	gemm_batch_group_t* groups = bli_malloc_intl( *group_count * sizeof( gemm_batch_group_t ), &r_val ); \
 \
-	/* Initialize BLIS. */ \
-	bli_init_auto(); \
+	f77_int idx = 0; \
 \
-	/* Perform BLAS parameter checking. */ \
-	for ( f77_int gi = 0; gi < *group_count; gi++ ) \
+	for ( f77_int i = 0; i < *group_count; i++ ) \
 	{ \
-		PASTEBLACHK(blisname) \
-		( \
-		  MKSTR(ch), \
-		  MKSTR(blisname), \
-		  transa_array+gi, \
-		  transb_array+gi, \
-		  m_array+gi, \
-		  n_array+gi, \
-		  k_array+gi, \
-		  lda_array+gi, \
-		  ldb_array+gi, \
-		  ldc_array+gi \
-		); \
-	} \
-\
-	const num_t dt     = PASTEMAC(ch,type); \
+		gemm_batch_group_t* group = &groups[ i ]; \
 \
-	f77_int idx = 0, i, j; \
-\
-	for ( i = 0; i < *group_count; i++ ) \
-	{ \
 		/* Map BLAS chars to their corresponding BLIS enumerated type value. */ \
 		bli_param_map_netlib_to_blis_trans( transa_array[i], &blis_transa ); \
 		bli_param_map_netlib_to_blis_trans( transb_array[i], &blis_transb ); \
@@ -199,52 +121,54 @@ void PASTEF77(ch,blasname) \
 		const inc_t cs_b = ldb_array[i]; \
 		const inc_t rs_c = 1; \
 		const inc_t cs_c = ldc_array[i]; \
-\
-		obj_t       alphao = BLIS_OBJECT_INITIALIZER_1X1; \
-		obj_t       betao  = BLIS_OBJECT_INITIALIZER_1X1; \
 \
 		dim_t       m0_a, n0_a; \
 		dim_t       m0_b, n0_b; \
 \
 		bli_set_dims_with_trans( blis_transa, m0, k0, &m0_a, &n0_a ); \
 		bli_set_dims_with_trans( blis_transb, k0, n0, &m0_b, &n0_b ); \
+\
+		obj_t       alphao = BLIS_OBJECT_INITIALIZER_1X1; \
+		obj_t       betao  = BLIS_OBJECT_INITIALIZER_1X1; \
+		obj_t       ao     = BLIS_OBJECT_INITIALIZER; \
+		obj_t       bo     = BLIS_OBJECT_INITIALIZER; \
+		obj_t       co     = BLIS_OBJECT_INITIALIZER; \
 \
 		bli_obj_init_finish_1x1( dt, (ftype*)(alpha_array + i), &alphao ); \
 		bli_obj_init_finish_1x1( dt, (ftype*)(beta_array  + i),  &betao ); \
 \
-		for( j = 0; j < group_size[i]; j++ ) \
-		{ \
-			obj_t       ao     = BLIS_OBJECT_INITIALIZER; \
-			obj_t       bo     = BLIS_OBJECT_INITIALIZER; \
-			obj_t       co     = BLIS_OBJECT_INITIALIZER; \
-\
-			bli_obj_init_finish( dt, m0_a, n0_a, (ftype*)*(a_array + idx), rs_a, cs_a, &ao ); \
-			bli_obj_init_finish( dt, m0_b, n0_b, (ftype*)*(b_array + idx), rs_b, cs_b, &bo ); \
-			bli_obj_init_finish( dt, m0,   n0,   (ftype*)*(c_array + idx), rs_c, cs_c, &co ); \
-			bli_obj_set_conjtrans( blis_transa, &ao ); \
-			bli_obj_set_conjtrans( blis_transb, &bo ); \
-\
-			PASTEMAC(blisname,BLIS_OAPI_EX_SUF) \
-			( \
-			  &alphao, \
-			  &ao, \
-			  &bo, \
-			  &betao, \
-			  &co, \
-			  NULL, \
-			  NULL  \
-			); \
-\
-			idx++; \
-		} \
+		/* The operands' buffers are given per member, below. */ \
+		bli_obj_init_finish( dt, m0_a, n0_a, NULL, rs_a, cs_a, &ao ); \
+		bli_obj_init_finish( dt, m0_b, n0_b, NULL, rs_b, cs_b, &bo ); \
+		bli_obj_init_finish( dt, m0,   n0,   NULL, rs_c, cs_c, &co ); \
+		bli_obj_set_conjtrans( blis_transa, &ao ); \
+		bli_obj_set_conjtrans( blis_transb, &bo ); \
+\
+		group->alpha = alphao; \
+		group->beta  = betao; \
+		group->a     = ao; \
+		group->b     = bo; \
+		group->c     = co; \
+\
+		group->size  = group_size[i]; \
+		group->buf_a = (const void* const*)(a_array + idx); \
+		group->buf_b = (const void* const*)(b_array + idx); \
+		group->buf_c = (      void* const*)(c_array + idx); \
+		group->str_a = 0; \
+		group->str_b = 0; \
+		group->str_c = 0; \
+\
+		idx += group_size[i]; \
 	} \
+\
+	bli_gemm_batch_ex( *group_count, groups, NULL, NULL ); \
+\
+	bli_free_intl( groups ); \
 \
 	/* Finalize BLIS. */  \
 	bli_finalize_auto(); \
 }
 
-#endif
-
 #ifdef BLIS_ENABLE_BLAS
 INSERT_GENTFUNC_BLAS( gemm_batch, gemm )
 #endif
@@ -79,10 +79,7 @@
 
 // -- MEMORY SUBSYSTEM PROPERTIES ----------------------------------------------
 
-// Size of a cache line (in bytes).
-#ifndef BLIS_CACHE_LINE_SIZE
-#define BLIS_CACHE_LINE_SIZE 64
-#endif
+#include "bli_mem_macro_defs.h"
 
 
 // -- MULTITHREADING -----------------------------------------------------------
@@ -149,6 +146,26 @@
   #define BLIS_NT_MAX_PRIME 11
 #endif
 
+// Set the policy used by threads waiting at a barrier when the application
+// has not requested one: BLIS_WAIT_ACTIVE (spin), BLIS_WAIT_PASSIVE (sleep),
+// or BLIS_WAIT_HYBRID (spin for a while, then sleep).
+#ifndef BLIS_WAIT_POLICY_DEFAULT
+  #define BLIS_WAIT_POLICY_DEFAULT BLIS_WAIT_HYBRID
+#endif
+
+// Set the number of spin iterations (each including a pause instruction, on
+// architectures that have one) that a thread performs under the hybrid wait
+// policy before going to sleep.
+#ifndef BLIS_WAIT_SPIN_COUNT
+  #define BLIS_WAIT_SPIN_COUNT 4000
+#endif
+
+// Set the maximum length of the global list of processors to which threads
+// are pinned under the BLIS_AFFINITY_LIST policy.
+#ifndef BLIS_AFFINITY_LIST_LEN_MAX
+  #define BLIS_AFFINITY_LIST_LEN_MAX 1024
+#endif
+
 
 // -- MIXED DATATYPE SUPPORT ---------------------------------------------------
 
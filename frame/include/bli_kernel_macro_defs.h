@@ -63,6 +63,20 @@
 #define BLIS_THREAD_MAX_JR      4
 #endif
 
+// BLIS_THREAD_MIN_UT_K is the least amount of work, measured in rank-1
+// updates of an MR x NR microtile, that each thread must receive in order
+// for it to be used when the number of threads is chosen automatically.
+// See bli_rntm.c to see how this macro is used.
+#ifndef BLIS_THREAD_MIN_UT_K
+#define BLIS_THREAD_MIN_UT_K    16384
+#endif
+
+// The maximum number of threads (or child nodes) that share a node of the
+// tree barrier, when it is enabled. See bli_thrcomm.c.
+#ifndef BLIS_TREE_BARRIER_ARITY
+#define BLIS_TREE_BARRIER_ARITY 4
+#endif
+
 #if 0
 // -- Skinny/small possibly-unpacked (sup code path) values --
 
@@ -229,6 +243,42 @@
 #define BLIS_POOL_ADDR_ALIGN_SIZE_GEN    BLIS_PAGE_SIZE
 #endif
 
+// The maximum number of blocks retained by each of the packing block
+// allocator's pools (zero means unbounded), and the number of times a pool
+// must become idle before it is trimmed down to its high-water mark (zero
+// means never). These may be overridden via environment variables of the
+// same names.
+#ifndef BLIS_POOL_MAX_BLOCKS
+#define BLIS_POOL_MAX_BLOCKS             0
+#endif
+
+#ifndef BLIS_POOL_TRIM_PERIOD
+#define BLIS_POOL_TRIM_PERIOD            0
+#endif
+
+// The number of slots in each of the packing block allocator's lock-free
+// caches of released blocks, which sit in front of the pools. Each thread
+// uses one slot per pool, so this should be at least the number of threads
+// that call BLIS concurrently. Zero disables the caches. This may be
+// overridden via an environment variable of the same name.
+#ifndef BLIS_PBA_CACHE_SLOTS
+#define BLIS_PBA_CACHE_SLOTS             32
+#endif
+
+// The number of small blocks (for control tree, thrinfo_t, and thrcomm_t
+// nodes) reserved per thread in a caller-supplied level-3 workspace.
+#ifndef BLIS_WSPACE_SBA_BLOCKS
+#define BLIS_WSPACE_SBA_BLOCKS           64
+#endif
+
+// Whether to derive the cache blocksizes (MC, KC, and NC) of the native
+// context from the cache hierarchy detected at runtime rather than use the
+// values registered by the configuration. This may be overridden via the
+// BLIS_CACHE_BLKSZ environment variable.
+#ifndef BLIS_CACHE_BLKSZ_DEFAULT
+#define BLIS_CACHE_BLKSZ_DEFAULT         0
+#endif
+
 // Offsets from alignment specified by BLIS_POOL_ADDR_ALIGN_SIZE_*.
 #ifndef BLIS_POOL_ADDR_OFFSET_SIZE_A
 #define BLIS_POOL_ADDR_OFFSET_SIZE_A     0
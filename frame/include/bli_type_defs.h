@@ -583,6 +583,44 @@ typedef enum
 } mdim_t;
 
 
+// -- Post-op types --
+
+typedef enum
+{
+	BLIS_POSTOP_BIAS = 0,  // c(i,j) += v(i) or v(j)
+	BLIS_POSTOP_SCALE,     // c(i,j) *= v(i) or v(j)
+	BLIS_POSTOP_RELU,      // c(i,j)  = max( c(i,j), 0 )
+	BLIS_POSTOP_GELU_TANH, // GELU, tanh approximation
+	BLIS_POSTOP_GELU_ERF,  // GELU, exact (erf) form
+	BLIS_POSTOP_CLIP       // c(i,j)  = min( max( c(i,j), lo ), hi )
+} postop_t;
+
+#define BLIS_POSTOPS_MAX 8
+
+typedef struct
+{
+	postop_t    op;
+
+	// The vector operand of a bias or scale post-op, which is indexed by
+	// the row (BLIS_M) or column (BLIS_N) index of C.
+	mdim_t      dim;
+	num_t       dt_v;
+	dim_t       n_v;
+	const void* v;
+	inc_t       incv;
+
+	// The bounds of a clip post-op.
+	double      lo;
+	double      hi;
+} postop_desc_t;
+
+typedef struct postops_s
+{
+	dim_t         n_ops;
+	postop_desc_t ops[ BLIS_POSTOPS_MAX ];
+} postops_t;
+
+
 // -- Machine parameter types --
 
 typedef enum
@@ -638,6 +676,89 @@ typedef enum
 } timpl_t;
 
 
+// -- Thread wait policy type --
+
+typedef enum
+{
+	// Spin until the condition being waited on is satisfied.
+	BLIS_WAIT_ACTIVE = 0,
+
+	// Sleep until woken by the thread that satisfies the condition.
+	BLIS_WAIT_PASSIVE,
+
+	// Spin for a bounded number of iterations, then sleep.
+	BLIS_WAIT_HYBRID,
+
+	// BLIS_NUM_WAIT_POLICIES must be last!
+	BLIS_NUM_WAIT_POLICIES
+
+} wpol_t;
+
+
+// -- Thread affinity type --
+
+typedef enum
+{
+	// Leave the placement of threads to the operating system.
+	BLIS_AFFINITY_NONE = 0,
+
+	// Pin consecutive threads to processors that are adjacent in the cache
+	// topology, so that the threads sharing a packed block share a cache.
+	BLIS_AFFINITY_COMPACT,
+
+	// Spread the JC groups of threads evenly across the processors, keeping
+	// the threads of each group within one region of the cache topology.
+	BLIS_AFFINITY_SCATTER,
+
+	// Pin thread i to the ith processor of a caller-supplied list.
+	BLIS_AFFINITY_LIST,
+
+	// BLIS_NUM_AFFINITIES must be last!
+	BLIS_NUM_AFFINITIES
+
+} aff_t;
+
+
+// -- Macro-kernel loop scheduling type --
+
+typedef enum
+{
+	// Partition the microtiles among the threads before the loops begin,
+	// according to the configure-time choice of slab, round-robin, or
+	// tile-level partitioning.
+	BLIS_JRIR_STATIC = 0,
+
+	// Have threads claim microtiles one at a time from a shared counter
+	// until none remain.
+	BLIS_JRIR_DYNAMIC,
+
+	// BLIS_NUM_JRIR_SCHEDS must be last!
+	BLIS_NUM_JRIR_SCHEDS
+
+} jrir_t;
+
+
+// -- Huge page mode type --
+
+typedef enum
+{
+	// Allocate pool blocks with BLIS_MALLOC_POOL (i.e., in base pages).
+	BLIS_HUGEPAGES_NONE = 0,
+
+	// Allocate pool blocks as 2 MB-aligned anonymous mappings and ask the
+	// kernel to back them with transparent huge pages.
+	BLIS_HUGEPAGES_THP,
+
+	// Allocate pool blocks from the hugetlbfs pool of reserved huge pages,
+	// falling back to transparent huge pages if none are available.
+	BLIS_HUGEPAGES_HUGETLB,
+
+	// BLIS_NUM_HUGEPAGE_MODES must be last!
+	BLIS_NUM_HUGEPAGE_MODES
+
+} hpg_t;
+
+
 // -- Kernel ID types --
 
 typedef enum
@@ -705,6 +826,14 @@ typedef enum
 	BLIS_GEMMSUP_CCC_UKR,
 	BLIS_GEMMSUP_XXX_UKR,
 
+	// l3 post-op (epilogue) kernels
+	BLIS_POSTOPS_KER,
+
+	// l3 compact (interleaved batch) kernels
+	BLIS_GEMM_COMPACT_KER,
+	BLIS_TRSM_COMPACT_KER,
+	BLIS_GETRFNP_COMPACT_KER,
+
 	// BLIS_NUM_UKRS must be last!
 	BLIS_NUM_UKRS
 } ukr_t;
@@ -901,6 +1030,15 @@ typedef enum
 	BLIS_NT, // level-3 small/unpacked matrix threshold in n dimension
 	BLIS_KT, // level-3 small/unpacked matrix threshold in k dimension
 
+	// level-3 tiny problem threshold
+	BLIS_TT, // largest dimension computed by the tiny gemm fast path
+
+	// level-1v multithreading threshold
+	BLIS_VT, // minimum vector length assigned to each thread
+
+	// compact batch format
+	BLIS_CV, // number of batch members interleaved in one vector
+
 	// gemmsup block sizes
 	BLIS_KR_SUP,
 	BLIS_MR_SUP,
@@ -1017,6 +1155,21 @@ typedef struct
 	malloc_ft malloc_fp;
 	free_ft   free_fp;
 
+	// The trimming policy: the maximum number of blocks retained by the
+	// pool (zero means unbounded) and the number of idle periods after
+	// which the pool is trimmed down to its high-water mark (zero means
+	// never), along with the state needed to enforce it.
+	dim_t     max_blocks;
+	dim_t     trim_period;
+	dim_t     high_water;
+	dim_t     num_idle;
+
+	// Counters reported by bli_memsys_stats().
+	dim_t     num_grows;
+	dim_t     num_shrinks;
+	dim_t     num_reinits;
+	siz_t     peak_size;
+
 } pool_t;
 
 
@@ -1044,13 +1197,89 @@ typedef struct
 } apool_t;
 
 
+// -- Memory pool statistics types --
+
+typedef struct
+{
+	// The current block size and the number of blocks allocated by the pool,
+	// and how many of those blocks are checked out.
+	siz_t        block_size;
+	dim_t        num_blocks;
+	dim_t        num_checked_out;
+
+	// The same, in bytes, along with the largest number of bytes that were
+	// ever checked out at once.
+	siz_t        size_reserved;
+	siz_t        size_checked_out;
+	siz_t        peak_size_checked_out;
+
+	// The number of times the pool allocated a block because it was
+	// exhausted, freed blocks, and was reinitialized with larger blocks.
+	dim_t        num_grows;
+	dim_t        num_shrinks;
+	dim_t        num_reinits;
+
+} pool_stats_t;
+
+typedef struct
+{
+	// The packing block allocator's pools, indexed by NUMA node and then by
+	// bli_packbuf_index() of the buffer type (A, B, and C, respectively).
+	dim_t        pba_num_nodes;
+	pool_stats_t pba[ BLIS_NUMA_NODES_MAX ][3];
+
+	// Contention on the packing block allocator's mutex: the number of
+	// acquisitions, how many of them found the mutex held by another thread,
+	// and the total time (in seconds) spent waiting in those cases.
+	dim_t        pba_num_lock_acquires;
+	dim_t        pba_num_lock_waits;
+	double       pba_lock_wait_time;
+
+	// The small block allocator: the number of arrays of per-thread pools
+	// and how many of them are checked out, along with the pools within the
+	// arrays that are not checked out, aggregated into one entry.
+	dim_t        sba_num_arrays;
+	dim_t        sba_num_checked_out;
+	pool_stats_t sba;
+
+} memsys_stats_t;
+
+
 // -- packing block allocator: Locked set of pools type --
 
+// One slot of a packing block allocator's cache of released blocks. Each
+// slot occupies its own cache line since it is updated by atomic exchange.
+typedef struct
+{
+	void*               buf;
+	char                pad[ BLIS_CACHE_LINE_SIZE - sizeof( void* ) ];
+
+} pba_slot_t;
+
 typedef struct pba_s
 {
-	pool_t              pools[3];
+	// One set of pools (for A, B, and C) per NUMA node.
+	pool_t              pools[ BLIS_NUMA_NODES_MAX ][3];
+	dim_t               n_nodes;
 	bli_pthread_mutex_t mutex;
 
+	// The kind of pages with which the blocks in the pools are backed.
+	hpg_t               hugepages;
+
+	// Statistics on contention for the mutex.
+	dim_t               num_lock_acquires;
+	dim_t               num_lock_waits;
+	double              lock_wait_time;
+
+	// Lock-free caches of released blocks, with cache_slots slots in front
+	// of each pool (or NULL if the caches are disabled).
+	dim_t               cache_slots;
+	pba_slot_t*         caches[ BLIS_NUMA_NODES_MAX ][3];
+
+	// Whether the blocks of the pools were carved from a caller-supplied
+	// workspace, in which case the pools must never allocate.
+	bool                in_wspace;
+
 	// These fields are used for general-purpose allocation.
 	siz_t               align_size;
 	malloc_ft           malloc_fp;
@@ -1431,19 +1660,53 @@ BLIS_INLINE void bli_obj_init_subpart_from( const obj_t* a, obj_t* b )
 }
 
 
+// -- Sup dispatch map type --
+
+// A calibrated record of whether the sup or the conventional implementation
+// is faster for gemm and gemmt, indexed by operation, datatype, storage
+// combination, and power-of-two buckets of the number of threads (1, 2-3,
+// 4-7, 8+) and of each of m, n, and k (<32, 32-63, ..., 1024-2047, 2048+).
+// Cells that were not calibrated hold BLIS_SUP_MAP_UNSET, in which case the
+// sup thresholds decide.
+
+#define BLIS_SUP_MAP_NUM_OPS   2 // gemm, gemmt
+#define BLIS_SUP_MAP_NUM_NT    4
+#define BLIS_SUP_MAP_NUM_DIM   8
+#define BLIS_SUP_MAP_DIM_SHIFT 4 // the first bucket ends at 1 << ( 4 + 1 )
+
+typedef enum
+{
+	BLIS_SUP_MAP_UNSET = 0,
+	BLIS_SUP_MAP_SUP,
+	BLIS_SUP_MAP_CONV
+} supdec_t;
+
+typedef struct sup_map_s
+{
+	uint8_t dec[ BLIS_SUP_MAP_NUM_OPS ]
+	           [ BLIS_NUM_FP_TYPES ]
+	           [ BLIS_NUM_3OP_RC_COMBOS - 1 ]
+	           [ BLIS_SUP_MAP_NUM_NT ]
+	           [ BLIS_SUP_MAP_NUM_DIM ]
+	           [ BLIS_SUP_MAP_NUM_DIM ]
+	           [ BLIS_SUP_MAP_NUM_DIM ];
+} sup_map_t;
+
+
 // -- Context type --
 
 typedef struct cntx_s
 {
-	blksz_t   blkszs[ BLIS_NUM_BLKSZS ];
-	bszid_t   bmults[ BLIS_NUM_BLKSZS ];
+	blksz_t    blkszs[ BLIS_NUM_BLKSZS ];
+	bszid_t    bmults[ BLIS_NUM_BLKSZS ];
 
-	func_t    ukrs[ BLIS_NUM_UKRS ];
-	mbool_t   ukr_prefs[ BLIS_NUM_UKR_PREFS ];
+	func_t     ukrs[ BLIS_NUM_UKRS ];
+	mbool_t    ukr_prefs[ BLIS_NUM_UKR_PREFS ];
 
-	void_fp   l3_sup_handlers[ BLIS_NUM_LEVEL3_OPS ];
+	void_fp    l3_sup_handlers[ BLIS_NUM_LEVEL3_OPS ];
+	sup_map_t* l3_sup_map;
 
-	ind_t     method;
+	ind_t      method;
 
 } cntx_t;
 
@@ -1457,14 +1720,27 @@ typedef struct rntm_s
 {
 	// "External" fields: these may be queried by the end-user.
 	timpl_t   thread_impl;
+	wpol_t    wait_policy;
+
+	aff_t     affinity;
+	const int* affinity_list;
+	dim_t     affinity_list_len;
+
+	jrir_t    jrir_sched;
 
 	bool      auto_factor;
+	bool      auto_nt; // allow auto-factorization to use fewer threads.
 
 	dim_t     num_threads;
 	dim_t     thrloop[ BLIS_NUM_LOOPS ];
 	bool      pack_a; // enable/disable packing of left-hand matrix A.
 	bool      pack_b; // enable/disable packing of right-hand matrix B.
 	bool      l3_sup; // enable/disable small matrix handling in level-3 ops.
+
+	void*     wspace_buf;  // caller-supplied workspace for level-3 ops.
+	siz_t     wspace_size; // the size of wspace_buf, in bytes.
+
+	const postops_t* postops; // post-ops applied to C by gemm.
 } rntm_t;
 
 
@@ -1577,7 +1853,13 @@ typedef enum
 	BLIS_KC_DEF_NONMULTIPLE_OF_KR              = (-164),
 	BLIS_KC_MAX_NONMULTIPLE_OF_KR              = (-165),
 
-	BLIS_ERROR_CODE_MAX                        = (-170)
+	// Post-op errors
+	BLIS_EXHAUSTED_POSTOPS                     = (-170),
+
+	// Batch-related errors
+	BLIS_OVERLAPPING_BATCH_MEMBERS             = (-180),
+
+	BLIS_ERROR_CODE_MAX                        = (-190)
 } err_t;
 
 #endif
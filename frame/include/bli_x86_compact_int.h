@@ -0,0 +1,280 @@
+/*
+
+   BLIS
+   An object-based framework for developing high-performance BLAS-like
+   libraries.
+
+   Copyright (C) 2014, The University of Texas at Austin
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are
+   met:
+    - Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    - Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    - Neither the name(s) of the copyright holder(s) nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+// This file is included by the compact (interleaved batch) kernels of each
+// x86 subconfiguration, which first define:
+//
+//   COMPACT_VOP( op, vch )  the intrinsic for vector operation 'op' (e.g.
+//                           loadu, fmadd) on vectors with suffix 'vch' (ps
+//                           or pd),
+//   COMPACT_VTYPE_S/_D      the vector types of float and double,
+//   COMPACT_ARCH            the suffix of the kernel names.
+//
+// These kernels operate on one group of members of a batch in the compact
+// format, in which each vector register holds element (i,j) of every member
+// of the group. Thus, each vector instruction performs the same scalar
+// operation on all of the members at once, and the kernels read exactly
+// like their scalar counterparts. (See ref_kernels/3/bli_compact_ref.c.)
+
+// The block of C held in registers by the gemm kernel, in vectors.
+#define GEMM_COMPACT_MR 4
+#define GEMM_COMPACT_NR 2
+
+#undef  GENTFUNC
+#define GENTFUNC( ctype, ch, vtype, vch, opname, arch ) \
+\
+/* Update an mr x nr block of C, where mr <= GEMM_COMPACT_MR and
+   nr <= GEMM_COMPACT_NR. The kernel passes constant dimensions for full
+   blocks so that, once inlined, the block of A*B is kept in registers. */ \
+BLIS_INLINE void PASTEMAC3(ch,opname,arch,_block) \
+     ( \
+             dim_t           mr, \
+             dim_t           nr, \
+             dim_t           k, \
+             vtype           alpha, \
+       const ctype* restrict a, inc_t rs_a, inc_t cs_a, \
+       const ctype* restrict b, inc_t rs_b, inc_t cs_b, \
+             vtype           beta, \
+             bool            beta_zero, \
+             ctype* restrict c, inc_t rs_c, inc_t cs_c  \
+     ) \
+{ \
+	vtype ab[ GEMM_COMPACT_MR ][ GEMM_COMPACT_NR ]; \
+\
+	for ( dim_t i = 0; i < mr; ++i ) \
+	for ( dim_t j = 0; j < nr; ++j ) \
+		ab[ i ][ j ] = COMPACT_VOP(setzero,vch)(); \
+\
+	for ( dim_t p = 0; p < k; ++p ) \
+	{ \
+		vtype bv[ GEMM_COMPACT_NR ]; \
+\
+		for ( dim_t j = 0; j < nr; ++j ) \
+			bv[ j ] = COMPACT_VOP(loadu,vch)( b + p*rs_b + j*cs_b ); \
+\
+		for ( dim_t i = 0; i < mr; ++i ) \
+		{ \
+			const vtype av = COMPACT_VOP(loadu,vch)( a + i*rs_a + p*cs_a ); \
+\
+			for ( dim_t j = 0; j < nr; ++j ) \
+				ab[ i ][ j ] = COMPACT_VOP(fmadd,vch)( av, bv[ j ], ab[ i ][ j ] ); \
+		} \
+	} \
+\
+	for ( dim_t i = 0; i < mr; ++i ) \
+	for ( dim_t j = 0; j < nr; ++j ) \
+	{ \
+		ctype* restrict cij = c + i*rs_c + j*cs_c; \
+		vtype           cv  = COMPACT_VOP(mul,vch)( alpha, ab[ i ][ j ] ); \
+\
+		/* C is not read if beta is zero. */ \
+		if ( !beta_zero ) \
+			cv = COMPACT_VOP(fmadd,vch)( beta, COMPACT_VOP(loadu,vch)( cij ), cv ); \
+\
+		COMPACT_VOP(storeu,vch)( cij, cv ); \
+	} \
+} \
+\
+void PASTEMAC2(ch,opname,arch) \
+     ( \
+             dim_t   m, \
+             dim_t   n, \
+             dim_t   k, \
+       const void*   alpha0, \
+       const void*   a0, inc_t rs_a, inc_t cs_a, \
+       const void*   b0, inc_t rs_b, inc_t cs_b, \
+       const void*   beta0, \
+             void*   c0, inc_t rs_c, inc_t cs_c, \
+       const cntx_t* cntx  \
+     ) \
+{ \
+	const ctype* restrict a         = a0; \
+	const ctype* restrict b         = b0; \
+	      ctype* restrict c         = c0; \
+	const vtype           alpha     = COMPACT_VOP(set1,vch)( *( const ctype* )alpha0 ); \
+	const vtype           beta      = COMPACT_VOP(set1,vch)( *( const ctype* )beta0 ); \
+	const bool            beta_zero = PASTEMAC(ch,eq0)( *( const ctype* )beta0 ); \
+\
+	for ( dim_t j = 0; j < n; j += GEMM_COMPACT_NR ) \
+	for ( dim_t i = 0; i < m; i += GEMM_COMPACT_MR ) \
+	{ \
+		const dim_t          mr = bli_min( GEMM_COMPACT_MR, m - i ); \
+		const dim_t          nr = bli_min( GEMM_COMPACT_NR, n - j ); \
+		const ctype*         ai = a + i*rs_a; \
+		const ctype*         bj = b + j*cs_b; \
+		      ctype*         cij = c + i*rs_c + j*cs_c; \
+\
+		if ( mr == GEMM_COMPACT_MR && nr == GEMM_COMPACT_NR ) \
+			PASTEMAC3(ch,opname,arch,_block) \
+			( \
+			  GEMM_COMPACT_MR, GEMM_COMPACT_NR, k, alpha, \
+			  ai, rs_a, cs_a, bj, rs_b, cs_b, beta, beta_zero, cij, rs_c, cs_c \
+			); \
+		else \
+			PASTEMAC3(ch,opname,arch,_block) \
+			( \
+			  mr, nr, k, alpha, \
+			  ai, rs_a, cs_a, bj, rs_b, cs_b, beta, beta_zero, cij, rs_c, cs_c \
+			); \
+	} \
+}
+
+GENTFUNC( float,  s, COMPACT_VTYPE_S, ps, gemm_compact, COMPACT_ARCH )
+GENTFUNC( double, d, COMPACT_VTYPE_D, pd, gemm_compact, COMPACT_ARCH )
+
+
+#undef  GENTFUNC
+#define GENTFUNC( ctype, ch, vtype, vch, opname, arch ) \
+\
+void PASTEMAC2(ch,opname,arch) \
+     ( \
+             uplo_t  uploa, \
+             diag_t  diaga, \
+             dim_t   m, \
+             dim_t   n, \
+       const void*   alpha0, \
+       const void*   a0, inc_t rs_a, inc_t cs_a, \
+             void*   b0, inc_t rs_b, inc_t cs_b, \
+       const cntx_t* cntx  \
+     ) \
+{ \
+	const ctype* restrict a       = a0; \
+	      ctype* restrict b       = b0; \
+	const vtype           alpha   = COMPACT_VOP(set1,vch)( *( const ctype* )alpha0 ); \
+	const bool            lower   = bli_is_lower( uploa ); \
+	const bool            nonunit = bli_is_nonunit_diag( diaga ); \
+\
+	/* Solve A * X = alpha * B, two columns at a time (sharing each element
+	   of A that is loaded between them), overwriting B with X. */ \
+	for ( dim_t j = 0; j < n; j += 2 ) \
+	{ \
+		const bool      two = ( j + 1 < n ); \
+		ctype*          b0j = b + j*cs_b; \
+		ctype*          b1j = b0j + ( two ? cs_b : 0 ); \
+\
+		for ( dim_t ii = 0; ii < m; ++ii ) \
+		{ \
+			const dim_t i     = ( lower ? ii : m - 1 - ii ); \
+			const dim_t p_beg = ( lower ? 0  : i + 1 ); \
+			const dim_t p_end = ( lower ? i  : m     ); \
+\
+			vtype x0 = COMPACT_VOP(mul,vch)( alpha, COMPACT_VOP(loadu,vch)( b0j + i*rs_b ) ); \
+			vtype x1 = COMPACT_VOP(mul,vch)( alpha, COMPACT_VOP(loadu,vch)( b1j + i*rs_b ) ); \
+\
+			for ( dim_t p = p_beg; p < p_end; ++p ) \
+			{ \
+				const vtype av = COMPACT_VOP(loadu,vch)( a + i*rs_a + p*cs_a ); \
+\
+				x0 = COMPACT_VOP(fnmadd,vch)( av, COMPACT_VOP(loadu,vch)( b0j + p*rs_b ), x0 ); \
+				x1 = COMPACT_VOP(fnmadd,vch)( av, COMPACT_VOP(loadu,vch)( b1j + p*rs_b ), x1 ); \
+			} \
+\
+			if ( nonunit ) \
+			{ \
+				const vtype aii = COMPACT_VOP(loadu,vch)( a + i*rs_a + i*cs_a ); \
+\
+				x0 = COMPACT_VOP(div,vch)( x0, aii ); \
+				x1 = COMPACT_VOP(div,vch)( x1, aii ); \
+			} \
+\
+			/* With an odd number of columns, the last one is computed twice
+			   (from the same inputs) and stored twice, which is why b0j and
+			   b1j are not restrict-qualified. */ \
+			COMPACT_VOP(storeu,vch)( b1j + i*rs_b, x1 ); \
+			COMPACT_VOP(storeu,vch)( b0j + i*rs_b, x0 ); \
+		} \
+	} \
+}
+
+GENTFUNC( float,  s, COMPACT_VTYPE_S, ps, trsm_compact, COMPACT_ARCH )
+GENTFUNC( double, d, COMPACT_VTYPE_D, pd, trsm_compact, COMPACT_ARCH )
+
+
+#undef  GENTFUNC
+#define GENTFUNC( ctype, ch, vtype, vch, opname, arch ) \
+\
+void PASTEMAC2(ch,opname,arch) \
+     ( \
+             dim_t   m, \
+             dim_t   n, \
+             void*   a0, inc_t rs_a, inc_t cs_a, \
+       const cntx_t* cntx  \
+     ) \
+{ \
+	ctype* restrict a = a0; \
+\
+	/* Factor A = L * U without pivoting (right-looking), overwriting the
+	   strictly lower triangle of A with that of L (whose diagonal is unit)
+	   and the upper triangle of A with U. */ \
+	for ( dim_t p = 0; p < bli_min( m, n ); ++p ) \
+	{ \
+		const vtype app = COMPACT_VOP(loadu,vch)( a + p*rs_a + p*cs_a ); \
+\
+		for ( dim_t i = p + 1; i < m; ++i ) \
+		{ \
+			ctype* restrict aip = a + i*rs_a + p*cs_a; \
+\
+			COMPACT_VOP(storeu,vch) \
+			( \
+			  aip, \
+			  COMPACT_VOP(div,vch)( COMPACT_VOP(loadu,vch)( aip ), app ) \
+			); \
+		} \
+\
+		for ( dim_t j = p + 1; j < n; ++j ) \
+		{ \
+			const vtype apj = COMPACT_VOP(loadu,vch)( a + p*rs_a + j*cs_a ); \
+\
+			for ( dim_t i = p + 1; i < m; ++i ) \
+			{ \
+				ctype* restrict aij = a + i*rs_a + j*cs_a; \
+\
+				COMPACT_VOP(storeu,vch) \
+				( \
+				  aij, \
+				  COMPACT_VOP(fnmadd,vch) \
+				  ( \
+				    COMPACT_VOP(loadu,vch)( a + i*rs_a + p*cs_a ), \
+				    apj, \
+				    COMPACT_VOP(loadu,vch)( aij ) \
+				  ) \
+				); \
+			} \
+		} \
+	} \
+}
+
+GENTFUNC( float,  s, COMPACT_VTYPE_S, ps, getrfnp_compact, COMPACT_ARCH )
+GENTFUNC( double, d, COMPACT_VTYPE_D, pd, getrfnp_compact, COMPACT_ARCH )
+
@@ -86,6 +86,7 @@ extern "C" {
 #include "bli_thread_range.h"
 #include "bli_thread_range_slab_rr.h"
 #include "bli_thread_range_tlb.h"
+#include "bli_thread_range_dyn.h"
 
 #include "bli_pthread.h"
 
@@ -130,6 +131,8 @@ extern "C" {
 #include "bli_rntm.h"
 #include "bli_gks.h"
 #include "bli_ind.h"
+#include "bli_numa.h"
+#include "bli_hugepage.h"
 #include "bli_pba.h"
 #include "bli_pool.h"
 #include "bli_array.h"
@@ -0,0 +1,483 @@
+/*
+
+   BLIS
+   An object-based framework for developing high-performance BLAS-like
+   libraries.
+
+   Copyright (C) 2014, The University of Texas at Austin
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are
+   met:
+    - Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    - Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    - Neither the name of The University of Texas nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+// Define _GNU_SOURCE so that the CPU_* macros and sched_setaffinity() are
+// declared.
+#ifdef __linux__
+  #ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+  #endif
+#endif
+
+#include "blis.h"
+
+#ifdef BLIS_OS_LINUX
+  #include <sched.h>
+#endif
+
+// -- Processor topology -------------------------------------------------------
+
+// The processors on which the process may run, sorted so that processors
+// sharing an L3 cache are adjacent and, within an L3 domain, so that the
+// first hardware thread of every core comes before the second hardware
+// thread of any core (and so forth). Consecutive entries thus share as much
+// of the cache hierarchy as possible without doubling up on cores.
+static int*  cpu_order   = NULL;
+static dim_t cpu_order_n = 0;
+
+// For each entry of cpu_order, the range [begin,end) of entries sharing its
+// L3 cache (or package).
+static int*  cpu_l3_begin = NULL;
+static int*  cpu_l3_end   = NULL;
+
+static bli_pthread_once_t cpu_order_once = BLIS_PTHREAD_ONCE_INIT;
+
+#ifdef BLIS_OS_LINUX
+
+// The processors on which the process could run when the topology was
+// queried. Threads that are no longer meant to be pinned are restored to it.
+static cpu_set_t cpu_allowed;
+
+// Sort keys for each processor.
+typedef struct
+{
+	int cpu;
+	int l3;  // The first processor sharing the L3 cache (or package).
+	int smt; // The index of the processor among its core's hardware threads.
+	int l2;  // The first processor sharing the L2 cache (or core).
+} cpu_key_t;
+
+// Read the first line of a sysfs file into buf. Return FALSE on failure.
+static bool bli_affinity_read_sysfs( const char* path, char* buf, int len )
+{
+	FILE* fp = fopen( path, "r" );
+
+	if ( fp == NULL ) return FALSE;
+
+	bool r_val = ( fgets( buf, len, fp ) != NULL );
+
+	fclose( fp );
+
+	return r_val;
+}
+
+// Return the first processor in a sysfs processor list, or -1.
+static int bli_affinity_sysfs_first( const char* path )
+{
+	char buf[ 4096 ];
+	int  cpu;
+
+	if ( !bli_affinity_read_sysfs( path, buf, sizeof( buf ) ) ) return -1;
+
+	if ( bli_affinity_parse_list( buf, 1, &cpu ) < 1 ) return -1;
+
+	return cpu;
+}
+
+// Return the position of cpu within a sysfs processor list, or 0.
+static int bli_affinity_sysfs_index( const char* path, int cpu )
+{
+	char buf[ 4096 ];
+	int  cpus[ 64 ];
+
+	if ( !bli_affinity_read_sysfs( path, buf, sizeof( buf ) ) ) return 0;
+
+	const dim_t n = bli_affinity_parse_list( buf, 64, cpus );
+
+	for ( dim_t i = 0; i < n; i++ )
+		if ( cpus[ i ] == cpu ) return ( int )i;
+
+	return 0;
+}
+
+// Fill in the sort keys for a processor from sysfs.
+static void bli_affinity_query_keys( int cpu, cpu_key_t* key )
+{
+	char path[ 256 ];
+
+	key->cpu = cpu;
+	key->smt = 0;
+	key->l2  = cpu;
+	key->l3  = -1;
+
+	snprintf( path, sizeof( path ),
+	          "/sys/devices/system/cpu/cpu%d/topology/thread_siblings_list", cpu );
+	key->smt = bli_affinity_sysfs_index( path, cpu );
+
+	// Walk the cache descriptions, recording the processors that share the
+	// L2 and the last-level (L3) caches.
+	for ( int index = 0; index < 8; index++ )
+	{
+		char buf[ 64 ];
+
+		snprintf( path, sizeof( path ),
+		          "/sys/devices/system/cpu/cpu%d/cache/index%d/level", cpu, index );
+		if ( !bli_affinity_read_sysfs( path, buf, sizeof( buf ) ) ) break;
+
+		const int level = atoi( buf );
+
+		snprintf( path, sizeof( path ),
+		          "/sys/devices/system/cpu/cpu%d/cache/index%d/shared_cpu_list", cpu, index );
+		const int first = bli_affinity_sysfs_first( path );
+
+		if ( first < 0 ) continue;
+
+		if      ( level == 2 ) key->l2 = first;
+		else if ( level == 3 ) key->l3 = first;
+	}
+
+	// Without an L3 cache, group the processors by package instead.
+	if ( key->l3 < 0 )
+	{
+		snprintf( path, sizeof( path ),
+		          "/sys/devices/system/cpu/cpu%d/topology/physical_package_id", cpu );
+
+		char buf[ 64 ];
+
+		key->l3 = ( bli_affinity_read_sysfs( path, buf, sizeof( buf ) )
+		            ? atoi( buf ) : 0 );
+	}
+}
+
+static int bli_affinity_compare_keys( const void* a_v, const void* b_v )
+{
+	const cpu_key_t* a = a_v;
+	const cpu_key_t* b = b_v;
+
+	if ( a->l3  != b->l3  ) return ( a->l3  < b->l3  ? -1 : 1 );
+	if ( a->smt != b->smt ) return ( a->smt < b->smt ? -1 : 1 );
+	if ( a->l2  != b->l2  ) return ( a->l2  < b->l2  ? -1 : 1 );
+	if ( a->cpu != b->cpu ) return ( a->cpu < b->cpu ? -1 : 1 );
+	return 0;
+}
+
+#endif
+
+static void bli_affinity_init_topology( void )
+{
+	err_t r_val;
+
+#ifdef BLIS_OS_LINUX
+
+	CPU_ZERO( &cpu_allowed );
+
+	if ( sched_getaffinity( 0, sizeof( cpu_allowed ), &cpu_allowed ) != 0 )
+		return;
+
+	const int n_cpus = CPU_COUNT( &cpu_allowed );
+
+	if ( n_cpus <= 0 ) return;
+
+	#ifdef BLIS_ENABLE_MEM_TRACING
+	printf( "bli_affinity_init_topology(): " );
+	#endif
+	cpu_key_t* keys = bli_malloc_intl( sizeof( cpu_key_t ) * n_cpus, &r_val );
+
+	#ifdef BLIS_ENABLE_MEM_TRACING
+	printf( "bli_affinity_init_topology(): " );
+	#endif
+	cpu_order = bli_malloc_intl( sizeof( int ) * n_cpus * 3, &r_val );
+
+	cpu_l3_begin = cpu_order + n_cpus;
+	cpu_l3_end   = cpu_order + n_cpus * 2;
+
+	dim_t n = 0;
+
+	for ( int cpu = 0; cpu < CPU_SETSIZE && n < n_cpus; cpu++ )
+	{
+		if ( !CPU_ISSET( cpu, &cpu_allowed ) ) continue;
+
+		bli_affinity_query_keys( cpu, &keys[ n ] );
+		n++;
+	}
+
+	qsort( keys, n, sizeof( cpu_key_t ), bli_affinity_compare_keys );
+
+	for ( dim_t i = 0; i < n; i++ )
+		cpu_order[ i ] = keys[ i ].cpu;
+
+	// Record the extent of each run of processors sharing an L3 cache.
+	for ( dim_t begin = 0, end; begin < n; begin = end )
+	{
+		for ( end = begin + 1; end < n && keys[ end ].l3 == keys[ begin ].l3; end++ )
+			;
+
+		for ( dim_t i = begin; i < end; i++ )
+		{
+			cpu_l3_begin[ i ] = begin;
+			cpu_l3_end[ i ]   = end;
+		}
+	}
+
+	cpu_order_n = n;
+
+	#ifdef BLIS_ENABLE_MEM_TRACING
+	printf( "bli_affinity_init_topology(): " );
+	#endif
+	bli_free_intl( keys );
+
+#else
+
+	// Pinning is only supported on Linux.
+	( void )r_val;
+
+#endif
+}
+
+// -- Parsing ------------------------------------------------------------------
+
+dim_t bli_affinity_parse_list
+     (
+       const char* str,
+             dim_t n_max,
+             int*  cpus
+     )
+{
+	// Parse a list of processors such as "0-3,8,10-11" into cpus, stopping
+	// at the first character that does not belong to the list. Return the
+	// number of processors stored.
+	dim_t n = 0;
+
+	while ( n < n_max )
+	{
+		char* end;
+
+		const long first = strtol( str, &end, 10 );
+
+		if ( end == str || first < 0 ) break;
+
+		long last = first;
+
+		str = end;
+
+		if ( *str == '-' )
+		{
+			last = strtol( str + 1, &end, 10 );
+
+			if ( end == str + 1 || last < first ) break;
+
+			str = end;
+		}
+
+		for ( long cpu = first; cpu <= last && n < n_max; cpu++ )
+			cpus[ n++ ] = ( int )cpu;
+
+		if ( *str != ',' ) break;
+
+		str++;
+	}
+
+	return n;
+}
+
+// -- Binding ------------------------------------------------------------------
+
+// Return the position in cpu_order at which a group of n_group threads that
+// would otherwise begin at pos is placed under the compact policy: if the
+// group would straddle the boundary between two L3 domains but fits within
+// one, it is moved to the start of the next domain.
+static dim_t bli_affinity_align_group( dim_t pos, dim_t n_group )
+{
+	const dim_t n_cpus = cpu_order_n;
+	const dim_t i      = pos % n_cpus;
+	const dim_t begin  = pos - i + cpu_l3_begin[ i ];
+	const dim_t end    = pos - i + cpu_l3_end[ i ];
+
+	if ( pos != begin && pos + n_group > end && n_group <= end - begin )
+		return end;
+
+	return pos;
+}
+
+// Return the position in cpu_order of thread tid under the compact policy.
+static dim_t bli_affinity_compact_pos( const rntm_t* rntm, dim_t tid )
+{
+	const dim_t n_threads = bli_rntm_num_threads( rntm );
+	const dim_t jc        = bli_max( bli_rntm_jc_ways( rntm ), 1 );
+	const dim_t pc        = bli_max( bli_rntm_pc_ways( rntm ), 1 );
+	const dim_t ic        = bli_max( bli_rntm_ic_ways( rntm ), 1 );
+
+	// Threads are organized so that the threads of each JC group (which
+	// share the packed block of B) have consecutive ids, as do the threads
+	// of each IC group (which share the packed block of A) within it. If the
+	// ways do not describe the threads, treat them as a single group.
+	if ( tid >= n_threads ) return tid;
+
+	dim_t n_jc_group = n_threads;
+	dim_t n_ic_group = n_threads;
+
+	if ( n_threads % ( jc * pc * ic ) == 0 )
+	{
+		n_jc_group = n_threads / jc;
+		n_ic_group = n_jc_group / ( pc * ic );
+	}
+
+	// Pack the groups onto consecutive processors, keeping each JC group,
+	// and each IC group within it, inside one L3 domain where it fits.
+	const dim_t ic_group = tid / n_ic_group;
+	const dim_t n_per_jc = n_jc_group / n_ic_group;
+
+	dim_t pos = 0;
+
+	for ( dim_t g = 0; g <= ic_group; g++ )
+	{
+		if ( g % n_per_jc == 0 ) pos = bli_affinity_align_group( pos, n_jc_group );
+
+		pos = bli_affinity_align_group( pos, n_ic_group );
+
+		if ( g < ic_group ) pos += n_ic_group;
+	}
+
+	return pos + tid % n_ic_group;
+}
+
+int bli_affinity_cpu_of_thread
+     (
+       const rntm_t* rntm,
+             dim_t   tid
+     )
+{
+	const aff_t aff = bli_rntm_affinity( rntm );
+
+	if ( aff == BLIS_AFFINITY_LIST )
+	{
+		const int*  list = bli_rntm_affinity_list( rntm );
+		const dim_t len  = bli_rntm_affinity_list_len( rntm );
+
+		if ( list == NULL || len <= 0 ) return -1;
+
+		return list[ tid % len ];
+	}
+
+	if ( aff != BLIS_AFFINITY_COMPACT &&
+	     aff != BLIS_AFFINITY_SCATTER ) return -1;
+
+	bli_pthread_once( &cpu_order_once, bli_affinity_init_topology );
+
+	const dim_t n_cpus = cpu_order_n;
+
+	if ( n_cpus == 0 ) return -1;
+
+	// Under the compact policy, threads sharing a packed block take
+	// neighbouring processors in topology order.
+	if ( aff == BLIS_AFFINITY_COMPACT )
+		return cpu_order[ bli_affinity_compact_pos( rntm, tid ) % n_cpus ];
+
+	// Under the scatter policy, divide the processors into one contiguous
+	// (and thus cache-sharing) region per JC group, and spread the threads of
+	// each group evenly across its region. (The threads of a JC group share
+	// the packed block of B.)
+	const dim_t n_threads = bli_rntm_num_threads( rntm );
+	const dim_t jc        = bli_max( bli_rntm_jc_ways( rntm ), 1 );
+	const dim_t n_group   = bli_max( n_threads / jc, 1 );
+	const dim_t group     = ( tid / n_group ) % jc;
+	const dim_t index     = tid % n_group;
+
+	const dim_t region_begin = (   group       * n_cpus ) / jc;
+	const dim_t region_end   = ( ( group + 1 ) * n_cpus ) / jc;
+	const dim_t region_len   = bli_max( region_end - region_begin, 1 );
+
+	return cpu_order[ ( region_begin + ( index * region_len ) / n_group ) % n_cpus ];
+}
+
+#ifdef BLIS_OS_LINUX
+// The processor to which the calling thread is currently pinned by BLIS (or
+// -1), and (for threads that do not belong to BLIS) the processors on which
+// it could run before.
+static BLIS_THREAD_LOCAL int       bound = -1;
+static BLIS_THREAD_LOCAL cpu_set_t saved_set;
+static BLIS_THREAD_LOCAL bool      saved = FALSE;
+#endif
+
+void bli_affinity_bind
+     (
+       const rntm_t* rntm,
+             dim_t   tid
+     )
+{
+#ifdef BLIS_OS_LINUX
+
+	const int cpu = bli_affinity_cpu_of_thread( rntm, tid );
+
+	// A thread that stays on the same processor from one launch to the next
+	// (e.g. a pooled worker) need not be pinned again.
+	if ( cpu == bound ) return;
+
+	if ( 0 <= cpu && cpu < CPU_SETSIZE )
+	{
+		cpu_set_t set;
+
+		CPU_ZERO( &set );
+		CPU_SET( cpu, &set );
+
+		if ( sched_setaffinity( 0, sizeof( set ), &set ) == 0 )
+			bound = cpu;
+	}
+	else if ( bound >= 0 )
+	{
+		// A thread that was pinned during an earlier launch (e.g. a pooled
+		// worker) is released to run on any of the allowed processors.
+		bli_pthread_once( &cpu_order_once, bli_affinity_init_topology );
+
+		sched_setaffinity( 0, sizeof( cpu_allowed ), &cpu_allowed );
+
+		bound = -1;
+	}
+
+#else
+
+	( void )rntm;
+	( void )tid;
+
+#endif
+}
+
+void bli_affinity_save( void )
+{
+#ifdef BLIS_OS_LINUX
+	saved = ( sched_getaffinity( 0, sizeof( saved_set ), &saved_set ) == 0 );
+#endif
+}
+
+void bli_affinity_restore( void )
+{
+#ifdef BLIS_OS_LINUX
+	if ( saved && bound >= 0 )
+		sched_setaffinity( 0, sizeof( saved_set ), &saved_set );
+
+	saved = FALSE;
+	bound = -1;
+#endif
+}
+
@@ -720,12 +720,28 @@ int bli_pthread_barrier_wait
 //    how "success" is conveyed because the switch must know whether to toggle
 //    its state after inspecting the return value of the user-supplied function.
 //
+// 5. The _switch_on_post() function additionally calls a second user-supplied
+//    function, post(), after turning the switch on and releasing its lock, but
+//    only in the thread that called init(). Since the switch is already on by
+//    then, post() may itself call code that turns the switch on (which then
+//    returns early) without deadlocking.
+//
 
 int bli_pthread_switch_on
      (
        bli_pthread_switch_t* sw,
        int                 (*init)(void)
      )
+{
+	return bli_pthread_switch_on_post( sw, init, NULL );
+}
+
+int bli_pthread_switch_on_post
+     (
+       bli_pthread_switch_t* sw,
+       int                 (*init)(void),
+       void                (*post)(void)
+     )
 {
 	// NOTE: This function assumes that init() will return 0 on success;
 	// otherwise, it will return some other integer. If the function
@@ -736,6 +752,9 @@ int bli_pthread_switch_on
 	// Initialize the return value with the error code for success.
 	int r_val = 0;
 
+	// Whether this thread turned the switch on.
+	bool turned_on = FALSE;
+
 	// Proceed only if the switch is currently off; otherwise, we return with
 	// an error code of 0.
 	if ( sw->status == 0 )
@@ -754,11 +773,19 @@ int bli_pthread_switch_on
 			// If the init() function succeeded, turn the switch on;
 			// otherwise, leave the switch off.
 			if ( r_val == 0 )
+			{
 				sw->status = 1;
+				turned_on  = TRUE;
+			}
 		}
 
 		// Release the switch's lock.
 		bli_pthread_mutex_unlock( &sw->mutex );
+
+		// Now that the switch is on and its lock released, call the post()
+		// function, if any.
+		if ( turned_on && post != NULL )
+			post();
 	}
 
 	return r_val;
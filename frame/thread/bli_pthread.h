@@ -289,6 +289,13 @@ int bli_pthread_switch_on
        int                 (*init)(void)
      );
 
+int bli_pthread_switch_on_post
+     (
+       bli_pthread_switch_t* sw,
+       int                 (*init)(void),
+       void                (*post)(void)
+     );
+
 int bli_pthread_switch_off
      (
        bli_pthread_switch_t* sw,
@@ -33,8 +33,23 @@
 
 */
 
+// syscall(), which we use to access futexes on Linux, is not part of POSIX
+// and so must be requested before any system headers are included.
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+  #define _GNU_SOURCE
+#endif
+
 #include "blis.h"
 
+#if   defined(BLIS_OS_LINUX)
+  #include <limits.h>
+  #include <unistd.h>
+  #include <sys/syscall.h>
+  #include <linux/futex.h>
+#elif !defined(BLIS_OS_WINDOWS) && !defined(BLIS_OS_NONE)
+  #include <sched.h>
+#endif
+
 // -- Method-agnostic functions ------------------------------------------------
 
 thrcomm_t* bli_thrcomm_create( timpl_t ti, pool_t* sba_pool, dim_t n_threads )
@@ -153,6 +168,14 @@ void bli_thrcomm_init( timpl_t ti, dim_t nt, thrcomm_t* comm )
 	// Note that we wait until after the init function has returned in case
 	// that function zeros out the entire struct before setting the fields.
 	comm->ti = ti;
+
+	// Start with the default wait policy. The creator of the communicator
+	// may override this before any thread uses it.
+	comm->wait_policy = BLIS_WAIT_POLICY_DEFAULT;
+
+	// Likewise for the scheduling of the macro-kernel's loops.
+	comm->jrir_sched  = BLIS_JRIR_STATIC;
+	comm->dyn_counter = 0;
 }
 
 void bli_thrcomm_cleanup( thrcomm_t* comm )
@@ -213,11 +236,14 @@ void* bli_thrcomm_bcast
 #define __ATOMIC_ACQUIRE
 #define __ATOMIC_RELEASE
 #define __ATOMIC_ACQ_REL
+#define __ATOMIC_SEQ_CST
 
 #define __atomic_load_n(ptr, constraint) \
     __sync_fetch_and_add(ptr, 0)
 #define __atomic_add_fetch(ptr, value, constraint) \
     __sync_add_and_fetch(ptr, value)
+#define __atomic_sub_fetch(ptr, value, constraint) \
+    __sync_sub_and_fetch(ptr, value)
 #define __atomic_fetch_add(ptr, value, constraint) \
     __sync_fetch_and_add(ptr, value)
 #define __atomic_fetch_xor(ptr, value, constraint) \
@@ -239,7 +265,7 @@ void bli_thrcomm_barrier_atomic( dim_t t_id, thrcomm_t* comm )
 	// fact, if everything else is working, a binary variable is sufficient,
 	// which is what we do here (i.e., 0 is incremented to 1, which is then
 	// decremented back to 0, and so forth).
-	gint_t orig_sense = __atomic_load_n( &comm->barrier_sense, __ATOMIC_RELAXED );
+	int orig_sense = __atomic_load_n( &comm->barrier_sense, __ATOMIC_RELAXED );
 
 	// Register ourselves (the current thread) as having arrived by
 	// incrementing the barrier_threads_arrived variable. We must perform
@@ -254,18 +280,280 @@ void bli_thrcomm_barrier_atomic( dim_t t_id, thrcomm_t* comm )
 		// Reset the variable tracking the number of threads that have arrived
 		// to zero (which returns the barrier to the "empty" state. Then
 		// atomically toggle the barrier sense variable. This will signal to
-		// the other threads (which are spinning in the branch elow) that it
-		// is now safe to exit the barrier.
+		// the other threads (which are waiting in the branch elow) that it
+		// is now safe to exit the barrier. Any threads that went to sleep
+		// while waiting must then be woken explicitly.
 		comm->barrier_threads_arrived = 0;
-		__atomic_fetch_xor( &comm->barrier_sense, 1, __ATOMIC_RELEASE );
+		__atomic_fetch_xor( &comm->barrier_sense, 1, __ATOMIC_SEQ_CST );
+		bli_thrcomm_wake( &comm->barrier_sense, &comm->barrier_sleepers );
 	}
 	else
 	{
 		// If the current thread is NOT the last thread to have arrived, then
-		// it spins on the sense variable until that sense variable changes at
-		// which time these threads will exit the barrier.
-		while ( __atomic_load_n( &comm->barrier_sense, __ATOMIC_ACQUIRE ) == orig_sense )
-			; // Empty loop body.
+		// it waits (by spinning, sleeping, or both, depending on the wait
+		// policy) for the sense variable to change, at which time these
+		// threads will exit the barrier.
+		bli_thrcomm_wait
+		(
+		  bli_thrcomm_wait_policy( comm ),
+		  &comm->barrier_sense,
+		  orig_sense,
+		  &comm->barrier_sleepers
+		);
+	}
+}
+
+// -- Tree barrier -------------------------------------------------------------
+
+#ifdef BLIS_TREE_BARRIER
+
+// The tree barrier is a combining tree in which each node (padded to occupy
+// its own cache lines) is shared by at most BLIS_TREE_BARRIER_ARITY threads
+// or child nodes. Threads arrive at their leaf; the last to arrive at a node
+// proceeds to its parent, and the last to arrive at the root releases the
+// tree from the top down, with each node's waiters polling only that node's
+// signal. Thus, no cache line is contended by more than arity threads, in
+// contrast to the central barrier, where all threads update (and poll) the
+// same counter (and sense variable).
+
+// Return the number of nodes needed for a tree spanning n_threads threads.
+static dim_t bli_thrcomm_tree_barrier_num_nodes( dim_t n_threads, dim_t arity )
+{
+	if ( n_threads <= arity ) return 1;
+
+	const dim_t per_kid = n_threads / arity;
+	const dim_t deficit = n_threads - per_kid * arity;
+
+	dim_t n_nodes = 1;
+
+	for ( dim_t i = 0; i < arity; i++ )
+		n_nodes += bli_thrcomm_tree_barrier_num_nodes( per_kid + ( i < deficit ? 1 : 0 ), arity );
+
+	return n_nodes;
+}
+
+// Initialize the subtree spanning n_threads threads, starting with threads
+// leaf_index and node *node_index, and return its root.
+static barrier_t* bli_thrcomm_tree_barrier_build
+     (
+       dim_t       n_threads,
+       dim_t       arity,
+       barrier_t*  nodes,
+       dim_t*      node_index,
+       barrier_t** leaves,
+       dim_t       leaf_index
+     )
+{
+	barrier_t* me = &nodes[ *node_index ];
+	*node_index += 1;
+
+	me->dad      = NULL;
+	me->signal   = 0;
+	me->sleepers = 0;
+
+	if ( n_threads <= arity )
+	{
+		// Base case: this node is a leaf shared by all n_threads threads.
+		for ( dim_t i = 0; i < n_threads; i++ )
+			leaves[ leaf_index + i ] = me;
+
+		me->count = n_threads;
+		me->arity = n_threads;
 	}
+	else
+	{
+		// Otherwise, this node has arity children, among which the threads
+		// are divided as evenly as possible.
+		const dim_t per_kid = n_threads / arity;
+		const dim_t deficit = n_threads - per_kid * arity;
+
+		for ( dim_t i = 0; i < arity; i++ )
+		{
+			const dim_t n_threads_kid = per_kid + ( i < deficit ? 1 : 0 );
+
+			barrier_t* kid = bli_thrcomm_tree_barrier_build
+			(
+			  n_threads_kid, arity, nodes, node_index, leaves, leaf_index
+			);
+			kid->dad = me;
+
+			leaf_index += n_threads_kid;
+		}
+
+		me->count = arity;
+		me->arity = arity;
+	}
+
+	return me;
+}
+
+void bli_thrcomm_tree_barrier_init( dim_t n_threads, thrcomm_t* comm )
+{
+	comm->barrier_nodes = NULL;
+	comm->barriers      = NULL;
+
+	// A single thread never waits, so there is no need for a tree.
+	if ( n_threads <= 1 ) return;
+
+	err_t r_val;
+
+	const dim_t arity   = BLIS_TREE_BARRIER_ARITY;
+	const dim_t n_nodes = bli_thrcomm_tree_barrier_num_nodes( n_threads, arity );
+
+	#ifdef BLIS_ENABLE_MEM_TRACING
+	printf( "bli_thrcomm_tree_barrier_init(): " );
+	#endif
+	comm->barrier_nodes = bli_malloc_intl( sizeof( barrier_t ) * n_nodes, &r_val );
+
+	#ifdef BLIS_ENABLE_MEM_TRACING
+	printf( "bli_thrcomm_tree_barrier_init(): " );
+	#endif
+	comm->barriers = bli_malloc_intl( sizeof( barrier_t* ) * n_threads, &r_val );
+
+	dim_t node_index = 0;
+
+	bli_thrcomm_tree_barrier_build
+	(
+	  n_threads, arity, comm->barrier_nodes, &node_index, comm->barriers, 0
+	);
+}
+
+void bli_thrcomm_tree_barrier_cleanup( thrcomm_t* comm )
+{
+	if ( comm->barriers == NULL ) return;
+
+	#ifdef BLIS_ENABLE_MEM_TRACING
+	printf( "bli_thrcomm_tree_barrier_cleanup(): " );
+	#endif
+	bli_free_intl( comm->barriers );
+
+	#ifdef BLIS_ENABLE_MEM_TRACING
+	printf( "bli_thrcomm_tree_barrier_cleanup(): " );
+	#endif
+	bli_free_intl( comm->barrier_nodes );
+
+	comm->barriers      = NULL;
+	comm->barrier_nodes = NULL;
+}
+
+static void bli_thrcomm_tree_barrier_arrive( wpol_t wp, barrier_t* node )
+{
+	// Read the node's signal before registering our arrival (after which
+	// the signal may change at any time).
+	int my_signal = __atomic_load_n( &node->signal, __ATOMIC_RELAXED );
+
+	int my_count = __atomic_fetch_add( &node->count, -1, __ATOMIC_ACQ_REL );
+
+	if ( my_count == 1 )
+	{
+		// We were the last to arrive at this node. Arrive at the parent
+		// node (if any) on behalf of the whole subtree, and once that
+		// returns, reset this node and release its waiters.
+		if ( node->dad != NULL )
+			bli_thrcomm_tree_barrier_arrive( wp, node->dad );
+
+		__atomic_store_n( &node->count, node->arity, __ATOMIC_RELAXED );
+		__atomic_fetch_xor( &node->signal, 1, __ATOMIC_SEQ_CST );
+		bli_thrcomm_wake( &node->signal, &node->sleepers );
+	}
+	else
+	{
+		bli_thrcomm_wait( wp, &node->signal, my_signal, &node->sleepers );
+	}
+}
+
+void bli_thrcomm_tree_barrier( dim_t t_id, thrcomm_t* comm )
+{
+	// Return early if the comm is NULL or if there is only one
+	// thread participating.
+	if ( comm == NULL || comm->n_threads == 1 ) return;
+
+	bli_thrcomm_tree_barrier_arrive
+	(
+	  bli_thrcomm_wait_policy( comm ),
+	  comm->barriers[ t_id ]
+	);
+}
+
+#endif
+
+// -- Wait policies ------------------------------------------------------------
+
+// Hint to the processor that the calling thread is in a spin-wait loop.
+BLIS_INLINE void bli_thrcomm_pause( void )
+{
+#if   defined(__x86_64__) || defined(__i386__)
+	__asm__ __volatile__( "pause" );
+#elif defined(__aarch64__) || defined(__arm__)
+	__asm__ __volatile__( "yield" );
+#endif
+}
+
+// Put the calling thread to sleep for as long as *flag == value (though it
+// may wake up spuriously). On Linux this is a futex wait; elsewhere we make
+// do with yielding the processor.
+static void bli_thrcomm_sleep( int* flag, int value )
+{
+#if   defined(BLIS_OS_LINUX)
+	syscall( SYS_futex, flag, FUTEX_WAIT_PRIVATE, value, NULL, NULL, 0 );
+#elif defined(BLIS_OS_WINDOWS)
+	( void )flag; ( void )value;
+	SwitchToThread();
+#elif !defined(BLIS_OS_NONE)
+	( void )flag; ( void )value;
+	sched_yield();
+#else
+	( void )flag; ( void )value;
+	bli_thrcomm_pause();
+#endif
+}
+
+// Wake all threads sleeping in bli_thrcomm_sleep() on flag.
+static void bli_thrcomm_wake_all( int* flag )
+{
+#if   defined(BLIS_OS_LINUX)
+	syscall( SYS_futex, flag, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0 );
+#else
+	// Sleeping threads poll, so there is nothing to do.
+	( void )flag;
+#endif
+}
+
+void bli_thrcomm_wait( wpol_t wp, int* flag, int value, int* sleepers )
+{
+	// Under the active and hybrid policies, spin until the flag changes,
+	// giving up after BLIS_WAIT_SPIN_COUNT iterations in the hybrid case.
+	if ( wp != BLIS_WAIT_PASSIVE )
+	{
+		for ( dim_t i = 0; wp == BLIS_WAIT_ACTIVE || i < BLIS_WAIT_SPIN_COUNT; ++i )
+		{
+			if ( __atomic_load_n( flag, __ATOMIC_ACQUIRE ) != value ) return;
+
+			bli_thrcomm_pause();
+		}
+	}
+
+	// Register as a sleeper before checking the flag one last time. Paired
+	// with the sequentially consistent update of the flag and read of the
+	// sleeper count in bli_thrcomm_wake(), this guarantees that either we
+	// observe the new flag value or the waker observes us and wakes us up.
+	// (The futex wait itself also returns immediately if the flag has
+	// changed in the meantime.)
+	__atomic_add_fetch( sleepers, 1, __ATOMIC_SEQ_CST );
+
+	while ( __atomic_load_n( flag, __ATOMIC_SEQ_CST ) == value )
+		bli_thrcomm_sleep( flag, value );
+
+	__atomic_sub_fetch( sleepers, 1, __ATOMIC_RELEASE );
+}
+
+void bli_thrcomm_wake( int* flag, int* sleepers )
+{
+	// NOTE: The caller must have already updated *flag (with sequentially
+	// consistent semantics) before calling this function.
+
+	// Only pay for a system call if some thread actually went to sleep.
+	if ( __atomic_load_n( sleepers, __ATOMIC_SEQ_CST ) > 0 )
+		bli_thrcomm_wake_all( flag );
 }
 
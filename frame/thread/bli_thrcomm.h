@@ -36,11 +36,10 @@
 #ifndef BLIS_THRCOMM_H
 #define BLIS_THRCOMM_H
 
-// Define barrier_t, which is specific to the tree barrier in the OpenMP
-// implementation. This needs to be done first since it is (potentially)
-// used within the definition of thrcomm_t below.
+// Define barrier_t, which is specific to the tree barrier. This needs to be
+// done first since it is (potentially) used within the definition of
+// thrcomm_t below.
 
-#ifdef BLIS_ENABLE_OPENMP
 #ifdef BLIS_TREE_BARRIER
 struct barrier_s
 {
@@ -57,15 +56,17 @@ struct barrier_s
 	// the fields above and fields below.
 	char   padding2[ BLIS_CACHE_LINE_SIZE ];
 
-	volatile int      signal;
+	int               signal;
+
+	// The number of threads sleeping while they wait for signal to change.
+	int               sleepers;
 
 	// We insert a cache line of padding here to eliminate false sharing between
 	// this struct and the next one.
-	char   padding2[ BLIS_CACHE_LINE_SIZE ];
+	char   padding3[ BLIS_CACHE_LINE_SIZE ];
 };
 typedef struct barrier_s barrier_t;
 #endif
-#endif
 
 // Define the thrcomm_t structure, which will be common to all threading
 // implementations.
@@ -77,6 +78,8 @@ typedef struct thrcomm_s
 	void*       sent_object;
 	dim_t       n_threads;
 	timpl_t     ti;
+	wpol_t      wait_policy;
+	jrir_t      jrir_sched;
 
 	// We insert a cache line of padding here to eliminate false sharing between
 	// the fields above and fields below.
@@ -87,9 +90,14 @@ typedef struct thrcomm_s
 	// don't allow the use of bool for the variables being operated upon.
 	// (Specifically, this was observed of __atomic_fetch_xor(), but it likely
 	// applies to all other related built-ins.) Thus, we get around this by
-	// redefining barrier_sense as a gint_t.
+	// redefining barrier_sense as an integer. We use an int (rather than a
+	// gint_t) so that sleeping threads may wait on it via a futex.
 	//volatile gint_t  barrier_sense;
-	gint_t barrier_sense;
+	int    barrier_sense;
+
+	// The number of threads that are sleeping (rather than spinning) while
+	// they wait for barrier_sense to change.
+	int    barrier_sleepers;
 
 	// We insert a cache line of padding here to eliminate false sharing between
 	// the fields above and fields below.
@@ -98,18 +106,27 @@ typedef struct thrcomm_s
 	dim_t  barrier_threads_arrived;
 
 	// We insert a cache line of padding here to eliminate false sharing between
-	// the fields above and whatever data structures follow.
+	// the fields above and fields below.
 	char   padding3[ BLIS_CACHE_LINE_SIZE ];
 
-	// -- Fields specific to OpenMP --
+	// The number of units of work claimed so far from the shared counter
+	// used by bli_thread_range_dyn().
+	dim_t  dyn_counter;
+
+	// We insert a cache line of padding here to eliminate false sharing between
+	// the fields above and whatever data structures follow.
+	char   padding4[ BLIS_CACHE_LINE_SIZE ];
+
+	// -- Fields specific to the tree barrier --
 
-	#ifdef BLIS_ENABLE_OPENMP
 	#ifdef BLIS_TREE_BARRIER
-	// This field is only needed if the tree barrier implementation is being
-	// compiled. The non-tree barrier code does not use it.
+	// These fields are only needed if the tree barrier implementation is
+	// being compiled. The central (counter-based) barrier code does not use
+	// them. barrier_nodes holds all nodes of the tree while barriers holds,
+	// for each thread, a pointer to the leaf node at which it arrives.
+	barrier_t*  barrier_nodes;
 	barrier_t** barriers;
 	#endif
-	#endif
 
 	// -- Fields specific to pthreads --
 
@@ -161,6 +178,29 @@ BLIS_INLINE timpl_t bli_thrcomm_thread_impl( thrcomm_t* comm )
 	return comm->ti;
 }
 
+BLIS_INLINE wpol_t bli_thrcomm_wait_policy( thrcomm_t* comm )
+{
+	return comm->wait_policy;
+}
+
+BLIS_INLINE jrir_t bli_thrcomm_jrir_sched( thrcomm_t* comm )
+{
+	return comm->jrir_sched;
+}
+
+
+// thrcomm_t modification (field only)
+
+BLIS_INLINE void bli_thrcomm_set_wait_policy( wpol_t wp, thrcomm_t* comm )
+{
+	comm->wait_policy = wp;
+}
+
+BLIS_INLINE void bli_thrcomm_set_jrir_sched( jrir_t js, thrcomm_t* comm )
+{
+	comm->jrir_sched = js;
+}
+
 
 // Threading method-agnostic function prototypes.
 thrcomm_t* bli_thrcomm_create( timpl_t ti, pool_t* sba_pool, dim_t n_threads );
@@ -179,5 +219,16 @@ BLIS_EXPORT_BLIS void  bli_thrcomm_barrier( dim_t thread_id, thrcomm_t* comm );
 BLIS_EXPORT_BLIS void* bli_thrcomm_bcast( dim_t inside_id, void* to_send, thrcomm_t* comm );
 void                   bli_thrcomm_barrier_atomic( dim_t thread_id, thrcomm_t* comm );
 
+// Prototypes specific to the tree barrier implementation.
+#ifdef BLIS_TREE_BARRIER
+void                   bli_thrcomm_tree_barrier_init( dim_t n_threads, thrcomm_t* comm );
+void                   bli_thrcomm_tree_barrier_cleanup( thrcomm_t* comm );
+void                   bli_thrcomm_tree_barrier( dim_t thread_id, thrcomm_t* comm );
+#endif
+
+// Wait/wake primitives that implement the wait policies.
+void                   bli_thrcomm_wait( wpol_t wp, int* flag, int value, int* sleepers );
+void                   bli_thrcomm_wake( int* flag, int* sleepers );
+
 #endif
 
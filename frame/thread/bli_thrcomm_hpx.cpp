@@ -72,16 +72,30 @@ void bli_thrcomm_init_hpx( dim_t n_threads, thrcomm_t* comm )
 	comm->sent_object = nullptr;
 	comm->n_threads = n_threads;
 	comm->barrier_sense = 0;
+	comm->barrier_sleepers = 0;
 	comm->barrier_threads_arrived = 0;
+
+	#ifdef BLIS_TREE_BARRIER
+	bli_thrcomm_tree_barrier_init( n_threads, comm );
+	#endif
 }
 
 void bli_thrcomm_cleanup_hpx( thrcomm_t* comm )
 {
+	if ( comm == nullptr ) return;
+
+	#ifdef BLIS_TREE_BARRIER
+	bli_thrcomm_tree_barrier_cleanup( comm );
+	#endif
 }
 
 void bli_thrcomm_barrier_hpx( dim_t t_id, thrcomm_t* comm )
 {
+	#ifdef BLIS_TREE_BARRIER
+	bli_thrcomm_tree_barrier( t_id, comm );
+	#else
 	bli_thrcomm_barrier_atomic( t_id, comm );
+	#endif
 }
 
 } // extern "C"
@@ -37,11 +37,10 @@
 
 #ifdef BLIS_ENABLE_OPENMP
 
-#ifndef BLIS_TREE_BARRIER
-
-// Define the non-tree barrier implementations of the init, cleanup, and
-// barrier functions. These are the default unless the tree barrier
-// versions are requested at compile-time.
+// Define the OpenMP implementations of the init, cleanup, and barrier
+// functions. Depending on whether the tree barrier was requested at
+// configure-time, these either use the central (counter-based) barrier or
+// the tree barrier.
 
 void bli_thrcomm_init_openmp( dim_t n_threads, thrcomm_t* comm )
 {
@@ -49,14 +48,22 @@ void bli_thrcomm_init_openmp( dim_t n_threads, thrcomm_t* comm )
 	comm->sent_object = NULL;
 	comm->n_threads = n_threads;
 	comm->barrier_sense = 0;
+	comm->barrier_sleepers = 0;
 	comm->barrier_threads_arrived = 0;
+
+	#ifdef BLIS_TREE_BARRIER
+	bli_thrcomm_tree_barrier_init( n_threads, comm );
+	#endif
 }
 
 
 void bli_thrcomm_cleanup_openmp( thrcomm_t* comm )
 {
-	//if ( comm == NULL ) return;
-	return;
+	if ( comm == NULL ) return;
+
+	#ifdef BLIS_TREE_BARRIER
+	bli_thrcomm_tree_barrier_cleanup( comm );
+	#endif
 }
 
 //'Normal' barrier for openmp
@@ -83,124 +90,12 @@ void bli_thrcomm_barrier_openmp( dim_t t_id, thrcomm_t* comm )
 		while ( *listener == my_sense ) {}
 	}
 #endif
+	#ifdef BLIS_TREE_BARRIER
+	bli_thrcomm_tree_barrier( t_id, comm );
+	#else
 	bli_thrcomm_barrier_atomic( t_id, comm );
+	#endif
 }
 
-#else
-
-// Define the tree barrier implementations of the init, cleanup, and
-// barrier functions.
-
-void bli_thrcomm_init_openmp( dim_t n_threads, thrcomm_t* comm )
-{
-	err_t r_val;
-
-	if ( comm == NULL ) return;
-	comm->sent_object = NULL;
-	comm->n_threads = n_threads;
-	comm->barriers = bli_malloc_intl( sizeof( barrier_t* ) * n_threads, &r_val );
-	bli_thrcomm_tree_barrier_create( n_threads, BLIS_TREE_BARRIER_ARITY, comm->barriers, 0 );
-}
-
-void bli_thrcomm_cleanup_openmp( thrcomm_t* comm )
-{
-	if ( comm == NULL ) return;
-	for ( dim_t i = 0; i < comm->n_threads; i++ )
-	{
-	   bli_thrcomm_tree_barrier_free( comm->barriers[i] );
-	}
-	bli_free_intl( comm->barriers );
-}
-
-void bli_thrcomm_barrier_openmp( dim_t t_id, thrcomm_t* comm )
-{
-	bli_thrcomm_tree_barrier( comm->barriers[t_id] );
-}
-
-// -- Helper functions ---------------------------------------------------------
-
-//Tree barrier used for Intel Xeon Phi
-barrier_t* bli_thrcomm_tree_barrier_create( int num_threads, int arity, barrier_t** leaves, int leaf_index )
-{
-	err_t r_val;
-
-	barrier_t* me = bli_malloc_intl( sizeof( barrier_t ), &r_val );
-
-	me->dad = NULL;
-	me->signal = 0;
-
-	// Base Case
-	if ( num_threads <= arity )
-	{
-		//Now must be registered as a leaf
-		for ( int i = 0; i < num_threads; i++ )
-		{
-			leaves[ leaf_index + i ] = me;
-		}
-		me->count = num_threads;
-		me->arity = num_threads;
-	}
-	else
-	{
-		// Otherwise this node has children
-		int threads_per_kid = num_threads / arity;
-		int defecit = num_threads - threads_per_kid * arity;
-
-		for ( int i = 0; i < arity; i++ )
-		{
-			int threads_this_kid = threads_per_kid;
-			if ( i < defecit ) threads_this_kid++;
-
-			barrier_t* kid = bli_thrcomm_tree_barrier_create( threads_this_kid, arity, leaves, leaf_index );
-			kid->dad = me;
-
-			leaf_index += threads_this_kid;
-		}  
-		me->count = arity;
-		me->arity = arity;
-	}  
-
-	return me;
-}
-
-void bli_thrcomm_tree_barrier_free( barrier_t* barrier )
-{
-	if ( barrier == NULL )
-		return;
-	barrier->count--;
-	if ( barrier->count == 0 )
-	{
-		bli_thrcomm_tree_barrier_free( barrier->dad );
-		bli_free_intl( barrier );
-	}
-	return;
-}
-
-void bli_thrcomm_tree_barrier( barrier_t* barack )
-{
-	int my_signal = barack->signal;
-	int my_count;
-
-	_Pragma( "omp atomic capture" )
-		my_count = barack->count--;
-
-	if ( my_count == 1 )
-	{
-		if ( barack->dad != NULL )
-		{
-			bli_thrcomm_tree_barrier( barack->dad );
-		}
-		barack->count = barack->arity;
-		barack->signal = !barack->signal;
-	}
-	else
-	{
-		volatile int* listener = &barack->signal;
-		while ( *listener == my_signal ) {}
-	}
-}
-
-#endif
-
 #endif
 
@@ -73,11 +73,21 @@ void bli_thrcomm_init_pthreads( dim_t n_threads, thrcomm_t* comm )
 	comm->sent_object = NULL;
 	comm->n_threads = n_threads;
 	comm->barrier_sense = 0;
+	comm->barrier_sleepers = 0;
 	comm->barrier_threads_arrived = 0;
+
+	#ifdef BLIS_TREE_BARRIER
+	bli_thrcomm_tree_barrier_init( n_threads, comm );
+	#endif
 }
 
 void bli_thrcomm_cleanup_pthreads( thrcomm_t* comm )
 {
+	if ( comm == NULL ) return;
+
+	#ifdef BLIS_TREE_BARRIER
+	bli_thrcomm_tree_barrier_cleanup( comm );
+	#endif
 }
 
 void bli_thrcomm_barrier_pthreads( dim_t t_id, thrcomm_t* comm )
@@ -100,7 +110,11 @@ void bli_thrcomm_barrier_pthreads( dim_t t_id, thrcomm_t* comm )
 		while( *listener == my_sense ) {}
 	}
 #endif
+	#ifdef BLIS_TREE_BARRIER
+	bli_thrcomm_tree_barrier( t_id, comm );
+	#else
 	bli_thrcomm_barrier_atomic( t_id, comm );
+	#endif
 }
 
 #endif
@@ -48,9 +48,67 @@ extern rntm_t global_rntm;
 // resides in bli_rntm.c.)
 extern bli_pthread_mutex_t global_rntm_mutex;
 
+// The processors to which threads are pinned when the global affinity is
+// BLIS_AFFINITY_LIST. global_rntm (and thus every rntm_t copied from it)
+// does not refer to the list. Instead, bli_thread_launch_rntm() holds a
+// reference to the current list for the duration of each launch that needs
+// it. A list is never modified once published, so a list replaced by
+// bli_thread_set_affinity_list() remains valid for the launches already
+// using it, and is freed when the last of them releases it.
+typedef struct
+{
+	dim_t refs;
+	dim_t len;
+	int   cpus[];
+} affinity_list_t;
+
+static affinity_list_t* global_affinity_list = NULL;
+
+static affinity_list_t* bli_thread_affinity_list_create( dim_t n, const int* cpus )
+{
+	const dim_t len = bli_min( bli_max( n, 0 ), BLIS_AFFINITY_LIST_LEN_MAX );
+
+	err_t r_val;
+	affinity_list_t* list = bli_malloc_intl( sizeof( affinity_list_t ) +
+	                                         len * sizeof( int ), &r_val );
+
+	list->refs = 1;
+	list->len  = len;
+
+	for ( dim_t i = 0; i < len; i++ )
+		list->cpus[ i ] = cpus[ i ];
+
+	return list;
+}
+
+static affinity_list_t* bli_thread_affinity_list_acquire( void )
+{
+	// Acquire the mutex protecting global_rntm, which also protects
+	// global_affinity_list from being replaced before its reference count
+	// is incremented.
+	bli_pthread_mutex_lock( &global_rntm_mutex );
+
+	affinity_list_t* list = global_affinity_list;
+
+	if ( list != NULL )
+		__atomic_add_fetch( &list->refs, 1, __ATOMIC_RELAXED );
+
+	bli_pthread_mutex_unlock( &global_rntm_mutex );
+
+	return list;
+}
+
+static void bli_thread_affinity_list_release( affinity_list_t* list )
+{
+	if ( list == NULL ) return;
+
+	if ( __atomic_sub_fetch( &list->refs, 1, __ATOMIC_ACQ_REL ) == 0 )
+		bli_free_intl( list );
+}
+
 typedef void (*thread_launch_t)
      (
-             dim_t         nt,
+       const rntm_t*       rntm,
              thread_func_t func,
        const void*         params
      );
@@ -91,10 +149,48 @@ void bli_thread_init( void )
 
 void bli_thread_finalize( void )
 {
+#ifdef BLIS_ENABLE_PTHREADS
+	// Shut down the pool of parked worker threads used by the pthreads
+	// implementation, if it was ever created.
+	bli_thread_finalize_pthreads();
+#endif
+
+	// Release the global affinity list, which no operation may use any
+	// longer.
+	bli_thread_affinity_list_release( global_affinity_list );
+	global_affinity_list = NULL;
 }
 
 // -----------------------------------------------------------------------------
 
+// Whether the calling thread is executing a function launched via
+// bli_thread_launch_rntm().
+static BLIS_THREAD_LOCAL bool in_region = FALSE;
+
+typedef struct
+{
+	      thread_func_t func;
+	const void*         params;
+} thread_region_t;
+
+static void bli_thread_region_entry( thrcomm_t* gl_comm, dim_t tid, const void* data_void )
+{
+	const thread_region_t* data = data_void;
+
+	// Mark the thread as executing within a parallel region for the duration
+	// of the call so that operations invoked by func (for example, level-1v
+	// operations applied to subvectors) do not launch threads of their own.
+	// The previous value is restored because the calling thread (thread 0)
+	// belongs to the application.
+	const bool in_region_prev = in_region;
+
+	in_region = TRUE;
+
+	data->func( gl_comm, tid, data->params );
+
+	in_region = in_region_prev;
+}
+
 void bli_thread_launch
      (
              timpl_t       ti,
@@ -103,7 +199,57 @@ void bli_thread_launch
        const void*         params
      )
 {
-	thread_launch_fpa[ti]( nt, func, params );
+	// Launch nt threads of implementation ti with the remaining runtime
+	// parameters (e.g. the wait policy and affinity) taken from the global
+	// rntm_t. The ways of parallelism are cleared since the threads are not
+	// divided among the loops of any particular operation.
+	rntm_t rntm;
+
+	bli_rntm_init_from_global( &rntm );
+	bli_rntm_set_thread_impl_only( ti, &rntm );
+	bli_rntm_set_num_threads_only( nt, &rntm );
+	bli_rntm_clear_ways_only( &rntm );
+
+	bli_thread_launch_rntm( &rntm, func, params );
+}
+
+void bli_thread_launch_rntm
+     (
+       const rntm_t*       rntm,
+             thread_func_t func,
+       const void*         params
+     )
+{
+	const timpl_t ti = bli_rntm_thread_impl( rntm );
+
+	const thread_region_t data = { .func = func, .params = params };
+
+	// If the threads are to be pinned to a list of processors but the rntm_t
+	// does not give one of its own, use the global list, holding on to it
+	// until the threads are done with it.
+	affinity_list_t* list = NULL;
+	rntm_t           rntm_l;
+
+	if ( bli_rntm_affinity( rntm ) == BLIS_AFFINITY_LIST &&
+	     bli_rntm_affinity_list( rntm ) == NULL )
+	{
+		list   = bli_thread_affinity_list_acquire();
+		rntm_l = *rntm;
+
+		if ( list != NULL )
+			bli_rntm_set_affinity_list_only( list->len, list->cpus, &rntm_l );
+
+		rntm = &rntm_l;
+	}
+
+	thread_launch_fpa[ti]( rntm, bli_thread_region_entry, &data );
+
+	bli_thread_affinity_list_release( list );
+}
+
+bool bli_thread_in_region( void )
+{
+	return in_region;
 }
 
 // -----------------------------------------------------------------------------
@@ -717,6 +863,66 @@ const char* bli_thread_get_thread_impl_str( timpl_t ti )
 	return bli_timpl_string[ti];
 }
 
+wpol_t bli_thread_get_wait_policy( void )
+{
+	// We must ensure that global_rntm has been initialized.
+	bli_init_once();
+
+	return bli_rntm_wait_policy( &global_rntm );
+}
+
+static const char* bli_wpol_string[BLIS_NUM_WAIT_POLICIES] =
+{
+	[BLIS_WAIT_ACTIVE]  = "active",
+	[BLIS_WAIT_PASSIVE] = "passive",
+	[BLIS_WAIT_HYBRID]  = "hybrid",
+};
+
+const char* bli_thread_get_wait_policy_str( wpol_t wp )
+{
+	return bli_wpol_string[wp];
+}
+
+aff_t bli_thread_get_affinity( void )
+{
+	// We must ensure that global_rntm has been initialized.
+	bli_init_once();
+
+	return bli_rntm_affinity( &global_rntm );
+}
+
+static const char* bli_aff_string[BLIS_NUM_AFFINITIES] =
+{
+	[BLIS_AFFINITY_NONE]    = "none",
+	[BLIS_AFFINITY_COMPACT] = "compact",
+	[BLIS_AFFINITY_SCATTER] = "scatter",
+	[BLIS_AFFINITY_LIST]    = "list",
+};
+
+const char* bli_thread_get_affinity_str( aff_t aff )
+{
+	return bli_aff_string[aff];
+}
+
+jrir_t bli_thread_get_jrir_sched( void )
+{
+	// We must ensure that global_rntm has been initialized.
+	bli_init_once();
+
+	return bli_rntm_jrir_sched( &global_rntm );
+}
+
+static const char* bli_jrir_string[BLIS_NUM_JRIR_SCHEDS] =
+{
+	[BLIS_JRIR_STATIC]  = "static",
+	[BLIS_JRIR_DYNAMIC] = "dynamic",
+};
+
+const char* bli_thread_get_jrir_sched_str( jrir_t js )
+{
+	return bli_jrir_string[js];
+}
+
 // ----------------------------------------------------------------------------
 
 void bli_thread_set_ways( dim_t jc, dim_t pc, dim_t ic, dim_t jr, dim_t ir )
@@ -734,9 +940,18 @@ void bli_thread_set_ways( dim_t jc, dim_t pc, dim_t ic, dim_t jr, dim_t ir )
 	// Ensure that the rntm_t is in a consistent state.
 	bli_rntm_sanitize( &global_rntm );
 
+	#ifdef BLIS_ENABLE_PTHREADS
+	const dim_t nt = bli_rntm_num_threads( &global_rntm );
+	#endif
+
 	// Release the mutex protecting global_rntm.
 	bli_pthread_mutex_unlock( &global_rntm_mutex );
 
+	#ifdef BLIS_ENABLE_PTHREADS
+	// Release any pooled pthreads that are no longer needed.
+	bli_thread_resize_pthreads( nt );
+	#endif
+
 #else
 
 	// When multithreading is disabled at compile time, ignore the user's
@@ -760,9 +975,18 @@ void bli_thread_set_num_threads( dim_t n_threads )
 	// Ensure that the rntm_t is in a consistent state.
 	bli_rntm_sanitize( &global_rntm );
 
+	#ifdef BLIS_ENABLE_PTHREADS
+	const dim_t nt = bli_rntm_num_threads( &global_rntm );
+	#endif
+
 	// Release the mutex protecting global_rntm.
 	bli_pthread_mutex_unlock( &global_rntm_mutex );
 
+	#ifdef BLIS_ENABLE_PTHREADS
+	// Release any pooled pthreads that are no longer needed.
+	bli_thread_resize_pthreads( nt );
+	#endif
+
 #else
 
 	// When multithreading is disabled at compile time, ignore the user's
@@ -785,6 +1009,86 @@ void bli_thread_set_thread_impl( timpl_t ti )
 	bli_pthread_mutex_unlock( &global_rntm_mutex );
 }
 
+void bli_thread_set_wait_policy( wpol_t wp )
+{
+	// We must ensure that global_rntm has been initialized.
+	bli_init_once();
+
+	// Acquire the mutex protecting global_rntm.
+	bli_pthread_mutex_lock( &global_rntm_mutex );
+
+	bli_rntm_set_wait_policy_only( wp, &global_rntm );
+
+	// Release the mutex protecting global_rntm.
+	bli_pthread_mutex_unlock( &global_rntm_mutex );
+}
+
+void bli_thread_set_jrir_sched( jrir_t js )
+{
+	// We must ensure that global_rntm has been initialized.
+	bli_init_once();
+
+	// Acquire the mutex protecting global_rntm.
+	bli_pthread_mutex_lock( &global_rntm_mutex );
+
+	bli_rntm_set_jrir_sched_only( js, &global_rntm );
+
+	// Release the mutex protecting global_rntm.
+	bli_pthread_mutex_unlock( &global_rntm_mutex );
+}
+
+void bli_thread_set_auto_nt( bool auto_nt )
+{
+	// We must ensure that global_rntm has been initialized.
+	bli_init_once();
+
+	// Acquire the mutex protecting global_rntm.
+	bli_pthread_mutex_lock( &global_rntm_mutex );
+
+	bli_rntm_set_auto_nt_only( auto_nt, &global_rntm );
+
+	// Release the mutex protecting global_rntm.
+	bli_pthread_mutex_unlock( &global_rntm_mutex );
+}
+
+void bli_thread_set_affinity( aff_t aff )
+{
+	// We must ensure that global_rntm has been initialized.
+	bli_init_once();
+
+	// Acquire the mutex protecting global_rntm.
+	bli_pthread_mutex_lock( &global_rntm_mutex );
+
+	bli_rntm_set_affinity_only( aff, &global_rntm );
+
+	// Release the mutex protecting global_rntm.
+	bli_pthread_mutex_unlock( &global_rntm_mutex );
+}
+
+void bli_thread_set_affinity_list( dim_t n, const int* cpus )
+{
+	// We must ensure that global_rntm has been initialized.
+	bli_init_once();
+
+	// Acquire the mutex protecting global_rntm.
+	bli_pthread_mutex_lock( &global_rntm_mutex );
+
+	// Copy the list since the caller's array need not outlive this call, and
+	// publish the copy in place of the current list.
+	affinity_list_t* list     = bli_thread_affinity_list_create( n, cpus );
+	affinity_list_t* list_old = global_affinity_list;
+
+	global_affinity_list = list;
+
+	bli_rntm_set_affinity_only( BLIS_AFFINITY_LIST, &global_rntm );
+
+	// Release the mutex protecting global_rntm.
+	bli_pthread_mutex_unlock( &global_rntm_mutex );
+
+	// Release the replaced list, which is freed once no launch uses it.
+	bli_thread_affinity_list_release( list_old );
+}
+
 // ----------------------------------------------------------------------------
 
 //#define PRINT_IMPL
@@ -862,6 +1166,94 @@ void bli_thread_init_rntm_from_env
 
 	// ------------------------------------------------------------------------
 
+	// Try to read BLIS_WAIT_POLICY. If it was not set, fall back to
+	// OMP_WAIT_POLICY, which accepts a subset of the same values.
+	wpol_t wp = BLIS_WAIT_POLICY_DEFAULT;
+
+	char* wp_env = bli_env_get_str( "BLIS_WAIT_POLICY" );
+
+	if ( wp_env == NULL ) wp_env = bli_env_get_str( "OMP_WAIT_POLICY" );
+
+	if ( wp_env != NULL )
+	{
+		// If the value was anything other than "active", "passive", or
+		// "hybrid", keep the default policy.
+		if      ( !strncmp( wp_env, "active",  6 ) ) wp = BLIS_WAIT_ACTIVE;
+		else if ( !strncmp( wp_env, "ACTIVE",  6 ) ) wp = BLIS_WAIT_ACTIVE;
+		else if ( !strncmp( wp_env, "passive", 7 ) ) wp = BLIS_WAIT_PASSIVE;
+		else if ( !strncmp( wp_env, "PASSIVE", 7 ) ) wp = BLIS_WAIT_PASSIVE;
+		else if ( !strncmp( wp_env, "hybrid",  6 ) ) wp = BLIS_WAIT_HYBRID;
+		else if ( !strncmp( wp_env, "HYBRID",  6 ) ) wp = BLIS_WAIT_HYBRID;
+	}
+
+	// ------------------------------------------------------------------------
+
+	// Try to read BLIS_JRIR_SCHED, which selects how the microtiles of the
+	// macro-kernel are divided among threads.
+	jrir_t js = BLIS_JRIR_STATIC;
+
+	char* js_env = bli_env_get_str( "BLIS_JRIR_SCHED" );
+
+	if ( js_env != NULL )
+	{
+		// If the value was anything other than "dynamic", keep the static
+		// schedule.
+		if      ( !strncmp( js_env, "dynamic", 7 ) ) js = BLIS_JRIR_DYNAMIC;
+		else if ( !strncmp( js_env, "DYNAMIC", 7 ) ) js = BLIS_JRIR_DYNAMIC;
+	}
+
+	// ------------------------------------------------------------------------
+
+	// Try to read BLIS_AUTO_NT, which, when zero, prevents BLIS from using
+	// fewer than the requested number of threads for small problems.
+	bool an = bli_env_get_var( "BLIS_AUTO_NT", 1 ) != 0;
+
+	// ------------------------------------------------------------------------
+
+	// Try to read BLIS_AFFINITY, which may be "none", "compact", "scatter",
+	// or "list" (in which case the processors are read from
+	// BLIS_AFFINITY_LIST), or may itself be a list of processors, such as
+	// "0-3,8-11".
+	aff_t aff = BLIS_AFFINITY_NONE;
+
+	char* aff_env = bli_env_get_str( "BLIS_AFFINITY" );
+
+	if ( aff_env != NULL )
+	{
+		char* list_env = NULL;
+
+		// If the value was not recognized, keep threads unpinned.
+		if      ( !strncmp( aff_env, "compact", 7 ) ) aff = BLIS_AFFINITY_COMPACT;
+		else if ( !strncmp( aff_env, "COMPACT", 7 ) ) aff = BLIS_AFFINITY_COMPACT;
+		else if ( !strncmp( aff_env, "scatter", 7 ) ) aff = BLIS_AFFINITY_SCATTER;
+		else if ( !strncmp( aff_env, "SCATTER", 7 ) ) aff = BLIS_AFFINITY_SCATTER;
+		else if ( !strncmp( aff_env, "list",    4 ) ) list_env = bli_env_get_str( "BLIS_AFFINITY_LIST" );
+		else if ( !strncmp( aff_env, "LIST",    4 ) ) list_env = bli_env_get_str( "BLIS_AFFINITY_LIST" );
+		else if ( '0' <= aff_env[0] && aff_env[0] <= '9' ) list_env = aff_env;
+
+		if ( list_env != NULL )
+		{
+			int cpus[ BLIS_AFFINITY_LIST_LEN_MAX ];
+
+			dim_t n = bli_affinity_parse_list( list_env,
+			                                   BLIS_AFFINITY_LIST_LEN_MAX,
+			                                   cpus );
+
+			if ( n > 0 )
+			{
+				// Publish the list as the global list, which is used by
+				// every launch requesting BLIS_AFFINITY_LIST without a list
+				// of its own.
+				bli_thread_affinity_list_release( global_affinity_list );
+				global_affinity_list = bli_thread_affinity_list_create( n, cpus );
+
+				aff = BLIS_AFFINITY_LIST;
+			}
+		}
+	}
+
+	// ------------------------------------------------------------------------
+
 	// Read the environment variables for the number of threads (ways of
 	// parallelism) for each individual loop.
 	dim_t jc = bli_env_get_var( "BLIS_JC_NT", -1 );
@@ -874,6 +1266,11 @@ void bli_thread_init_rntm_from_env
 
 	// Save the results back in the runtime object.
 	bli_rntm_set_thread_impl_only( ti, rntm );
+	bli_rntm_set_wait_policy_only( wp, rntm );
+	bli_rntm_set_affinity_only( aff, rntm );
+	bli_rntm_set_affinity_list_only( 0, NULL, rntm );
+	bli_rntm_set_jrir_sched_only( js, rntm );
+	bli_rntm_set_auto_nt_only( an, rntm );
 	bli_rntm_set_num_threads_only( nt, rntm );
 	bli_rntm_set_ways_only( jc, pc, ic, jr, ir, rntm );
 
@@ -43,6 +43,9 @@
 // Include thread info (thrinfo_t) object definitions and prototypes.
 #include "bli_thrinfo.h"
 
+// Include thread affinity prototypes.
+#include "bli_affinity.h"
+
 // Thread lanuch prototypes. Must go before including implementation headers.
 typedef void (*thread_func_t)( thrcomm_t* gl_comm, dim_t tid, const void* params );
 
@@ -66,6 +69,19 @@ BLIS_EXPORT_BLIS void bli_thread_launch
        const void*         params
      );
 
+// Launch the threads requested by rntm, which also gives the wait policy
+// and affinity with which they run.
+BLIS_EXPORT_BLIS void bli_thread_launch_rntm
+     (
+       const rntm_t*       rntm,
+             thread_func_t func,
+       const void*         params
+     );
+
+// Return whether the calling thread was launched by (and has not yet
+// returned from) bli_thread_launch() or bli_thread_launch_rntm().
+bool bli_thread_in_region( void );
+
 // -----------------------------------------------------------------------------
 
 // Factorization and partitioning prototypes
@@ -122,10 +138,21 @@ BLIS_EXPORT_BLIS dim_t   bli_thread_get_ir_nt( void );
 BLIS_EXPORT_BLIS dim_t   bli_thread_get_num_threads( void );
 BLIS_EXPORT_BLIS timpl_t bli_thread_get_thread_impl( void );
 BLIS_EXPORT_BLIS const char* bli_thread_get_thread_impl_str( timpl_t ti );
+BLIS_EXPORT_BLIS wpol_t  bli_thread_get_wait_policy( void );
+BLIS_EXPORT_BLIS const char* bli_thread_get_wait_policy_str( wpol_t wp );
+BLIS_EXPORT_BLIS aff_t   bli_thread_get_affinity( void );
+BLIS_EXPORT_BLIS const char* bli_thread_get_affinity_str( aff_t aff );
+BLIS_EXPORT_BLIS jrir_t  bli_thread_get_jrir_sched( void );
+BLIS_EXPORT_BLIS const char* bli_thread_get_jrir_sched_str( jrir_t js );
 
 BLIS_EXPORT_BLIS void    bli_thread_set_ways( dim_t jc, dim_t pc, dim_t ic, dim_t jr, dim_t ir );
 BLIS_EXPORT_BLIS void    bli_thread_set_num_threads( dim_t value );
 BLIS_EXPORT_BLIS void    bli_thread_set_thread_impl( timpl_t ti );
+BLIS_EXPORT_BLIS void    bli_thread_set_wait_policy( wpol_t wp );
+BLIS_EXPORT_BLIS void    bli_thread_set_affinity( aff_t aff );
+BLIS_EXPORT_BLIS void    bli_thread_set_affinity_list( dim_t n, const int* cpus );
+BLIS_EXPORT_BLIS void    bli_thread_set_jrir_sched( jrir_t js );
+BLIS_EXPORT_BLIS void    bli_thread_set_auto_nt( bool auto_nt );
 
 void                     bli_thread_init_rntm_from_env( rntm_t* rntm );
 
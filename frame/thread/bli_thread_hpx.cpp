@@ -45,17 +45,24 @@ extern "C"
 
 void bli_thread_launch_hpx
      (
-             dim_t         n_threads,
+       const rntm_t*       rntm,
              thread_func_t func,
        const void*         params
      )
 {
-	const timpl_t ti = BLIS_HPX;
+	const timpl_t ti        = BLIS_HPX;
+	const dim_t   n_threads = bli_rntm_num_threads( rntm );
 
 	// Allocate a global communicator for the root thrinfo_t structures.
 	pool_t*    gl_comm_pool = nullptr;
 	thrcomm_t* gl_comm      = bli_thrcomm_create( ti, gl_comm_pool, n_threads );
 
+	// Have the threads wait at barriers according to the requested policy.
+	bli_thrcomm_set_wait_policy( bli_rntm_wait_policy( rntm ), gl_comm );
+
+	// Likewise for the scheduling of the macro-kernel's loops.
+	bli_thrcomm_set_jrir_sched( bli_rntm_jrir_sched( rntm ), gl_comm );
+
 	auto irange = hpx::util::counting_shape(n_threads);
 
 	hpx::for_each(hpx::execution::par, hpx::util::begin(irange), hpx::util::end(irange),
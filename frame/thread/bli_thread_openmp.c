@@ -36,22 +36,42 @@
 
 #ifdef BLIS_ENABLE_OPENMP
 
-void bli_thread_launch_openmp( dim_t n_threads, thread_func_t func, const void* params )
+void bli_thread_launch_openmp( const rntm_t* rntm, thread_func_t func, const void* params )
 {
-	const timpl_t ti = BLIS_OPENMP;
+	const timpl_t ti        = BLIS_OPENMP;
+	const dim_t   n_threads = bli_rntm_num_threads( rntm );
 
 	// Allocate a global communicator for the root thrinfo_t structures.
 	pool_t*    gl_comm_pool = NULL;
 	thrcomm_t* gl_comm      = bli_thrcomm_create( ti, gl_comm_pool, n_threads );
 
+	// Have the threads wait at barriers according to the requested policy.
+	bli_thrcomm_set_wait_policy( bli_rntm_wait_policy( rntm ), gl_comm );
+
+	// Likewise for the scheduling of the macro-kernel's loops.
+	bli_thrcomm_set_jrir_sched( bli_rntm_jrir_sched( rntm ), gl_comm );
+
+	const bool pin_chief = ( n_threads > 1 &&
+	                         bli_rntm_affinity( rntm ) != BLIS_AFFINITY_NONE );
+
 	_Pragma( "omp parallel num_threads(n_threads)" )
 	{
 		// Query the thread's id from OpenMP.
 		const dim_t tid = omp_get_thread_num();
 
+		// Pin the thread according to the requested affinity. The calling
+		// thread (thread 0) belongs to the application, so its original
+		// affinity is restored once it finishes its share of the work.
+		// Other threads remain pinned until they are unpinned by a later
+		// launch.
+		if ( tid == 0 && pin_chief ) bli_affinity_save();
+		if ( tid != 0 || pin_chief ) bli_affinity_bind( rntm, tid );
+
 		// Call the thread entry point, passing the global communicator, the
 		// thread id, and the params struct as arguments.
 		func( gl_comm, tid, params );
+
+		if ( tid == 0 && pin_chief ) bli_affinity_restore();
 	}
 
 	// Free the global communicator, because the root thrinfo_t node
@@ -40,7 +40,7 @@
 
 void bli_thread_launch_openmp
      (
-             dim_t         nt,
+       const rntm_t*       rntm,
              thread_func_t func,
        const void*         params
      );
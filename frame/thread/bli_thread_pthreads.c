@@ -40,6 +40,7 @@
 typedef struct thread_data
 {
 	      dim_t         tid;
+	const rntm_t*       rntm;
 	      thrcomm_t*    gl_comm;
 	      thread_func_t func;
 	const void*         params;
@@ -51,10 +52,15 @@ static void* bli_posix_thread_entry( void* data_void )
 	const thread_data_t* data     = data_void;
 
 	const dim_t          tid      = data->tid;
+	const rntm_t*        rntm     = data->rntm;
 	      thrcomm_t*     gl_comm  = data->gl_comm;
 	      thread_func_t  func     = data->func;
 	const void*          params   = data->params;
 
+	// Pin the thread according to the requested affinity. (The chief thread
+	// is pinned by bli_thread_launch_pthreads().)
+	if ( tid != 0 ) bli_affinity_bind( rntm, tid );
+
 	// Call the thread entry point, passing the global communicator, the
 	// thread id, and the params struct as arguments.
 	func( gl_comm, tid, params );
@@ -62,15 +68,259 @@ static void* bli_posix_thread_entry( void* data_void )
 	return NULL;
 }
 
-void bli_thread_launch_pthreads( dim_t n_threads, thread_func_t func, const void* params )
+// -- Persistent thread pool ---------------------------------------------------
+
+// The pool of parked worker threads. Worker i executes the work of thread id
+// i+1; the thread calling bli_thread_launch_pthreads() always acts as thread
+// id 0. Workers sleep on cond_start between launches and are woken whenever
+// the generation counter changes, which happens either when new work is
+// posted or when the pool is being shrunk.
+typedef struct thread_pool_s
+{
+	// Held by the chief thread for the duration of a launch (and while
+	// resizing) so that only one team at a time uses the pool.
+	bli_pthread_mutex_t owner;
+
+	// Protects all of the fields below.
+	bli_pthread_mutex_t mutex;
+	bli_pthread_cond_t  cond_start;
+	bli_pthread_cond_t  cond_done;
+
+	bli_pthread_t*      workers;
+	dim_t               n_workers;
+
+	// Workers whose index is at or above n_keep exit when they are woken.
+	dim_t               n_keep;
+
+	// The number of workers participating in the current launch and the
+	// number of those that have finished.
+	dim_t               n_active;
+	dim_t               n_done;
+
+	uint64_t            generation;
+
+	// The work posted for the current launch.
+	const rntm_t*       rntm;
+	      thread_func_t func;
+	const void*         params;
+	      thrcomm_t*    gl_comm;
+} thread_pool_t;
+
+static thread_pool_t thread_pool =
+{
+	.owner      = BLIS_PTHREAD_MUTEX_INITIALIZER,
+	.mutex      = BLIS_PTHREAD_MUTEX_INITIALIZER,
+	.cond_start = BLIS_PTHREAD_COND_INITIALIZER,
+	.cond_done  = BLIS_PTHREAD_COND_INITIALIZER,
+	.workers    = NULL,
+	.n_workers  = 0,
+	.n_keep     = 0,
+	.n_active   = 0,
+	.n_done     = 0,
+	.generation = 0,
+	.rntm       = NULL,
+	.func       = NULL,
+	.params     = NULL,
+	.gl_comm    = NULL,
+};
+
+// A worker's index within the pool and the generation that was current when
+// it was spawned (so that it does not mistake past work for new work).
+typedef struct pool_worker_data
+{
+	dim_t    index;
+	uint64_t generation;
+} pool_worker_data_t;
+
+// Entry point for pooled worker threads.
+static void* bli_posix_pool_worker_entry( void* data_void )
+{
+	pool_worker_data_t* data  = data_void;
+
+	const dim_t    index   = data->index;
+	      uint64_t gen_cur = data->generation;
+
+	// The spawning thread allocated the data struct on our behalf.
+	bli_free_intl( data );
+
+	thread_pool_t* pool = &thread_pool;
+
+	bli_pthread_mutex_lock( &pool->mutex );
+
+	while ( TRUE )
+	{
+		// Park until something changes.
+		while ( pool->generation == gen_cur )
+			bli_pthread_cond_wait( &pool->cond_start, &pool->mutex );
+
+		gen_cur = pool->generation;
+
+		// Exit if the pool is being shrunk past our index.
+		if ( pool->n_keep <= index ) break;
+
+		// Go back to sleep if we are not needed for the current launch.
+		if ( pool->n_active <= index ) continue;
+
+		const rntm_t*       rntm    = pool->rntm;
+		      thread_func_t func    = pool->func;
+		const void*         params  = pool->params;
+		      thrcomm_t*    gl_comm = pool->gl_comm;
+
+		bli_pthread_mutex_unlock( &pool->mutex );
+
+		// Pin (or, if a previous launch pinned us, unpin) the worker
+		// according to this launch's affinity.
+		bli_affinity_bind( rntm, index + 1 );
+
+		func( gl_comm, index + 1, params );
+
+		bli_pthread_mutex_lock( &pool->mutex );
+
+		pool->n_done += 1;
+
+		if ( pool->n_done == pool->n_active )
+			bli_pthread_cond_broadcast( &pool->cond_done );
+	}
+
+	bli_pthread_mutex_unlock( &pool->mutex );
+
+	return NULL;
+}
+
+// Resize the pool so that it holds exactly n_workers parked threads. The
+// caller must hold pool->owner.
+static void bli_thread_pool_resize( thread_pool_t* pool, dim_t n_workers )
 {
 	err_t r_val;
 
-	const timpl_t ti = BLIS_POSIX;
+	const dim_t n_prev = pool->n_workers;
 
-	// Allocate a global communicator for the root thrinfo_t structures.
-	pool_t*    gl_comm_pool = NULL;
-	thrcomm_t* gl_comm      = bli_thrcomm_create( ti, gl_comm_pool, n_threads );
+	if ( n_workers == n_prev ) return;
+
+	if ( n_workers < n_prev )
+	{
+		// Wake all workers and instruct the surplus ones to exit.
+		bli_pthread_mutex_lock( &pool->mutex );
+		pool->n_keep    = n_workers;
+		pool->n_active  = 0;
+		pool->generation += 1;
+		bli_pthread_cond_broadcast( &pool->cond_start );
+		bli_pthread_mutex_unlock( &pool->mutex );
+
+		for ( dim_t i = n_workers; i < n_prev; ++i )
+			bli_pthread_join( pool->workers[i], NULL );
+
+		pool->n_workers = n_workers;
+
+		if ( n_workers == 0 )
+		{
+			#ifdef BLIS_ENABLE_MEM_TRACING
+			printf( "bli_thread_pool_resize(): " );
+			#endif
+			bli_free_intl( pool->workers );
+			pool->workers = NULL;
+		}
+
+		return;
+	}
+
+	// Otherwise, the pool is growing. Reallocate the array of pthread objects
+	// and copy over the handles of the existing workers.
+	#ifdef BLIS_ENABLE_MEM_TRACING
+	printf( "bli_thread_pool_resize(): " );
+	#endif
+	bli_pthread_t* workers = bli_malloc_intl( sizeof( bli_pthread_t ) * n_workers, &r_val );
+
+	for ( dim_t i = 0; i < n_prev; ++i )
+		workers[i] = pool->workers[i];
+
+	if ( pool->workers != NULL )
+	{
+		#ifdef BLIS_ENABLE_MEM_TRACING
+		printf( "bli_thread_pool_resize(): " );
+		#endif
+		bli_free_intl( pool->workers );
+	}
+
+	pool->workers = workers;
+
+	bli_pthread_mutex_lock( &pool->mutex );
+	pool->n_keep = n_workers;
+	const uint64_t gen_cur = pool->generation;
+	bli_pthread_mutex_unlock( &pool->mutex );
+
+	for ( dim_t i = n_prev; i < n_workers; ++i )
+	{
+		#ifdef BLIS_ENABLE_MEM_TRACING
+		printf( "bli_thread_pool_resize(): " );
+		#endif
+		pool_worker_data_t* data = bli_malloc_intl( sizeof( pool_worker_data_t ), &r_val );
+
+		data->index      = i;
+		data->generation = gen_cur;
+
+		bli_pthread_create( &pool->workers[i], NULL, &bli_posix_pool_worker_entry, data );
+	}
+
+	pool->n_workers = n_workers;
+}
+
+// Run func on n_threads threads, using the calling thread as thread 0 and the
+// (resized, if necessary) pool for the rest. The caller must hold
+// pool->owner.
+static void bli_thread_pool_launch
+     (
+             thread_pool_t* pool,
+       const rntm_t*        rntm,
+             dim_t          n_threads,
+             thread_func_t  func,
+       const void*          params,
+             thrcomm_t*     gl_comm
+     )
+{
+	// Grow the pool if this team is larger than any that came before it.
+	// (The pool only shrinks when the number of threads is explicitly
+	// lowered; see bli_thread_resize_pthreads().)
+	if ( pool->n_workers < n_threads - 1 )
+		bli_thread_pool_resize( pool, n_threads - 1 );
+
+	// Post the work and wake the workers.
+	bli_pthread_mutex_lock( &pool->mutex );
+	pool->rntm       = rntm;
+	pool->func       = func;
+	pool->params     = params;
+	pool->gl_comm    = gl_comm;
+	pool->n_active   = n_threads - 1;
+	pool->n_done     = 0;
+	pool->generation += 1;
+	bli_pthread_cond_broadcast( &pool->cond_start );
+	bli_pthread_mutex_unlock( &pool->mutex );
+
+	// The chief thread performs its share of the work.
+	func( gl_comm, 0, params );
+
+	// Wait for the workers to finish.
+	bli_pthread_mutex_lock( &pool->mutex );
+	while ( pool->n_done < pool->n_active )
+		bli_pthread_cond_wait( &pool->cond_done, &pool->mutex );
+	pool->n_active = 0;
+	bli_pthread_mutex_unlock( &pool->mutex );
+}
+
+// Spawn and join a fresh set of threads for a single launch. This is used
+// when the pool is already busy, e.g. because several application threads
+// call BLIS concurrently or because BLIS was called from within a thread
+// that is itself part of a BLIS-managed team.
+static void bli_thread_spawn_launch
+     (
+       const rntm_t*       rntm,
+             dim_t         n_threads,
+             thread_func_t func,
+       const void*         params,
+             thrcomm_t*    gl_comm
+     )
+{
+	err_t r_val;
 
 	// Allocate an array of pthread objects and auxiliary data structs to pass
 	// to the thread entry functions.
@@ -91,6 +341,7 @@ void bli_thread_launch_pthreads( dim_t n_threads, thread_func_t func, const void
 	{
 		// Set up thread data for additional threads (beyond thread 0).
 		datas[tid].tid      = tid;
+		datas[tid].rntm     = rntm;
 		datas[tid].gl_comm  = gl_comm;
 		datas[tid].func     = func;
 		datas[tid].params   = params;
@@ -108,10 +359,6 @@ void bli_thread_launch_pthreads( dim_t n_threads, thread_func_t func, const void
 		bli_pthread_join( pthreads[tid], NULL );
 	}
 
-	// Free the global communicator, because the root thrinfo_t node
-	// never frees its communicator.
-	bli_thrcomm_free( gl_comm_pool, gl_comm );
-
 	// Free the array of pthread objects and auxiliary data structs.
 	#ifdef BLIS_ENABLE_MEM_TRACING
 	printf( "bli_l3_thread_decorator().pth: " );
@@ -124,5 +371,87 @@ void bli_thread_launch_pthreads( dim_t n_threads, thread_func_t func, const void
 	bli_free_intl( datas );
 }
 
+void bli_thread_launch_pthreads( const rntm_t* rntm, thread_func_t func, const void* params )
+{
+	const timpl_t ti        = BLIS_POSIX;
+	const dim_t   n_threads = bli_rntm_num_threads( rntm );
+
+	// Allocate a global communicator for the root thrinfo_t structures.
+	pool_t*    gl_comm_pool = NULL;
+	thrcomm_t* gl_comm      = bli_thrcomm_create( ti, gl_comm_pool, n_threads );
+
+	// Have the threads wait at barriers according to the requested policy.
+	bli_thrcomm_set_wait_policy( bli_rntm_wait_policy( rntm ), gl_comm );
+
+	// Likewise for the scheduling of the macro-kernel's loops.
+	bli_thrcomm_set_jrir_sched( bli_rntm_jrir_sched( rntm ), gl_comm );
+
+	thread_pool_t* pool = &thread_pool;
+
+	// Pin the calling thread as thread 0 for the duration of the launch. Its
+	// original affinity is restored afterwards since it belongs to the
+	// application.
+	const bool pin_chief = ( n_threads > 1 &&
+	                         bli_rntm_affinity( rntm ) != BLIS_AFFINITY_NONE );
+
+	if ( pin_chief )
+	{
+		bli_affinity_save();
+		bli_affinity_bind( rntm, 0 );
+	}
+
+	// A team of one needs no other threads.
+	if ( n_threads == 1 )
+	{
+		func( gl_comm, 0, params );
+	}
+	// Dispatch into the persistent pool if no other team is using it. If it
+	// is busy, fall back to spawning (and joining) threads for this launch
+	// only.
+	else if ( bli_pthread_mutex_trylock( &pool->owner ) == 0 )
+	{
+		bli_thread_pool_launch( pool, rntm, n_threads, func, params, gl_comm );
+
+		bli_pthread_mutex_unlock( &pool->owner );
+	}
+	else
+	{
+		bli_thread_spawn_launch( rntm, n_threads, func, params, gl_comm );
+	}
+
+	if ( pin_chief ) bli_affinity_restore();
+
+	// Free the global communicator, because the root thrinfo_t node
+	// never frees its communicator.
+	bli_thrcomm_free( gl_comm_pool, gl_comm );
+}
+
+void bli_thread_resize_pthreads( dim_t n_threads )
+{
+	thread_pool_t* pool = &thread_pool;
+
+	// Release any parked workers that a team of n_threads would not use.
+	// Growing is deferred until the next launch actually needs the threads.
+	bli_pthread_mutex_lock( &pool->owner );
+
+	if ( bli_max( n_threads - 1, 0 ) < pool->n_workers )
+		bli_thread_pool_resize( pool, bli_max( n_threads - 1, 0 ) );
+
+	bli_pthread_mutex_unlock( &pool->owner );
+}
+
+void bli_thread_finalize_pthreads( void )
+{
+	thread_pool_t* pool = &thread_pool;
+
+	// Join all parked workers and release the pool's resources. The pool
+	// will be recreated lazily by the next launch.
+	bli_pthread_mutex_lock( &pool->owner );
+
+	bli_thread_pool_resize( pool, 0 );
+
+	bli_pthread_mutex_unlock( &pool->owner );
+}
+
 #endif
 
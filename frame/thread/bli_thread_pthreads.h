@@ -40,11 +40,14 @@
 
 void bli_thread_launch_pthreads
      (
-             dim_t         nt,
+       const rntm_t*       rntm,
              thread_func_t func,
        const void*         params
      );
 
+void bli_thread_resize_pthreads( dim_t nt );
+void bli_thread_finalize_pthreads( void );
+
 #endif
 
 #endif
@@ -0,0 +1,73 @@
+/*
+
+   BLIS
+   An object-based framework for developing high-performance BLAS-like
+   libraries.
+
+   Copyright (C) 2014, The University of Texas at Austin
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are
+   met:
+    - Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    - Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    - Neither the name(s) of the copyright holder(s) nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef BLIS_THREAD_RANGE_DYN_H
+#define BLIS_THREAD_RANGE_DYN_H
+
+// Claim the next unit of work, in [0,n), from a pool shared by all threads in
+// the thread's communicator. Returns n once the pool is exhausted, after
+// which every thread must have stopped calling this function (for the current
+// loop) before any of them calls it again for the next loop. In practice this
+// is guaranteed by the barriers that separate successive macro-kernel calls
+// (e.g. those performed when packing the next block of A).
+//
+// Rather than resetting the shared counter between loops, which would
+// require an additional barrier, each thread records in its thrinfo_t the
+// value of the counter at which the current loop began. Since every thread
+// makes exactly one unsuccessful claim per loop, the next loop begins once
+// the counter reaches dyn_base + n + n_threads.
+BLIS_INLINE dim_t bli_thread_range_dyn
+     (
+       thrinfo_t* thread,
+       dim_t      n
+     )
+{
+	thrcomm_t*  comm = bli_thrinfo_comm( thread );
+	const dim_t base = bli_thrinfo_dyn_base( thread );
+
+	// The work itself is ordered by the barriers mentioned above, so the
+	// counter only needs to be atomic.
+	const dim_t i = __atomic_fetch_add( &comm->dyn_counter, 1,
+	                                    __ATOMIC_RELAXED ) - base;
+
+	if ( i < n ) return i;
+
+	bli_thrinfo_set_dyn_base( base + n + bli_thrinfo_num_threads( thread ),
+	                          thread );
+
+	return n;
+}
+
+#endif
+
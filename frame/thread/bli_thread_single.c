@@ -34,7 +34,7 @@
 
 #include "blis.h"
 
-void bli_thread_launch_single( dim_t nt, thread_func_t func, const void* params )
+void bli_thread_launch_single( const rntm_t* rntm, thread_func_t func, const void* params )
 {
 	// Call the thread entry point, passing the global single-threaded
 	// communicator, thread id of 0, and the params struct as arguments.
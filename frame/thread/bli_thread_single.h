@@ -37,7 +37,7 @@
 
 void bli_thread_launch_single
      (
-             dim_t         nt,
+       const rntm_t*       rntm,
              thread_func_t func,
        const void*         params
      );
@@ -82,6 +82,7 @@ thrinfo_t* bli_thrinfo_create
 	bli_thrinfo_set_sba_pool( sba_pool, thread );
 	bli_thrinfo_set_pba( pba, thread );
 	bli_mem_clear( bli_thrinfo_mem( thread ) );
+	bli_thrinfo_set_dyn_base( 0, thread );
 
 	bli_thrinfo_set_sub_node( NULL, thread );
 	bli_thrinfo_set_sub_prenode( NULL, thread );
@@ -208,9 +209,16 @@ thrinfo_t* bli_thrinfo_split
 
 		// Chiefs in the child communicator allocate the communicator
 		// object and store it in the array element corresponding to the
-		// parent's work id.
+		// parent's work id. The new communicator inherits the parent's
+		// wait policy and jr/ir schedule.
 		if ( child_thread_id == 0 )
+		{
 			new_comms[ child_work_id ] = bli_thrcomm_create( ti, sba_pool, child_num_threads );
+			bli_thrcomm_set_wait_policy( bli_thrcomm_wait_policy( parent_comm ),
+			                             new_comms[ child_work_id ] );
+			bli_thrcomm_set_jrir_sched( bli_thrcomm_jrir_sched( parent_comm ),
+			                            new_comms[ child_work_id ] );
+		}
 
 		bli_thrinfo_barrier( thread_par );
 
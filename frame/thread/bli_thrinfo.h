@@ -68,6 +68,10 @@ struct thrinfo_s
 	// Storage for allocated memory obtained from the packing block allocator.
 	mem_t              mem;
 
+	// The value of the communicator's dyn_counter at which the current
+	// dynamically-scheduled loop began. See bli_thread_range_dyn().
+	dim_t              dyn_base;
+
 	struct thrinfo_s*  sub_prenode;
 	struct thrinfo_s*  sub_node;
 };
@@ -124,6 +128,11 @@ BLIS_INLINE mem_t* bli_thrinfo_mem( thrinfo_t* t )
 	return &t->mem;
 }
 
+BLIS_INLINE dim_t bli_thrinfo_dyn_base( const thrinfo_t* t )
+{
+	return t->dyn_base;
+}
+
 BLIS_INLINE thrinfo_t* bli_thrinfo_sub_node( const thrinfo_t* t )
 {
 	return t->sub_node;
@@ -178,6 +187,11 @@ BLIS_INLINE void bli_thrinfo_set_pba( pba_t* pba, thrinfo_t* t )
 	t->pba = pba;
 }
 
+BLIS_INLINE void bli_thrinfo_set_dyn_base( dim_t dyn_base, thrinfo_t* t )
+{
+	t->dyn_base = dyn_base;
+}
+
 BLIS_INLINE void bli_thrinfo_set_sub_node( thrinfo_t* sub_node, thrinfo_t* t )
 {
 	t->sub_node = sub_node;
@@ -62,9 +62,43 @@ void PASTEMAC2(ch,opname,EX_SUF) \
 		PASTEMAC(chr,set0s)( *asum ); \
 		return; \
 	} \
+\
+	const num_t dt = PASTEMAC(ch,type); \
 \
 	/* Obtain a valid context from the gks if necessary. */ \
-	/*if ( cntx == NULL ) cntx = bli_gks_query_cntx();*/ \
+	if ( cntx == NULL ) cntx = bli_gks_query_cntx(); \
+\
+	/* Use multiple threads if the rntm_t requests them and the vector is
+	   long enough for each thread to be given a worthwhile amount of work. */ \
+	rntm_t rntm_l; \
+	dim_t  nt = bli_l1v_thread_nt( dt, n, cntx, rntm, &rntm_l ); \
+	if ( nt > 1 ) \
+	{ \
+		err_t    r_val; \
+		ctype_r* part = bli_malloc_intl( nt * sizeof( ctype_r ), &r_val ); \
+\
+		l1v_decor_params_t params = \
+		{ \
+		  .body  = bli_l1v_body_asumv, \
+		  .f     = ( void_fp )PASTEMAC2(ch,opname,_unb_var1), \
+		  .dt    = dt, \
+		  .n     = n, \
+		  .x     = x, .incx = incx, \
+		  .part  = part, \
+		  .cntx  = cntx, \
+		}; \
+\
+		bli_l1v_thread_decorator( &params, &rntm_l ); \
+\
+		/* Sum the threads' partial results in a fixed order so that the
+		   result does not depend on how the threads were scheduled. */ \
+		PASTEMAC(chr,set0s)( *asum ); \
+		for ( dim_t t = 0; t < bli_rntm_num_threads( &rntm_l ); ++t ) \
+			PASTEMAC(chr,adds)( part[ t ], *asum ); \
+\
+		bli_free_intl( part ); \
+		return; \
+	} \
 \
 	/* Invoke the helper variant, which loops over the appropriate kernel
 	   to implement the current operation. */ \
@@ -0,0 +1,356 @@
+/*
+
+   BLIS
+   An object-based framework for developing high-performance BLAS-like
+   libraries.
+
+   Copyright (C) 2014, The University of Texas at Austin
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are
+   met:
+    - Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    - Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    - Neither the name(s) of the copyright holder(s) nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "immintrin.h"
+#include "blis.h"
+
+// These kernels apply the post-ops to C one contiguous line (column or row)
+// at a time, one vector register's worth of elements at a time: each vector
+// is loaded once, passed through the entire list of post-ops, and stored
+// once. Lines that are not contiguous (general stride) are handled one
+// element at a time.
+
+#define GELU_SQRT_2_OVER_PI 0.7978845608028654
+#define GELU_COEF           0.044715
+#define GELU_SQRT_1_OVER_2  0.7071067811865476
+
+// -- Vector exp() -------------------------------------------------------------
+
+// exp(x) = 2^n * exp(r), where n = round(x / ln 2) and |r| <= (ln 2) / 2.
+// exp(r) is evaluated with its Taylor polynomial, truncated well beyond the
+// point where its remainder falls below the precision of the datatype.
+
+BLIS_INLINE __m256 bli_exp_ps( __m256 x )
+{
+	x = _mm256_min_ps( x, _mm256_set1_ps(  88.3f ) );
+	x = _mm256_max_ps( x, _mm256_set1_ps( -87.3f ) );
+
+	const __m256 n = _mm256_round_ps
+	(
+	  _mm256_mul_ps( x, _mm256_set1_ps( 1.44269504088896341f ) ),
+	  _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC
+	);
+
+	__m256 r = _mm256_fnmadd_ps( n, _mm256_set1_ps( 0.693359375f ), x );
+	       r = _mm256_fnmadd_ps( n, _mm256_set1_ps( -2.12194440e-4f ), r );
+
+	__m256 p = _mm256_set1_ps( 1.0f / 5040.0f );
+	p = _mm256_fmadd_ps( p, r, _mm256_set1_ps( 1.0f / 720.0f ) );
+	p = _mm256_fmadd_ps( p, r, _mm256_set1_ps( 1.0f / 120.0f ) );
+	p = _mm256_fmadd_ps( p, r, _mm256_set1_ps( 1.0f / 24.0f ) );
+	p = _mm256_fmadd_ps( p, r, _mm256_set1_ps( 1.0f / 6.0f ) );
+	p = _mm256_fmadd_ps( p, r, _mm256_set1_ps( 0.5f ) );
+	p = _mm256_fmadd_ps( p, r, _mm256_set1_ps( 1.0f ) );
+	p = _mm256_fmadd_ps( p, r, _mm256_set1_ps( 1.0f ) );
+
+	const __m256i e = _mm256_slli_epi32
+	(
+	  _mm256_add_epi32( _mm256_cvtps_epi32( n ), _mm256_set1_epi32( 127 ) ),
+	  23
+	);
+
+	return _mm256_mul_ps( p, _mm256_castsi256_ps( e ) );
+}
+
+BLIS_INLINE __m256d bli_exp_pd( __m256d x )
+{
+	x = _mm256_min_pd( x, _mm256_set1_pd(  709.0 ) );
+	x = _mm256_max_pd( x, _mm256_set1_pd( -708.0 ) );
+
+	const __m256d n = _mm256_round_pd
+	(
+	  _mm256_mul_pd( x, _mm256_set1_pd( 1.4426950408889634 ) ),
+	  _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC
+	);
+
+	__m256d r = _mm256_fnmadd_pd( n, _mm256_set1_pd( 6.93145751953125e-1 ), x );
+	        r = _mm256_fnmadd_pd( n, _mm256_set1_pd( 1.42860682030941723212e-6 ), r );
+
+	__m256d p = _mm256_set1_pd( 1.0 / 6227020800.0 );
+	p = _mm256_fmadd_pd( p, r, _mm256_set1_pd( 1.0 / 479001600.0 ) );
+	p = _mm256_fmadd_pd( p, r, _mm256_set1_pd( 1.0 / 39916800.0 ) );
+	p = _mm256_fmadd_pd( p, r, _mm256_set1_pd( 1.0 / 3628800.0 ) );
+	p = _mm256_fmadd_pd( p, r, _mm256_set1_pd( 1.0 / 362880.0 ) );
+	p = _mm256_fmadd_pd( p, r, _mm256_set1_pd( 1.0 / 40320.0 ) );
+	p = _mm256_fmadd_pd( p, r, _mm256_set1_pd( 1.0 / 5040.0 ) );
+	p = _mm256_fmadd_pd( p, r, _mm256_set1_pd( 1.0 / 720.0 ) );
+	p = _mm256_fmadd_pd( p, r, _mm256_set1_pd( 1.0 / 120.0 ) );
+	p = _mm256_fmadd_pd( p, r, _mm256_set1_pd( 1.0 / 24.0 ) );
+	p = _mm256_fmadd_pd( p, r, _mm256_set1_pd( 1.0 / 6.0 ) );
+	p = _mm256_fmadd_pd( p, r, _mm256_set1_pd( 0.5 ) );
+	p = _mm256_fmadd_pd( p, r, _mm256_set1_pd( 1.0 ) );
+	p = _mm256_fmadd_pd( p, r, _mm256_set1_pd( 1.0 ) );
+
+	const __m256i e = _mm256_slli_epi64
+	(
+	  _mm256_add_epi64( _mm256_cvtepi32_epi64( _mm256_cvtpd_epi32( n ) ),
+	                    _mm256_set1_epi64x( 1023 ) ),
+	  52
+	);
+
+	return _mm256_mul_pd( p, _mm256_castsi256_pd( e ) );
+}
+
+// -- Vector GELU --------------------------------------------------------------
+
+// The tanh approximation of GELU, 0.5 x ( 1 + tanh( u ) ), is evaluated
+// as x / ( 1 + exp( -2u ) ), which is the same function.
+
+BLIS_INLINE __m256 bli_gelu_tanh_ps( __m256 x )
+{
+	const __m256 x2 = _mm256_mul_ps( x, x );
+	      __m256 u  = _mm256_fmadd_ps( x2, _mm256_set1_ps( GELU_COEF ),
+	                                   _mm256_set1_ps( 1.0f ) );
+	             u  = _mm256_mul_ps( _mm256_mul_ps( u, x ),
+	                                 _mm256_set1_ps( -2.0f * GELU_SQRT_2_OVER_PI ) );
+
+	return _mm256_div_ps( x, _mm256_add_ps( _mm256_set1_ps( 1.0f ),
+	                                        bli_exp_ps( u ) ) );
+}
+
+BLIS_INLINE __m256d bli_gelu_tanh_pd( __m256d x )
+{
+	const __m256d x2 = _mm256_mul_pd( x, x );
+	      __m256d u  = _mm256_fmadd_pd( x2, _mm256_set1_pd( GELU_COEF ),
+	                                    _mm256_set1_pd( 1.0 ) );
+	              u  = _mm256_mul_pd( _mm256_mul_pd( u, x ),
+	                                  _mm256_set1_pd( -2.0 * GELU_SQRT_2_OVER_PI ) );
+
+	return _mm256_div_pd( x, _mm256_add_pd( _mm256_set1_pd( 1.0 ),
+	                                        bli_exp_pd( u ) ) );
+}
+
+// The erf form of GELU has no vector implementation; erf() is applied to
+// the elements one at a time.
+
+BLIS_INLINE __m256 bli_gelu_erf_ps( __m256 x )
+{
+	float t[ 8 ] __attribute__((aligned(32)));
+
+	_mm256_store_ps( t, x );
+	for ( dim_t i = 0; i < 8; ++i )
+		t[ i ] = 0.5f * t[ i ] * ( 1.0f + erff( t[ i ] * GELU_SQRT_1_OVER_2 ) );
+
+	return _mm256_load_ps( t );
+}
+
+BLIS_INLINE __m256d bli_gelu_erf_pd( __m256d x )
+{
+	double t[ 4 ] __attribute__((aligned(32)));
+
+	_mm256_store_pd( t, x );
+	for ( dim_t i = 0; i < 4; ++i )
+		t[ i ] = 0.5 * t[ i ] * ( 1.0 + erf( t[ i ] * GELU_SQRT_1_OVER_2 ) );
+
+	return _mm256_load_pd( t );
+}
+
+// -----------------------------------------------------------------------------
+
+#undef  GENTFUNC
+#define GENTFUNC( ctype, ch, vtype, vch, itype, vlen, ivec, opname, arch ) \
+\
+/* Return the elements of the vector operand of a bias or scale post-op
+   that correspond to a vector of elements of a line of C. */ \
+BLIS_INLINE vtype PASTEMAC3(ch,opname,arch,_vop) \
+     ( \
+       const postop_desc_t* op, \
+             mdim_t         dim_e, \
+             dim_t          off_l, \
+             dim_t          off_e, \
+             dim_t          cnt, \
+             itype          mask \
+     ) \
+{ \
+	const ctype* v    = op->v; \
+	const inc_t  incv = op->incv; \
+\
+	/* If the vector operand is indexed by the line of C, broadcast the
+	   element for the line. */ \
+	if ( op->dim != dim_e ) \
+		return PASTECH(_mm256_set1_,vch)( v[ off_l * incv ] ); \
+\
+	v += off_e * incv; \
+\
+	if ( incv == 1 ) \
+	{ \
+		if ( cnt == vlen ) return PASTECH(_mm256_loadu_,vch)( v ); \
+		else               return PASTECH(_mm256_maskload_,vch)( v, mask ); \
+	} \
+\
+	ctype t[ vlen ] __attribute__((aligned(32))) = { 0 }; \
+	for ( dim_t i = 0; i < cnt; ++i ) t[ i ] = v[ i * incv ]; \
+\
+	return PASTECH(_mm256_load_,vch)( t ); \
+} \
+\
+/* Apply the post-ops to a vector of elements of a line of C. */ \
+BLIS_INLINE vtype PASTEMAC3(ch,opname,arch,_vec) \
+     ( \
+       const postops_t* postops, \
+             vtype      x, \
+             mdim_t     dim_e, \
+             dim_t      off_l, \
+             dim_t      off_e, \
+             dim_t      cnt, \
+             itype      mask \
+     ) \
+{ \
+	for ( dim_t p = 0; p < postops->n_ops; ++p ) \
+	{ \
+		const postop_desc_t* op = &postops->ops[ p ]; \
+\
+		switch ( op->op ) \
+		{ \
+			case BLIS_POSTOP_BIAS: \
+				x = PASTECH(_mm256_add_,vch) \
+				( \
+				  x, \
+				  PASTEMAC3(ch,opname,arch,_vop)( op, dim_e, off_l, off_e, cnt, mask ) \
+				); \
+				break; \
+			case BLIS_POSTOP_SCALE: \
+				x = PASTECH(_mm256_mul_,vch) \
+				( \
+				  x, \
+				  PASTEMAC3(ch,opname,arch,_vop)( op, dim_e, off_l, off_e, cnt, mask ) \
+				); \
+				break; \
+			case BLIS_POSTOP_RELU: \
+				/* The operands are ordered so that NaNs propagate. */ \
+				x = PASTECH(_mm256_max_,vch)( PASTECH(_mm256_setzero_,vch)(), x ); \
+				break; \
+			case BLIS_POSTOP_GELU_TANH: \
+				x = PASTECH(bli_gelu_tanh_,vch)( x ); \
+				break; \
+			case BLIS_POSTOP_GELU_ERF: \
+				x = PASTECH(bli_gelu_erf_,vch)( x ); \
+				break; \
+			case BLIS_POSTOP_CLIP: \
+				x = PASTECH(_mm256_max_,vch)( PASTECH(_mm256_set1_,vch)( op->lo ), x ); \
+				x = PASTECH(_mm256_min_,vch)( PASTECH(_mm256_set1_,vch)( op->hi ), x ); \
+				break; \
+		} \
+	} \
+\
+	return x; \
+} \
+\
+void PASTEMAC2(ch,opname,arch) \
+     ( \
+             dim_t      m, \
+             dim_t      n, \
+             dim_t      off_m, \
+             dim_t      off_n, \
+       const postops_t* postops, \
+             void*      c0, inc_t rs_c, inc_t cs_c, \
+       const cntx_t*    cntx  \
+     ) \
+{ \
+	ctype* restrict c = c0; \
+\
+	/* Traverse C by rows if it is row-stored and by columns otherwise. */ \
+	const bool   row_stored = ( cs_c == 1 && rs_c != 1 ); \
+	const dim_t  n_line     = ( row_stored ? m     : n     ); \
+	const dim_t  n_elem     = ( row_stored ? n     : m     ); \
+	const inc_t  ld_l       = ( row_stored ? rs_c  : cs_c  ); \
+	const inc_t  inc_e      = ( row_stored ? cs_c  : rs_c  ); \
+	const dim_t  off_l      = ( row_stored ? off_m : off_n ); \
+	const dim_t  off_e      = ( row_stored ? off_n : off_m ); \
+	const mdim_t dim_e      = ( row_stored ? BLIS_N : BLIS_M ); \
+\
+	const dim_t  n_left     = n_elem % vlen; \
+	const itype  mask       = ivec; \
+\
+	for ( dim_t l = 0; l < n_line; ++l ) \
+	{ \
+		ctype* restrict cl = c + l * ld_l; \
+\
+		if ( inc_e == 1 ) \
+		{ \
+			dim_t e = 0; \
+\
+			for ( ; e + vlen <= n_elem; e += vlen ) \
+			{ \
+				vtype x = PASTECH(_mm256_loadu_,vch)( cl + e ); \
+				x = PASTEMAC3(ch,opname,arch,_vec) \
+				( \
+				  postops, x, dim_e, off_l + l, off_e + e, vlen, mask \
+				); \
+				PASTECH(_mm256_storeu_,vch)( cl + e, x ); \
+			} \
+\
+			if ( n_left ) \
+			{ \
+				vtype x = PASTECH(_mm256_maskload_,vch)( cl + e, mask ); \
+				x = PASTEMAC3(ch,opname,arch,_vec) \
+				( \
+				  postops, x, dim_e, off_l + l, off_e + e, n_left, mask \
+				); \
+				PASTECH(_mm256_maskstore_,vch)( cl + e, mask, x ); \
+			} \
+		} \
+		else \
+		{ \
+			/* Gather the elements of the line (vlen at a time) into a
+			   contiguous temporary and proceed as above. */ \
+			for ( dim_t e = 0; e < n_elem; e += vlen ) \
+			{ \
+				const dim_t cnt = bli_min( vlen, n_elem - e ); \
+				ctype       t[ vlen ] __attribute__((aligned(32))) = { 0 }; \
+\
+				for ( dim_t i = 0; i < cnt; ++i ) t[ i ] = cl[ ( e + i ) * inc_e ]; \
+\
+				vtype x = PASTECH(_mm256_load_,vch)( t ); \
+				x = PASTEMAC3(ch,opname,arch,_vec) \
+				( \
+				  postops, x, dim_e, off_l + l, off_e + e, cnt, mask \
+				); \
+				PASTECH(_mm256_store_,vch)( t, x ); \
+\
+				for ( dim_t i = 0; i < cnt; ++i ) cl[ ( e + i ) * inc_e ] = t[ i ]; \
+			} \
+		} \
+	} \
+}
+
+GENTFUNC( float,  s, __m256,  ps, __m256i, 8,
+          _mm256_cmpgt_epi32( _mm256_set1_epi32( n_left ),
+                              _mm256_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7 ) ),
+          postops, _haswell_int )
+GENTFUNC( double, d, __m256d, pd, __m256i, 4,
+          _mm256_cmpgt_epi64( _mm256_set1_epi64x( n_left ),
+                              _mm256_setr_epi64x( 0, 1, 2, 3 ) ),
+          postops, _haswell_int )
+
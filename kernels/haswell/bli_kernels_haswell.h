@@ -71,6 +71,18 @@ GEMMTRSM_UKR_PROT( double,   d, gemmtrsm_l_haswell_asm_6x8 )
 GEMMTRSM_UKR_PROT( float,    s, gemmtrsm_u_haswell_asm_6x16 )
 GEMMTRSM_UKR_PROT( double,   d, gemmtrsm_u_haswell_asm_6x8 )
 
+// post-ops
+POSTOPS_KER_PROT( float,    s, postops_haswell_int )
+POSTOPS_KER_PROT( double,   d, postops_haswell_int )
+
+// compact (interleaved batch)
+GEMM_COMPACT_KER_PROT(    float,  s, gemm_compact_haswell_int )
+GEMM_COMPACT_KER_PROT(    double, d, gemm_compact_haswell_int )
+TRSM_COMPACT_KER_PROT(    float,  s, trsm_compact_haswell_int )
+TRSM_COMPACT_KER_PROT(    double, d, trsm_compact_haswell_int )
+GETRFNP_COMPACT_KER_PROT( float,  s, getrfnp_compact_haswell_int )
+GETRFNP_COMPACT_KER_PROT( double, d, getrfnp_compact_haswell_int )
+
 
 // gemm (asm d8x6)
 //GEMM_UKR_PROT( float,    s, gemm_haswell_asm_16x6 )
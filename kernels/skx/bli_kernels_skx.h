@@ -38,4 +38,12 @@ GEMM_UKR_PROT( float ,   s, gemm_skx_asm_12x32_l2 )
 GEMM_UKR_PROT( double,   d, gemm_skx_asm_16x12_l2 )
 GEMM_UKR_PROT( double,   d, gemm_skx_asm_16x14 )
 
+// compact (interleaved batch)
+GEMM_COMPACT_KER_PROT(    float,  s, gemm_compact_skx_int )
+GEMM_COMPACT_KER_PROT(    double, d, gemm_compact_skx_int )
+TRSM_COMPACT_KER_PROT(    float,  s, trsm_compact_skx_int )
+TRSM_COMPACT_KER_PROT(    double, d, trsm_compact_skx_int )
+GETRFNP_COMPACT_KER_PROT( float,  s, getrfnp_compact_skx_int )
+GETRFNP_COMPACT_KER_PROT( double, d, getrfnp_compact_skx_int )
+
 
@@ -0,0 +1,208 @@
+/*
+
+   BLIS
+   An object-based framework for developing high-performance BLAS-like
+   libraries.
+
+   Copyright (C) 2014, The University of Texas at Austin
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are
+   met:
+    - Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    - Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    - Neither the name(s) of the copyright holder(s) nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "blis.h"
+
+// Reference kernels for the compact batch format, in which element (i,j)
+// of V consecutive members of a batch occupies V consecutive elements (see
+// bli_compact.h). Each kernel operates on one such group of V members, and
+// the row and column strides of its operands are those of the vectors of V
+// elements. Every operation is written with the loop over the members
+// innermost so that it vectorizes across the batch.
+
+#undef  GENTFUNCRO
+#define GENTFUNCRO( ctype, ch, opname, arch, suf ) \
+\
+void PASTEMAC3(ch,opname,arch,suf) \
+     ( \
+             dim_t   m, \
+             dim_t   n, \
+             dim_t   k, \
+       const void*   alpha0, \
+       const void*   a0, inc_t rs_a, inc_t cs_a, \
+       const void*   b0, inc_t rs_b, inc_t cs_b, \
+       const void*   beta0, \
+             void*   c0, inc_t rs_c, inc_t cs_c, \
+       const cntx_t* cntx  \
+     ) \
+{ \
+	const dim_t           v     = bli_cntx_get_blksz_def_dt( PASTEMAC(ch,type), BLIS_CV, cntx ); \
+	const ctype           alpha = *( const ctype* )alpha0; \
+	const ctype           beta  = *( const ctype* )beta0; \
+	const ctype* restrict a     = a0; \
+	const ctype* restrict b     = b0; \
+	      ctype* restrict c     = c0; \
+\
+	for ( dim_t j = 0; j < n; ++j ) \
+	{ \
+		ctype* restrict cj = c + j*cs_c; \
+\
+		/* Scale the column of C by beta, overwriting it if beta is zero. */ \
+		for ( dim_t i = 0; i < m; ++i ) \
+		for ( dim_t l = 0; l < v; ++l ) \
+		{ \
+			ctype* restrict cij = cj + i*rs_c + l; \
+			if ( PASTEMAC(ch,eq0)( beta ) ) *cij = 0; \
+			else                            *cij = beta * *cij; \
+		} \
+\
+		for ( dim_t p = 0; p < k; ++p ) \
+		{ \
+			const ctype* restrict bpj = b + p*rs_b + j*cs_b; \
+\
+			for ( dim_t i = 0; i < m; ++i ) \
+			{ \
+				const ctype* restrict aip = a + i*rs_a + p*cs_a; \
+				      ctype* restrict cij = cj + i*rs_c; \
+\
+				for ( dim_t l = 0; l < v; ++l ) \
+					cij[ l ] += aip[ l ] * ( alpha * bpj[ l ] ); \
+			} \
+		} \
+	} \
+}
+
+INSERT_GENTFUNCRO_BASIC( gemm_compact, BLIS_CNAME_INFIX, BLIS_REF_SUFFIX )
+
+
+#undef  GENTFUNCRO
+#define GENTFUNCRO( ctype, ch, opname, arch, suf ) \
+\
+void PASTEMAC3(ch,opname,arch,suf) \
+     ( \
+             uplo_t  uploa, \
+             diag_t  diaga, \
+             dim_t   m, \
+             dim_t   n, \
+       const void*   alpha0, \
+       const void*   a0, inc_t rs_a, inc_t cs_a, \
+             void*   b0, inc_t rs_b, inc_t cs_b, \
+       const cntx_t* cntx  \
+     ) \
+{ \
+	const dim_t           v     = bli_cntx_get_blksz_def_dt( PASTEMAC(ch,type), BLIS_CV, cntx ); \
+	const ctype           alpha = *( const ctype* )alpha0; \
+	const ctype* restrict a     = a0; \
+	      ctype* restrict b     = b0; \
+\
+	/* Solve A * X = alpha * B, one column at a time, overwriting B with X.
+	   Rows are solved top-down if A is lower triangular, and bottom-up if
+	   it is upper triangular. */ \
+	const bool  lower = bli_is_lower( uploa ); \
+\
+	for ( dim_t j = 0; j < n; ++j ) \
+	{ \
+		ctype* restrict bj = b + j*cs_b; \
+\
+		for ( dim_t ii = 0; ii < m; ++ii ) \
+		{ \
+			const dim_t i     = ( lower ? ii : m - 1 - ii ); \
+			const dim_t p_beg = ( lower ? 0  : i + 1 ); \
+			const dim_t p_end = ( lower ? i  : m     ); \
+\
+			ctype* restrict bij = bj + i*rs_b; \
+\
+			for ( dim_t l = 0; l < v; ++l ) \
+				bij[ l ] *= alpha; \
+\
+			for ( dim_t p = p_beg; p < p_end; ++p ) \
+			{ \
+				const ctype* restrict aip = a + i*rs_a + p*cs_a; \
+				const ctype* restrict bpj = bj + p*rs_b; \
+\
+				for ( dim_t l = 0; l < v; ++l ) \
+					bij[ l ] -= aip[ l ] * bpj[ l ]; \
+			} \
+\
+			if ( bli_is_nonunit_diag( diaga ) ) \
+			{ \
+				const ctype* restrict aii = a + i*rs_a + i*cs_a; \
+\
+				for ( dim_t l = 0; l < v; ++l ) \
+					bij[ l ] /= aii[ l ]; \
+			} \
+		} \
+	} \
+}
+
+INSERT_GENTFUNCRO_BASIC( trsm_compact, BLIS_CNAME_INFIX, BLIS_REF_SUFFIX )
+
+
+#undef  GENTFUNCRO
+#define GENTFUNCRO( ctype, ch, opname, arch, suf ) \
+\
+void PASTEMAC3(ch,opname,arch,suf) \
+     ( \
+             dim_t   m, \
+             dim_t   n, \
+             void*   a0, inc_t rs_a, inc_t cs_a, \
+       const cntx_t* cntx  \
+     ) \
+{ \
+	const dim_t           v = bli_cntx_get_blksz_def_dt( PASTEMAC(ch,type), BLIS_CV, cntx ); \
+	      ctype* restrict a = a0; \
+\
+	/* Factor A = L * U without pivoting (right-looking), overwriting the
+	   strictly lower triangle of A with that of L (whose diagonal is unit)
+	   and the upper triangle of A with U. */ \
+	for ( dim_t p = 0; p < bli_min( m, n ); ++p ) \
+	{ \
+		const ctype* restrict app = a + p*rs_a + p*cs_a; \
+\
+		for ( dim_t i = p + 1; i < m; ++i ) \
+		{ \
+			ctype* restrict aip = a + i*rs_a + p*cs_a; \
+\
+			for ( dim_t l = 0; l < v; ++l ) \
+				aip[ l ] /= app[ l ]; \
+		} \
+\
+		for ( dim_t j = p + 1; j < n; ++j ) \
+		{ \
+			const ctype* restrict apj = a + p*rs_a + j*cs_a; \
+\
+			for ( dim_t i = p + 1; i < m; ++i ) \
+			{ \
+				const ctype* restrict aip = a + i*rs_a + p*cs_a; \
+				      ctype* restrict aij = a + i*rs_a + j*cs_a; \
+\
+				for ( dim_t l = 0; l < v; ++l ) \
+					aij[ l ] -= aip[ l ] * apj[ l ]; \
+			} \
+		} \
+	} \
+}
+
+INSERT_GENTFUNCRO_BASIC( getrfnp_compact, BLIS_CNAME_INFIX, BLIS_REF_SUFFIX )
+
@@ -0,0 +1,108 @@
+/*
+
+   BLIS
+   An object-based framework for developing high-performance BLAS-like
+   libraries.
+
+   Copyright (C) 2014, The University of Texas at Austin
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are
+   met:
+    - Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    - Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    - Neither the name(s) of the copyright holder(s) nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "blis.h"
+
+// Apply a list of post-ops to an m x n submatrix of C whose (0,0) element
+// is element (off_m,off_n) of C; the offsets are used to index the vector
+// operands of bias and scale post-ops.
+
+#undef  GENTFUNCRO
+#define GENTFUNCRO( ctype, ch, opname, arch, suf ) \
+\
+void PASTEMAC3(ch,opname,arch,suf) \
+     ( \
+             dim_t      m, \
+             dim_t      n, \
+             dim_t      off_m, \
+             dim_t      off_n, \
+       const postops_t* postops, \
+             void*      c0, inc_t rs_c, inc_t cs_c, \
+       const cntx_t*    cntx  \
+     ) \
+{ \
+	ctype* restrict c = c0; \
+\
+	/* Traverse C along its contiguous dimension, if it has one. */ \
+	const bool  row_stored = ( cs_c == 1 && rs_c != 1 ); \
+	const dim_t n_iter     = ( row_stored ? m : n ); \
+	const dim_t n_elem     = ( row_stored ? n : m ); \
+\
+	for ( dim_t l = 0; l < n_iter; ++l ) \
+	for ( dim_t e = 0; e < n_elem; ++e ) \
+	{ \
+		const dim_t i   = ( row_stored ? l : e ); \
+		const dim_t j   = ( row_stored ? e : l ); \
+		      ctype cij = c[ i*rs_c + j*cs_c ]; \
+\
+		for ( dim_t p = 0; p < postops->n_ops; ++p ) \
+		{ \
+			const postop_desc_t* op = &postops->ops[ p ]; \
+			const ctype*         v  = op->v; \
+			const dim_t          iv = ( op->dim == BLIS_M ? off_m + i \
+			                                              : off_n + j ); \
+\
+			switch ( op->op ) \
+			{ \
+				case BLIS_POSTOP_BIAS: \
+					cij += v[ iv * op->incv ]; \
+					break; \
+				case BLIS_POSTOP_SCALE: \
+					cij *= v[ iv * op->incv ]; \
+					break; \
+				case BLIS_POSTOP_RELU: \
+					cij = ( cij < 0 ? 0 : cij ); \
+					break; \
+				case BLIS_POSTOP_GELU_TANH: \
+					/* 0.5 x ( 1 + tanh( u ) ) = x / ( 1 + exp( -2u ) ), but the
+					   latter does not suffer cancellation when u << 0. */ \
+					cij = cij / ( 1.0 + exp( -2.0 * 0.7978845608028654 * \
+					                         ( cij + 0.044715 * cij * cij * cij ) ) ); \
+					break; \
+				case BLIS_POSTOP_GELU_ERF: \
+					cij = 0.5 * cij * ( 1.0 + erf( cij * 0.7071067811865476 ) ); \
+					break; \
+				case BLIS_POSTOP_CLIP: \
+					cij = ( cij < op->lo ? op->lo : cij ); \
+					cij = ( cij > op->hi ? op->hi : cij ); \
+					break; \
+			} \
+		} \
+\
+		c[ i*rs_c + j*cs_c ] = cij; \
+	} \
+}
+
+INSERT_GENTFUNCRO_BASIC( postops, BLIS_CNAME_INFIX, BLIS_REF_SUFFIX )
+
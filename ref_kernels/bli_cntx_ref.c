@@ -78,6 +78,32 @@ INSERT_PROTMAC_BASIC( GEMMTRSM_UKR_PROT, gemmtrsm_u_ukr_name )
 INSERT_PROTMAC_BASIC( TRSM_UKR_PROT,     trsm_l_ukr_name )
 INSERT_PROTMAC_BASIC( TRSM_UKR_PROT,     trsm_u_ukr_name )
 
+// -- Construct arch-specific names for reference level-3 post-op kernels --
+
+#define postops_ker_name    GENARNAME(postops)
+
+// Instantiate prototypes for above functions using the pre-defined level-3
+// post-op kernel prototype-generating macros.
+
+POSTOPS_KER_PROT( float,  s, postops_ker_name )
+POSTOPS_KER_PROT( double, d, postops_ker_name )
+
+// -- Construct arch-specific names for reference level-3 compact kernels --
+
+#define gemm_compact_ker_name     GENARNAME(gemm_compact)
+#define trsm_compact_ker_name     GENARNAME(trsm_compact)
+#define getrfnp_compact_ker_name  GENARNAME(getrfnp_compact)
+
+// Instantiate prototypes for above functions using the pre-defined level-3
+// compact kernel prototype-generating macros.
+
+GEMM_COMPACT_KER_PROT(    float,  s, gemm_compact_ker_name )
+GEMM_COMPACT_KER_PROT(    double, d, gemm_compact_ker_name )
+TRSM_COMPACT_KER_PROT(    float,  s, trsm_compact_ker_name )
+TRSM_COMPACT_KER_PROT(    double, d, trsm_compact_ker_name )
+GETRFNP_COMPACT_KER_PROT( float,  s, getrfnp_compact_ker_name )
+GETRFNP_COMPACT_KER_PROT( double, d, getrfnp_compact_ker_name )
+
 
 // -- Level-3 virtual micro-kernel prototype redefinitions ---------------------
 
@@ -222,6 +248,12 @@ INSERT_PROTMAC_BASIC( XPBYV_KER_PROT,    xpbyv_ker_name )
 	                       PASTEMAC(c,opname), PASTEMAC(z,opname) ); \
 }
 
+#define gen_func_init_ro( func_p, opname ) \
+{ \
+	bli_func_init( func_p, PASTEMAC(s,opname), PASTEMAC(d,opname), \
+	                       NULL,               NULL                ); \
+}
+
 #define gen_func_init( func_p, opname ) \
 { \
 	bli_func_init( func_p, PASTEMAC(s,opname), PASTEMAC(d,opname), \
@@ -303,6 +335,34 @@ void GENBARNAME(cntx_init)
 	bli_blksz_init_easy( &blkszs[ BLIS_NT ],    0,    0,    0,    0 );
 	bli_blksz_init_easy( &blkszs[ BLIS_KT ],    0,    0,    0,    0 );
 
+	// -- Set level-3 tiny problem threshold -----------------------------------
+
+	// NOTE: gemm problems in which no dimension exceeds this threshold are
+	// computed by the typed API and the BLAS directly with the sup
+	// millikernels, without building objects (see bli_gemm_tiny.h). A
+	// threshold of zero disables this fast path. The path is also skipped
+	// for any datatype whose sup thresholds are unmet (including the zero
+	// defaults above) or that has no sup blocksizes.
+	//                                           s      d      c      z
+	bli_blksz_init_easy( &blkszs[ BLIS_TT ],    16,    16,     8,     8 );
+
+	// -- Set level-1v multithreading threshold --------------------------------
+
+	// NOTE: Level-1v operations are only parallelized when each thread can be
+	// given at least this many elements. The default corresponds to 256 KiB
+	// of each vector per thread. A threshold of zero disables multithreading.
+	//                                           s      d      c      z
+	bli_blksz_init_easy( &blkszs[ BLIS_VT ], 65536, 32768, 32768, 16384 );
+
+	// -- Set compact batch format vector length -------------------------------
+
+	// NOTE: This is the number of batch members whose elements are
+	// interleaved in the compact format, which an optimized configuration
+	// sets to the number of elements in a vector register along with its
+	// compact kernels. The reference kernels accept any value.
+	//                                           s      d      c      z
+	bli_blksz_init_easy( &blkszs[ BLIS_CV ],     8,     4,     4,     2 );
+
 	// Initialize the context with the default blocksize objects and their
 	// multiples.
 	bli_cntx_set_blkszs
@@ -322,6 +382,9 @@ void GENBARNAME(cntx_init)
 	  BLIS_MT,  &blkszs[ BLIS_MT  ], BLIS_MT,
 	  BLIS_NT,  &blkszs[ BLIS_NT  ], BLIS_NT,
 	  BLIS_KT,  &blkszs[ BLIS_KT  ], BLIS_KT,
+	  BLIS_TT,  &blkszs[ BLIS_TT  ], BLIS_TT,
+	  BLIS_VT,  &blkszs[ BLIS_VT  ], BLIS_VT,
+	  BLIS_CV,  &blkszs[ BLIS_CV  ], BLIS_CV,
 	  BLIS_BBM, &blkszs[ BLIS_BBM ], BLIS_BBM,
 	  BLIS_BBN, &blkszs[ BLIS_BBN ], BLIS_BBN,
 	  BLIS_VA_END
@@ -362,6 +425,20 @@ void GENBARNAME(cntx_init)
 	bli_mbool_init( &mbools[ BLIS_TRSM_U_UKR_ROW_PREF ],     FALSE, FALSE, FALSE, FALSE );
 
 
+	// -- Set level-3 post-op kernels ------------------------------------------
+
+	// Post-ops are only defined for real matrices.
+	gen_func_init_ro( &funcs[ BLIS_POSTOPS_KER ], postops_ker_name );
+
+
+	// -- Set level-3 compact kernels ------------------------------------------
+
+	// The compact format is only defined for real matrices.
+	gen_func_init_ro( &funcs[ BLIS_GEMM_COMPACT_KER ],    gemm_compact_ker_name );
+	gen_func_init_ro( &funcs[ BLIS_TRSM_COMPACT_KER ],    trsm_compact_ker_name );
+	gen_func_init_ro( &funcs[ BLIS_GETRFNP_COMPACT_KER ], getrfnp_compact_ker_name );
+
+
 	// -- Set level-3 small/unpacked micro-kernels and preferences -------------
 
 	gen_func_init( &funcs[ BLIS_GEMMSUP_RRR_UKR ], gemmsup_rv_ukr_name );
@@ -0,0 +1,93 @@
+#!/bin/bash
+
+# Compare BLIS gemm performance with and without huge pages backing the
+# packing block pools. With BLIS_HUGEPAGES=0, packed blocks of A and B live
+# in base (4 KB) pages, so streaming a packed block of B through the
+# microkernel touches a new TLB entry every 4 KB. With BLIS_HUGEPAGES=1, the
+# blocks are 2 MB-aligned and backed by transparent huge pages, and with
+# BLIS_HUGEPAGES=2, they come from the reserved hugetlbfs pages (see
+# /proc/sys/vm/nr_hugepages), falling back to transparent huge pages. Build
+# the drivers first via 'make blis-st blis-mt'.
+
+# File pefixes.
+exec_root="test"
+out_root="output_hugepages"
+delay=0.1
+
+# Threadedness to test ('st' and/or 'mt'). For 'mt', use all of the
+# machine's hardware threads.
+threads="st mt"
+nt=$(getconf _NPROCESSORS_ONLN)
+
+# Problem size range. Huge pages matter most for large problems, in which
+# the packed blocks are as large as the cache blocksizes allow.
+psr="1000 8000 1000"
+
+# Optionally, prefix the driver with a tool that counts DTLB misses, which
+# makes the effect of the huge pages visible directly (rather than only
+# through the resulting performance).
+counters=""
+#counters="perf stat -e dTLB-loads,dTLB-load-misses,dtlb_load_misses.walk_completed --"
+
+# Huge page modes to test.
+modes="0 1 2"
+
+# Datatypes to test.
+test_dts="d"
+
+# Number of repeats per problem size.
+nrepeats=3
+
+# The induced method to use ('native' or '1m').
+ind="native"
+
+# For testing purposes.
+#dryrun="yes"
+
+# Iterate over the threadedness.
+for th in ${threads}; do
+
+	exec_name="${exec_root}_gemm_blis_${th}.x"
+
+	if [ ! -x "./${exec_name}" ]; then
+
+		echo "Could not find ${exec_name}; run 'make blis-${th}' first."
+		exit 1
+	fi
+
+	if [ "${th}" = "mt" ]; then
+		export BLIS_NUM_THREADS=${nt}
+	else
+		export BLIS_NUM_THREADS=1
+	fi
+
+	# Iterate over the datatypes.
+	for dt in ${test_dts}; do
+
+		# Iterate over the huge page modes.
+		for mode in ${modes}; do
+
+			export BLIS_HUGEPAGES=${mode}
+
+			# Construct the name of the output file.
+			out_file="${out_root}${mode}_${th}_${dt}gemm_nn_blis.m"
+
+			# Use printf for its formatting capabilities.
+			printf 'Running BLIS_HUGEPAGES=%s %s %s %s %s %s %s %s > %s\n' \
+			       "${mode}" "${counters}" "./${exec_name}" "-d ${dt}" \
+			                                                 "-c nn" \
+			                                                 "-i ${ind}" \
+			                                                 "-p \"${psr}\"" \
+			                                                 "-r ${nrepeats}" \
+			                                                 "${out_file}"
+
+			if [ "${dryrun}" != "yes" ]; then
+				${counters} ./${exec_name} -d ${dt} -c nn -i ${ind} -p "${psr}" -r ${nrepeats} -v > ${out_file}
+			fi
+
+			# Bedtime!
+			sleep ${delay}
+
+		done
+	done
+done
@@ -0,0 +1,81 @@
+#!/bin/bash
+
+# Compare multithreaded BLIS gemm performance with and without per-NUMA-node
+# packing block pools. With BLIS_NUMA_POOLS=0, all threads share one set of
+# pools, so threads on one node may end up packing into (and streaming from)
+# blocks that reside in the memory of another node. With BLIS_NUMA_POOLS=1
+# (the default), each thread checks out blocks from the pools of its own
+# node. Build the driver first via 'make blis-mt'.
+
+# File pefixes.
+exec_root="test"
+out_root="output_numa"
+delay=0.1
+
+# Use all of the machine's hardware threads by default, with one thread bound
+# to each processor so that threads do not migrate between nodes.
+nt=$(getconf _NPROCESSORS_ONLN)
+export BLIS_NUM_THREADS=${nt}
+export GOMP_CPU_AFFINITY="0-$(expr ${nt} - 1)"
+export OMP_PROC_BIND=true
+
+# Problem size range.
+psr="400 8000 400"
+
+# Optionally, prefix the driver with a tool that counts local and remote
+# memory accesses, which makes the effect of the per-node pools visible
+# directly (rather than only through the resulting performance).
+counters=""
+#counters="perf stat -e node-loads,node-load-misses --"
+
+# Datatypes to test.
+test_dts="d"
+
+# Number of repeats per problem size.
+nrepeats=3
+
+# The induced method to use ('native' or '1m').
+ind="native"
+
+# For testing purposes.
+#dryrun="yes"
+
+exec_name="${exec_root}_gemm_blis_mt.x"
+
+if [ ! -x "./${exec_name}" ]; then
+
+	echo "Could not find ${exec_name}; run 'make blis-mt' first."
+	exit 1
+fi
+
+echo "Using ${nt} threads."
+
+# Iterate over the datatypes.
+for dt in ${test_dts}; do
+
+	# Iterate over the pool configurations: shared (0) and per-node (1).
+	for pools in 0 1; do
+
+		export BLIS_NUMA_POOLS=${pools}
+
+		# Construct the name of the output file.
+		out_file="${out_root}${pools}_mt_${dt}gemm_nn_blis.m"
+
+		# Use printf for its formatting capabilities.
+		printf 'Running BLIS_NUMA_POOLS=%s %s %s %s %s %s %s %s > %s\n' \
+		       "${pools}" "${counters}" "./${exec_name}" "-d ${dt}" \
+		                                                 "-c nn" \
+		                                                 "-i ${ind}" \
+		                                                 "-p \"${psr}\"" \
+		                                                 "-r ${nrepeats}" \
+		                                                 "${out_file}"
+
+		if [ "${dryrun}" != "yes" ]; then
+			${counters} ./${exec_name} -d ${dt} -c nn -i ${ind} -p "${psr}" -r ${nrepeats} -v > ${out_file}
+		fi
+
+		# Bedtime!
+		sleep ${delay}
+
+	done
+done
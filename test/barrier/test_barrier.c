@@ -0,0 +1,132 @@
+/*
+
+   BLIS
+   An object-based framework for developing high-performance BLAS-like
+   libraries.
+
+   Copyright (C) 2014, The University of Texas at Austin
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are
+   met:
+    - Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    - Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    - Neither the name of The University of Texas nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "blis.h"
+
+//
+// A microbenchmark that measures the average latency of the barrier used to
+// synchronize threads within the level-3 operations (bli_thrcomm_barrier())
+// as a function of the number of threads. Whether the central or the tree
+// barrier is measured depends on whether BLIS was configured with
+// --enable-tree-barrier. The threading implementation and wait policy are
+// taken from the environment (e.g. BLIS_THREAD_IMPL and BLIS_WAIT_POLICY).
+//
+
+#ifdef BLIS_TREE_BARRIER
+#define BAR_STR "tree"
+#else
+#define BAR_STR "central"
+#endif
+
+typedef struct
+{
+	dim_t   n_barriers;
+	double* dtime;
+} params_t;
+
+static void barrier_entry( thrcomm_t* gl_comm, dim_t tid, const void* params_v )
+{
+	const params_t* params     = params_v;
+	const dim_t     n_barriers = params->n_barriers;
+
+	// Warm up the barrier (and let all threads arrive) before timing.
+	for ( dim_t i = 0; i < 100; i++ )
+		bli_thrcomm_barrier( tid, gl_comm );
+
+	double dtime = bli_clock();
+
+	for ( dim_t i = 0; i < n_barriers; i++ )
+		bli_thrcomm_barrier( tid, gl_comm );
+
+	dtime = bli_clock() - dtime;
+
+	if ( tid == 0 ) *params->dtime = dtime;
+}
+
+int main( int argc, char** argv )
+{
+	const dim_t n_repeats = 3;
+
+	bli_init();
+
+	const timpl_t ti = bli_thread_get_thread_impl();
+	const wpol_t  wp = bli_thread_get_wait_policy();
+
+	printf( "%% barrier: %s; threading: %s; wait policy: %s; barriers per trial: %d\n",
+	        BAR_STR,
+	        bli_thread_get_thread_impl_str( ti ),
+	        bli_thread_get_wait_policy_str( wp ),
+	        ( int )N_BARRIERS );
+	printf( "%% ( nt, 1:2 ) = [ threads  usec/barrier ]\n" );
+
+	dim_t p_begin = P_BEGIN;
+	dim_t p_end   = P_END;
+	dim_t p_inc   = P_INC;
+
+	// Skip the thread counts that are not possible in single-threaded builds.
+	if ( ti == BLIS_SINGLE ) p_end = 1;
+
+	for ( dim_t nt = p_begin; nt <= p_end; nt += p_inc )
+	{
+		rntm_t   rntm = BLIS_RNTM_INITIALIZER;
+		double   dtime;
+		double   dtime_save = DBL_MAX;
+		params_t params;
+
+		bli_rntm_set_thread_impl( ti, &rntm );
+		bli_rntm_set_wait_policy( wp, &rntm );
+		bli_rntm_set_num_threads( nt, &rntm );
+
+		params.n_barriers = N_BARRIERS;
+		params.dtime      = &dtime;
+
+		for ( dim_t r = 0; r < n_repeats; r++ )
+		{
+			bli_thread_launch_rntm( &rntm, barrier_entry, &params );
+
+			dtime_save = bli_fmin( dtime_save, dtime );
+		}
+
+		double usec = ( dtime_save / ( double )N_BARRIERS ) * 1.0e6;
+
+		printf( "data_barrier_%s( %2lu, 1:2 ) = [ %4lu %10.4f ];\n",
+		        BAR_STR, ( unsigned long )( ( nt - p_begin ) / p_inc + 1 ),
+		        ( unsigned long )nt, usec );
+	}
+
+	bli_finalize();
+
+	return 0;
+}
+
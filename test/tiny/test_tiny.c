@@ -0,0 +1,160 @@
+/*
+
+   BLIS
+   An object-based framework for developing high-performance BLAS-like
+   libraries.
+
+   Copyright (C) 2014, The University of Texas at Austin
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are
+   met:
+    - Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    - Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    - Neither the name(s) of the copyright holder(s) nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "blis.h"
+
+//
+// A microbenchmark that measures the average latency, in nanoseconds per
+// call, of the typed gemm API on tiny square problems (m = n = k). Each
+// problem is timed twice: once with the default context, for which problems
+// no larger than the BLIS_TT threshold are computed directly by the sup
+// millikernels (see bli_gemm_tiny.h), and once with a copy of that context
+// whose threshold is zero, so that every problem takes the full object path.
+// Calls are single-threaded. The fast path applies only to datatypes for
+// which the configuration registers sup blocksizes and whose sup thresholds
+// admit the problem; for other datatypes, both columns time the full object
+// path and the difference is noise.
+//
+
+#undef  GENTFUNC
+#define GENTFUNC( ctype, ch, opname ) \
+\
+static double PASTEMAC(ch,opname) \
+     ( \
+       dim_t         n, \
+       dim_t         n_calls, \
+       const cntx_t* cntx, \
+       const rntm_t* rntm  \
+     ) \
+{ \
+	const dim_t n_repeats = 3; \
+\
+	err_t  r_val; \
+	ctype  alpha = *PASTEMAC(ch,1); \
+	ctype  beta  = *PASTEMAC(ch,1); \
+	ctype* a     = bli_malloc_user( n * n * sizeof( ctype ), &r_val ); \
+	ctype* b     = bli_malloc_user( n * n * sizeof( ctype ), &r_val ); \
+	ctype* c     = bli_malloc_user( n * n * sizeof( ctype ), &r_val ); \
+	double dtime_save = DBL_MAX; \
+\
+	PASTEMAC(ch,setm)( BLIS_NO_CONJUGATE, 0, BLIS_NONUNIT_DIAG, BLIS_DENSE, \
+	                   n, n, PASTEMAC(ch,1), a, 1, n ); \
+	PASTEMAC(ch,setm)( BLIS_NO_CONJUGATE, 0, BLIS_NONUNIT_DIAG, BLIS_DENSE, \
+	                   n, n, PASTEMAC(ch,1), b, 1, n ); \
+	PASTEMAC(ch,setm)( BLIS_NO_CONJUGATE, 0, BLIS_NONUNIT_DIAG, BLIS_DENSE, \
+	                   n, n, PASTEMAC(ch,0), c, 1, n ); \
+\
+	for ( dim_t r = 0; r < n_repeats; r++ ) \
+	{ \
+		double dtime = bli_clock(); \
+\
+		for ( dim_t i = 0; i < n_calls; i++ ) \
+			PASTEMAC2(ch,gemm,BLIS_TAPI_EX_SUF) \
+			( \
+			  BLIS_NO_TRANSPOSE, BLIS_NO_TRANSPOSE, n, n, n, \
+			  &alpha, a, 1, n, b, 1, n, &beta, c, 1, n, cntx, rntm \
+			); \
+\
+		dtime_save = bli_fmin( dtime_save, bli_clock() - dtime ); \
+	} \
+\
+	bli_free_user( a ); \
+	bli_free_user( b ); \
+	bli_free_user( c ); \
+\
+	return ( dtime_save / ( double )n_calls ) * 1.0e9; \
+}
+
+INSERT_GENTFUNC_BASIC( time_gemm )
+
+int main( int argc, char** argv )
+{
+	bli_init();
+
+	rntm_t rntm = BLIS_RNTM_INITIALIZER;
+
+	bli_rntm_set_num_threads( 1, &rntm );
+
+	// Copy the default context and disable the fast path in the copy.
+	const cntx_t* cntx_fast = bli_gks_query_cntx();
+	cntx_t        cntx_full = *cntx_fast;
+
+	for ( num_t dt = BLIS_DT_LO; dt <= BLIS_DT_HI; dt++ )
+		bli_cntx_set_blksz_def_dt( dt, BLIS_TT, 0, &cntx_full );
+
+	const char* dt_str[] = { "s", "c", "d", "z" };
+
+	for ( num_t dt = BLIS_DT_LO; dt <= BLIS_DT_HI; dt++ )
+	{
+		const dim_t tt = bli_cntx_get_blksz_def_dt( dt, BLIS_TT, cntx_fast );
+
+		printf( "%% %sgemm: tiny threshold: %d; calls per trial: %d\n",
+		        dt_str[ dt ], ( int )tt, ( int )N_CALLS );
+		printf( "%% ( n, 1:4 ) = [ m=n=k  ns/call(fast)  ns/call(full)  savings ]\n" );
+
+		for ( dim_t n = P_BEGIN; n <= P_END; n += P_INC )
+		{
+			double ns_fast = 0.0, ns_full = 0.0;
+
+			switch ( dt )
+			{
+				case BLIS_FLOAT:
+					ns_fast = bli_stime_gemm( n, N_CALLS, cntx_fast,  &rntm );
+					ns_full = bli_stime_gemm( n, N_CALLS, &cntx_full, &rntm );
+					break;
+				case BLIS_DOUBLE:
+					ns_fast = bli_dtime_gemm( n, N_CALLS, cntx_fast,  &rntm );
+					ns_full = bli_dtime_gemm( n, N_CALLS, &cntx_full, &rntm );
+					break;
+				case BLIS_SCOMPLEX:
+					ns_fast = bli_ctime_gemm( n, N_CALLS, cntx_fast,  &rntm );
+					ns_full = bli_ctime_gemm( n, N_CALLS, &cntx_full, &rntm );
+					break;
+				case BLIS_DCOMPLEX:
+					ns_fast = bli_ztime_gemm( n, N_CALLS, cntx_fast,  &rntm );
+					ns_full = bli_ztime_gemm( n, N_CALLS, &cntx_full, &rntm );
+					break;
+				default: break;
+			}
+
+			printf( "data_tiny_%sgemm( %2lu, 1:4 ) = [ %4lu %10.1f %10.1f %8.1f ];\n",
+			        dt_str[ dt ], ( unsigned long )( ( n - P_BEGIN ) / P_INC + 1 ),
+			        ( unsigned long )n, ns_fast, ns_full, ns_full - ns_fast );
+		}
+	}
+
+	bli_finalize();
+
+	return 0;
+}
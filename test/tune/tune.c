@@ -0,0 +1,380 @@
+/*
+
+   BLIS
+   An object-based framework for developing high-performance BLAS-like
+   libraries.
+
+   Copyright (C) 2014, The University of Texas at Austin
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are
+   met:
+    - Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    - Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    - Neither the name of The University of Texas nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "blis.h"
+
+//
+// An offline autotuner for the cache blocksizes of the native context. For
+// each requested datatype, it sweeps KC, MC, and NC (in that order, keeping
+// the best value of each before moving on to the next) for the conventional
+// gemm path, and then KC_SUP, MC_SUP, and NC_SUP for the sup path, timing
+// gemm on problems shaped so that the blocksize being swept matters. The
+// results are written as a tuning profile that BLIS applies over the
+// registered blocksizes at initialization when the BLIS_TUNING_FILE
+// environment variable names it, e.g.:
+//
+//   $ ./tune.x -o $HOME/.blis_tuning
+//   $ BLIS_TUNING_FILE=$HOME/.blis_tuning ./my_app
+//
+// With -s, it also calibrates the sup dispatch map: for each requested
+// storage combination of C, A, and B, and for m, n, and k drawn from each
+// power-of-two bucket of the map up to the size given by -x, it times gemm
+// via the sup and the conventional implementations and records the faster
+// one. (The blocksizes are tuned first, so the comparison is made with the
+// tuned values.) Problems whose sizes fall outside the calibrated buckets
+// are still dispatched by the MT, NT, and KT thresholds.
+//
+// Threading is taken from the environment (e.g. BLIS_NUM_THREADS), so the
+// tuner should be run with the thread count the application will use. The
+// sup dispatch map records the thread count, so it may be calibrated for
+// several thread counts by appending the output of several runs.
+//
+// Options:
+//   -n <size>   problem size of the large dimensions      (default: 2000)
+//   -r <reps>   timed repetitions per candidate           (default: 3)
+//   -d <dts>    datatypes to tune, any of 'sdcz'          (default: sd)
+//   -b <0|1>    whether to tune the blocksizes            (default: 1)
+//   -s <stors>  storage combinations for which to         (default: none)
+//               calibrate the sup dispatch map, e.g.
+//               'ccc,rrr' (C, A, B; r = row, c = column)
+//   -x <size>   largest size calibrated in the map        (default: 1024)
+//   -o <file>   profile to write                          (default: stdout)
+//   -a <0|1>    whether to append to the profile          (default: 0)
+//
+
+// The candidates are the registered value scaled by each of these factors,
+// rounded down to the registered multiple.
+static const double scale[] = { 0.25, 0.5, 0.75, 1.0, 1.25, 1.5, 2.0, 3.0, 4.0 };
+#define N_SCALE ( sizeof( scale ) / sizeof( scale[0] ) )
+
+static dim_t n_reps = 3;
+
+static char dt_char( num_t dt )
+{
+	char c;
+	bli_param_map_blis_to_char_dt( dt, &c );
+	return c;
+}
+
+static void create_matrix( num_t dt, dim_t m, dim_t n, char stor, obj_t* x )
+{
+	if ( stor == 'r' ) bli_obj_create( dt, m, n, n, 1, x );
+	else               bli_obj_create( dt, m, n, 1, m, x );
+}
+
+static double time_gemm
+     (
+       num_t       dt,
+       const char* stor,
+       dim_t       m,
+       dim_t       n,
+       dim_t       k,
+       bool        sup,
+       cntx_t*     cntx
+     )
+{
+	obj_t   a, b, c;
+	rntm_t  rntm;
+	double  dtime_save = DBL_MAX;
+
+	bli_rntm_init_from_global( &rntm );
+
+	if ( sup ) bli_rntm_enable_l3_sup( &rntm );
+	else       bli_rntm_disable_l3_sup( &rntm );
+
+	create_matrix( dt, m, n, stor[0], &c );
+	create_matrix( dt, m, k, stor[1], &a );
+	create_matrix( dt, k, n, stor[2], &b );
+
+	bli_randm( &a );
+	bli_randm( &b );
+	bli_randm( &c );
+
+	// One untimed run warms up the caches and the memory pools.
+	for ( dim_t r = 0; r < n_reps + 1; r++ )
+	{
+		double dtime = bli_clock();
+
+		bli_gemm_ex( &BLIS_ONE, &a, &b, &BLIS_ONE, &c, cntx, &rntm );
+
+		if ( r > 0 ) dtime_save = bli_clock_min_diff( dtime_save, dtime );
+	}
+
+	bli_obj_free( &a );
+	bli_obj_free( &b );
+	bli_obj_free( &c );
+
+	// Return GFLOPS.
+	double flops = 2.0 * m * n * k * ( bli_is_complex( dt ) ? 4.0 : 1.0 );
+
+	return flops / ( dtime_save * 1.0e9 );
+}
+
+static void set_blksz( num_t dt, bszid_t bs_id, dim_t bs, cntx_t* cntx )
+{
+	// Keep any registered extension of the maximum, as the profile loader
+	// does.
+	const dim_t ext = bli_cntx_get_blksz_max_dt( dt, bs_id, cntx ) -
+	                  bli_cntx_get_blksz_def_dt( dt, bs_id, cntx );
+
+	bli_cntx_set_blksz_def_dt( dt, bs_id, bs,                      cntx );
+	bli_cntx_set_blksz_max_dt( dt, bs_id, bs + bli_max( ext, 0 ), cntx );
+}
+
+static void tune_blksz
+     (
+       num_t       dt,
+       bszid_t     bs_id,
+       const char* name,
+       dim_t       m,
+       dim_t       n,
+       dim_t       k,
+       bool        sup,
+       cntx_t*     cntx
+     )
+{
+	const dim_t bs0  = bli_cntx_get_blksz_def_dt( dt, bs_id, cntx );
+	const dim_t mult = bli_max( bli_cntx_get_bmult_dt( dt, bs_id, cntx ), 1 );
+	dim_t       best_bs    = bs0;
+	double      best_gflop = 0.0;
+	dim_t       prev_bs    = 0;
+
+	if ( bs0 <= 0 ) return;
+
+	for ( size_t i = 0; i < N_SCALE; i++ )
+	{
+		dim_t bs = ( ( dim_t )( scale[ i ] * bs0 ) / mult ) * mult;
+
+		if ( bs < mult || bs == prev_bs ) continue;
+		prev_bs = bs;
+
+		set_blksz( dt, bs_id, bs, cntx );
+
+		const double gflop = time_gemm( dt, "ccc", m, n, k, sup, cntx );
+
+		fprintf( stderr, "  %c %-6s %6ld: %8.2f GFLOPS\n",
+		         dt_char( dt ), name, ( long )bs, gflop );
+
+		if ( gflop > best_gflop ) { best_gflop = gflop; best_bs = bs; }
+	}
+
+	set_blksz( dt, bs_id, best_bs, cntx );
+}
+
+static void print_row( FILE* f, const char* name, bszid_t bs_id, const bool* tuned, const cntx_t* cntx )
+{
+	// The columns are in the order s, d, c, z, as in the bli_cntx_init_*.c
+	// files.
+	const num_t dts[] = { BLIS_FLOAT, BLIS_DOUBLE, BLIS_SCOMPLEX, BLIS_DCOMPLEX };
+
+	fprintf( f, "%-8s", name );
+
+	for ( size_t i = 0; i < 4; i++ )
+		fprintf( f, " %6ld", tuned[ dts[ i ] ]
+		                     ? ( long )bli_cntx_get_blksz_def_dt( dts[ i ], bs_id, cntx )
+		                     : 0L );
+
+	fprintf( f, "\n" );
+}
+
+static void calibrate_sup_map
+     (
+       FILE*       f,
+       num_t       dt,
+       const char* stor,
+       dim_t       max_size,
+       cntx_t*     cntx
+     )
+{
+	// Time the sup implementation on a copy of the context whose thresholds
+	// admit every problem and which carries no dispatch map of its own.
+	cntx_t cntx_sup = *cntx;
+
+	cntx_sup.l3_sup_map = NULL;
+	bli_cntx_set_blksz_def_dt( dt, BLIS_MT, INT32_MAX, &cntx_sup );
+	bli_cntx_set_blksz_def_dt( dt, BLIS_NT, INT32_MAX, &cntx_sup );
+	bli_cntx_set_blksz_def_dt( dt, BLIS_KT, INT32_MAX, &cntx_sup );
+
+	rntm_t rntm;
+	bli_rntm_init_from_global( &rntm );
+
+	dim_t nt = bli_rntm_num_threads( &rntm );
+	if ( nt < 1 ) nt = bli_rntm_calc_num_threads( &rntm );
+	nt = bli_max( nt, 1 );
+
+	// Sample each bucket of the map at 1.5 times its lower bound.
+	dim_t sizes[ BLIS_SUP_MAP_NUM_DIM ];
+	dim_t n_sizes = 0;
+
+	for ( dim_t b = 0; b < BLIS_SUP_MAP_NUM_DIM; b++ )
+	{
+		const dim_t size = 3 << ( b + BLIS_SUP_MAP_DIM_SHIFT - 1 );
+		if ( size <= max_size ) sizes[ n_sizes++ ] = size;
+	}
+
+	for ( dim_t im = 0; im < n_sizes; im++ )
+	for ( dim_t in = 0; in < n_sizes; in++ )
+	for ( dim_t ik = 0; ik < n_sizes; ik++ )
+	{
+		const dim_t m = sizes[ im ];
+		const dim_t n = sizes[ in ];
+		const dim_t k = sizes[ ik ];
+
+		const double gflop_sup  = time_gemm( dt, stor, m, n, k, TRUE,  &cntx_sup );
+		const double gflop_conv = time_gemm( dt, stor, m, n, k, FALSE, cntx );
+
+		fprintf( stderr, "  %c %s %5ld %5ld %5ld: sup %8.2f conv %8.2f GFLOPS\n",
+		         dt_char( dt ), stor, ( long )m, ( long )n, ( long )k,
+		         gflop_sup, gflop_conv );
+
+		fprintf( f, "sup gemm %c %s %ld %ld %ld %ld %s\n",
+		         dt_char( dt ), stor, ( long )nt, ( long )m, ( long )n, ( long )k,
+		         gflop_sup >= gflop_conv ? "sup" : "conv" );
+	}
+}
+
+int main( int argc, char** argv )
+{
+	dim_t       n_size  = 2000;
+	const char* dts     = "sd";
+	const char* outfile = NULL;
+	const char* stors   = NULL;
+	dim_t       max_sup = 1024;
+	bool        do_blk  = TRUE;
+	bool        append  = FALSE;
+
+	for ( int i = 1; i + 1 < argc; i += 2 )
+	{
+		if      ( strcmp( argv[ i ], "-n" ) == 0 ) n_size  = atol( argv[ i + 1 ] );
+		else if ( strcmp( argv[ i ], "-r" ) == 0 ) n_reps  = atol( argv[ i + 1 ] );
+		else if ( strcmp( argv[ i ], "-d" ) == 0 ) dts     = argv[ i + 1 ];
+		else if ( strcmp( argv[ i ], "-b" ) == 0 ) do_blk  = atoi( argv[ i + 1 ] ) != 0;
+		else if ( strcmp( argv[ i ], "-s" ) == 0 ) stors   = argv[ i + 1 ];
+		else if ( strcmp( argv[ i ], "-x" ) == 0 ) max_sup = atol( argv[ i + 1 ] );
+		else if ( strcmp( argv[ i ], "-o" ) == 0 ) outfile = argv[ i + 1 ];
+		else if ( strcmp( argv[ i ], "-a" ) == 0 ) append  = atoi( argv[ i + 1 ] ) != 0;
+		else
+		{
+			fprintf( stderr, "usage: %s [-n size] [-r reps] [-d sdcz] [-b 0|1] "
+			                 "[-s stors] [-x size] [-o file] [-a 0|1]\n", argv[0] );
+			return 1;
+		}
+	}
+
+	bli_init();
+
+	// Tune a copy of the native context so that the registered values remain
+	// the starting point of every sweep.
+	cntx_t cntx = *bli_gks_query_nat_cntx();
+
+	FILE* f = stdout;
+
+	if ( outfile != NULL && ( f = fopen( outfile, append ? "a" : "w" ) ) == NULL )
+	{
+		fprintf( stderr, "could not open '%s' for writing.\n", outfile );
+		return 1;
+	}
+
+	const arch_t id = bli_arch_query_id();
+
+	fprintf( f, "# BLIS tuning profile written by test/tune (n = %ld).\n", ( long )n_size );
+	fprintf( f, "# Apply with BLIS_TUNING_FILE=<this file>. Zero leaves a value untouched.\n" );
+	fprintf( f, "arch %s\n", bli_arch_string( id ) );
+
+	bool tuned[ BLIS_NUM_FP_TYPES ]     = { FALSE };
+	bool tuned_sup[ BLIS_NUM_FP_TYPES ] = { FALSE };
+
+	for ( num_t dt = BLIS_DT_LO; dt <= BLIS_DT_HI && do_blk; dt++ )
+	{
+		if ( strchr( dts, dt_char( dt ) ) == NULL ) continue;
+
+		fprintf( stderr, "tuning %c (n = %ld)\n", dt_char( dt ), ( long )n_size );
+
+		tune_blksz( dt, BLIS_KC, "KC", n_size, n_size, n_size, FALSE, &cntx );
+		tune_blksz( dt, BLIS_MC, "MC", n_size, n_size, n_size, FALSE, &cntx );
+		tune_blksz( dt, BLIS_NC, "NC", n_size, n_size, n_size, FALSE, &cntx );
+		tuned[ dt ] = TRUE;
+
+		// The sup path is taken only when at least one dimension falls below
+		// its threshold, so each sup blocksize is swept on a problem that is
+		// small in a dimension it does not block. Datatypes without sup
+		// thresholds never take the sup path.
+		const dim_t mt = bli_cntx_get_blksz_def_dt( dt, BLIS_MT, &cntx );
+		const dim_t nt = bli_cntx_get_blksz_def_dt( dt, BLIS_NT, &cntx );
+
+		if ( mt <= 1 || nt <= 1 ) continue;
+
+		tune_blksz( dt, BLIS_KC_SUP, "KC_SUP", n_size, nt - 1, n_size, TRUE, &cntx );
+		tune_blksz( dt, BLIS_MC_SUP, "MC_SUP", n_size, nt - 1, n_size, TRUE, &cntx );
+		tune_blksz( dt, BLIS_NC_SUP, "NC_SUP", mt - 1, n_size, n_size, TRUE, &cntx );
+		tuned_sup[ dt ] = TRUE;
+	}
+
+	if ( do_blk )
+	{
+		fprintf( f, "#             s      d      c      z\n" );
+		print_row( f, "MC",     BLIS_MC,     tuned,     &cntx );
+		print_row( f, "KC",     BLIS_KC,     tuned,     &cntx );
+		print_row( f, "NC",     BLIS_NC,     tuned,     &cntx );
+		print_row( f, "MC_SUP", BLIS_MC_SUP, tuned_sup, &cntx );
+		print_row( f, "KC_SUP", BLIS_KC_SUP, tuned_sup, &cntx );
+		print_row( f, "NC_SUP", BLIS_NC_SUP, tuned_sup, &cntx );
+	}
+
+	for ( num_t dt = BLIS_DT_LO; dt <= BLIS_DT_HI && stors != NULL; dt++ )
+	{
+		if ( strchr( dts, dt_char( dt ) ) == NULL ) continue;
+
+		fprintf( stderr, "calibrating the sup dispatch map for %c\n", dt_char( dt ) );
+		fprintf( f, "#   op   dt stor nt m n k faster\n" );
+
+		for ( const char* st = stors; *st != '\0'; )
+		{
+			if ( strspn( st, "rc" ) >= 3 )
+			{
+				char stor[ 4 ] = { st[0], st[1], st[2], '\0' };
+				calibrate_sup_map( f, dt, stor, max_sup, &cntx );
+			}
+
+			st += strcspn( st, "," );
+			if ( *st == ',' ) st++;
+		}
+	}
+
+	if ( f != stdout ) fclose( f );
+
+	bli_finalize();
+
+	return 0;
+}
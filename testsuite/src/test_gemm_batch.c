@@ -0,0 +1,422 @@
+/*
+
+   BLIS
+   An object-based framework for developing high-performance BLAS-like
+   libraries.
+
+   Copyright (C) 2014, The University of Texas at Austin
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are
+   met:
+    - Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    - Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    - Neither the name(s) of the copyright holder(s) nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "blis.h"
+#include "test_libblis.h"
+
+
+// Static variables.
+static char*     op_str                    = "gemm_batch";
+static char*     o_types                   = "mmm"; // a b c
+static char*     p_types                   = "hh";  // transa transb
+static thresh_t  thresh[BLIS_NUM_FP_TYPES] = { { 1e-04, 1e-05 },   // warn, pass for s
+                                               { 1e-04, 1e-05 },   // warn, pass for c
+                                               { 1e-13, 1e-14 },   // warn, pass for d
+                                               { 1e-13, 1e-14 } }; // warn, pass for z
+
+// The groups of the batches. The first five groups form one batch, in which
+// groups share A, share B, or share neither, and whose first two groups take
+// the conventional path (with the m used by the input files) and the others
+// the sup path. The last group forms a second batch with fewer members than
+// most thread counts, which is instead computed by teams of threads.
+#define GEMM_BATCH_NUM_GROUPS  6
+#define GEMM_BATCH_MAX_SIZE    4
+
+static const dim_t gemm_batch_size[ GEMM_BATCH_NUM_GROUPS ]  = { 2, 2, 4, 4, 3, 2 };
+static const char  gemm_batch_share[ GEMM_BATCH_NUM_GROUPS ] = { 'a', 'b', 'a', 'b', 'n', 'b' };
+static const dim_t gemm_batch_mdiv[ GEMM_BATCH_NUM_GROUPS ]  = { 1, 1, 8, 8, 8, 8 };
+static const dim_t gemm_batch_ndiv[ GEMM_BATCH_NUM_GROUPS ]  = { 1, 1, 1, 1, 2, 1 };
+
+// Local prototypes.
+void libblis_test_gemm_batch_deps
+     (
+       thread_data_t* tdata,
+       test_params_t* params,
+       test_op_t*     op
+     );
+
+void libblis_test_gemm_batch_experiment
+     (
+       test_params_t* params,
+       test_op_t*     op,
+       iface_t        iface,
+       char*          dc_str,
+       char*          pc_str,
+       char*          sc_str,
+       unsigned int   p_cur,
+       double*        perf,
+       double*        resid
+     );
+
+void libblis_test_gemm_batch_impl
+     (
+       iface_t   iface,
+       dim_t     n_groups,
+       dim_t*    size,
+       char*     share,
+       obj_t*    alpha,
+       obj_t     a[][ GEMM_BATCH_MAX_SIZE ],
+       obj_t     b[][ GEMM_BATCH_MAX_SIZE ],
+       obj_t*    beta,
+       obj_t     c[][ GEMM_BATCH_MAX_SIZE ]
+     );
+
+void libblis_test_gemm_batch_check
+     (
+       test_params_t* params,
+       obj_t*         c,
+       obj_t*         c_ref,
+       double*        resid
+     );
+
+
+
+void libblis_test_gemm_batch_deps
+     (
+       thread_data_t* tdata,
+       test_params_t* params,
+       test_op_t*     op
+     )
+{
+	libblis_test_randm( tdata, params, &(op->ops->randm) );
+	libblis_test_normfm( tdata, params, &(op->ops->normfm) );
+	libblis_test_subm( tdata, params, &(op->ops->subm) );
+	libblis_test_copym( tdata, params, &(op->ops->copym) );
+	libblis_test_gemm( tdata, params, &(op->ops->gemm) );
+}
+
+
+
+void libblis_test_gemm_batch
+     (
+       thread_data_t* tdata,
+       test_params_t* params,
+       test_op_t*     op
+     )
+{
+
+	// Return early if this test has already been done.
+	if ( libblis_test_op_is_done( op ) ) return;
+
+	// Return early if operation is disabled.
+	if ( libblis_test_op_is_disabled( op ) ||
+	     libblis_test_l3_is_disabled( op ) ) return;
+
+	// Call dependencies first.
+	if ( TRUE ) libblis_test_gemm_batch_deps( tdata, params, op );
+
+	// Execute the test driver for each implementation requested.
+	//if ( op->front_seq == ENABLE )
+	{
+		libblis_test_op_driver( tdata,
+		                        params,
+		                        op,
+		                        BLIS_TEST_SEQ_FRONT_END,
+		                        op_str,
+		                        p_types,
+		                        o_types,
+		                        thresh,
+		                        libblis_test_gemm_batch_experiment );
+	}
+}
+
+
+
+void libblis_test_gemm_batch_experiment
+     (
+       test_params_t* params,
+       test_op_t*     op,
+       iface_t        iface,
+       char*          dc_str,
+       char*          pc_str,
+       char*          sc_str,
+       unsigned int   p_cur,
+       double*        perf,
+       double*        resid
+     )
+{
+	unsigned int n_repeats = params->n_repeats;
+	unsigned int i;
+
+	double       time_min  = DBL_MAX;
+	double       time;
+	double       resid_cur;
+	double       flops     = 0.0;
+
+	num_t        datatype;
+
+	dim_t        m, n, k;
+	dim_t        mi[ GEMM_BATCH_NUM_GROUPS ];
+	dim_t        ni[ GEMM_BATCH_NUM_GROUPS ];
+	dim_t        size[ GEMM_BATCH_NUM_GROUPS ];
+	char         share[ GEMM_BATCH_NUM_GROUPS ];
+	dim_t        g, j;
+
+	trans_t      transa;
+	trans_t      transb;
+
+	obj_t        alpha, beta;
+	obj_t        a[ GEMM_BATCH_NUM_GROUPS ][ GEMM_BATCH_MAX_SIZE ];
+	obj_t        b[ GEMM_BATCH_NUM_GROUPS ][ GEMM_BATCH_MAX_SIZE ];
+	obj_t        c[ GEMM_BATCH_NUM_GROUPS ][ GEMM_BATCH_MAX_SIZE ];
+	obj_t        c_save[ GEMM_BATCH_NUM_GROUPS ][ GEMM_BATCH_MAX_SIZE ];
+	obj_t        c_ref;
+
+
+	// Use the datatype of the first char in the datatype combination string.
+	bli_param_map_char_to_blis_dt( dc_str[0], &datatype );
+
+	// Map the dimension specifier to actual dimensions.
+	m = libblis_test_get_dim_from_prob_size( op->dim_spec[0], p_cur );
+	n = libblis_test_get_dim_from_prob_size( op->dim_spec[1], p_cur );
+	k = libblis_test_get_dim_from_prob_size( op->dim_spec[2], p_cur );
+
+	// Map parameter characters to BLIS constants.
+	bli_param_map_char_to_blis_trans( pc_str[0], &transa );
+	bli_param_map_char_to_blis_trans( pc_str[1], &transb );
+
+	// Create test scalars.
+	bli_obj_scalar_init_detached( datatype, &alpha );
+	bli_obj_scalar_init_detached( datatype, &beta );
+
+	// Set alpha and beta.
+	if ( bli_is_real( datatype ) )
+	{
+		bli_setsc(  1.2,  0.0, &alpha );
+		bli_setsc(  0.9,  0.0, &beta );
+	}
+	else
+	{
+		bli_setsc(  1.2,  0.8, &alpha );
+		bli_setsc(  0.9,  1.0, &beta );
+	}
+
+	// Create the operands of each group. A shared operand is created only
+	// once, as that of the first member, and is read by every member.
+	for ( g = 0; g < GEMM_BATCH_NUM_GROUPS; ++g )
+	{
+		size[ g ]  = gemm_batch_size[ g ];
+		share[ g ] = gemm_batch_share[ g ];
+		mi[ g ]    = bli_max( m / gemm_batch_mdiv[ g ], 1 );
+		ni[ g ]    = bli_max( n / gemm_batch_ndiv[ g ], 1 );
+
+		for ( j = 0; j < size[ g ]; ++j )
+		{
+			if ( j == 0 || share[ g ] != 'a' )
+			{
+				libblis_test_mobj_create( params, datatype, transa,
+				                          sc_str[1], mi[ g ], k, &a[ g ][ j ] );
+				libblis_test_mobj_randomize( params, TRUE, &a[ g ][ j ] );
+				bli_obj_set_conjtrans( transa, &a[ g ][ j ] );
+			}
+			if ( j == 0 || share[ g ] != 'b' )
+			{
+				libblis_test_mobj_create( params, datatype, transb,
+				                          sc_str[2], k, ni[ g ], &b[ g ][ j ] );
+				libblis_test_mobj_randomize( params, TRUE, &b[ g ][ j ] );
+				bli_obj_set_conjtrans( transb, &b[ g ][ j ] );
+			}
+
+			libblis_test_mobj_create( params, datatype, BLIS_NO_TRANSPOSE,
+			                          sc_str[0], mi[ g ], ni[ g ], &c[ g ][ j ] );
+			libblis_test_mobj_create( params, datatype, BLIS_NO_TRANSPOSE,
+			                          sc_str[0], mi[ g ], ni[ g ], &c_save[ g ][ j ] );
+			libblis_test_mobj_randomize( params, TRUE, &c[ g ][ j ] );
+			bli_copym( &c[ g ][ j ], &c_save[ g ][ j ] );
+
+			flops += 2.0 * mi[ g ] * ni[ g ] * k;
+		}
+	}
+
+	// Repeat the experiment n_repeats times and record results.
+	for ( i = 0; i < n_repeats; ++i )
+	{
+		for ( g = 0; g < GEMM_BATCH_NUM_GROUPS; ++g )
+		for ( j = 0; j < size[ g ]; ++j )
+			bli_copym( &c_save[ g ][ j ], &c[ g ][ j ] );
+
+		time = bli_clock();
+
+		libblis_test_gemm_batch_impl( iface, GEMM_BATCH_NUM_GROUPS - 1,
+		                              size, share, &alpha, a, b, &beta, c );
+		libblis_test_gemm_batch_impl( iface, 1,
+		                              size + GEMM_BATCH_NUM_GROUPS - 1,
+		                              share + GEMM_BATCH_NUM_GROUPS - 1,
+		                              &alpha,
+		                              a + GEMM_BATCH_NUM_GROUPS - 1,
+		                              b + GEMM_BATCH_NUM_GROUPS - 1,
+		                              &beta,
+		                              c + GEMM_BATCH_NUM_GROUPS - 1 );
+
+		time_min = bli_clock_min_diff( time_min, time );
+	}
+
+	// Estimate the performance of the best experiment repeat.
+	*perf = flops / time_min / FLOPS_PER_UNIT_PERF;
+	if ( bli_is_complex( datatype ) ) *perf *= 4.0;
+
+	*resid = 0.0;
+
+	// Check each member against bli_gemm(), and free the test objects.
+	for ( g = 0; g < GEMM_BATCH_NUM_GROUPS; ++g )
+	{
+		for ( j = 0; j < size[ g ]; ++j )
+		{
+			obj_t* aj = &a[ g ][ share[ g ] == 'a' ? 0 : j ];
+			obj_t* bj = &b[ g ][ share[ g ] == 'b' ? 0 : j ];
+
+			libblis_test_mobj_create( params, datatype, BLIS_NO_TRANSPOSE,
+			                          sc_str[0], mi[ g ], ni[ g ], &c_ref );
+			bli_copym( &c_save[ g ][ j ], &c_ref );
+			bli_gemm( &alpha, aj, bj, &beta, &c_ref );
+
+			// Perform checks.
+			libblis_test_gemm_batch_check( params, &c[ g ][ j ], &c_ref, &resid_cur );
+
+			// Keep the largest residual, or the first NaN.
+			if ( !bli_isnan( *resid ) &&
+			     ( bli_isnan( resid_cur ) || *resid < resid_cur ) )
+				*resid = resid_cur;
+
+			bli_obj_free( &c_ref );
+		}
+
+		for ( j = 0; j < size[ g ]; ++j )
+		{
+			if ( j == 0 || share[ g ] != 'a' ) bli_obj_free( &a[ g ][ j ] );
+			if ( j == 0 || share[ g ] != 'b' ) bli_obj_free( &b[ g ][ j ] );
+			bli_obj_free( &c[ g ][ j ] );
+			bli_obj_free( &c_save[ g ][ j ] );
+		}
+	}
+
+	// Zero out performance and residual if the problem is empty.
+	if ( m == 0 || n == 0 ) { *perf = 0.0; *resid = 0.0; }
+}
+
+
+
+void libblis_test_gemm_batch_impl
+     (
+       iface_t   iface,
+       dim_t     n_groups,
+       dim_t*    size,
+       char*     share,
+       obj_t*    alpha,
+       obj_t     a[][ GEMM_BATCH_MAX_SIZE ],
+       obj_t     b[][ GEMM_BATCH_MAX_SIZE ],
+       obj_t*    beta,
+       obj_t     c[][ GEMM_BATCH_MAX_SIZE ]
+     )
+{
+	gemm_batch_group_t groups[ GEMM_BATCH_NUM_GROUPS ];
+	const void*        buf_a[ GEMM_BATCH_NUM_GROUPS ][ GEMM_BATCH_MAX_SIZE ];
+	const void*        buf_b[ GEMM_BATCH_NUM_GROUPS ][ GEMM_BATCH_MAX_SIZE ];
+	void*              buf_c[ GEMM_BATCH_NUM_GROUPS ][ GEMM_BATCH_MAX_SIZE ];
+
+	// Describe each group by the objects of its first member, and pass the
+	// buffers of all members. The members of a group that shares A (or B)
+	// are all given the same A (or B) buffer.
+	for ( dim_t g = 0; g < n_groups; ++g )
+	{
+		for ( dim_t j = 0; j < size[ g ]; ++j )
+		{
+			buf_a[ g ][ j ] = bli_obj_buffer( &a[ g ][ share[ g ] == 'a' ? 0 : j ] );
+			buf_b[ g ][ j ] = bli_obj_buffer( &b[ g ][ share[ g ] == 'b' ? 0 : j ] );
+			buf_c[ g ][ j ] = bli_obj_buffer( &c[ g ][ j ] );
+		}
+
+		groups[ g ].alpha = *alpha;
+		groups[ g ].a     = a[ g ][ 0 ];
+		groups[ g ].b     = b[ g ][ 0 ];
+		groups[ g ].beta  = *beta;
+		groups[ g ].c     = c[ g ][ 0 ];
+		groups[ g ].size  = size[ g ];
+		groups[ g ].buf_a = buf_a[ g ];
+		groups[ g ].buf_b = buf_b[ g ];
+		groups[ g ].buf_c = buf_c[ g ];
+		groups[ g ].str_a = 0;
+		groups[ g ].str_b = 0;
+		groups[ g ].str_c = 0;
+	}
+
+	switch ( iface )
+	{
+		case BLIS_TEST_SEQ_FRONT_END:
+		bli_gemm_batch( n_groups, groups );
+		break;
+
+		default:
+		libblis_test_printf_error( "Invalid interface type.\n" );
+	}
+}
+
+
+
+void libblis_test_gemm_batch_check
+     (
+       test_params_t* params,
+       obj_t*         c,
+       obj_t*         c_ref,
+       double*        resid
+     )
+{
+	num_t  dt_real = bli_obj_dt_proj_to_real( c );
+
+	obj_t  norm;
+
+	double junk;
+
+	//
+	// Pre-conditions:
+	// - a and b are randomized.
+	// - c_ref holds the result of the member computed by bli_gemm(),
+	//
+	//     C_ref := beta * C_orig + alpha * transa(A) * transb(B)
+	//
+	// Under these conditions, we assume that the implementation for the
+	// same member within the batch is functioning correctly if
+	//
+	//   normfm( C - C_ref )
+	//
+	// is negligible.
+	//
+
+	bli_obj_scalar_init_detached( dt_real, &norm );
+
+	bli_subm( c_ref, c );
+	bli_normfm( c, &norm );
+
+	bli_getsc( &norm, resid, &junk );
+}
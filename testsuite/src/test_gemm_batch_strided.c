@@ -0,0 +1,455 @@
+/*
+
+   BLIS
+   An object-based framework for developing high-performance BLAS-like
+   libraries.
+
+   Copyright (C) 2014, The University of Texas at Austin
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are
+   met:
+    - Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    - Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    - Neither the name(s) of the copyright holder(s) nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "blis.h"
+#include "test_libblis.h"
+
+
+// Static variables. The operation name is abbreviated to keep the function
+// name strings within MAX_FUNC_STRING_LENGTH.
+static char*     op_str                    = "gemm_bstrided";
+static char*     o_types                   = "mmm"; // a b c
+static char*     p_types                   = "hh";  // transa transb
+static thresh_t  thresh[BLIS_NUM_FP_TYPES] = { { 1e-04, 1e-05 },   // warn, pass for s
+                                               { 1e-04, 1e-05 },   // warn, pass for c
+                                               { 1e-13, 1e-14 },   // warn, pass for d
+                                               { 1e-13, 1e-14 } }; // warn, pass for z
+
+// The number of members of each batch, and whether each pass gives A and B
+// a stride of zero, so that every member reads the same operand.
+#define GEMM_BATCH_STRIDED_COUNT  4
+#define GEMM_BATCH_STRIDED_PASSES 4
+
+static const bool gemm_batch_strided_zero_a[ GEMM_BATCH_STRIDED_PASSES ] = { TRUE,  FALSE, TRUE, FALSE };
+static const bool gemm_batch_strided_zero_b[ GEMM_BATCH_STRIDED_PASSES ] = { FALSE, TRUE,  TRUE, FALSE };
+
+// Local prototypes.
+void libblis_test_gemm_batch_strided_deps
+     (
+       thread_data_t* tdata,
+       test_params_t* params,
+       test_op_t*     op
+     );
+
+void libblis_test_gemm_batch_strided_experiment
+     (
+       test_params_t* params,
+       test_op_t*     op,
+       iface_t        iface,
+       char*          dc_str,
+       char*          pc_str,
+       char*          sc_str,
+       unsigned int   p_cur,
+       double*        perf,
+       double*        resid
+     );
+
+void libblis_test_gemm_batch_strided_impl
+     (
+       iface_t   iface,
+       num_t     dt,
+       trans_t   transa,
+       trans_t   transb,
+       dim_t     m,
+       dim_t     n,
+       dim_t     k,
+       void*     alpha,
+       void*     a, inc_t rs_a, inc_t cs_a, inc_t stride_a,
+       void*     b, inc_t rs_b, inc_t cs_b, inc_t stride_b,
+       void*     beta,
+       void*     c, inc_t rs_c, inc_t cs_c, inc_t stride_c,
+       dim_t     batch_count
+     );
+
+void libblis_test_gemm_batch_strided_check
+     (
+       test_params_t* params,
+       obj_t*         c,
+       obj_t*         c_ref,
+       double*        resid
+     );
+
+static void libblis_test_gemm_batch_strided_member
+     (
+       num_t   dt,
+       char    storage,
+       dim_t   m,
+       dim_t   n,
+       void*   buf,
+       inc_t   stride,
+       dim_t   i,
+       obj_t*  x
+     );
+
+
+
+void libblis_test_gemm_batch_strided_deps
+     (
+       thread_data_t* tdata,
+       test_params_t* params,
+       test_op_t*     op
+     )
+{
+	libblis_test_randm( tdata, params, &(op->ops->randm) );
+	libblis_test_normfm( tdata, params, &(op->ops->normfm) );
+	libblis_test_subm( tdata, params, &(op->ops->subm) );
+	libblis_test_copym( tdata, params, &(op->ops->copym) );
+	libblis_test_gemm( tdata, params, &(op->ops->gemm) );
+}
+
+
+
+void libblis_test_gemm_batch_strided
+     (
+       thread_data_t* tdata,
+       test_params_t* params,
+       test_op_t*     op
+     )
+{
+
+	// Return early if this test has already been done.
+	if ( libblis_test_op_is_done( op ) ) return;
+
+	// Return early if operation is disabled.
+	if ( libblis_test_op_is_disabled( op ) ||
+	     libblis_test_l3_is_disabled( op ) ) return;
+
+	// Call dependencies first.
+	if ( TRUE ) libblis_test_gemm_batch_strided_deps( tdata, params, op );
+
+	// Execute the test driver for each implementation requested.
+	//if ( op->front_seq == ENABLE )
+	{
+		libblis_test_op_driver( tdata,
+		                        params,
+		                        op,
+		                        BLIS_TEST_SEQ_FRONT_END,
+		                        op_str,
+		                        p_types,
+		                        o_types,
+		                        thresh,
+		                        libblis_test_gemm_batch_strided_experiment );
+	}
+}
+
+
+
+void libblis_test_gemm_batch_strided_experiment
+     (
+       test_params_t* params,
+       test_op_t*     op,
+       iface_t        iface,
+       char*          dc_str,
+       char*          pc_str,
+       char*          sc_str,
+       unsigned int   p_cur,
+       double*        perf,
+       double*        resid
+     )
+{
+	unsigned int n_repeats = params->n_repeats;
+	unsigned int i;
+
+	double       time_min  = DBL_MAX;
+	double       time;
+	double       resid_cur;
+
+	num_t        datatype;
+	siz_t        elem_size;
+	err_t        r_val;
+
+	dim_t        m, n, k;
+	dim_t        m_a, n_a, m_b, n_b;
+	dim_t        nb        = GEMM_BATCH_STRIDED_COUNT;
+	inc_t        stride_a, stride_b, stride_c;
+
+	trans_t      transa;
+	trans_t      transb;
+
+	obj_t        alpha, beta;
+	obj_t        aj, bj, cj, c_savej, c_ref;
+	obj_t        a0, b0, c0;
+
+	void*        buf_a;
+	void*        buf_b;
+	void*        buf_c;
+	void*        buf_c_save;
+
+
+	// Use the datatype of the first char in the datatype combination string.
+	bli_param_map_char_to_blis_dt( dc_str[0], &datatype );
+
+	elem_size = bli_dt_size( datatype );
+
+	// Map the dimension specifier to actual dimensions.
+	m = libblis_test_get_dim_from_prob_size( op->dim_spec[0], p_cur );
+	n = libblis_test_get_dim_from_prob_size( op->dim_spec[1], p_cur );
+	k = libblis_test_get_dim_from_prob_size( op->dim_spec[2], p_cur );
+
+	// Map parameter characters to BLIS constants.
+	bli_param_map_char_to_blis_trans( pc_str[0], &transa );
+	bli_param_map_char_to_blis_trans( pc_str[1], &transb );
+
+	// Determine the dimensions of A and B as they are stored.
+	bli_set_dims_with_trans( transa, m, k, &m_a, &n_a );
+	bli_set_dims_with_trans( transb, k, n, &m_b, &n_b );
+
+	// Create test scalars.
+	bli_obj_scalar_init_detached( datatype, &alpha );
+	bli_obj_scalar_init_detached( datatype, &beta );
+
+	// Set alpha and beta.
+	if ( bli_is_real( datatype ) )
+	{
+		bli_setsc(  1.2,  0.0, &alpha );
+		bli_setsc(  0.9,  0.0, &beta );
+	}
+	else
+	{
+		bli_setsc(  1.2,  0.8, &alpha );
+		bli_setsc(  0.9,  1.0, &beta );
+	}
+
+	*resid = 0.0;
+
+	// Compute one strided batch per pass, in which A, B, both, or neither
+	// have a stride of zero. C always holds nb distinct members, and the
+	// stride of each operand is the size of one member.
+	for ( dim_t pass = 0; pass < GEMM_BATCH_STRIDED_PASSES; ++pass )
+	{
+		stride_a = ( gemm_batch_strided_zero_a[ pass ] ? 0 : m_a * n_a );
+		stride_b = ( gemm_batch_strided_zero_b[ pass ] ? 0 : m_b * n_b );
+		stride_c = m * n;
+
+		buf_a      = bli_malloc_user( bli_max( stride_a * nb, m_a * n_a ) * elem_size, &r_val );
+		buf_b      = bli_malloc_user( bli_max( stride_b * nb, m_b * n_b ) * elem_size, &r_val );
+		buf_c      = bli_malloc_user( stride_c * nb * elem_size, &r_val );
+		buf_c_save = bli_malloc_user( stride_c * nb * elem_size, &r_val );
+
+		// Randomize the members of A, B, and C.
+		for ( dim_t j = 0; j < nb; ++j )
+		{
+			libblis_test_gemm_batch_strided_member( datatype, sc_str[1], m_a, n_a, buf_a, stride_a, j, &aj );
+			libblis_test_gemm_batch_strided_member( datatype, sc_str[2], m_b, n_b, buf_b, stride_b, j, &bj );
+			libblis_test_gemm_batch_strided_member( datatype, sc_str[0], m,   n,   buf_c, stride_c, j, &cj );
+			libblis_test_gemm_batch_strided_member( datatype, sc_str[0], m,   n,   buf_c_save, stride_c, j, &c_savej );
+
+			if ( j == 0 || stride_a != 0 ) libblis_test_mobj_randomize( params, TRUE, &aj );
+			if ( j == 0 || stride_b != 0 ) libblis_test_mobj_randomize( params, TRUE, &bj );
+			libblis_test_mobj_randomize( params, TRUE, &cj );
+			bli_copym( &cj, &c_savej );
+		}
+
+		// Use the objects of the first members for their strides.
+		libblis_test_gemm_batch_strided_member( datatype, sc_str[1], m_a, n_a, buf_a, stride_a, 0, &a0 );
+		libblis_test_gemm_batch_strided_member( datatype, sc_str[2], m_b, n_b, buf_b, stride_b, 0, &b0 );
+		libblis_test_gemm_batch_strided_member( datatype, sc_str[0], m,   n,   buf_c, stride_c, 0, &c0 );
+
+		// Repeat the experiment n_repeats times and record results.
+		for ( i = 0; i < n_repeats; ++i )
+		{
+			for ( dim_t j = 0; j < nb; ++j )
+			{
+				libblis_test_gemm_batch_strided_member( datatype, sc_str[0], m, n, buf_c, stride_c, j, &cj );
+				libblis_test_gemm_batch_strided_member( datatype, sc_str[0], m, n, buf_c_save, stride_c, j, &c_savej );
+				bli_copym( &c_savej, &cj );
+			}
+
+			time = bli_clock();
+
+			libblis_test_gemm_batch_strided_impl( iface, datatype, transa, transb, m, n, k,
+			                                      bli_obj_buffer( &alpha ),
+			                                      buf_a, bli_obj_row_stride( &a0 ), bli_obj_col_stride( &a0 ), stride_a,
+			                                      buf_b, bli_obj_row_stride( &b0 ), bli_obj_col_stride( &b0 ), stride_b,
+			                                      bli_obj_buffer( &beta ),
+			                                      buf_c, bli_obj_row_stride( &c0 ), bli_obj_col_stride( &c0 ), stride_c,
+			                                      nb );
+
+			time_min = bli_clock_min_diff( time_min, time );
+		}
+
+		// Check each member against bli_gemm().
+		for ( dim_t j = 0; j < nb; ++j )
+		{
+			libblis_test_gemm_batch_strided_member( datatype, sc_str[1], m_a, n_a, buf_a, stride_a, j, &aj );
+			libblis_test_gemm_batch_strided_member( datatype, sc_str[2], m_b, n_b, buf_b, stride_b, j, &bj );
+			libblis_test_gemm_batch_strided_member( datatype, sc_str[0], m,   n,   buf_c, stride_c, j, &cj );
+			libblis_test_gemm_batch_strided_member( datatype, sc_str[0], m,   n,   buf_c_save, stride_c, j, &c_savej );
+
+			bli_obj_set_conjtrans( transa, &aj );
+			bli_obj_set_conjtrans( transb, &bj );
+
+			libblis_test_mobj_create( params, datatype, BLIS_NO_TRANSPOSE,
+			                          sc_str[0], m, n, &c_ref );
+			bli_copym( &c_savej, &c_ref );
+			bli_gemm( &alpha, &aj, &bj, &beta, &c_ref );
+
+			// Perform checks.
+			libblis_test_gemm_batch_strided_check( params, &cj, &c_ref, &resid_cur );
+
+			// Keep the largest residual, or the first NaN.
+			if ( !bli_isnan( *resid ) &&
+			     ( bli_isnan( resid_cur ) || *resid < resid_cur ) )
+				*resid = resid_cur;
+
+			bli_obj_free( &c_ref );
+		}
+
+		bli_free_user( buf_a );
+		bli_free_user( buf_b );
+		bli_free_user( buf_c );
+		bli_free_user( buf_c_save );
+	}
+
+	// Estimate the performance of the best experiment repeat.
+	*perf = ( 2.0 * m * n * k * nb ) / time_min / FLOPS_PER_UNIT_PERF;
+	if ( bli_is_complex( datatype ) ) *perf *= 4.0;
+
+	// Zero out performance and residual if the problem is empty.
+	if ( m == 0 || n == 0 ) { *perf = 0.0; *resid = 0.0; }
+}
+
+
+
+static void libblis_test_gemm_batch_strided_member
+     (
+       num_t   dt,
+       char    storage,
+       dim_t   m,
+       dim_t   n,
+       void*   buf,
+       inc_t   stride,
+       dim_t   i,
+       obj_t*  x
+     )
+{
+	inc_t rs, cs;
+
+	// Describe member i of a strided batch of m x n matrices, each stored
+	// contiguously by rows or by columns.
+	if ( storage == 'r' ) { rs = n; cs = 1; }
+	else                  { rs = 1; cs = m; }
+
+	bli_obj_create_with_attached_buffer( dt, m, n,
+	                                     ( char* )buf + i * stride * bli_dt_size( dt ),
+	                                     rs, cs, x );
+}
+
+
+
+void libblis_test_gemm_batch_strided_impl
+     (
+       iface_t   iface,
+       num_t     dt,
+       trans_t   transa,
+       trans_t   transb,
+       dim_t     m,
+       dim_t     n,
+       dim_t     k,
+       void*     alpha,
+       void*     a, inc_t rs_a, inc_t cs_a, inc_t stride_a,
+       void*     b, inc_t rs_b, inc_t cs_b, inc_t stride_b,
+       void*     beta,
+       void*     c, inc_t rs_c, inc_t cs_c, inc_t stride_c,
+       dim_t     batch_count
+     )
+{
+	switch ( iface )
+	{
+		case BLIS_TEST_SEQ_FRONT_END:
+		if      ( dt == BLIS_FLOAT )
+			bli_sgemm_batch_strided( transa, transb, m, n, k, alpha,
+			                         a, rs_a, cs_a, stride_a,
+			                         b, rs_b, cs_b, stride_b, beta,
+			                         c, rs_c, cs_c, stride_c, batch_count );
+		else if ( dt == BLIS_DOUBLE )
+			bli_dgemm_batch_strided( transa, transb, m, n, k, alpha,
+			                         a, rs_a, cs_a, stride_a,
+			                         b, rs_b, cs_b, stride_b, beta,
+			                         c, rs_c, cs_c, stride_c, batch_count );
+		else if ( dt == BLIS_SCOMPLEX )
+			bli_cgemm_batch_strided( transa, transb, m, n, k, alpha,
+			                         a, rs_a, cs_a, stride_a,
+			                         b, rs_b, cs_b, stride_b, beta,
+			                         c, rs_c, cs_c, stride_c, batch_count );
+		else if ( dt == BLIS_DCOMPLEX )
+			bli_zgemm_batch_strided( transa, transb, m, n, k, alpha,
+			                         a, rs_a, cs_a, stride_a,
+			                         b, rs_b, cs_b, stride_b, beta,
+			                         c, rs_c, cs_c, stride_c, batch_count );
+		break;
+
+		default:
+		libblis_test_printf_error( "Invalid interface type.\n" );
+	}
+}
+
+
+
+void libblis_test_gemm_batch_strided_check
+     (
+       test_params_t* params,
+       obj_t*         c,
+       obj_t*         c_ref,
+       double*        resid
+     )
+{
+	num_t  dt_real = bli_obj_dt_proj_to_real( c );
+
+	obj_t  norm;
+
+	double junk;
+
+	//
+	// Pre-conditions:
+	// - a and b are randomized.
+	// - c_ref holds the result of the member computed by bli_gemm(),
+	//
+	//     C_ref := beta * C_orig + alpha * transa(A) * transb(B)
+	//
+	// Under these conditions, we assume that the implementation for the
+	// same member within the strided batch is functioning correctly if
+	//
+	//   normfm( C - C_ref )
+	//
+	// is negligible.
+	//
+
+	bli_obj_scalar_init_detached( dt_real, &norm );
+
+	bli_subm( c_ref, c );
+	bli_normfm( c, &norm );
+
+	bli_getsc( &norm, resid, &junk );
+}
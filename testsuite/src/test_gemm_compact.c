@@ -0,0 +1,423 @@
+/*
+
+   BLIS
+   An object-based framework for developing high-performance BLAS-like
+   libraries.
+
+   Copyright (C) 2014, The University of Texas at Austin
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are
+   met:
+    - Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    - Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    - Neither the name(s) of the copyright holder(s) nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "blis.h"
+#include "test_libblis.h"
+
+
+// Static variables.
+static char*     op_str                    = "gemm_compact";
+static char*     o_types                   = "mmm"; // a b c
+static char*     p_types                   = "hh";  // transa transb
+static thresh_t  thresh[BLIS_NUM_FP_TYPES] = { { 1e-04, 1e-05 },   // warn, pass for s
+                                               { 1e-04, 1e-05 },   // warn, pass for c
+                                               { 1e-13, 1e-14 },   // warn, pass for d
+                                               { 1e-13, 1e-14 } }; // warn, pass for z
+
+// Local prototypes.
+void libblis_test_gemm_compact_deps
+     (
+       thread_data_t* tdata,
+       test_params_t* params,
+       test_op_t*     op
+     );
+
+void libblis_test_gemm_compact_experiment
+     (
+       test_params_t* params,
+       test_op_t*     op,
+       iface_t        iface,
+       char*          dc_str,
+       char*          pc_str,
+       char*          sc_str,
+       unsigned int   p_cur,
+       double*        perf,
+       double*        resid
+     );
+
+void libblis_test_gemm_compact_impl
+     (
+       iface_t   iface,
+       dim_t     nb,
+       obj_t*    alpha,
+       obj_t*    a,
+       obj_t*    b,
+       obj_t*    beta,
+       obj_t*    c
+     );
+
+void libblis_test_gemm_compact_check
+     (
+       test_params_t* params,
+       obj_t*         c,
+       obj_t*         c_ref,
+       double*        resid
+     );
+
+
+
+void libblis_test_gemm_compact_deps
+     (
+       thread_data_t* tdata,
+       test_params_t* params,
+       test_op_t*     op
+     )
+{
+	libblis_test_randm( tdata, params, &(op->ops->randm) );
+	libblis_test_normfm( tdata, params, &(op->ops->normfm) );
+	libblis_test_subm( tdata, params, &(op->ops->subm) );
+	libblis_test_copym( tdata, params, &(op->ops->copym) );
+	libblis_test_gemm( tdata, params, &(op->ops->gemm) );
+}
+
+
+
+void libblis_test_gemm_compact
+     (
+       thread_data_t* tdata,
+       test_params_t* params,
+       test_op_t*     op
+     )
+{
+
+	// Return early if this test has already been done.
+	if ( libblis_test_op_is_done( op ) ) return;
+
+	// Return early if operation is disabled.
+	if ( libblis_test_op_is_disabled( op ) ||
+	     libblis_test_l3_is_disabled( op ) ) return;
+
+	// Call dependencies first.
+	if ( TRUE ) libblis_test_gemm_compact_deps( tdata, params, op );
+
+	// Execute the test driver for each implementation requested.
+	//if ( op->front_seq == ENABLE )
+	{
+		libblis_test_op_driver( tdata,
+		                        params,
+		                        op,
+		                        BLIS_TEST_SEQ_FRONT_END,
+		                        op_str,
+		                        p_types,
+		                        o_types,
+		                        thresh,
+		                        libblis_test_gemm_compact_experiment );
+	}
+}
+
+
+
+void libblis_test_gemm_compact_experiment
+     (
+       test_params_t* params,
+       test_op_t*     op,
+       iface_t        iface,
+       char*          dc_str,
+       char*          pc_str,
+       char*          sc_str,
+       unsigned int   p_cur,
+       double*        perf,
+       double*        resid
+     )
+{
+	double       time_min  = DBL_MAX;
+	double       time;
+	double       resid_cur;
+
+	num_t        datatype;
+
+	dim_t        m, n, k;
+	dim_t        nb;
+
+	trans_t      transa;
+	trans_t      transb;
+
+	obj_t        alpha, beta;
+	obj_t*       a;
+	obj_t*       b;
+	obj_t*       c;
+	obj_t*       c_ref;
+
+	err_t        r_val;
+
+	// Use the datatype of the first char in the datatype combination string.
+	bli_param_map_char_to_blis_dt( dc_str[0], &datatype );
+
+	*perf  = 0.0;
+	*resid = 0.0;
+
+	// The compact operations are only defined for the real domain.
+	if ( bli_is_complex( datatype ) ) return;
+
+	// Map the dimension specifier to actual dimensions.
+	m = libblis_test_get_dim_from_prob_size( op->dim_spec[0], p_cur );
+	n = libblis_test_get_dim_from_prob_size( op->dim_spec[1], p_cur );
+	k = libblis_test_get_dim_from_prob_size( op->dim_spec[2], p_cur );
+
+	// Use a batch of two full groups and a partial one, so that the padding
+	// of the last group is exercised.
+	nb = 2 * bli_compact_width( datatype, NULL ) + 3;
+
+	// Map parameter characters to BLIS constants.
+	bli_param_map_char_to_blis_trans( pc_str[0], &transa );
+	bli_param_map_char_to_blis_trans( pc_str[1], &transb );
+
+	// Create test scalars.
+	bli_obj_scalar_init_detached( datatype, &alpha );
+	bli_obj_scalar_init_detached( datatype, &beta );
+
+	// Set alpha.
+	bli_setsc(  1.2,  0.0, &alpha );
+
+	// Create the members of the batch.
+	a     = bli_malloc_user( nb * sizeof( obj_t ), &r_val );
+	b     = bli_malloc_user( nb * sizeof( obj_t ), &r_val );
+	c     = bli_malloc_user( nb * sizeof( obj_t ), &r_val );
+	c_ref = bli_malloc_user( nb * sizeof( obj_t ), &r_val );
+
+	for ( dim_t q = 0; q < nb; ++q )
+	{
+		libblis_test_mobj_create( params, datatype, transa,
+		                          sc_str[1], m, k, &a[q] );
+		libblis_test_mobj_create( params, datatype, transb,
+		                          sc_str[2], k, n, &b[q] );
+		libblis_test_mobj_create( params, datatype, BLIS_NO_TRANSPOSE,
+		                          sc_str[0], m, n, &c[q] );
+		libblis_test_mobj_create( params, datatype, BLIS_NO_TRANSPOSE,
+		                          sc_str[0], m, n, &c_ref[q] );
+
+		// Randomize A and B.
+		libblis_test_mobj_randomize( params, TRUE, &a[q] );
+		libblis_test_mobj_randomize( params, TRUE, &b[q] );
+
+		// Apply the parameters.
+		bli_obj_set_conjtrans( transa, &a[q] );
+		bli_obj_set_conjtrans( transb, &b[q] );
+	}
+
+	// Run the experiment twice: first with a nonzero beta, and then with
+	// beta equal to zero and C filled with NaN, which must then not
+	// propagate to the output.
+	for ( dim_t i = 0; i < 2; ++i )
+	{
+		for ( dim_t q = 0; q < nb; ++q )
+		{
+			if ( i == 0 ) libblis_test_mobj_randomize( params, TRUE, &c[q] );
+			else          bli_setm( &BLIS_NAN, &c[q] );
+
+			// Save C.
+			bli_copym( &c[q], &c_ref[q] );
+		}
+
+		if ( i == 0 ) bli_setsc( 0.9, 0.0, &beta );
+		else          bli_setsc( 0.0, 0.0, &beta );
+
+		time = bli_clock();
+
+		libblis_test_gemm_compact_impl( iface, nb, &alpha, a, b, &beta, c );
+
+		time_min = bli_clock_min_diff( time_min, time );
+
+		for ( dim_t q = 0; q < nb; ++q )
+		{
+			// Compute the reference result for each member separately.
+			bli_gemm( &alpha, &a[q], &b[q], &beta, &c_ref[q] );
+
+			// Perform checks.
+			libblis_test_gemm_compact_check( params, &c[q], &c_ref[q], &resid_cur );
+
+			// Keep the largest residual, or the first NaN.
+			if ( !bli_isnan( *resid ) &&
+			     ( bli_isnan( resid_cur ) || *resid < resid_cur ) )
+				*resid = resid_cur;
+		}
+	}
+
+	// Estimate the performance of the best experiment repeat. Note that the
+	// time includes the conversion of the batch to and from the compact
+	// format.
+	*perf = ( 2.0 * m * n * k * nb ) / time_min / FLOPS_PER_UNIT_PERF;
+
+	// Zero out performance and residual if output matrix is empty.
+	libblis_test_check_empty_problem( &c[0], perf, resid );
+
+	// Free the test objects.
+	for ( dim_t q = 0; q < nb; ++q )
+	{
+		bli_obj_free( &a[q] );
+		bli_obj_free( &b[q] );
+		bli_obj_free( &c[q] );
+		bli_obj_free( &c_ref[q] );
+	}
+
+	bli_free_user( a );
+	bli_free_user( b );
+	bli_free_user( c );
+	bli_free_user( c_ref );
+}
+
+
+
+void libblis_test_gemm_compact_impl
+     (
+       iface_t   iface,
+       dim_t     nb,
+       obj_t*    alpha,
+       obj_t*    a,
+       obj_t*    b,
+       obj_t*    beta,
+       obj_t*    c
+     )
+{
+	num_t   dt     = bli_obj_dt( c );
+
+	trans_t transa = bli_obj_conjtrans_status( &a[0] );
+	trans_t transb = bli_obj_conjtrans_status( &b[0] );
+	dim_t   m      = bli_obj_length( &c[0] );
+	dim_t   n      = bli_obj_width( &c[0] );
+	dim_t   k      = bli_obj_width_after_trans( &a[0] );
+
+	// The members of the batch are stored alike, so the strides of the first
+	// member apply to all of them.
+	dim_t   m_a    = bli_obj_length( &a[0] );
+	dim_t   n_a    = bli_obj_width( &a[0] );
+	inc_t   rs_a   = bli_obj_row_stride( &a[0] );
+	inc_t   cs_a   = bli_obj_col_stride( &a[0] );
+	dim_t   m_b    = bli_obj_length( &b[0] );
+	dim_t   n_b    = bli_obj_width( &b[0] );
+	inc_t   rs_b   = bli_obj_row_stride( &b[0] );
+	inc_t   cs_b   = bli_obj_col_stride( &b[0] );
+	inc_t   rs_c   = bli_obj_row_stride( &c[0] );
+	inc_t   cs_c   = bli_obj_col_stride( &c[0] );
+
+	void*   buf_alpha = bli_obj_buffer_for_1x1( dt, alpha );
+	void*   buf_beta  = bli_obj_buffer_for_1x1( dt, beta );
+
+	err_t   r_val;
+
+	void**  buf_a  = bli_malloc_user( nb * sizeof( void* ), &r_val );
+	void**  buf_b  = bli_malloc_user( nb * sizeof( void* ), &r_val );
+	void**  buf_c  = bli_malloc_user( nb * sizeof( void* ), &r_val );
+
+	void*   ap     = bli_malloc_user( bli_compact_size( dt, m_a, n_a, nb, NULL ), &r_val );
+	void*   bp     = bli_malloc_user( bli_compact_size( dt, m_b, n_b, nb, NULL ), &r_val );
+	void*   cp     = bli_malloc_user( bli_compact_size( dt, m,   n,   nb, NULL ), &r_val );
+
+	for ( dim_t q = 0; q < nb; ++q )
+	{
+		buf_a[q] = bli_obj_buffer_at_off( &a[q] );
+		buf_b[q] = bli_obj_buffer_at_off( &b[q] );
+		buf_c[q] = bli_obj_buffer_at_off( &c[q] );
+	}
+
+	switch ( iface )
+	{
+		case BLIS_TEST_SEQ_FRONT_END:
+		// Convert the batch to the compact format, compute, and convert C
+		// back.
+		if      ( dt == BLIS_FLOAT )
+		{
+			bli_sgepack_compact( m_a, n_a, ( const float* const* )buf_a, rs_a, cs_a, nb, ap );
+			bli_sgepack_compact( m_b, n_b, ( const float* const* )buf_b, rs_b, cs_b, nb, bp );
+			bli_sgepack_compact( m,   n,   ( const float* const* )buf_c, rs_c, cs_c, nb, cp );
+			bli_sgemm_compact( transa, transb, m, n, k,
+			                   buf_alpha, ap, bp, buf_beta, cp, nb );
+			bli_sgeunpack_compact( m, n, cp, nb, ( float* const* )buf_c, rs_c, cs_c );
+		}
+		else if ( dt == BLIS_DOUBLE )
+		{
+			bli_dgepack_compact( m_a, n_a, ( const double* const* )buf_a, rs_a, cs_a, nb, ap );
+			bli_dgepack_compact( m_b, n_b, ( const double* const* )buf_b, rs_b, cs_b, nb, bp );
+			bli_dgepack_compact( m,   n,   ( const double* const* )buf_c, rs_c, cs_c, nb, cp );
+			bli_dgemm_compact( transa, transb, m, n, k,
+			                   buf_alpha, ap, bp, buf_beta, cp, nb );
+			bli_dgeunpack_compact( m, n, cp, nb, ( double* const* )buf_c, rs_c, cs_c );
+		}
+		break;
+
+		default:
+		libblis_test_printf_error( "Invalid interface type.\n" );
+	}
+
+	bli_free_user( ap );
+	bli_free_user( bp );
+	bli_free_user( cp );
+
+	bli_free_user( buf_a );
+	bli_free_user( buf_b );
+	bli_free_user( buf_c );
+}
+
+
+
+void libblis_test_gemm_compact_check
+     (
+       test_params_t* params,
+       obj_t*         c,
+       obj_t*         c_ref,
+       double*        resid
+     )
+{
+	num_t  dt_real = bli_obj_dt_proj_to_real( c );
+
+	obj_t  norm;
+
+	double junk;
+
+	//
+	// Pre-conditions:
+	// - a and b are randomized.
+	// - c_ref holds the result of the object API for the same member,
+	//
+	//     C_ref := beta * C_orig + alpha * transa(A) * transb(B)
+	//
+	// Under these conditions, we assume that the implementation for
+	//
+	//   C := beta * C_orig + alpha * transa(A) * transb(B)
+	//
+	// (via the compact format) is functioning correctly if
+	//
+	//   normfm( C - C_ref )
+	//
+	// is negligible.
+	//
+
+	bli_obj_scalar_init_detached( dt_real, &norm );
+
+	bli_subm( c_ref, c );
+	bli_normfm( c, &norm );
+
+	bli_getsc( &norm, resid, &junk );
+}
+
@@ -0,0 +1,426 @@
+/*
+
+   BLIS
+   An object-based framework for developing high-performance BLAS-like
+   libraries.
+
+   Copyright (C) 2014, The University of Texas at Austin
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are
+   met:
+    - Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    - Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    - Neither the name(s) of the copyright holder(s) nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "blis.h"
+#include "test_libblis.h"
+
+
+// Static variables.
+static char*     op_str                    = "gemm_postops";
+static char*     o_types                   = "mmm"; // a b c
+static char*     p_types                   = "hh";  // transa transb
+static thresh_t  thresh[BLIS_NUM_FP_TYPES] = { { 1e-04, 1e-05 },   // warn, pass for s
+                                               { 1e-04, 1e-05 },   // warn, pass for c
+                                               { 1e-13, 1e-14 },   // warn, pass for d
+                                               { 1e-13, 1e-14 } }; // warn, pass for z
+
+// The post-op lists that are tested: each kind of post-op by itself, with
+// bias and scale along both m and n, followed by one list of several.
+#define N_POSTOPS_LISTS 9
+
+// Local prototypes.
+void libblis_test_gemm_postops_deps
+     (
+       thread_data_t* tdata,
+       test_params_t* params,
+       test_op_t*     op
+     );
+
+void libblis_test_gemm_postops_experiment
+     (
+       test_params_t* params,
+       test_op_t*     op,
+       iface_t        iface,
+       char*          dc_str,
+       char*          pc_str,
+       char*          sc_str,
+       unsigned int   p_cur,
+       double*        perf,
+       double*        resid
+     );
+
+void libblis_test_gemm_postops_impl
+     (
+       iface_t    iface,
+       obj_t*     alpha,
+       obj_t*     a,
+       obj_t*     b,
+       obj_t*     beta,
+       obj_t*     c,
+       postops_t* postops
+     );
+
+void libblis_test_gemm_postops_check
+     (
+       test_params_t* params,
+       postops_t*     postops,
+       obj_t*         c,
+       obj_t*         c_ref,
+       double*        resid
+     );
+
+
+
+void libblis_test_gemm_postops_deps
+     (
+       thread_data_t* tdata,
+       test_params_t* params,
+       test_op_t*     op
+     )
+{
+	libblis_test_randm( tdata, params, &(op->ops->randm) );
+	libblis_test_normfm( tdata, params, &(op->ops->normfm) );
+	libblis_test_subm( tdata, params, &(op->ops->subm) );
+	libblis_test_copym( tdata, params, &(op->ops->copym) );
+	libblis_test_gemm( tdata, params, &(op->ops->gemm) );
+}
+
+
+
+void libblis_test_gemm_postops
+     (
+       thread_data_t* tdata,
+       test_params_t* params,
+       test_op_t*     op
+     )
+{
+
+	// Return early if this test has already been done.
+	if ( libblis_test_op_is_done( op ) ) return;
+
+	// Return early if operation is disabled.
+	if ( libblis_test_op_is_disabled( op ) ||
+	     libblis_test_l3_is_disabled( op ) ) return;
+
+	// Call dependencies first.
+	if ( TRUE ) libblis_test_gemm_postops_deps( tdata, params, op );
+
+	// Execute the test driver for each implementation requested.
+	//if ( op->front_seq == ENABLE )
+	{
+		libblis_test_op_driver( tdata,
+		                        params,
+		                        op,
+		                        BLIS_TEST_SEQ_FRONT_END,
+		                        op_str,
+		                        p_types,
+		                        o_types,
+		                        thresh,
+		                        libblis_test_gemm_postops_experiment );
+	}
+}
+
+
+
+void libblis_test_gemm_postops_experiment
+     (
+       test_params_t* params,
+       test_op_t*     op,
+       iface_t        iface,
+       char*          dc_str,
+       char*          pc_str,
+       char*          sc_str,
+       unsigned int   p_cur,
+       double*        perf,
+       double*        resid
+     )
+{
+	double       time_min  = DBL_MAX;
+	double       time;
+	double       flops     = 0.0;
+	double       resid_cur;
+
+	num_t        datatype;
+
+	dim_t        m, n, k;
+	dim_t        mi;
+
+	trans_t      transa;
+	trans_t      transb;
+
+	obj_t        alpha, a, b, beta, c;
+	obj_t        c_save, c_ref;
+	obj_t        v_m, v_n;
+
+	postops_t    postops;
+
+
+	// Use the datatype of the first char in the datatype combination string.
+	bli_param_map_char_to_blis_dt( dc_str[0], &datatype );
+
+	*perf  = 0.0;
+	*resid = 0.0;
+
+	// Post-ops are only defined for the real domain.
+	if ( bli_is_complex( datatype ) ) return;
+
+	// Map the dimension specifier to actual dimensions.
+	m = libblis_test_get_dim_from_prob_size( op->dim_spec[0], p_cur );
+	n = libblis_test_get_dim_from_prob_size( op->dim_spec[1], p_cur );
+	k = libblis_test_get_dim_from_prob_size( op->dim_spec[2], p_cur );
+
+	// Map parameter characters to BLIS constants.
+	bli_param_map_char_to_blis_trans( pc_str[0], &transa );
+	bli_param_map_char_to_blis_trans( pc_str[1], &transb );
+
+	// Create test scalars.
+	bli_obj_scalar_init_detached( datatype, &alpha );
+	bli_obj_scalar_init_detached( datatype, &beta );
+
+	// Set alpha and beta so that the elements of C are of order one, which
+	// makes ReLU, GELU, and clip act nonlinearly on a good share of them.
+	bli_setsc( 1.0 / sqrt( ( double )bli_max( k, 1 ) ), 0.0, &alpha );
+	bli_setsc( 0.5, 0.0, &beta );
+
+	// Run each list once with m rows and once with m/8 rows. With the
+	// problem in the input files, the former takes the conventional path
+	// and the latter the sup path.
+	for ( dim_t pass = 0; pass < 2; ++pass )
+	{
+		mi = ( pass == 0 ? m : bli_max( m / 8, 1 ) );
+
+		// Create test operands (vectors and/or matrices).
+		libblis_test_mobj_create( params, datatype, transa,
+		                          sc_str[1], mi, k, &a );
+		libblis_test_mobj_create( params, datatype, transb,
+		                          sc_str[2], k, n, &b );
+		libblis_test_mobj_create( params, datatype, BLIS_NO_TRANSPOSE,
+		                          sc_str[0], mi, n, &c );
+		libblis_test_mobj_create( params, datatype, BLIS_NO_TRANSPOSE,
+		                          sc_str[0], mi, n, &c_save );
+		libblis_test_mobj_create( params, datatype, BLIS_NO_TRANSPOSE,
+		                          sc_str[0], mi, n, &c_ref );
+		libblis_test_vobj_create( params, datatype, 'c', mi, &v_m );
+		libblis_test_vobj_create( params, datatype, 'c', n,  &v_n );
+
+		// Randomize A, B, C, and the vectors, but do not normalize them.
+		libblis_test_mobj_randomize( params, FALSE, &a );
+		libblis_test_mobj_randomize( params, FALSE, &b );
+		libblis_test_mobj_randomize( params, FALSE, &c );
+		libblis_test_vobj_randomize( params, FALSE, &v_m );
+		libblis_test_vobj_randomize( params, FALSE, &v_n );
+
+		// Save C.
+		bli_copym( &c, &c_save );
+
+		// Apply the parameters.
+		bli_obj_set_conjtrans( transa, &a );
+		bli_obj_set_conjtrans( transb, &b );
+
+		for ( dim_t l = 0; l < N_POSTOPS_LISTS; ++l )
+		{
+			bli_postops_init( &postops );
+
+			switch ( l )
+			{
+				case 0: bli_postops_append_bias( BLIS_M, &v_m, &postops ); break;
+				case 1: bli_postops_append_bias( BLIS_N, &v_n, &postops ); break;
+				case 2: bli_postops_append_scale( BLIS_M, &v_m, &postops ); break;
+				case 3: bli_postops_append_scale( BLIS_N, &v_n, &postops ); break;
+				case 4: bli_postops_append_relu( &postops ); break;
+				case 5: bli_postops_append_gelu_tanh( &postops ); break;
+				case 6: bli_postops_append_gelu_erf( &postops ); break;
+				case 7: bli_postops_append_clip( -0.5, 0.25, &postops ); break;
+				default:
+					bli_postops_append_scale( BLIS_N, &v_n, &postops );
+					bli_postops_append_bias( BLIS_M, &v_m, &postops );
+					bli_postops_append_gelu_tanh( &postops );
+					bli_postops_append_clip( -0.1, 0.75, &postops );
+					break;
+			}
+
+			bli_copym( &c_save, &c );
+
+			time = bli_clock();
+
+			libblis_test_gemm_postops_impl( iface, &alpha, &a, &b, &beta, &c,
+			                                &postops );
+
+			time_min = bli_clock_min_diff( time_min, time );
+
+			if ( pass == 0 && l == 0 ) flops = 2.0 * mi * n * k;
+
+			// Compute the reference result without post-ops. The check
+			// applies them.
+			bli_copym( &c_save, &c_ref );
+			bli_gemm( &alpha, &a, &b, &beta, &c_ref );
+
+			// Perform checks.
+			libblis_test_gemm_postops_check( params, &postops, &c, &c_ref, &resid_cur );
+
+			// Keep the largest residual, or the first NaN.
+			if ( !bli_isnan( *resid ) &&
+			     ( bli_isnan( resid_cur ) || *resid < resid_cur ) )
+				*resid = resid_cur;
+		}
+
+		// Free the test objects.
+		bli_obj_free( &a );
+		bli_obj_free( &b );
+		bli_obj_free( &c );
+		bli_obj_free( &c_save );
+		bli_obj_free( &c_ref );
+		bli_obj_free( &v_m );
+		bli_obj_free( &v_n );
+	}
+
+	// Estimate the performance of the best experiment, which is a rough
+	// figure since the smaller problems are included.
+	*perf = flops / time_min / FLOPS_PER_UNIT_PERF;
+
+	// Zero out performance and residual if the problem is empty.
+	if ( m == 0 || n == 0 ) { *perf = 0.0; *resid = 0.0; }
+}
+
+
+
+void libblis_test_gemm_postops_impl
+     (
+       iface_t    iface,
+       obj_t*     alpha,
+       obj_t*     a,
+       obj_t*     b,
+       obj_t*     beta,
+       obj_t*     c,
+       postops_t* postops
+     )
+{
+	rntm_t rntm = BLIS_RNTM_INITIALIZER;
+
+	bli_rntm_set_postops( postops, &rntm );
+
+	switch ( iface )
+	{
+		case BLIS_TEST_SEQ_FRONT_END:
+		bli_gemm_ex( alpha, a, b, beta, c, NULL, &rntm );
+		break;
+
+		default:
+		libblis_test_printf_error( "Invalid interface type.\n" );
+	}
+}
+
+
+
+void libblis_test_gemm_postops_check
+     (
+       test_params_t* params,
+       postops_t*     postops,
+       obj_t*         c,
+       obj_t*         c_ref,
+       double*        resid
+     )
+{
+	num_t  dt_real = bli_obj_dt_proj_to_real( c );
+
+	dim_t  m       = bli_obj_length( c );
+	dim_t  n       = bli_obj_width( c );
+
+	obj_t  norm;
+
+	double norm_ref;
+	double junk;
+
+	//
+	// Pre-conditions:
+	// - a, b, and the vectors of the post-ops are randomized.
+	// - c_ref holds the result of gemm without post-ops,
+	//
+	//     C_ref := beta * C_orig + alpha * transa(A) * transb(B)
+	//
+	// Under these conditions, we assume that the implementation for
+	//
+	//   C := postops( beta * C_orig + alpha * transa(A) * transb(B) )
+	//
+	// is functioning correctly if
+	//
+	//   normfm( C - postops( C_ref ) ) / normfm( postops( C_ref ) )
+	//
+	// is negligible, where postops() is applied to C_ref elementwise here.
+	//
+
+	for ( dim_t j = 0; j < n; ++j )
+	for ( dim_t i = 0; i < m; ++i )
+	{
+		double x, v;
+
+		bli_getijm( i, j, c_ref, &x, &junk );
+
+		for ( dim_t p = 0; p < postops->n_ops; ++p )
+		{
+			const postop_desc_t* desc = &postops->ops[ p ];
+
+			// Read the element of the vector that applies to (i,j).
+			if ( desc->v != NULL )
+			{
+				const dim_t iv = ( desc->dim == BLIS_M ? i : j );
+
+				if ( bli_is_float( desc->dt_v ) )
+					v = ( ( float*  )desc->v )[ iv * desc->incv ];
+				else
+					v = ( ( double* )desc->v )[ iv * desc->incv ];
+			}
+			else
+			{
+				v = 0.0;
+			}
+
+			switch ( desc->op )
+			{
+				case BLIS_POSTOP_BIAS:      x = x + v; break;
+				case BLIS_POSTOP_SCALE:     x = x * v; break;
+				case BLIS_POSTOP_RELU:      x = bli_max( x, 0.0 ); break;
+				case BLIS_POSTOP_GELU_TANH: x = 0.5 * x * ( 1.0 + tanh( 0.7978845608028654 *
+				                                ( x + 0.044715 * x * x * x ) ) ); break;
+				case BLIS_POSTOP_GELU_ERF:  x = 0.5 * x * ( 1.0 + erf( x * 0.7071067811865476 ) ); break;
+				case BLIS_POSTOP_CLIP:      x = bli_min( bli_max( x, desc->lo ), desc->hi ); break;
+				default: break;
+			}
+		}
+
+		bli_setijm( x, 0.0, i, j, c_ref );
+	}
+
+	bli_obj_scalar_init_detached( dt_real, &norm );
+
+	bli_normfm( c_ref, &norm );
+	bli_getsc( &norm, &norm_ref, &junk );
+
+	bli_subm( c_ref, c );
+	bli_normfm( c, &norm );
+	bli_getsc( &norm, resid, &junk );
+
+	if ( norm_ref != 0.0 ) *resid /= norm_ref;
+}
+
@@ -0,0 +1,372 @@
+/*
+
+   BLIS
+   An object-based framework for developing high-performance BLAS-like
+   libraries.
+
+   Copyright (C) 2014, The University of Texas at Austin
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are
+   met:
+    - Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    - Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    - Neither the name(s) of the copyright holder(s) nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "blis.h"
+#include "test_libblis.h"
+
+
+// Static variables.
+static char*     op_str                    = "gemm_tiny";
+static char*     o_types                   = "mmm"; // a b c
+static char*     p_types                   = "hh";  // transa transb
+static thresh_t  thresh[BLIS_NUM_FP_TYPES] = { { 1e-04, 1e-05 },   // warn, pass for s
+                                               { 1e-04, 1e-05 },   // warn, pass for c
+                                               { 1e-13, 1e-14 },   // warn, pass for d
+                                               { 1e-13, 1e-14 } }; // warn, pass for z
+
+// Local prototypes.
+void libblis_test_gemm_tiny_deps
+     (
+       thread_data_t* tdata,
+       test_params_t* params,
+       test_op_t*     op
+     );
+
+void libblis_test_gemm_tiny_experiment
+     (
+       test_params_t* params,
+       test_op_t*     op,
+       iface_t        iface,
+       char*          dc_str,
+       char*          pc_str,
+       char*          sc_str,
+       unsigned int   p_cur,
+       double*        perf,
+       double*        resid
+     );
+
+void libblis_test_gemm_tiny_impl
+     (
+       iface_t   iface,
+       obj_t*    alpha,
+       obj_t*    a,
+       obj_t*    b,
+       obj_t*    beta,
+       obj_t*    c
+     );
+
+void libblis_test_gemm_tiny_check
+     (
+       test_params_t* params,
+       obj_t*         c,
+       obj_t*         c_ref,
+       double*        resid
+     );
+
+
+
+void libblis_test_gemm_tiny_deps
+     (
+       thread_data_t* tdata,
+       test_params_t* params,
+       test_op_t*     op
+     )
+{
+	libblis_test_randm( tdata, params, &(op->ops->randm) );
+	libblis_test_normfm( tdata, params, &(op->ops->normfm) );
+	libblis_test_subm( tdata, params, &(op->ops->subm) );
+	libblis_test_copym( tdata, params, &(op->ops->copym) );
+	libblis_test_gemm( tdata, params, &(op->ops->gemm) );
+}
+
+
+
+void libblis_test_gemm_tiny
+     (
+       thread_data_t* tdata,
+       test_params_t* params,
+       test_op_t*     op
+     )
+{
+
+	// Return early if this test has already been done.
+	if ( libblis_test_op_is_done( op ) ) return;
+
+	// Return early if operation is disabled.
+	if ( libblis_test_op_is_disabled( op ) ||
+	     libblis_test_l3_is_disabled( op ) ) return;
+
+	// Call dependencies first.
+	if ( TRUE ) libblis_test_gemm_tiny_deps( tdata, params, op );
+
+	// Execute the test driver for each implementation requested.
+	//if ( op->front_seq == ENABLE )
+	{
+		libblis_test_op_driver( tdata,
+		                        params,
+		                        op,
+		                        BLIS_TEST_SEQ_FRONT_END,
+		                        op_str,
+		                        p_types,
+		                        o_types,
+		                        thresh,
+		                        libblis_test_gemm_tiny_experiment );
+	}
+}
+
+
+
+void libblis_test_gemm_tiny_experiment
+     (
+       test_params_t* params,
+       test_op_t*     op,
+       iface_t        iface,
+       char*          dc_str,
+       char*          pc_str,
+       char*          sc_str,
+       unsigned int   p_cur,
+       double*        perf,
+       double*        resid
+     )
+{
+	double       time_min  = DBL_MAX;
+	double       time;
+	double       flops     = 0.0;
+	double       resid_cur;
+
+	num_t        datatype;
+
+	dim_t        m, n, k;
+	dim_t        mi, ni;
+
+	trans_t      transa;
+	trans_t      transb;
+
+	obj_t        alpha, a, b, beta, c;
+	obj_t        c_ref;
+
+
+	// Use the datatype of the first char in the datatype combination string.
+	bli_param_map_char_to_blis_dt( dc_str[0], &datatype );
+
+	// Map the dimension specifier to actual dimensions. The typed API takes
+	// its tiny fast path only for problems no larger than the BLIS_TT
+	// threshold, so m and n here are the largest dimensions of a sweep
+	// over every m x n problem (with the given k) that straddles it.
+	m = libblis_test_get_dim_from_prob_size( op->dim_spec[0], p_cur );
+	n = libblis_test_get_dim_from_prob_size( op->dim_spec[1], p_cur );
+	k = libblis_test_get_dim_from_prob_size( op->dim_spec[2], p_cur );
+
+	// Map parameter characters to BLIS constants.
+	bli_param_map_char_to_blis_trans( pc_str[0], &transa );
+	bli_param_map_char_to_blis_trans( pc_str[1], &transb );
+
+	// Create test scalars.
+	bli_obj_scalar_init_detached( datatype, &alpha );
+	bli_obj_scalar_init_detached( datatype, &beta );
+
+	// Set alpha.
+	if ( bli_is_real( datatype ) )
+		bli_setsc(  1.2,  0.0, &alpha );
+	else
+		bli_setsc(  1.2,  0.8, &alpha );
+
+	*resid = 0.0;
+
+	for ( mi = 1; mi <= m; ++mi )
+	for ( ni = 1; ni <= n; ++ni )
+	{
+		// Create test operands (vectors and/or matrices).
+		libblis_test_mobj_create( params, datatype, transa,
+		                          sc_str[1], mi, k, &a );
+		libblis_test_mobj_create( params, datatype, transb,
+		                          sc_str[2], k, ni, &b );
+		libblis_test_mobj_create( params, datatype, BLIS_NO_TRANSPOSE,
+		                          sc_str[0], mi, ni, &c );
+		libblis_test_mobj_create( params, datatype, BLIS_NO_TRANSPOSE,
+		                          sc_str[0], mi, ni, &c_ref );
+
+		// Randomize A and B.
+		libblis_test_mobj_randomize( params, TRUE, &a );
+		libblis_test_mobj_randomize( params, TRUE, &b );
+
+		// For every other problem, set beta to zero and fill C with NaN,
+		// which must then not propagate to the output. Otherwise, set beta
+		// to a nonzero value and randomize C.
+		if ( ( mi + ni ) % 2 == 0 )
+		{
+			bli_setsc( 0.0, 0.0, &beta );
+			bli_setm( &BLIS_NAN, &c );
+		}
+		else
+		{
+			if ( bli_is_real( datatype ) ) bli_setsc( 0.9, 0.0, &beta );
+			else                           bli_setsc( 0.9, 1.0, &beta );
+			libblis_test_mobj_randomize( params, TRUE, &c );
+		}
+
+		// Save C.
+		bli_copym( &c, &c_ref );
+
+		// Apply the parameters.
+		bli_obj_set_conjtrans( transa, &a );
+		bli_obj_set_conjtrans( transb, &b );
+
+		time = bli_clock();
+
+		libblis_test_gemm_tiny_impl( iface, &alpha, &a, &b, &beta, &c );
+
+		time_min = bli_clock_min_diff( time_min, time );
+
+		flops += 2.0 * mi * ni * k;
+
+		// Compute the reference result with the object API, which never
+		// takes the tiny fast path.
+		bli_gemm( &alpha, &a, &b, &beta, &c_ref );
+
+		// Perform checks.
+		libblis_test_gemm_tiny_check( params, &c, &c_ref, &resid_cur );
+
+		// Keep the largest residual, or the first NaN.
+		if ( !bli_isnan( *resid ) &&
+		     ( bli_isnan( resid_cur ) || *resid < resid_cur ) )
+			*resid = resid_cur;
+
+		// Free the test objects.
+		bli_obj_free( &a );
+		bli_obj_free( &b );
+		bli_obj_free( &c );
+		bli_obj_free( &c_ref );
+	}
+
+	// Estimate the performance of the best (i.e., the smallest) problem
+	// instance. This is a rough figure since each problem is timed once.
+	*perf = ( flops / ( m * n ) ) / time_min / FLOPS_PER_UNIT_PERF;
+	if ( bli_is_complex( datatype ) ) *perf *= 4.0;
+
+	// Zero out performance and residual if the sweep is empty.
+	if ( m == 0 || n == 0 || k == 0 ) { *perf = 0.0; *resid = 0.0; }
+}
+
+
+
+void libblis_test_gemm_tiny_impl
+     (
+       iface_t   iface,
+       obj_t*    alpha,
+       obj_t*    a,
+       obj_t*    b,
+       obj_t*    beta,
+       obj_t*    c
+     )
+{
+	num_t   dt     = bli_obj_dt( c );
+
+	trans_t transa = bli_obj_conjtrans_status( a );
+	trans_t transb = bli_obj_conjtrans_status( b );
+	dim_t   m      = bli_obj_length( c );
+	dim_t   n      = bli_obj_width( c );
+	dim_t   k      = bli_obj_width_after_trans( a );
+
+	void*   buf_alpha = bli_obj_buffer_for_1x1( dt, alpha );
+	void*   buf_a     = bli_obj_buffer_at_off( a );
+	inc_t   rs_a      = bli_obj_row_stride( a );
+	inc_t   cs_a      = bli_obj_col_stride( a );
+	void*   buf_b     = bli_obj_buffer_at_off( b );
+	inc_t   rs_b      = bli_obj_row_stride( b );
+	inc_t   cs_b      = bli_obj_col_stride( b );
+	void*   buf_beta  = bli_obj_buffer_for_1x1( dt, beta );
+	void*   buf_c     = bli_obj_buffer_at_off( c );
+	inc_t   rs_c      = bli_obj_row_stride( c );
+	inc_t   cs_c      = bli_obj_col_stride( c );
+
+	switch ( iface )
+	{
+		case BLIS_TEST_SEQ_FRONT_END:
+		// Call the typed API, which is where the tiny fast path lives.
+		if      ( dt == BLIS_FLOAT )
+			bli_sgemm( transa, transb, m, n, k,
+			           buf_alpha, buf_a, rs_a, cs_a, buf_b, rs_b, cs_b,
+			           buf_beta, buf_c, rs_c, cs_c );
+		else if ( dt == BLIS_DOUBLE )
+			bli_dgemm( transa, transb, m, n, k,
+			           buf_alpha, buf_a, rs_a, cs_a, buf_b, rs_b, cs_b,
+			           buf_beta, buf_c, rs_c, cs_c );
+		else if ( dt == BLIS_SCOMPLEX )
+			bli_cgemm( transa, transb, m, n, k,
+			           buf_alpha, buf_a, rs_a, cs_a, buf_b, rs_b, cs_b,
+			           buf_beta, buf_c, rs_c, cs_c );
+		else if ( dt == BLIS_DCOMPLEX )
+			bli_zgemm( transa, transb, m, n, k,
+			           buf_alpha, buf_a, rs_a, cs_a, buf_b, rs_b, cs_b,
+			           buf_beta, buf_c, rs_c, cs_c );
+		break;
+
+		default:
+		libblis_test_printf_error( "Invalid interface type.\n" );
+	}
+}
+
+
+
+void libblis_test_gemm_tiny_check
+     (
+       test_params_t* params,
+       obj_t*         c,
+       obj_t*         c_ref,
+       double*        resid
+     )
+{
+	num_t  dt_real = bli_obj_dt_proj_to_real( c );
+
+	obj_t  norm;
+
+	double junk;
+
+	//
+	// Pre-conditions:
+	// - a and b are randomized.
+	// - c_ref holds the result of the object API,
+	//
+	//     C_ref := beta * C_orig + alpha * transa(A) * transb(B)
+	//
+	// Under these conditions, we assume that the implementation for
+	//
+	//   C := beta * C_orig + alpha * transa(A) * transb(B)
+	//
+	// (via the typed API) is functioning correctly if
+	//
+	//   normfm( C - C_ref )
+	//
+	// is negligible.
+	//
+
+	bli_obj_scalar_init_detached( dt_real, &norm );
+
+	bli_subm( c_ref, c );
+	bli_normfm( c, &norm );
+
+	bli_getsc( &norm, resid, &junk );
+}
+
@@ -0,0 +1,383 @@
+/*
+
+   BLIS
+   An object-based framework for developing high-performance BLAS-like
+   libraries.
+
+   Copyright (C) 2014, The University of Texas at Austin
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are
+   met:
+    - Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    - Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    - Neither the name(s) of the copyright holder(s) nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+   HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "blis.h"
+#include "test_libblis.h"
+
+
+// Static variables.
+static char*     op_str                    = "getrfnp_compact";
+static char*     o_types                   = "m";  // a
+static char*     p_types                   = "";   // (no parameters)
+static thresh_t  thresh[BLIS_NUM_FP_TYPES] = { { 1e-04, 1e-05 },   // warn, pass for s
+                                               { 1e-04, 1e-05 },   // warn, pass for c
+                                               { 1e-13, 1e-14 },   // warn, pass for d
+                                               { 1e-13, 1e-14 } }; // warn, pass for z
+
+// Local prototypes.
+void libblis_test_getrfnp_compact_deps
+     (
+       thread_data_t* tdata,
+       test_params_t* params,
+       test_op_t*     op
+     );
+
+void libblis_test_getrfnp_compact_experiment
+     (
+       test_params_t* params,
+       test_op_t*     op,
+       iface_t        iface,
+       char*          dc_str,
+       char*          pc_str,
+       char*          sc_str,
+       unsigned int   p_cur,
+       double*        perf,
+       double*        resid
+     );
+
+void libblis_test_getrfnp_compact_impl
+     (
+       iface_t   iface,
+       dim_t     nb,
+       obj_t*    a
+     );
+
+void libblis_test_getrfnp_compact_check
+     (
+       test_params_t* params,
+       obj_t*         a,
+       obj_t*         a_orig,
+       double*        resid
+     );
+
+
+
+void libblis_test_getrfnp_compact_deps
+     (
+       thread_data_t* tdata,
+       test_params_t* params,
+       test_op_t*     op
+     )
+{
+	libblis_test_randm( tdata, params, &(op->ops->randm) );
+	libblis_test_normfm( tdata, params, &(op->ops->normfm) );
+	libblis_test_subm( tdata, params, &(op->ops->subm) );
+	libblis_test_copym( tdata, params, &(op->ops->copym) );
+	libblis_test_gemm( tdata, params, &(op->ops->gemm) );
+}
+
+
+
+void libblis_test_getrfnp_compact
+     (
+       thread_data_t* tdata,
+       test_params_t* params,
+       test_op_t*     op
+     )
+{
+
+	// Return early if this test has already been done.
+	if ( libblis_test_op_is_done( op ) ) return;
+
+	// Return early if operation is disabled.
+	if ( libblis_test_op_is_disabled( op ) ||
+	     libblis_test_l3_is_disabled( op ) ) return;
+
+	// Call dependencies first.
+	if ( TRUE ) libblis_test_getrfnp_compact_deps( tdata, params, op );
+
+	// Execute the test driver for each implementation requested.
+	//if ( op->front_seq == ENABLE )
+	{
+		libblis_test_op_driver( tdata,
+		                        params,
+		                        op,
+		                        BLIS_TEST_SEQ_FRONT_END,
+		                        op_str,
+		                        p_types,
+		                        o_types,
+		                        thresh,
+		                        libblis_test_getrfnp_compact_experiment );
+	}
+}
+
+
+
+void libblis_test_getrfnp_compact_experiment
+     (
+       test_params_t* params,
+       test_op_t*     op,
+       iface_t        iface,
+       char*          dc_str,
+       char*          pc_str,
+       char*          sc_str,
+       unsigned int   p_cur,
+       double*        perf,
+       double*        resid
+     )
+{
+	unsigned int n_repeats = params->n_repeats;
+	unsigned int i;
+
+	double       time_min  = DBL_MAX;
+	double       time;
+	double       resid_cur;
+
+	num_t        datatype;
+
+	dim_t        m, n;
+	dim_t        mn;
+	dim_t        nb;
+
+	obj_t*       a;
+	obj_t*       a_save;
+
+	err_t        r_val;
+
+
+	// Use the datatype of the first char in the datatype combination string.
+	bli_param_map_char_to_blis_dt( dc_str[0], &datatype );
+
+	*perf  = 0.0;
+	*resid = 0.0;
+
+	// The compact operations are only defined for the real domain.
+	if ( bli_is_complex( datatype ) ) return;
+
+	// Map the dimension specifier to actual dimensions.
+	m  = libblis_test_get_dim_from_prob_size( op->dim_spec[0], p_cur );
+	n  = libblis_test_get_dim_from_prob_size( op->dim_spec[1], p_cur );
+	mn = bli_min( m, n );
+
+	// Use a batch of two full groups and a partial one, so that the padding
+	// of the last group is exercised.
+	nb = 2 * bli_compact_width( datatype, NULL ) + 3;
+
+	// Create the members of the batch.
+	a      = bli_malloc_user( nb * sizeof( obj_t ), &r_val );
+	a_save = bli_malloc_user( nb * sizeof( obj_t ), &r_val );
+
+	for ( dim_t q = 0; q < nb; ++q )
+	{
+		libblis_test_mobj_create( params, datatype, BLIS_NO_TRANSPOSE,
+		                          sc_str[0], m, n, &a[q] );
+		libblis_test_mobj_create( params, datatype, BLIS_NO_TRANSPOSE,
+		                          sc_str[0], m, n, &a_save[q] );
+
+		// Randomize A and load the diagonal, so that the factorization is
+		// stable without pivoting. Then save A.
+		libblis_test_mobj_randomize( params, TRUE, &a[q] );
+		libblis_test_mobj_load_diag( params, &a[q] );
+		bli_copym( &a[q], &a_save[q] );
+	}
+
+	// Repeat the experiment n_repeats times and record results.
+	for ( i = 0; i < n_repeats; ++i )
+	{
+		for ( dim_t q = 0; q < nb; ++q )
+			bli_copym( &a_save[q], &a[q] );
+
+		time = bli_clock();
+
+		libblis_test_getrfnp_compact_impl( iface, nb, a );
+
+		time_min = bli_clock_min_diff( time_min, time );
+	}
+
+	// Estimate the performance of the best experiment repeat. Note that the
+	// time includes the conversion of the batch to and from the compact
+	// format.
+	*perf = ( ( 1.0 * m * n * mn - ( m + n ) * mn * mn / 2.0 + mn * mn * mn / 3.0 ) * 2.0 * nb )
+	        / time_min / FLOPS_PER_UNIT_PERF;
+
+	for ( dim_t q = 0; q < nb; ++q )
+	{
+		// Perform checks for each member separately.
+		libblis_test_getrfnp_compact_check( params, &a[q], &a_save[q], &resid_cur );
+
+		// Keep the largest residual, or the first NaN.
+		if ( !bli_isnan( *resid ) &&
+		     ( bli_isnan( resid_cur ) || *resid < resid_cur ) )
+			*resid = resid_cur;
+	}
+
+	// Zero out performance and residual if output matrix is empty.
+	libblis_test_check_empty_problem( &a[0], perf, resid );
+
+	// Free the test objects.
+	for ( dim_t q = 0; q < nb; ++q )
+	{
+		bli_obj_free( &a[q] );
+		bli_obj_free( &a_save[q] );
+	}
+
+	bli_free_user( a );
+	bli_free_user( a_save );
+}
+
+
+
+void libblis_test_getrfnp_compact_impl
+     (
+       iface_t   iface,
+       dim_t     nb,
+       obj_t*    a
+     )
+{
+	num_t   dt     = bli_obj_dt( a );
+
+	// The members of the batch are stored alike, so the strides of the first
+	// member apply to all of them.
+	dim_t   m      = bli_obj_length( &a[0] );
+	dim_t   n      = bli_obj_width( &a[0] );
+	inc_t   rs_a   = bli_obj_row_stride( &a[0] );
+	inc_t   cs_a   = bli_obj_col_stride( &a[0] );
+
+	err_t   r_val;
+
+	void**  buf_a  = bli_malloc_user( nb * sizeof( void* ), &r_val );
+
+	void*   ap     = bli_malloc_user( bli_compact_size( dt, m, n, nb, NULL ), &r_val );
+
+	for ( dim_t q = 0; q < nb; ++q )
+		buf_a[q] = bli_obj_buffer_at_off( &a[q] );
+
+	switch ( iface )
+	{
+		case BLIS_TEST_SEQ_FRONT_END:
+		// Convert the batch to the compact format, factor, and convert A
+		// back.
+		if      ( dt == BLIS_FLOAT )
+		{
+			bli_sgepack_compact( m, n, ( const float* const* )buf_a, rs_a, cs_a, nb, ap );
+			bli_sgetrfnp_compact( m, n, ap, nb );
+			bli_sgeunpack_compact( m, n, ap, nb, ( float* const* )buf_a, rs_a, cs_a );
+		}
+		else if ( dt == BLIS_DOUBLE )
+		{
+			bli_dgepack_compact( m, n, ( const double* const* )buf_a, rs_a, cs_a, nb, ap );
+			bli_dgetrfnp_compact( m, n, ap, nb );
+			bli_dgeunpack_compact( m, n, ap, nb, ( double* const* )buf_a, rs_a, cs_a );
+		}
+		break;
+
+		default:
+		libblis_test_printf_error( "Invalid interface type.\n" );
+	}
+
+	bli_free_user( ap );
+
+	bli_free_user( buf_a );
+}
+
+
+
+void libblis_test_getrfnp_compact_check
+     (
+       test_params_t* params,
+       obj_t*         a,
+       obj_t*         a_orig,
+       double*        resid
+     )
+{
+	num_t  dt      = bli_obj_dt( a );
+	num_t  dt_real = bli_obj_dt_proj_to_real( a );
+
+	dim_t  m       = bli_obj_length( a );
+	dim_t  n       = bli_obj_width( a );
+	dim_t  mn      = bli_min( m, n );
+
+	obj_t  a_l, a_u;
+	obj_t  l, u, lu;
+	obj_t  norm;
+
+	double junk;
+
+	//
+	// Pre-conditions:
+	// - a_orig is randomized with a loaded diagonal.
+	// - a holds the factors of the same member, i.e., the strictly lower
+	//   trapezoid of the unit lower trapezoidal m x min(m,n) matrix L, and
+	//   the upper trapezoidal min(m,n) x n matrix U.
+	//
+	// Under these conditions, we assume that the implementation for
+	//
+	//   A_orig = L * U
+	//
+	// (via the compact format) is functioning correctly if
+	//
+	//   normfm( L * U - A_orig )
+	//
+	// is negligible.
+	//
+
+	bli_obj_scalar_init_detached( dt_real, &norm );
+
+	bli_obj_create( dt, m,  mn, 0, 0, &l );
+	bli_obj_create( dt, mn, n,  0, 0, &u );
+	bli_obj_create( dt, m,  n,  0, 0, &lu );
+
+	// Extract L from the leading m x min(m,n) part of A. Only the strictly
+	// lower part is copied, so the unit diagonal is set explicitly.
+	bli_obj_alias_to( a, &a_l );
+	bli_obj_set_dims( m, mn, &a_l );
+	bli_obj_set_struc( BLIS_TRIANGULAR, &a_l );
+	bli_obj_set_uplo( BLIS_LOWER, &a_l );
+	bli_obj_set_diag( BLIS_UNIT_DIAG, &a_l );
+
+	bli_setm( &BLIS_ZERO, &l );
+	bli_copym( &a_l, &l );
+	bli_setd( &BLIS_ONE, &l );
+
+	// Extract U from the leading min(m,n) x n part of A.
+	bli_obj_alias_to( a, &a_u );
+	bli_obj_set_dims( mn, n, &a_u );
+	bli_obj_set_struc( BLIS_TRIANGULAR, &a_u );
+	bli_obj_set_uplo( BLIS_UPPER, &a_u );
+
+	bli_setm( &BLIS_ZERO, &u );
+	bli_copym( &a_u, &u );
+
+	bli_gemm( &BLIS_ONE, &l, &u, &BLIS_ZERO, &lu );
+
+	bli_subm( a_orig, &lu );
+	bli_normfm( &lu, &norm );
+
+	bli_getsc( &norm, resid, &junk );
+
+	bli_obj_free( &l );
+	bli_obj_free( &u );
+	bli_obj_free( &lu );
+}
+
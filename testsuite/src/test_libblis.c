@@ -338,6 +338,15 @@ void libblis_test_level3_ops( thread_data_t* tdata, test_params_t* params, test_
 	libblis_test_trmm( tdata, params, &(ops->trmm) );
 	libblis_test_trmm3( tdata, params, &(ops->trmm3) );
 	libblis_test_trsm( tdata, params, &(ops->trsm) );
+	libblis_test_gemm_tiny( tdata, params, &(ops->gemm_tiny) );
+	libblis_test_gemm_compact( tdata, params, &(ops->gemm_compact) );
+	libblis_test_trsm_compact( tdata, params, &(ops->trsm_compact) );
+	libblis_test_getrfnp_compact( tdata, params, &(ops->getrfnp_compact) );
+	libblis_test_gemm_pack( tdata, params, &(ops->gemm_pack) );
+	libblis_test_gemm_postops( tdata, params, &(ops->gemm_postops) );
+	libblis_test_gemm_batch( tdata, params, &(ops->gemm_batch) );
+	libblis_test_gemm_batch_strided( tdata, params, &(ops->gemm_batch_strided) );
+	libblis_test_gemm_wspace( tdata, params, &(ops->gemm_wspace) );
 }
 
 
@@ -435,6 +444,15 @@ void libblis_test_read_ops_file( char* input_filename, test_ops_t* ops )
 	libblis_test_read_op_info( ops, input_stream, BLIS_TRMM,  BLIS_TEST_DIMS_MN,  4, &(ops->trmm) );
 	libblis_test_read_op_info( ops, input_stream, BLIS_TRMM3, BLIS_TEST_DIMS_MN,  5, &(ops->trmm3) );
 	libblis_test_read_op_info( ops, input_stream, BLIS_TRSM,  BLIS_TEST_DIMS_MN,  4, &(ops->trsm) );
+	libblis_test_read_op_info( ops, input_stream, BLIS_NOID, BLIS_TEST_DIMS_MNK, 2, &(ops->gemm_tiny) );
+	libblis_test_read_op_info( ops, input_stream, BLIS_NOID, BLIS_TEST_DIMS_MNK, 2, &(ops->gemm_compact) );
+	libblis_test_read_op_info( ops, input_stream, BLIS_NOID, BLIS_TEST_DIMS_MN,  4, &(ops->trsm_compact) );
+	libblis_test_read_op_info( ops, input_stream, BLIS_NOID, BLIS_TEST_DIMS_MN,  0, &(ops->getrfnp_compact) );
+	libblis_test_read_op_info( ops, input_stream, BLIS_NOID, BLIS_TEST_DIMS_MNK, 2, &(ops->gemm_pack) );
+	libblis_test_read_op_info( ops, input_stream, BLIS_NOID, BLIS_TEST_DIMS_MNK, 2, &(ops->gemm_postops) );
+	libblis_test_read_op_info( ops, input_stream, BLIS_NOID, BLIS_TEST_DIMS_MNK, 2, &(ops->gemm_batch) );
+	libblis_test_read_op_info( ops, input_stream, BLIS_NOID, BLIS_TEST_DIMS_MNK, 2, &(ops->gemm_batch_strided) );
+	libblis_test_read_op_info( ops, input_stream, BLIS_NOID, BLIS_TEST_DIMS_MNK, 2, &(ops->gemm_wspace) );
 
 	// Output the section overrides.
 	libblis_test_output_section_overrides( stdout, ops );
@@ -907,6 +925,14 @@ void libblis_test_output_params_struct( FILE* os, test_params_t* params )
 	libblis_test_fprintf_c( os, "libmemkind                       \n" );
 	libblis_test_fprintf_c( os, "  enabled?                     %d\n", ( int )bli_info_get_enable_memkind() );
 	libblis_test_fprintf_c( os, "\n" );
+	libblis_test_fprintf_c( os, "libnuma                          \n" );
+	libblis_test_fprintf_c( os, "  enabled?                     %d\n", ( int )bli_info_get_enable_libnuma() );
+	libblis_test_fprintf_c( os, "  NUMA nodes (pba pools)       %d\n", ( int )bli_pba_num_nodes( bli_pba_query() ) );
+	libblis_test_fprintf_c( os, "\n" );
+	libblis_test_fprintf_c( os, "huge pages                       \n" );
+	libblis_test_fprintf_c( os, "  enabled by default?          %d\n", ( int )bli_info_get_enable_hugepages() );
+	libblis_test_fprintf_c( os, "  mode (pba pools)             %d\n", ( int )bli_pba_hugepages( bli_pba_query() ) );
+	libblis_test_fprintf_c( os, "\n" );
 	libblis_test_fprintf_c( os, "gemm sandbox                     \n" );
 	libblis_test_fprintf_c( os, "  enabled?                     %d\n", ( int )bli_info_get_enable_sandbox() );
 	libblis_test_fprintf_c( os, "\n" );
@@ -972,6 +998,8 @@ void libblis_test_output_params_struct( FILE* os, test_params_t* params )
 	libblis_test_fprintf_c( os, "thread partitioning              \n" );
 	//libblis_test_fprintf_c( os, "  jc/ic loops                  %s\n", "slab" );
 	libblis_test_fprintf_c( os, "  jr/ir loops                  %s\n", jrir_str );
+	libblis_test_fprintf_c( os, "  jr/ir schedule (gemm)        %s\n",
+	                        bli_thread_get_jrir_sched_str( bli_thread_get_jrir_sched() ) );
 	libblis_test_fprintf_c( os, "\n" );
 
 	libblis_test_fprintf_c( os, "\n" );
@@ -285,6 +285,15 @@ typedef struct test_ops_s
 	test_op_t trmm;
 	test_op_t trmm3;
 	test_op_t trsm;
+	test_op_t gemm_tiny;
+	test_op_t gemm_compact;
+	test_op_t trsm_compact;
+	test_op_t getrfnp_compact;
+	test_op_t gemm_pack;
+	test_op_t gemm_postops;
+	test_op_t gemm_batch;
+	test_op_t gemm_batch_strided;
+	test_op_t gemm_wspace;
 
 } test_ops_t;
 
@@ -561,4 +570,13 @@ char libblis_test_proj_dtchar_to_precchar( char dt_char );
 #include "test_trmm.h"
 #include "test_trmm3.h"
 #include "test_trsm.h"
+#include "test_gemm_tiny.h"
+#include "test_gemm_compact.h"
+#include "test_trsm_compact.h"
+#include "test_getrfnp_compact.h"
+#include "test_gemm_pack.h"
+#include "test_gemm_postops.h"
+#include "test_gemm_batch.h"
+#include "test_gemm_batch_strided.h"
+#include "test_gemm_wspace.h"
 